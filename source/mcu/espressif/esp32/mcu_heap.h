@@ -28,6 +28,11 @@
 
 #if defined(MCU_HEAP_DEBUG)
 #include "module/comm/dbg.h"
+#include "mcu/mcu_heap_profiler.h"
+#endif
+
+#if MCU_HEAP_USE_SLAB
+#include "mcu/mcu_heap_slab.h"
 #endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -39,23 +44,40 @@
  */
 #define mcu_heap_get_free_size()            esp_get_free_heap_size()
 
-#if defined(MCU_HEAP_DEBUG)
+#if CONFIG_SPIRAM
+/// Allocates from the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_calloc(num, size)   heap_caps_calloc(num, size, MALLOC_CAP_SPIRAM)
+/// Allocates from the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_malloc(size)        heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
+#else
+/// Allocates from the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_calloc(num, size)   calloc(num, size)
+/// Allocates from the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_malloc(size)        malloc(size)
+#endif
+/// Frees memory of the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_free(ptr)           free(ptr)
 
-void* mcu_heap_calloc_debug(char* filename, char* line_str, size_t num, size_t size);
+#if defined(MCU_HEAP_DEBUG)
 
 #define mcu_heap_calloc(num, size)          mcu_heap_calloc_debug(DBG_STRING, num, size)
 
-void* mcu_heap_malloc_debug(char* filename, char* line_str, size_t size);
-
 #define mcu_heap_malloc(size)               mcu_heap_malloc_debug(DBG_STRING, size)
 
-void mcu_heap_free_debug(char* filename, char* line_str, void* ptr);
-
 /**
  * @brief Frees a pointer from the heap. 
  */
 #define mcu_heap_free(ptr)                  mcu_heap_free_debug(DBG_STRING, ptr)
 
+#elif MCU_HEAP_USE_SLAB
+
+#define mcu_heap_calloc(num, size)          mcu_heap_slab_calloc(num, size)
+#define mcu_heap_malloc(size)               mcu_heap_slab_malloc(size)
+/**
+ * @brief Frees a pointer from the heap. 
+ */
+#define mcu_heap_free(ptr)                  mcu_heap_slab_free(ptr)
+
 #else
 
 #if CONFIG_SPIRAM
@@ -219,40 +219,6 @@ void mcu_io_interrupt_disable_expander(MCU_IO_PIN p)
 	}
 }
 
-#if defined(MCU_HEAP_DEBUG)
-
-void* mcu_heap_calloc_debug(char* filename, char* line_str, size_t num, size_t size)
-{
-	void* ptr;
-#if CONFIG_SPIRAM
-	ptr = heap_caps_calloc(num, size, MALLOC_CAP_SPIRAM); 
-#else
-	ptr = calloc(num, size); 
-#endif
-	dbg_printf(filename, line_str, "calloc(%u, %u) -> %08x\n", num, size, ptr); 
-	return ptr;
-}
-
-void* mcu_heap_malloc_debug(char* filename, char* line_str, size_t size)
-{
-	void* ptr;
-#if CONFIG_SPIRAM
-	ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM); 
-#else
-	ptr = malloc(size); 
-#endif
-	dbg_printf(filename, line_str, "malloc(%u) -> %08x\n", size, ptr); 
-	return ptr;
-}
-
-void mcu_heap_free_debug(char* filename, char* line_str, void* ptr)
-{
-	free(ptr);
-	dbg_printf(filename, line_str, "free(%08x)\n", ptr); 
-}
-
-#endif
-
 #if MCU_PERIPHERY_ENABLE_WAIT_TIMER
 void mcu_wait_us(uint16_t delay)
 {
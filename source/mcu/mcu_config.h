@@ -230,6 +230,12 @@
 #define MCU_PERIPHERY_ENABLE_COMM_MODE_UART				(CONFIG_MCU_PERIPHERY_ENABLE_COMM_MODE_UART)
 /// Enable/disable freertos
 #define MCU_ENABLE_FREERTOS								(CONFIG_MCU_ENABLE_FREERTOS)
+/// Redirects the mcu_heap functions to the slab allocator.
+#define MCU_HEAP_USE_SLAB								(CONFIG_MCU_HEAP_USE_SLAB)
+#if MCU_HEAP_USE_SLAB
+/// Size of the arena in bytes that is allocated from the system heap for the slab pages.
+#define MCU_HEAP_SLAB_ARENA_SIZE						CONFIG_MCU_HEAP_SLAB_ARENA_SIZE
+#endif
 /// Number of allocated IO Interrupt instances.
 #define MCU_PERIPHERY_DEVICE_COUNT_IO_INTERRUPT			CONFIG_MCU_PERIPHERY_DEVICE_COUNT_IO_INTERRUPT
 /// Number of allocated Timer instances.
@@ -0,0 +1,336 @@
+/**
+ * @file 	mcu_heap_profiler.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ * @author 	Tim Koczwara
+ **/
+
+#include "mcu.h"
+#if defined(MCU_HEAP_DEBUG)
+#include "mcu_heap_profiler.h"
+#include "module/comm/comm.h"
+#include "module/comm/dbg.h"
+#include <string.h>
+#include <stddef.h>
+
+#if MCU_ENABLE_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#if MCU_ENABLE_FREERTOS && defined(ESP_PLATFORM)
+/// Spinlocks are used, because they also work between the cores.
+static portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+#define _PROFILER_LOCK()            taskENTER_CRITICAL(&_lock)
+#define _PROFILER_UNLOCK()          taskEXIT_CRITICAL(&_lock)
+#elif MCU_ENABLE_FREERTOS
+#define _PROFILER_LOCK()            vTaskSuspendAll()
+#define _PROFILER_UNLOCK()          xTaskResumeAll()
+#else
+#define _PROFILER_LOCK()            do{}while(0)
+#define _PROFILER_UNLOCK()          do{}while(0)
+#endif
+
+/// Number of probes before a new call site is accounted to the overflow entry.
+#define _PROFILER_MAX_PROBES        8
+
+/// Index of the entry that collects the call sites which did not fit into the table.
+#define _PROFILER_OVERFLOW          0
+
+#if (MCU_HEAP_PROFILER_SITES & (MCU_HEAP_PROFILER_SITES - 1)) != 0 || MCU_HEAP_PROFILER_SITES < 2
+#error MCU_HEAP_PROFILER_SITES must be a power of two
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal structures and enums
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Header in front of every allocation. The union keeps the user memory aligned like malloc does.
+typedef union _alloc_header_u
+{
+    struct
+    {
+        /// Requested size in bytes
+        size_t size;
+        /// Index of the call site in _sites
+        size_t site;
+    };
+    max_align_t align;
+}_alloc_header_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal function prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the index of the entry for the call site and creates it if needed. Must be called while locked.
+ *
+ * @param filename      Filename of the call site.
+ * @param line_str      Line of the call site.
+ * @return              Index inside _sites.
+ */
+static size_t _get_site(const char* filename, const char* line_str);
+
+/**
+ * @brief Adds the header to the allocated memory and accounts the size to the call site.
+ *
+ * @param h             Pointer to the allocated memory including the header. Can be NULL.
+ * @param filename      Filename of the call site.
+ * @param line_str      Line of the call site.
+ * @param size          Requested size in bytes.
+ * @return              Pointer to the memory behind the header or NULL if h is NULL.
+ */
+static void* _register_alloc(_alloc_header_t* h, const char* filename, const char* line_str, size_t size);
+
+/**
+ * @brief Removes the unused entries from a copy of the call site table and sorts the rest by live bytes, starting with the biggest.
+ *
+ * @param sites         Copy of _sites with MCU_HEAP_PROFILER_SITES entries.
+ * @return              Number of used call sites at the start of sites.
+ */
+static size_t _sort_sites(mcu_heap_profiler_site_t* sites);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal variables
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Call site table. Entry 0 is reserved for the call sites that did not fit into the table.
+static mcu_heap_profiler_site_t _sites[MCU_HEAP_PROFILER_SITES] = {0};
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void* mcu_heap_calloc_debug(const char* filename, const char* line_str, size_t num, size_t size)
+{
+	size_t total = num * size;
+	void* ptr;
+
+	if(size != 0 && total / size != num)
+	{
+		return NULL;
+	}
+
+	ptr = _register_alloc(mcu_heap_system_calloc(1, sizeof(_alloc_header_t) + total), filename, line_str, total);
+#if MCU_HEAP_DEBUG_PRINT
+	dbg_printf(filename, line_str, "calloc(%u, %u) -> %08x\n", num, size, ptr);
+#endif
+	return ptr;
+}
+
+void* mcu_heap_malloc_debug(const char* filename, const char* line_str, size_t size)
+{
+	void* ptr = _register_alloc(mcu_heap_system_malloc(sizeof(_alloc_header_t) + size), filename, line_str, size);
+#if MCU_HEAP_DEBUG_PRINT
+	dbg_printf(filename, line_str, "malloc(%u) -> %08x\n", size, ptr);
+#endif
+	return ptr;
+}
+
+void mcu_heap_free_debug(const char* filename, const char* line_str, void* ptr)
+{
+	_alloc_header_t* h;
+	mcu_heap_profiler_site_t* s;
+
+	if(ptr == NULL)
+	{
+		return;
+	}
+
+	h = (_alloc_header_t*)ptr - 1;
+
+	_PROFILER_LOCK();
+	s = &_sites[h->site];
+	s->live_bytes -= h->size;
+	s->free_count++;
+	_PROFILER_UNLOCK();
+
+	mcu_heap_system_free(h);
+#if MCU_HEAP_DEBUG_PRINT
+	dbg_printf(filename, line_str, "free(%08x)\n", ptr);
+#else
+	(void)filename;
+	(void)line_str;
+#endif
+}
+
+size_t mcu_heap_profiler_get_sites(mcu_heap_profiler_site_t* sites, size_t num)
+{
+	mcu_heap_profiler_site_t* copy = sites;
+	size_t cnt;
+
+	if(sites == NULL || num == 0)
+	{
+		return 0;
+	}
+
+	if(num < MCU_HEAP_PROFILER_SITES)
+	{
+		copy = mcu_heap_system_malloc(sizeof(_sites));
+		if(copy == NULL)
+		{
+			return 0;
+		}
+	}
+
+	// Only the copy is done while locked, so the allocations on other tasks and cores are not blocked by the sorting.
+	_PROFILER_LOCK();
+	memcpy(copy, _sites, sizeof(_sites));
+	_PROFILER_UNLOCK();
+
+	cnt = _sort_sites(copy);
+
+	if(copy != sites)
+	{
+		if(cnt > num)
+		{
+			cnt = num;
+		}
+		memcpy(sites, copy, cnt * sizeof(mcu_heap_profiler_site_t));
+		mcu_heap_system_free(copy);
+	}
+
+	return cnt;
+}
+
+void mcu_heap_profiler_print(comm_t* comm, size_t max_sites)
+{
+	// Copy the whole table, so printing does not block the allocations.
+	mcu_heap_profiler_site_t* sites = mcu_heap_system_malloc(sizeof(_sites));
+	size_t cnt;
+	size_t live = 0;
+
+	if(sites == NULL)
+	{
+		comm_puts(comm, "heap profiler: no memory\n");
+		return;
+	}
+
+	cnt = mcu_heap_profiler_get_sites(sites, MCU_HEAP_PROFILER_SITES);
+
+	for(size_t i = 0; i < cnt; i++)
+	{
+		live += sites[i].live_bytes;
+	}
+
+	comm_printf(comm, "heap profiler: %u sites, %u bytes live\n", (unsigned int)cnt, (unsigned int)live);
+
+	if(max_sites == 0 || max_sites > cnt)
+	{
+		max_sites = cnt;
+	}
+
+	for(size_t i = 0; i < max_sites; i++)
+	{
+		comm_printf(comm, "%s:%s live=%u peak=%u alloc=%u free=%u\n",
+				sites[i].filename ? sites[i].filename : "<overflow>",
+				sites[i].line ? sites[i].line : "-",
+				(unsigned int)sites[i].live_bytes,
+				(unsigned int)sites[i].peak_bytes,
+				(unsigned int)sites[i].alloc_count,
+				(unsigned int)sites[i].free_count);
+	}
+
+	mcu_heap_system_free(sites);
+}
+
+void mcu_heap_profiler_reset_peaks(void)
+{
+	_PROFILER_LOCK();
+	for(size_t i = 0; i < MCU_HEAP_PROFILER_SITES; i++)
+	{
+		_sites[i].peak_bytes = _sites[i].live_bytes;
+	}
+	_PROFILER_UNLOCK();
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t _get_site(const char* filename, const char* line_str)
+{
+	// The strings are constants of the call site, so their addresses are unique and hashing the pointers is enough.
+	uintptr_t key = (uintptr_t)filename ^ ((uintptr_t)line_str * 31);
+	size_t idx = (size_t)((key * 0x9E3779B1u) >> 7);
+
+	for(size_t i = 0; i < _PROFILER_MAX_PROBES; i++, idx++)
+	{
+		idx &= (MCU_HEAP_PROFILER_SITES - 1);
+
+		if(idx == _PROFILER_OVERFLOW)
+		{
+			idx++;
+		}
+
+		if(_sites[idx].filename == filename && _sites[idx].line == line_str)
+		{
+			return idx;
+		}
+
+		if(_sites[idx].filename == NULL)
+		{
+			_sites[idx].filename = filename;
+			_sites[idx].line = line_str;
+			return idx;
+		}
+	}
+
+	return _PROFILER_OVERFLOW;
+}
+
+static void* _register_alloc(_alloc_header_t* h, const char* filename, const char* line_str, size_t size)
+{
+	mcu_heap_profiler_site_t* s;
+
+	if(h == NULL)
+	{
+		return NULL;
+	}
+
+	h->size = size;
+
+	_PROFILER_LOCK();
+	h->site = _get_site(filename, line_str);
+	s = &_sites[h->site];
+	s->live_bytes += size;
+	if(s->live_bytes > s->peak_bytes)
+	{
+		s->peak_bytes = s->live_bytes;
+	}
+	s->alloc_count++;
+	_PROFILER_UNLOCK();
+
+	return h + 1;
+}
+
+static size_t _sort_sites(mcu_heap_profiler_site_t* sites)
+{
+	size_t cnt = 0;
+
+	for(size_t i = 0; i < MCU_HEAP_PROFILER_SITES; i++)
+	{
+		mcu_heap_profiler_site_t s = sites[i];
+		size_t pos;
+
+		if(s.alloc_count == 0)
+		{
+			continue;
+		}
+
+		// Insertion sort into the front of the array. Entries behind cnt are not needed anymore, so they can be overwritten.
+		for(pos = cnt; pos > 0 && sites[pos - 1].live_bytes < s.live_bytes; pos--)
+		{
+			sites[pos] = sites[pos - 1];
+		}
+		sites[pos] = s;
+		cnt++;
+	}
+
+	return cnt;
+}
+
+#endif
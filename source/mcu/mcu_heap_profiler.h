@@ -0,0 +1,125 @@
+/**
+ * 	@file 		mcu_heap_profiler.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Per call site heap profiler that is active when MCU_HEAP_DEBUG is defined.
+ *
+ *				Every mcu_heap_calloc and mcu_heap_malloc call site is identified by the file and line pointers of DBG_STRING.
+ *				The call sites are kept in a fixed size open addressing table, so alloc and free only need a hash lookup and a few
+ *				counter updates. Each allocation gets a small header with its size and call site, so free can update the
+ *				call site without searching. Call sites that do not fit into the table anymore are collected in the first entry.
+ *
+ *				mcu_heap_free must only be called with memory of mcu_heap_calloc and mcu_heap_malloc. Memory of other
+ *				allocators, like heap_caps_calloc or mcu_heap_system_calloc, has no header and must be freed with the free
+ *				function of its allocator, like heap_caps_free or mcu_heap_system_free.
+ *
+ *				Use mcu_heap_profiler_print to dump the call sites sorted by live bytes on any comm interface, like the debug
+ *				UART or a TCP debug connection.
+ *
+ *  @version	1.01 (18.10.2026)
+ *  			 - Memory of other allocators must be freed with their own free function instead of mcu_heap_free
+ *  			 - mcu_heap_profiler_get_sites only copies the table while locked and sorts the copy afterwards
+ *  @version	1.00 (18.10.2026)
+ *  			 - Initial release
+ *
+ ******************************************************************************/
+
+#ifndef __MCU_HEAP_PROFILER_H__
+#define __MCU_HEAP_PROFILER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "module/comm/comm_type.h"
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Configuration
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef MCU_HEAP_PROFILER_SITES
+/// Number of call sites that can be tracked. Must be a power of two.
+#define MCU_HEAP_PROFILER_SITES             128
+#endif
+
+#ifndef MCU_HEAP_DEBUG_PRINT
+/// If true, every allocation and free is printed on the debug interface additionally to the profiling.
+#define MCU_HEAP_DEBUG_PRINT                false
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Statistic of a single call site.
+typedef struct mcu_heap_profiler_site_s
+{
+    /// Filename of the call site. Is NULL for the entry that collects call sites which did not fit into the table.
+    const char* filename;
+    /// Line of the call site as a string.
+    const char* line;
+    /// Number of bytes that are allocated by this call site and not freed yet.
+    size_t live_bytes;
+    /// Highest value of live_bytes.
+    size_t peak_bytes;
+    /// Number of allocations.
+    uint32_t alloc_count;
+    /// Number of frees of memory that was allocated by this call site.
+    uint32_t free_count;
+}mcu_heap_profiler_site_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Allocates zero initialized memory and accounts it to the call site. Use mcu_heap_calloc instead of calling this directly.
+ *
+ * @param filename      Filename of the call site from DBG_STRING.
+ * @param line_str      Line of the call site from DBG_STRING.
+ * @param num           Number of elements.
+ * @param size          Size of a single element.
+ * @return              Pointer to the memory or NULL if no memory is available.
+ */
+void* mcu_heap_calloc_debug(const char* filename, const char* line_str, size_t num, size_t size);
+/**
+ * @brief Allocates memory and accounts it to the call site. Use mcu_heap_malloc instead of calling this directly.
+ *
+ * @param filename      Filename of the call site from DBG_STRING.
+ * @param line_str      Line of the call site from DBG_STRING.
+ * @param size          Number of bytes to allocate.
+ * @return              Pointer to the memory or NULL if no memory is available.
+ */
+void* mcu_heap_malloc_debug(const char* filename, const char* line_str, size_t size);
+/**
+ * @brief Frees memory and removes it from the call site that allocated it. Use mcu_heap_free instead of calling this directly.
+ *
+ * @param filename      Filename of the call site from DBG_STRING.
+ * @param line_str      Line of the call site from DBG_STRING.
+ * @param ptr           Pointer to memory of mcu_heap_calloc or mcu_heap_malloc. Does nothing on NULL.
+ */
+void mcu_heap_free_debug(const char* filename, const char* line_str, void* ptr);
+/**
+ * @brief Copies the call site statistics sorted by live bytes, starting with the biggest.
+ *
+ * The table is only locked while it is copied. If num is smaller than MCU_HEAP_PROFILER_SITES, a copy of the whole
+ * table is allocated from the system heap temporarily.
+ *
+ * @param sites         Array the statistics are written into.
+ * @param num           Number of elements in sites.
+ * @return              Number of call sites that were written. Is 0 if no memory for the copy is available.
+ */
+size_t mcu_heap_profiler_get_sites(mcu_heap_profiler_site_t* sites, size_t num);
+/**
+ * @brief Prints the call sites sorted by live bytes in the format "<file>:<line> live=<bytes> peak=<bytes> alloc=<n> free=<n>".
+ *
+ * @param comm          Pointer of the comm interface to print on.
+ * @param max_sites     Maximum number of call sites to print. 0 prints all.
+ */
+void mcu_heap_profiler_print(comm_t* comm, size_t max_sites);
+/**
+ * @brief Sets the peak of each call site to its current live bytes, so the next peak of a test phase can be measured.
+ */
+void mcu_heap_profiler_reset_peaks(void);
+
+#endif /* __MCU_HEAP_PROFILER_H__ */
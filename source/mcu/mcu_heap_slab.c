@@ -0,0 +1,396 @@
+/**
+ * @file 	mcu_heap_slab.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ * @author 	Tim Koczwara
+ **/
+
+#include "mcu.h"
+#if MCU_HEAP_USE_SLAB
+#include "mcu_heap_slab.h"
+#include <string.h>
+
+#if MCU_ENABLE_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#if MCU_ENABLE_FREERTOS && defined(ESP_PLATFORM)
+/// Spinlocks are used, because they also work between the cores.
+typedef portMUX_TYPE _slab_lock_t;
+#define _SLAB_LOCK_INITIALIZER      portMUX_INITIALIZER_UNLOCKED
+#define _SLAB_LOCK_INIT(l)          spinlock_initialize(l)
+#define _SLAB_LOCK(l)               taskENTER_CRITICAL(l)
+#define _SLAB_UNLOCK(l)             taskEXIT_CRITICAL(l)
+#define _SLAB_NUM_CORES             portNUM_PROCESSORS
+#define _SLAB_CORE_ID()             xPortGetCoreID()
+#elif MCU_ENABLE_FREERTOS
+/// On single core FreeRTOS targets suspending the scheduler is enough.
+typedef uint8_t _slab_lock_t;
+#define _SLAB_LOCK_INITIALIZER      0
+#define _SLAB_LOCK_INIT(l)          ((void)(l))
+#define _SLAB_LOCK(l)               ((void)(l), vTaskSuspendAll())
+#define _SLAB_UNLOCK(l)             ((void)(l), xTaskResumeAll())
+#define _SLAB_NUM_CORES             1
+#define _SLAB_CORE_ID()             0
+#else
+/// Without an operating system there is nothing to lock. The lock is only referenced, so it does not warn as unused.
+typedef uint8_t _slab_lock_t;
+#define _SLAB_LOCK_INITIALIZER      0
+#define _SLAB_LOCK_INIT(l)          ((void)(l))
+#define _SLAB_LOCK(l)               ((void)(l))
+#define _SLAB_UNLOCK(l)             ((void)(l))
+#define _SLAB_NUM_CORES             1
+#define _SLAB_CORE_ID()             0
+#endif
+
+/// Magazines are only worth it when multiple cores compete for the shared free lists.
+#define _SLAB_USE_MAGAZINE          (_SLAB_NUM_CORES > 1 && MCU_HEAP_SLAB_MAGAZINE_SIZE > 0)
+
+/// Number of pages in the arena
+#define _SLAB_NUM_PAGES             (MCU_HEAP_SLAB_ARENA_SIZE / MCU_HEAP_SLAB_PAGE_SIZE)
+
+/// Size of the objects in a size class
+#define _SLAB_CLASS_SIZE(c)         ((size_t)MCU_HEAP_SLAB_MIN_SIZE << (c))
+
+#if (MCU_HEAP_SLAB_MAX_SIZE & (MCU_HEAP_SLAB_MAX_SIZE - 1)) != 0
+#error MCU_HEAP_SLAB_MAX_SIZE must be a power of two
+#endif
+#if (MCU_HEAP_SLAB_PAGE_SIZE % MCU_HEAP_SLAB_MAX_SIZE) != 0
+#error MCU_HEAP_SLAB_PAGE_SIZE must be a multiple of MCU_HEAP_SLAB_MAX_SIZE
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal structures and enums
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Shared free list of a size class.
+typedef struct _slab_depot_s
+{
+    /// First free object. Free objects store the pointer to the next free object in their first bytes.
+    void* free_list;
+    /// Number of pages assigned to this class.
+    size_t pages;
+    /// Number of objects that are not in the free list.
+    size_t taken;
+    /// Highest value of taken.
+    size_t taken_max;
+}_slab_depot_t;
+
+/// Data that only belongs to a single core.
+typedef struct _slab_core_s
+{
+    /// Lock for this structure. Is only contended when another task on the same core is preempted while holding it.
+    _slab_lock_t lock;
+#if _SLAB_USE_MAGAZINE
+    /// Free objects per size class that are reserved for this core.
+    void* magazine[MCU_HEAP_SLAB_NUM_CLASSES][MCU_HEAP_SLAB_MAGAZINE_SIZE];
+    /// Number of objects in each magazine.
+    uint8_t magazine_num[MCU_HEAP_SLAB_NUM_CLASSES];
+#endif
+    /// Number of allocations per size class.
+    uint32_t allocations[MCU_HEAP_SLAB_NUM_CLASSES];
+    /// Number of frees per size class.
+    uint32_t frees[MCU_HEAP_SLAB_NUM_CLASSES];
+    /// Sum of requested bytes.
+    uint64_t bytes_requested;
+    /// Sum of served bytes.
+    uint64_t bytes_served;
+    /// Number of allocations passed to the system heap.
+    uint32_t fallback_allocations;
+}_slab_core_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Allocates the arena on first use.
+ */
+static void _init(void);
+/**
+ * @brief Allocates an object of the given size class.
+ *
+ * @param cls           Index of the size class.
+ * @param size          Requested size, only used for statistics.
+ * @return              Pointer to the object or NULL if the arena is exhausted.
+ */
+static void* _alloc(uint8_t cls, size_t size);
+/**
+ * @brief Takes an object from the shared free list of a size class. Assigns a new page to the class if needed. Global lock must be taken.
+ *
+ * @param cls           Index of the size class.
+ * @return              Pointer to the object or NULL if the arena is exhausted.
+ */
+static void* _depot_pop(uint8_t cls);
+/**
+ * @brief Puts an object back into the shared free list of a size class. Global lock must be taken.
+ *
+ * @param cls           Index of the size class.
+ * @param obj           Object to put back.
+ */
+static void _depot_push(uint8_t cls, void* obj);
+/**
+ * @brief Returns the size class for a size.
+ *
+ * @param size          Requested size. Must not be bigger than MCU_HEAP_SLAB_MAX_SIZE.
+ * @return              Index of the size class.
+ */
+static inline uint8_t _get_class(size_t size);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal variables
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Lock for the arena and the depots.
+static _slab_lock_t _lock = _SLAB_LOCK_INITIALIZER;
+/// Set when the arena was allocated.
+static volatile bool _initialized = false;
+/// Start of the arena. Is NULL if the arena could not be allocated.
+static uint8_t* _arena = NULL;
+/// Number of pages assigned to a size class. Pages are assigned in ascending order.
+static size_t _pages_used = 0;
+/// Size class of each page.
+static uint8_t _page_class[_SLAB_NUM_PAGES];
+/// Shared free lists.
+static _slab_depot_t _depot[MCU_HEAP_SLAB_NUM_CLASSES];
+/// Per core data.
+static _slab_core_t _core[_SLAB_NUM_CORES];
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void* mcu_heap_slab_calloc(size_t num, size_t size)
+{
+    if(size != 0 && num > SIZE_MAX / size)
+        return NULL;
+
+    size *= num;
+
+    if(size > MCU_HEAP_SLAB_MAX_SIZE)
+        return mcu_heap_system_calloc(1, size);
+
+    void* ptr = _alloc(_get_class(size), size);
+    if(ptr)
+    {
+        memset(ptr, 0, size);
+        return ptr;
+    }
+    return mcu_heap_system_calloc(1, size);
+}
+
+void* mcu_heap_slab_malloc(size_t size)
+{
+    if(size > MCU_HEAP_SLAB_MAX_SIZE)
+        return mcu_heap_system_malloc(size);
+
+    void* ptr = _alloc(_get_class(size), size);
+    if(ptr)
+        return ptr;
+
+    return mcu_heap_system_malloc(size);
+}
+
+void mcu_heap_slab_free(void* ptr)
+{
+    if(ptr == NULL)
+        return;
+
+    uint8_t* p = ptr;
+    if(_arena == NULL || p < _arena || p >= _arena + MCU_HEAP_SLAB_ARENA_SIZE)
+    {
+        // Not from the arena -> Was allocated by the system heap
+        mcu_heap_system_free(ptr);
+        return;
+    }
+
+    uint8_t cls = _page_class[(size_t)(p - _arena) / MCU_HEAP_SLAB_PAGE_SIZE];
+    _slab_core_t* core = &_core[_SLAB_CORE_ID()];
+
+    _SLAB_LOCK(&core->lock);
+    core->frees[cls]++;
+#if _SLAB_USE_MAGAZINE
+    if(core->magazine_num[cls] == MCU_HEAP_SLAB_MAGAZINE_SIZE)
+    {
+        // Magazine is full -> Give half of it back, so the other core can use it.
+        _SLAB_LOCK(&_lock);
+        while(core->magazine_num[cls] > MCU_HEAP_SLAB_MAGAZINE_SIZE / 2)
+        {
+            core->magazine_num[cls]--;
+            _depot_push(cls, core->magazine[cls][core->magazine_num[cls]]);
+        }
+        _SLAB_UNLOCK(&_lock);
+    }
+    core->magazine[cls][core->magazine_num[cls]] = ptr;
+    core->magazine_num[cls]++;
+#else
+    _SLAB_LOCK(&_lock);
+    _depot_push(cls, ptr);
+    _SLAB_UNLOCK(&_lock);
+#endif
+    _SLAB_UNLOCK(&core->lock);
+}
+
+void mcu_heap_slab_get_stats(mcu_heap_slab_stats_t* stats)
+{
+    if(stats == NULL)
+        return;
+
+    memset(stats, 0, sizeof(mcu_heap_slab_stats_t));
+
+    _SLAB_LOCK(&_lock);
+    for(uint8_t c = 0; c < MCU_HEAP_SLAB_NUM_CLASSES; c++)
+    {
+        stats->classes[c].object_size = _SLAB_CLASS_SIZE(c);
+        stats->classes[c].pages = _depot[c].pages;
+        stats->classes[c].in_use_max = _depot[c].taken_max;
+    }
+    stats->pages_used = _pages_used;
+    stats->pages_total = _arena ? _SLAB_NUM_PAGES : 0;
+    _SLAB_UNLOCK(&_lock);
+
+    // Counters of the cores are read without their lock. They might be off by a currently running allocation.
+    for(size_t i = 0; i < _SLAB_NUM_CORES; i++)
+    {
+        for(uint8_t c = 0; c < MCU_HEAP_SLAB_NUM_CLASSES; c++)
+        {
+            stats->classes[c].allocations += _core[i].allocations[c];
+            stats->classes[c].in_use += _core[i].allocations[c] - _core[i].frees[c];
+        }
+        stats->bytes_requested += _core[i].bytes_requested;
+        stats->bytes_served += _core[i].bytes_served;
+        stats->fallback_allocations += _core[i].fallback_allocations;
+    }
+
+    for(uint8_t c = 0; c < MCU_HEAP_SLAB_NUM_CLASSES; c++)
+    {
+        stats->bytes_free_in_pages += stats->classes[c].pages * MCU_HEAP_SLAB_PAGE_SIZE - stats->classes[c].in_use * stats->classes[c].object_size;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void _init(void)
+{
+    _SLAB_LOCK(&_lock);
+    if(!_initialized)
+    {
+        for(size_t i = 0; i < _SLAB_NUM_CORES; i++)
+        {
+            _SLAB_LOCK_INIT(&_core[i].lock);
+        }
+        _arena = mcu_heap_system_malloc(MCU_HEAP_SLAB_ARENA_SIZE);
+        _initialized = true;
+    }
+    _SLAB_UNLOCK(&_lock);
+}
+
+static void* _alloc(uint8_t cls, size_t size)
+{
+    void* obj = NULL;
+
+    if(!_initialized)
+        _init();
+
+    _slab_core_t* core = &_core[_SLAB_CORE_ID()];
+
+    _SLAB_LOCK(&core->lock);
+#if _SLAB_USE_MAGAZINE
+    if(core->magazine_num[cls] == 0)
+    {
+        // Magazine is empty -> Fill half of it from the depot.
+        _SLAB_LOCK(&_lock);
+        while(core->magazine_num[cls] < (MCU_HEAP_SLAB_MAGAZINE_SIZE + 1) / 2)
+        {
+            void* o = _depot_pop(cls);
+            if(o == NULL)
+                break;
+            core->magazine[cls][core->magazine_num[cls]] = o;
+            core->magazine_num[cls]++;
+        }
+        _SLAB_UNLOCK(&_lock);
+    }
+    if(core->magazine_num[cls] > 0)
+    {
+        core->magazine_num[cls]--;
+        obj = core->magazine[cls][core->magazine_num[cls]];
+    }
+#else
+    _SLAB_LOCK(&_lock);
+    obj = _depot_pop(cls);
+    _SLAB_UNLOCK(&_lock);
+#endif
+    if(obj)
+    {
+        core->allocations[cls]++;
+        core->bytes_requested += size;
+        core->bytes_served += _SLAB_CLASS_SIZE(cls);
+    }
+    else
+    {
+        core->fallback_allocations++;
+    }
+    _SLAB_UNLOCK(&core->lock);
+
+    return obj;
+}
+
+static void* _depot_pop(uint8_t cls)
+{
+    _slab_depot_t* d = &_depot[cls];
+
+    if(d->free_list == NULL)
+    {
+        if(_arena == NULL || _pages_used >= _SLAB_NUM_PAGES)
+            return NULL;
+
+        // Assign a new page to this class and link all objects of the page into the free list.
+        uint8_t* page = _arena + _pages_used * MCU_HEAP_SLAB_PAGE_SIZE;
+        size_t size = _SLAB_CLASS_SIZE(cls);
+        _page_class[_pages_used] = cls;
+        _pages_used++;
+        d->pages++;
+
+        for(size_t offset = MCU_HEAP_SLAB_PAGE_SIZE; offset >= size; offset -= size)
+        {
+            void* o = page + offset - size;
+            *(void**)o = d->free_list;
+            d->free_list = o;
+        }
+    }
+
+    void* obj = d->free_list;
+    d->free_list = *(void**)obj;
+    d->taken++;
+    if(d->taken > d->taken_max)
+    {
+        d->taken_max = d->taken;
+    }
+    return obj;
+}
+
+static void _depot_push(uint8_t cls, void* obj)
+{
+    _slab_depot_t* d = &_depot[cls];
+
+    *(void**)obj = d->free_list;
+    d->free_list = obj;
+    d->taken--;
+}
+
+static inline uint8_t _get_class(size_t size)
+{
+    if(size <= MCU_HEAP_SLAB_MIN_SIZE)
+        return 0;
+
+    // Index of the next power of two, relative to the smallest class.
+    return (uint8_t)(32 - __builtin_clz((uint32_t)size - 1) - __builtin_ctz(MCU_HEAP_SLAB_MIN_SIZE));
+}
+
+#endif // MCU_HEAP_USE_SLAB
@@ -0,0 +1,134 @@
+/**
+ * 	@file 		mcu_heap_slab.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Slab allocator for small objects that can be placed behind mcu_heap_calloc, mcu_heap_malloc and mcu_heap_free.
+ *
+ *				Set MCU_HEAP_USE_SLAB to true in the mcu configuration to redirect the mcu_heap functions to this allocator.
+ *				Requests up to MCU_HEAP_SLAB_MAX_SIZE bytes are rounded up to a power of two and served from pages of an arena
+ *				that is allocated from the system heap on first use. Bigger requests and requests that do not fit into the arena
+ *				anymore fall back to the system heap. Freeing finds the size class of a pointer via its page, so there is no
+ *				header in front of the objects. Pages stay assigned to their size class once they are used, so the arena should be
+ *				sized for the peak of small allocations.
+ *
+ *				On multi-core FreeRTOS targets every core has a magazine of free objects per size class, so most allocations
+ *				and frees do not touch the shared free lists.
+ *
+ *  @version	1.00 (18.10.2026)
+ *  			 - Initial release
+ *
+ ******************************************************************************/
+
+#ifndef __MCU_HEAP_SLAB_H__
+#define __MCU_HEAP_SLAB_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Configuration
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef MCU_HEAP_SLAB_ARENA_SIZE
+/// Size of the arena in bytes that is allocated from the system heap for the slab pages.
+#define MCU_HEAP_SLAB_ARENA_SIZE            (32 * 1024)
+#endif
+
+#ifndef MCU_HEAP_SLAB_PAGE_SIZE
+/// Size of a single page in bytes. A page is assigned to a single size class when it is first needed. Must be a multiple of MCU_HEAP_SLAB_MAX_SIZE.
+#define MCU_HEAP_SLAB_PAGE_SIZE             1024
+#endif
+
+#ifndef MCU_HEAP_SLAB_MAX_SIZE
+/// Biggest size class in bytes. Must be a power of two. Bigger allocations are passed to the system heap.
+#define MCU_HEAP_SLAB_MAX_SIZE              256
+#endif
+
+#ifndef MCU_HEAP_SLAB_MAGAZINE_SIZE
+/// Number of free objects per size class that each core keeps for itself. Only used on multi-core FreeRTOS targets.
+#define MCU_HEAP_SLAB_MAGAZINE_SIZE         8
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Size of the smallest size class. Every free object has to be able to store a pointer.
+#define MCU_HEAP_SLAB_MIN_SIZE              8
+
+/// Number of size classes from MCU_HEAP_SLAB_MIN_SIZE to MCU_HEAP_SLAB_MAX_SIZE.
+#define MCU_HEAP_SLAB_NUM_CLASSES           (__builtin_ctz(MCU_HEAP_SLAB_MAX_SIZE) - __builtin_ctz(MCU_HEAP_SLAB_MIN_SIZE) + 1)
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Usage statistic of a single size class.
+typedef struct mcu_heap_slab_class_stats_s
+{
+    /// Size of the objects in this class in bytes.
+    size_t object_size;
+    /// Number of pages that are assigned to this class.
+    size_t pages;
+    /// Number of objects that are currently allocated.
+    size_t in_use;
+    /// Highest number of objects that were taken from the shared free list at the same time. Objects in magazines count as taken.
+    size_t in_use_max;
+    /// Total number of allocations in this class.
+    uint32_t allocations;
+}mcu_heap_slab_class_stats_t;
+
+/// Usage statistic of the slab allocator.
+typedef struct mcu_heap_slab_stats_s
+{
+    /// Statistic for each size class, starting with the smallest class.
+    mcu_heap_slab_class_stats_t classes[MCU_HEAP_SLAB_NUM_CLASSES];
+    /// Number of pages in the arena that are assigned to a size class.
+    size_t pages_used;
+    /// Total number of pages in the arena.
+    size_t pages_total;
+    /// Sum of the requested sizes of all slab allocations.
+    uint64_t bytes_requested;
+    /// Sum of the size classes of all slab allocations. The difference to bytes_requested is the internal fragmentation.
+    uint64_t bytes_served;
+    /// Bytes in assigned pages that are not allocated right now.
+    size_t bytes_free_in_pages;
+    /// Number of allocations that were passed to the system heap.
+    uint32_t fallback_allocations;
+}mcu_heap_slab_stats_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Allocates zero initialized memory for an array of num elements of the given size.
+ *
+ * @param num           Number of elements.
+ * @param size          Size of a single element.
+ * @return              Pointer to the memory or NULL if no memory is available.
+ */
+void* mcu_heap_slab_calloc(size_t num, size_t size);
+/**
+ * @brief Allocates memory of the given size. The memory is not initialized.
+ *
+ * @param size          Number of bytes to allocate.
+ * @return              Pointer to the memory or NULL if no memory is available.
+ */
+void* mcu_heap_slab_malloc(size_t size);
+/**
+ * @brief Frees memory that was allocated by mcu_heap_slab_calloc or mcu_heap_slab_malloc. Does nothing on NULL.
+ *
+ * @param ptr           Pointer to the memory.
+ */
+void mcu_heap_slab_free(void* ptr);
+/**
+ * @brief Reads the usage statistic of the slab allocator.
+ *
+ * @param stats         Pointer to the structure the statistic is written into.
+ */
+void mcu_heap_slab_get_stats(mcu_heap_slab_stats_t* stats);
+
+#endif /* __MCU_HEAP_SLAB_H__ */
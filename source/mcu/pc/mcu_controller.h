@@ -70,4 +70,26 @@ typedef enum {
 #define MCU_UART6_INIT_PARAM	6, P1_4, P1_5			/**< UART6 TX und RX */
 #define MCU_UART7_INIT_PARAM	7, P1_6, P1_7			/**< UART7 TX und RX */
 #define MCU_UART8_INIT_PARAM	8, P2_0, P2_1			/**< UART8 TX und RX */
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Flash Type defines
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// The flash is emulated in ram with MCU_CONTROLLER_ROM_SIZE_KBYTE, addresses start at 0.
+#define FLASH_PTR_TYPE	uint32_t
+#define BUF_PTR_TYPE   	uint8_t*
+#define ERASE_PTR_TYPE	uint32_t
+
+#define MCU_CONTROLLER_FLASH_MIN_STEPPING	1
+
+/// Size of an erasable block of the emulated flash.
+#define MCU_CONTROLLER_FLASH_BLOCK_SIZE		4096
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Flash Block Addresses
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#define BLOCK(n)	((n) * MCU_CONTROLLER_FLASH_BLOCK_SIZE)
+
+#define BLOCK_DB(n)	BLOCK(n)
+
 #endif
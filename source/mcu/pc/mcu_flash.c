@@ -0,0 +1,73 @@
+/***
+ * @file mcu_flash.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ **/
+
+#include "../mcu.h"
+
+#if MCU_TYPE == PC_EMU && MCU_PERIPHERY_ENABLE_FLASH
+
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Size of the emulated flash in bytes
+#define _FLASH_SIZE			((uint32_t)MCU_CONTROLLER_ROM_SIZE_KBYTE * 1024)
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal variables
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Content of the emulated flash
+static uint8_t _flash[_FLASH_SIZE];
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void mcu_flash_init(void)
+{
+	memset(_flash, 0xFF, sizeof(_flash));
+}
+
+bool mcu_flash_erase(ERASE_PTR_TYPE flash_addr)
+{
+	if(flash_addr >= _FLASH_SIZE)
+		return false;
+
+	flash_addr -= flash_addr % MCU_CONTROLLER_FLASH_BLOCK_SIZE;
+	memset(&_flash[flash_addr], 0xFF, MCU_CONTROLLER_FLASH_BLOCK_SIZE);
+
+	return true;
+}
+
+bool mcu_flash_write(FLASH_PTR_TYPE flash_addr, BUF_PTR_TYPE buffer_addr, uint32_t bytes)
+{
+	bool ret = true;
+
+	if(flash_addr > _FLASH_SIZE || bytes > _FLASH_SIZE - flash_addr)
+		return false;
+
+	// Like a real flash, writing can only clear bits. Writing to an area that is not erased fails.
+	for(uint32_t i = 0; i < bytes; i++)
+	{
+		_flash[flash_addr + i] &= buffer_addr[i];
+		ret &= (_flash[flash_addr + i] == buffer_addr[i]);
+	}
+
+	return ret;
+}
+
+bool mcu_flash_read(FLASH_PTR_TYPE flash_addr, BUF_PTR_TYPE buffer_addr, uint32_t bytes)
+{
+	if(flash_addr > _FLASH_SIZE || bytes > _FLASH_SIZE - flash_addr)
+		return false;
+
+	memcpy(buffer_addr, &_flash[flash_addr], bytes);
+
+	return true;
+}
+
+#endif
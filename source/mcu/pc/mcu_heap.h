@@ -23,8 +23,24 @@
 // #define MCU_HEAP_DEBUG          
 #include <stdlib.h>
 
+// Activate the heap profiler for its unittest
+#if TEST_MCU_HEAP_PROFILER
+#define MCU_HEAP_DEBUG
+#endif
+
 #if defined(MCU_HEAP_DEBUG)
 #include "module/comm/dbg.h"
+#include "mcu/mcu_heap_profiler.h"
+#endif
+
+// Activate the slab allocator for its unittest
+#if TEST_MCU_HEAP_SLAB
+#undef MCU_HEAP_USE_SLAB
+#define MCU_HEAP_USE_SLAB                   1
+#endif
+
+#if MCU_HEAP_USE_SLAB
+#include "mcu/mcu_heap_slab.h"
 #endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -36,23 +52,33 @@
  */
 #define mcu_heap_get_free_size()            0xFFFFFF
 
-#if defined(MCU_HEAP_DEBUG)
+/// Allocates from the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_calloc(num, size)   calloc(num, size)
+/// Allocates from the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_malloc(size)        malloc(size)
+/// Frees memory of the system heap, regardless of MCU_HEAP_USE_SLAB.
+#define mcu_heap_system_free(ptr)           free(ptr)
 
-void* mcu_heap_calloc_debug(char* filename, char* line_str, size_t num, size_t size);
+#if defined(MCU_HEAP_DEBUG)
 
 #define mcu_heap_calloc(num, size)          mcu_heap_calloc_debug(DBG_STRING, num, size)
 
-void* mcu_heap_malloc_debug(char* filename, char* line_str, size_t size);
-
 #define mcu_heap_malloc(size)               mcu_heap_malloc_debug(DBG_STRING, size)
 
-void mcu_heap_free_debug(char* filename, char* line_str, void* ptr);
-
 /**
  * @brief Frees a pointer from the heap. 
  */
 #define mcu_heap_free(ptr)                  mcu_heap_free_debug(DBG_STRING, ptr)
 
+#elif MCU_HEAP_USE_SLAB
+
+#define mcu_heap_calloc(num, size)          mcu_heap_slab_calloc(num, size)
+#define mcu_heap_malloc(size)               mcu_heap_slab_malloc(size)
+/**
+ * @brief Frees a pointer from the heap. 
+ */
+#define mcu_heap_free(ptr)                  mcu_heap_slab_free(ptr)
+
 #else
 
 #define mcu_heap_calloc(num, size)          calloc(num, size) 
@@ -9,11 +9,15 @@
 #include "comm.h"
 #include "mcu/sys.h"
 #include "module/convert/string.h"
+#include "module/convert/dtoa.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/// Number of bytes that are converted into a hex string before it is sent in %a and %q. Is the length of a hex dump line.
+#define _COMM_HEX_BYTES_PER_PUT			16
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal structures and enums
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -38,6 +42,29 @@ char comm_num_str[COMM_MAX_FORMAT_LENGTH];
 // Prototypes
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#if MODULE_ENABLE_CONVERT_DTOA
+/**
+ * @brief	Prints a double for %f, %F and %e.
+ *
+ * @param h					Pointer to the comm_t.
+ * @param value				Value that is printed.
+ * @param format			'f', 'F' or 'e'.
+ * @param digits_len		Number of digits in len_ascii_str of the comm_t.
+ * @param precision_pos		Index of the first digit behind '.' in len_ascii_str or -1 if there is no '.'.
+ **/
+static void _print_double(comm_t *h, double value, uint8_t format, uint8_t digits_len, int8_t precision_pos);
+#endif
+/**
+ * @brief	Prints a byte array as hex string for %a, %A, %q and %Q. The string is created in blocks of
+ * 			_COMM_HEX_BYTES_PER_PUT bytes, so each block is sent with a single xputs.
+ *
+ * @param h					Pointer to the comm_t.
+ * @param arr				Bytes that are printed.
+ * @param len				Number of bytes.
+ * @param separator			Character between the bytes or 0 for none.
+ **/
+static void _print_hex_array(comm_t *h, const uint8_t* arr, uint16_t len, char separator);
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -135,6 +162,8 @@ void comm_vprintf(comm_t *h, const char *str, va_list vl)
 	bool use_var_len = false;			// Is set when two parameter for one wildcard are used, first one is the number of letters to print, second is the value.
 	bool use_prev_len = false;			// Is set when the previously printed parameter is the length value for the current value.
 	bool string_left_aligned = true;	// Is cleared with wildcard '.'. Strings will then be right aligned.
+	int8_t precision_pos = -1;			// Index in len_ascii_str where the digits behind '.' start. Is used as precision for %f, %F and %e.
+	uint8_t format_digits = 0;			// Number of digits in len_ascii_str of the current wildcard.
 	char* tmp_ptr = NULL;				// Is used for storing string pointers temporarily
 	int32_t tmp_int32 = 0;				// Is used for storing integers temporarily
 	int64_t tmp_int64 = 0;
@@ -157,6 +186,8 @@ void comm_vprintf(comm_t *h, const char *str, va_list vl)
 			 is_in_fromatted_data = true;
 			 use_var_len = false;
 			 use_prev_len = false;
+			 precision_pos = -1;
+			 format_digits = 0;
 			 do
 			 {
 				 letter2 = *str++;
@@ -180,6 +211,7 @@ void comm_vprintf(comm_t *h, const char *str, va_list vl)
 				 else if(letter2 == '.')
 				 {
 					 string_left_aligned = false;
+					 precision_pos = h->len_ascii_str_len;
 					 continue;
 				 }
 				 else if(letter2 == 'l')
@@ -189,6 +221,7 @@ void comm_vprintf(comm_t *h, const char *str, va_list vl)
 				 }
 				 else if(h->len_ascii_str_len > 0)
 				 {
+					format_digits = h->len_ascii_str_len;
 					 // Can be replaces by an ascii to int function in the future -> Do not use standard libraries.
 					switch(h->len_ascii_str_len)
 					{
@@ -283,6 +316,15 @@ void comm_vprintf(comm_t *h, const char *str, va_list vl)
 						is_in_fromatted_data = false;
 					break;
 
+#if MODULE_ENABLE_CONVERT_DTOA
+					case 'f':
+					case 'F':
+					case 'e':
+						_print_double(h, va_arg(vl, double), letter2, format_digits, precision_pos);
+						is_in_fromatted_data = false;
+					break;
+#endif
+
 					case 'X':
 					case 'x':
 					case 'h':
@@ -296,32 +338,14 @@ void comm_vprintf(comm_t *h, const char *str, va_list vl)
 					case 'a':
 					case 'A':
 						string_set_hex_letter_size(letter2 == 'A');
-						{
-							uint8_t* arr = va_arg(vl, uint8_t*);
-							uint16_t i;
-							for(i = 0; i < h->format_len; i++)
-							{
-								comm_putc(h, string_uint8_to_ascii((arr[i] >> 4) & 0x0F));
-								comm_putc(h, string_uint8_to_ascii((arr[i]     ) & 0x0F));
-								if(i < h->format_len - 1)
-									comm_putc(h, ' ');
-							}
-						}
+						_print_hex_array(h, va_arg(vl, uint8_t*), h->format_len, ' ');
 						is_in_fromatted_data = false;
 					break;
 
 					case 'q':
 					case 'Q':
 						string_set_hex_letter_size(letter2 == 'Q');
-						{
-							uint8_t* arr = va_arg(vl, uint8_t*);
-							uint16_t i;
-							for(i = 0; i < h->format_len; i++)
-							{
-								comm_putc(h, string_uint8_to_ascii((arr[i] >> 4) & 0x0F));
-								comm_putc(h, string_uint8_to_ascii((arr[i]     ) & 0x0F));
-							}
-						}
+						_print_hex_array(h, va_arg(vl, uint8_t*), h->format_len, 0);
 						is_in_fromatted_data = false;
 					break;
 
@@ -431,4 +455,72 @@ int	comm_data_available(comm_t *h)
 // Internal Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#if MODULE_ENABLE_CONVERT_DTOA
+static void _print_double(comm_t *h, double value, uint8_t format, uint8_t digits_len, int8_t precision_pos)
+{
+	char str[DTOA_STRING_SIZE];
+	char* ptr = str;
+	uint16_t width = h->format_len;
+	int16_t precision = -1;
+	uint16_t len;
+	uint8_t i;
+
+	// %8.3f -> Digits in front of '.' are the width, digits behind are the precision.
+	if(precision_pos >= 0)
+	{
+		width = 0;
+		for(i = 0; i < precision_pos; i++)
+			width = width * 10 + h->len_ascii_str[i] - '0';
+
+		precision = 0;
+		for(i = precision_pos; i < digits_len; i++)
+			precision = precision * 10 + h->len_ascii_str[i] - '0';
+
+		if(precision > DTOA_MAX_PRECISION)
+			precision = DTOA_MAX_PRECISION;
+	}
+
+	if(format == 'F')
+		len = dtoa_create_float_string(str, (float)value, precision, false) - str;
+	else
+		len = dtoa_create_double_string(str, value, precision, format == 'e') - str;
+
+	if(digits_len > 0 && precision_pos != 0 && h->len_ascii_str[0] == '0' && width > len && str[len - 1] >= '0' && str[len - 1] <= '9')
+	{
+		// Zeros are added behind the sign
+		h->format_len = 0;
+		if(*ptr == '-')
+			comm_putc(h, *ptr++);
+		for(; width > len; width--)
+			comm_putc(h, '0');
+		comm_puts(h, ptr);
+	}
+	else
+	{
+		h->format_len = width;
+		comm_puts(h, str);
+	}
+}
+#endif
+
+static void _print_hex_array(comm_t *h, const uint8_t* arr, uint16_t len, char separator)
+{
+	// Space for the separator in front of the block, 3 characters per byte and the terminating zero.
+	char str[3 * _COMM_HEX_BYTES_PER_PUT + 2];
+	char* end;
+	uint16_t i, n;
+
+	if(arr == NULL)
+		return;
+
+	for(i = 0; i < len; i += n)
+	{
+		n = (len - i) < _COMM_HEX_BYTES_PER_PUT ? (len - i) : _COMM_HEX_BYTES_PER_PUT;
+		str[0] = separator;
+		// Blocks after the first one start with the separator.
+		end = string_create_hex_array_string(&str[(i > 0 && separator) ? 1 : 0], &arr[i], n, separator);
+		comm_put(h, (uint8_t*)str, end - str);
+	}
+}
+
 #endif
@@ -14,6 +14,9 @@
  *				Also the stdio.h functions differ when using different compiler, so this module is a solution that works
  *				with all.
  *
+ *	@version	2.10 (18.10.2026)
+ *				 - Added %f and %e for double and %F for float values, which need MODULE_ENABLE_CONVERT_DTOA.
+ *				   Without precision the shortest string is printed, e.g. %f, %.2f or %8.3f.
  *	@version	2.09 (19.01.2022)
  * 				 - Modified to be used in esopekernel
  *	@version	2.08 (07.06.2018)
@@ -68,7 +71,7 @@
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /// Version of the comm module
-#define COMM_STR_VERSION		"2.09"
+#define COMM_STR_VERSION		"2.10"
 
 #ifndef NULL
 	#define NULL 0	///< NULL is needed inside, so it must be defined if it does not exist.
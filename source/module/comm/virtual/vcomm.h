@@ -25,7 +25,7 @@
 /// Version of the comm module
 #define VCOMM_STR_VERSION		"1.00"
 
-#include "module/comm.h"
+#include "module/comm/comm.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Structure
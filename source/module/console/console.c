@@ -12,6 +12,10 @@
 
 #include "mcu/sys.h"
 #include "module/convert/string.h"
+#include "module/util/hash_map.h"
+#if MODULE_ENABLE_CONVERT_DTOA
+#include "module/convert/dtoa.h"
+#endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal definitions
@@ -30,13 +34,25 @@
 /// Task of the debug console
 //static console_data_t			_data;
 
-static char*					_args_ptr[CONSOLE_MAX_ARGUMENTS];
-
 /// Pointer to the first registered command.
 static console_command_t*			_first_command;
 
+/// Pointer to the last registered command, new commands are appended here.
+static console_command_t*			_last_command;
+
+/// Index of the registered commands by their name. Is created with the first command.
+static hash_map_t					_command_map;
+
+/// Is set when a command could not be added to _command_map. The commands are searched in the list then.
+static bool							_command_map_incomplete = false;
+
+/// Number of registered commands that are not in _command_map, because a command with the same name was registered before.
+static size_t						_command_duplicates = 0;
+
 static console_command_t			_command_help;
 
+static console_command_t			_command_batch;
+
 static bool 						_is_first_init = true;
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -52,10 +68,24 @@ static void console_handle(console_data_t* data);
 /**
  *
  * @param data		Pointer to the console the command should be checked on.
- * @param cmd		Command to be checked if it is whitelisted.
+ * @param cmd		Command to be checked if it is whitelisted. Does not need to be zero terminated.
+ * @param len		Length of the command.
+ * @param hash		Hash of the command calculated with hash_map_hash_str.
  * @return			true if command passes the whitelistcheck or false if command should be ignored.
  */
-static bool _passes_whitelist(console_data_t* data, const char* cmd);
+static bool _passes_whitelist(console_data_t* data, const char* cmd, size_t len, uint32_t hash);
+/**
+ * @brief	Creates the hash set of the whitelist. If it cannot be created, the whitelist is compared one by one.
+ *
+ * @param data		Pointer to the console.
+ */
+static void _create_whitelist_set(console_data_t* data);
+/**
+ * @brief	Returns true if the command is inside the list of registered commands.
+ *
+ * @param cmd_obj	Pointer to the command structure.
+ */
+static bool _is_registered(console_command_t* cmd_obj);
 /**
  * @brief	Handles the command that was received in the line string.
  *
@@ -63,12 +93,80 @@ static bool _passes_whitelist(console_data_t* data, const char* cmd);
  * @param line					0-terminated string that contains the received line that should be handled.
  */
 static void console_handle_command(console_data_t* data, char* line);
+/**
+ * @brief	Splits the arguments of a line at the spaces. Arguments starting with a quote end at the next quote and can
+ * 			contain spaces. The separators are replaced with 0, so the arguments point into the line.
+ *
+ * @param data		Pointer to the console.
+ * @param ptr		Start of the arguments.
+ * @param end		End of the line.
+ * @return			Number of arguments stored in args_ptr and args_len. Arguments behind CONSOLE_MAX_ARGUMENTS are ignored.
+ */
+static uint8_t _tokenize(console_data_t* data, char* ptr, char* end);
+/**
+ * @brief	Converts the arguments in args_ptr into args as described in the argument schema of the command.
+ *
+ * @param data		Pointer to the console.
+ * @param cmd		Command with an argument schema.
+ * @param num		Number of arguments in args_ptr.
+ * @return			FUNCTION_RETURN_OK if all arguments are valid. Otherwise FUNCTION_RETURN_PARAM_ERROR and the response is set.
+ */
+static FUNCTION_RETURN _parse_args(console_data_t* data, const console_command_t* cmd, uint8_t num);
+/**
+ * @brief	Converts a single argument.
+ *
+ * @param schema	Description of the argument.
+ * @param arg		Converted argument.
+ * @param str		Zero-terminated argument inside the line buffer. Is overwritten for CONSOLE_ARG_BYTES.
+ * @param len		Length of str.
+ * @return			true if the argument is valid.
+ */
+static bool _parse_arg(const console_arg_schema_t* schema, console_arg_t* arg, char* str, uint16_t len);
+/**
+ * @brief	Parses a 32-bit integer that contains only digits, an optional sign for CONSOLE_ARG_INT and an optional 0x
+ * 			for CONSOLE_ARG_HEX.
+ *
+ * @param str		String with the number.
+ * @param len		Length of str.
+ * @param type		CONSOLE_ARG_INT, CONSOLE_ARG_UINT or CONSOLE_ARG_HEX.
+ * @param v			Pointer to the parsed value.
+ * @return			true if str is a valid number inside the range of the type.
+ */
+static bool _parse_integer(const char* str, uint16_t len, CONSOLE_ARG_TYPE type, int64_t* v);
+/**
+ * @brief	Returns the value of a hex digit.
+ *
+ * @param c			Character 0-9, a-f or A-F.
+ * @return			Value 0-15 or -1 if c is no hex digit.
+ */
+static int8_t _digit_value(char c);
 /**
  * @brief	Prints a list of all registered application commands.
  *
  * @param line		Line of the command, starting after the command.
  */
 FUNCTION_RETURN console_help_execute(console_data_t* data, char* line);
+/**
+ * @brief	Resets the sequence number of the batch mode and responds with the window size.
+ *
+ * @param line		Line of the command, starting after the command.
+ */
+static FUNCTION_RETURN _batch_execute(console_data_t* data, char* line);
+/**
+ * @brief	Handles a line of the batch mode like "#12 command 1A2B". Checks the crc and the sequence number before the
+ * 			command is executed and always sends a response tagged with the sequence number.
+ *
+ * @param data		Pointer to the console.
+ * @param line		0-terminated line starting with '#'.
+ * @param len		Length of the line.
+ */
+static void _handle_batch_line(console_data_t* data, char* line, uint16_t len);
+/**
+ * @brief	Frees the response message if it is in heap and resets the arena for the next command.
+ *
+ * @param data		Pointer to the console.
+ */
+static void _clear_response(console_data_t* data);
 /**
  * Handles the return value of a console function to print parameter error, etc.
  * @param data		Pointer to the console.
@@ -76,6 +174,15 @@ FUNCTION_RETURN console_help_execute(console_data_t* data, char* line);
  * @param ret		Return value of a function.
  */
 static void _handle_return_value(console_data_t* data, char* cmd, FUNCTION_RETURN ret);
+/**
+ * @brief	Returns the registered command with the name.
+ *
+ * @param cmd		Pointer to the name. Does not need to be zero terminated.
+ * @param len		Length of the name.
+ * @param hash		Hash of the name calculated with hash_map_hash_str.
+ * @return			Pointer to the command or NULL if no command has this name.
+ */
+static console_command_t* _find_command(const char* cmd, size_t len, uint32_t hash);
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
@@ -87,7 +194,11 @@ void console_init(console_data_t* data, comm_t* comm)
 	data->comm = comm;
 #if MCU_TYPE == MCU_ESP32
 	data->line_buffer = mcu_heap_calloc(1, CONSOLE_LINE_BUFFER_SIZE);
+	data->arena = mcu_heap_calloc(1, CONSOLE_RESPONSE_ARENA_SIZE);
 #endif
+	data->message = NULL;
+	data->message_heap = false;
+	data->arena_used = 0;
 
 	if(_is_first_init)
 	{
@@ -101,6 +212,13 @@ void console_init(console_data_t* data, comm_t* comm)
 		_command_help.explanation = "Prints the help.";
 		_command_help.use_array_param = false;
 		console_add_command(&_command_help);
+
+		// Add the batch command -> Is used to start the batch mode
+		_command_batch.command = "batch";
+		_command_batch.fnc_exec = _batch_execute;
+		_command_batch.explanation = "Resets the sequence of the batch mode and prints the window size.";
+		_command_batch.use_array_param = false;
+		console_add_command(&_command_batch);
 	}
 #if CONSOLE_ENABLE_CRC
 	crc_init_handler(&data->crc, 0x1021, 0xFFFF, 0x0000);
@@ -116,59 +234,148 @@ void console_stop(console_data_t* data)
 		return;
 
 	system_remove_task(&data->task);
+	hash_map_free(&data->whitelist_set);
+	data->whitelist_set_source = NULL;
+	data->whitelist_set_num = 0;
 #if MCU_TYPE == MCU_ESP32
 	if(data->line_buffer)
 	{
 		mcu_heap_free(data->line_buffer);
 		data->line_buffer = NULL;
 	}
+	if(data->arena)
+	{
+		mcu_heap_free(data->arena);
+		data->arena = NULL;
+	}
 #endif
 }
 
 void console_add_command(console_command_t* cmd_obj)
 {
-	if(cmd_obj == NULL)
+	if(cmd_obj == NULL || _is_registered(cmd_obj))
 		return;
 
-	if(_first_command == NULL)
-	{
+	cmd_obj->next = NULL;
+	cmd_obj->prev = _last_command;
+
+	if(_last_command == NULL)
 		_first_command = cmd_obj;
-		_first_command->next = NULL;
+	else
+		_last_command->next = cmd_obj;
+
+	_last_command = cmd_obj;
+
+	if(_command_map.entries == NULL && hash_map_init_dynamic(&_command_map, HASH_MAP_KEY_STRING, CONSOLE_COMMAND_MAP_SIZE) != FUNCTION_RETURN_OK)
+	{
+		_command_map_incomplete = true;
+		return;
 	}
+
+	// If a command with the same name was registered before, it stays the one that is executed.
+	if(hash_map_get_str(&_command_map, cmd_obj->command) != NULL)
+		_command_duplicates++;
+	else if(hash_map_put_str(&_command_map, cmd_obj->command, cmd_obj) != FUNCTION_RETURN_OK)
+		_command_map_incomplete = true;
+}
+
+void console_remove_command(console_command_t* cmd_obj)
+{
+	if(cmd_obj == NULL || !_is_registered(cmd_obj))
+		return;
+
+	if(cmd_obj->prev)
+		((console_command_t*)cmd_obj->prev)->next = cmd_obj->next;
+	else
+		_first_command = (console_command_t*)cmd_obj->next;
+
+	if(cmd_obj->next)
+		((console_command_t*)cmd_obj->next)->prev = cmd_obj->prev;
 	else
+		_last_command = (console_command_t*)cmd_obj->prev;
+
+	cmd_obj->next = NULL;
+	cmd_obj->prev = NULL;
+
+	console_command_t* registered = hash_map_get_str(&_command_map, cmd_obj->command);
+
+	if(registered == cmd_obj)
 	{
-		console_command_t* tmp = _first_command;
+		hash_map_remove_str(&_command_map, cmd_obj->command);
 
-		while(tmp->next != NULL)
-		{
-			if(tmp == cmd_obj)
-				return;
+		if(_command_duplicates == 0)
+			return;
 
-			tmp = (console_command_t*)tmp->next;
+		// Another command with the same name takes over.
+		for(console_command_t* tmp = _first_command; tmp; tmp = (console_command_t*)tmp->next)
+		{
+			if(strcmp(tmp->command, cmd_obj->command) == 0)
+			{
+				_command_duplicates--;
+				if(hash_map_put_str(&_command_map, tmp->command, tmp) != FUNCTION_RETURN_OK)
+					_command_map_incomplete = true;
+				break;
+			}
 		}
-
-		tmp->next = cmd_obj;
-		cmd_obj->next = NULL;
+	}
+	else if(registered != NULL)
+	{
+		_command_duplicates--;
 	}
 }
 
-void console_remove_command(console_command_t* cmd_obj)
+void console_set_whitelist(console_data_t* data, const char** whitelist, int num)
 {
-	if(cmd_obj == NULL || _first_command == NULL)
+	if(data == NULL)
 		return;
 
-	if(_first_command == cmd_obj)
-		_first_command = (console_command_t*)_first_command->next;
-	else
+	data->command_whitelist = whitelist;
+	data->num_whitelist = num;
+	_create_whitelist_set(data);
+}
+
+uint16_t console_complete_command(console_data_t* data, const char* prefix, size_t len, const console_command_t** matches, uint16_t max_matches, size_t* common_len)
+{
+	const console_command_t* first = NULL;
+	uint16_t num = 0;
+	size_t common = 0;
+	size_t i;
+
+	if(prefix == NULL)
+		return 0;
+
+	for(console_command_t* tmp = _first_command; tmp; tmp = (console_command_t*)tmp->next)
 	{
-		console_command_t* tmp = _first_command;
+		if(strncmp(tmp->command, prefix, len) != 0)
+			continue;
 
-		while(tmp->next != cmd_obj && tmp->next != NULL)
-			tmp = (console_command_t*)tmp->next;
+		size_t cmd_len = strlen(tmp->command);
+		uint32_t hash = hash_map_hash_str(tmp->command, cmd_len);
 
-		if(tmp->next == cmd_obj)
-			tmp->next = cmd_obj->next;
+		// Commands that are hidden by a command with the same name or that are not whitelisted cannot be executed.
+		if(_find_command(tmp->command, cmd_len, hash) != tmp || (data && !_passes_whitelist(data, tmp->command, cmd_len, hash)))
+			continue;
+
+		if(first == NULL)
+		{
+			first = tmp;
+			common = cmd_len;
+		}
+		else
+		{
+			for(i = len; i < common && tmp->command[i] == first->command[i]; i++);
+			common = i;
+		}
+
+		if(matches && num < max_matches)
+			matches[num] = tmp;
+		num++;
 	}
+
+	if(common_len)
+		*common_len = first ? common : 0;
+
+	return num;
 }
 
 void console_set_byte_callback(console_data_t* data, console_cb_byte f, uint32_t timeout_ms, uint8_t escape_character)
@@ -208,23 +415,35 @@ FUNCTION_RETURN console_set_response_dynamic(console_data_t* data, FUNCTION_RETU
 		return ret;
 	}
 
-	data->message = mcu_heap_calloc(1, max_len);
+	// The message is created in the arena, the heap is only used if the arena is full.
+	size_t arena_start = data->arena_used;
+	data->message = console_arena_alloc(data, max_len);
+	data->message_heap = data->message == NULL;
+	if(data->message_heap)
+		data->message = mcu_heap_calloc(1, max_len);
+
 	if(data->message)
 	{
 		va_list vl;
-		data->message_heap = true;
 		va_start(vl, format);
 		int16_t len = string_vnprintf(data->message, max_len, format, vl);
 		va_end(vl);
 		
-		if(len == max_len || data->message[len])
+		if(len >= max_len || data->message[len])
 		{
 			// This means the terminating 0 was not added. 
+			if(data->message_heap)
+				mcu_heap_free(data->message);
+			else
+				data->arena_used = arena_start;
 			data->message_heap = false;
-			mcu_heap_free(data->message);
 			data->message = NULL;
 			return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
 		}
+
+		// The message is the last allocation in the arena, so the unused part can be given back.
+		if(!data->message_heap)
+			data->arena_used = (size_t)((uint8_t*)data->message - (uint8_t*)data->arena) + len + 1;
 		return ret;
 	}
 
@@ -250,6 +469,25 @@ FUNCTION_RETURN console_set_response_static(console_data_t* data, FUNCTION_RETUR
 	return ret;
 }
 
+void* console_arena_alloc(console_data_t* data, size_t size)
+{
+	if(data == NULL)
+		return NULL;
+#if MCU_TYPE == MCU_ESP32
+	if(data->arena == NULL)
+		return NULL;
+#endif
+
+	// Every allocation starts at a multiple of 8 bytes, the arena itself is an array of uint64_t.
+	size_t start = (data->arena_used + 7) & ~(size_t)7;
+
+	if(size > CONSOLE_RESPONSE_ARENA_SIZE || start > CONSOLE_RESPONSE_ARENA_SIZE - size)
+		return NULL;
+
+	data->arena_used = start + size;
+	return (uint8_t*)data->arena + start;
+}
+
 #if CONSOLE_ENABLE_CRC
 uint16_t console_get_last_crc_value(console_data_t* data)
 {
@@ -277,6 +515,8 @@ bool console_can_receive(console_data_t* data)
 static void console_handle(console_data_t* data)
 {
 	uint8_t c;
+	uint8_t batch_cnt = 0;
+	uint8_t line_cnt = 0;
 
 	if(data == NULL)
 		return;
@@ -330,16 +570,31 @@ static void console_handle(console_data_t* data)
 			{
 				data->line_buffer[data->line_cnt] = 0;
 #if CONSOLE_ENABLE_CRC
+				data->crc_valid = false;
 				if(data->line_cnt > 4)
 				{
 					data->crc_value = crc_calc(&data->crc, (uint8_t*)data->line_buffer, data->line_cnt - 4);
 					data->crc_valid = data->crc_value == strtol(&data->line_buffer[data->line_cnt - 4], NULL, 16);
 				}
 #endif
-				console_handle_command(data, data->line_buffer);
+				if(data->line_buffer[0] == '#')
+				{
+					_handle_batch_line(data, data->line_buffer, data->line_cnt);
+					batch_cnt++;
+				}
+				else
+					console_handle_command(data, data->line_buffer);
+				line_cnt++;
 			}
+			// The line is terminated when it is complete, so the buffer does not need to be cleared.
 			data->line_cnt = 0;
-			memset(data->line_buffer, 0, CONSOLE_LINE_BUFFER_SIZE);
+
+			// Let other tasks and sessions run after a number of lines, the remaining lines stay in the receive buffer.
+			if(batch_cnt >= CONSOLE_BATCH_WINDOW || line_cnt >= CONSOLE_MAX_LINES_PER_CALL)
+			{
+				data->timestamp = system_get_tick_count();
+				return;
+			}
 		}
 		else // Character needs to be added to the line
 		{
@@ -376,119 +631,136 @@ static void console_handle(console_data_t* data)
 	}
 }
 
-static bool _passes_whitelist(console_data_t* data, const char* cmd)
+static bool _passes_whitelist(console_data_t* data, const char* cmd, size_t len, uint32_t hash)
 {
 	if(data->command_whitelist == NULL)
 		return true;
 
+	// command_whitelist can be set directly, so the set is created again if it was changed.
+	if(data->whitelist_set_source != data->command_whitelist || data->whitelist_set_num != data->num_whitelist)
+		_create_whitelist_set(data);
+
+	if(data->whitelist_set.entries)
+		return hash_map_get_strn_hashed(&data->whitelist_set, cmd, len, hash) != NULL;
+
 	for(int i = 0; i < data->num_whitelist; i++)
 	{
-		if(strcmp(cmd, data->command_whitelist[i]) == 0)
+		if(strncmp(cmd, data->command_whitelist[i], len) == 0 && data->command_whitelist[i][len] == 0)
 			return true;
 	}
 
 	return false;
 }
 
-static void console_handle_command(console_data_t* data, char* line)
+static void _create_whitelist_set(console_data_t* data)
 {
-	console_command_t* tmp = _first_command;
+	hash_map_free(&data->whitelist_set);
+	data->whitelist_set_source = data->command_whitelist;
+	data->whitelist_set_num = data->num_whitelist;
 
-	data->has_response = false;
-	data->message = NULL;
-	data->message_heap = false;
+	if(data->command_whitelist == NULL || data->num_whitelist <= 0)
+		return;
 
-	while(tmp != NULL)
+	if(hash_map_init_dynamic(&data->whitelist_set, HASH_MAP_KEY_STRING, 2 * (size_t)data->num_whitelist) != FUNCTION_RETURN_OK)
+		return;
+
+	for(int i = 0; i < data->num_whitelist; i++)
 	{
-		if(tmp->fnc_exec != NULL)
+		if(hash_map_put_str(&data->whitelist_set, data->command_whitelist[i], (void*)data->command_whitelist[i]) != FUNCTION_RETURN_OK)
 		{
-			char* ptr = line + strlen(tmp->command);
-			if(strncmp(tmp->command, line, strlen(tmp->command)) == 0 && (*ptr == ' ' || *ptr == '\0'))
-			{
-//				dbg_printf(DBG_STRING, "Handle Command: \"%s\"\n", data->line_buffer);
-				if(!_passes_whitelist(data, tmp->command))
-				{
-					// Command did not pass the whitelist check -> Ignore it!
-					continue;
-				}
+			// The whitelist is compared one by one instead.
+			hash_map_free(&data->whitelist_set);
+			return;
+		}
+	}
+}
 
-				while(*ptr == ' ')
-					ptr++;
+static bool _is_registered(console_command_t* cmd_obj)
+{
+	console_command_t* registered = hash_map_get_str(&_command_map, cmd_obj->command);
 
-				if(!tmp->use_array_param)
-				{
-					FUNCTION_RETURN ret = ((FUNCTION_RETURN(*)(console_data_t*, char*))tmp->fnc_exec)(data, ptr);
-					_handle_return_value(data, tmp->command, ret);
-				}
-				else
-				{
-					if(*ptr)
-					{
-						uint8_t args_length = 0;
-						bool in_string = false;
-						memset(_args_ptr, 0, sizeof(_args_ptr));
-						_args_ptr[0] = ptr;
-
-						while(*ptr != 0)
-						{
-							if(*ptr == '\"')
-							{
-								in_string = false;
-								*ptr = 0;
-							}
-							else if(!in_string && *ptr == ' ')
-							{
-								while(*ptr == ' ')
-								{
-									*ptr++ = 0;
-								}
-								// If max length is reached break before ++ because the ++ in the if below the while will trigger
-								// the ++.
-								if(args_length == CONSOLE_MAX_ARGUMENTS)
-								{
-									*ptr = 0;
-									continue;
-								}
-								args_length++;
-								if(*ptr == '\"') // First quote
-								{
-									in_string = true;
-									*ptr++ = 0;
-								}
-								if(*ptr != 0)
-								{
-									_args_ptr[args_length] = ptr;
-									if(in_string && *ptr == '\"') // Next is second quote
-										continue;
-								}
-							}
-							ptr++;
-						}
-
-						if(_args_ptr[args_length])// && _args_ptr[args_length][0])
-							args_length++;
-
-						FUNCTION_RETURN ret = ((FUNCTION_RETURN(*)(console_data_t*, char**, uint8_t))tmp->fnc_exec)(data, _args_ptr, args_length);
-						_handle_return_value(data, tmp->command, ret);
-					}
-					else
-					{
-						FUNCTION_RETURN ret = ((FUNCTION_RETURN(*)(console_data_t*, char**, uint8_t))tmp->fnc_exec)(data, _args_ptr, 0);
-						_handle_return_value(data, tmp->command, ret);
-					}
-				}
+	if(registered == cmd_obj)
+		return true;
 
-				if(data->message_heap && data->message)
-				{
-					mcu_heap_free(data->message);
-					data->message = NULL;
-					data->message_heap = false;
-				}
+	// Every registered command has its name in the map, unless it is hidden by another command with the same name.
+	if(registered == NULL && !_command_map_incomplete)
+		return false;
 
-				return;
+	for(console_command_t* tmp = _first_command; tmp; tmp = (console_command_t*)tmp->next)
+	{
+		if(tmp == cmd_obj)
+			return true;
+	}
+
+	return false;
+}
+
+static void console_handle_command(console_data_t* data, char* line)
+{
+	size_t line_len = strlen(line);
+	// The command is the first word of the line
+	char* ptr = memchr(line, ' ', line_len);
+	size_t len = ptr ? (size_t)(ptr - line) : line_len;
+	// The hash is used for the command and the whitelist.
+	uint32_t hash = hash_map_hash_str(line, len);
+	console_command_t* tmp = _find_command(line, len, hash);
+	FUNCTION_RETURN ret;
+	uint8_t args_length;
+
+	_clear_response(data);
+
+	if(tmp != NULL && tmp->fnc_exec != NULL)
+	{
+		ptr = line + len;
+//		dbg_printf(DBG_STRING, "Handle Command: \"%s\"\n", data->line_buffer);
+		if(!_passes_whitelist(data, line, len, hash))
+		{
+			// Command did not pass the whitelist check -> Ignore it! Batch lines need a response for their sequence number.
+			if(data->in_batch)
+			{
+				data->message = "Not whitelisted";
+				_handle_return_value(data, line, FUNCTION_RETURN_UNAUTHORIZED);
 			}
+			return;
 		}
-		tmp = (console_command_t*)tmp->next;
+
+		while(*ptr == ' ')
+			ptr++;
+
+		if(tmp->args_schema != NULL)
+		{
+#if CONSOLE_ENABLE_CRC
+			// Batch lines are stripped by _handle_batch_line, other lines still end with the crc.
+			if(data->crc_valid && !data->in_batch)
+			{
+				line_len -= 4;
+				while(line_len > 0 && line[line_len - 1] == ' ')
+					line_len--;
+				if(ptr > line + line_len)
+					ptr = line + line_len;
+				line[line_len] = 0;
+			}
+#endif
+			args_length = _tokenize(data, ptr, line + line_len);
+			ret = _parse_args(data, tmp, args_length);
+			if(ret == FUNCTION_RETURN_OK)
+				ret = ((FUNCTION_RETURN(*)(console_data_t*, const console_arg_t*, uint8_t))tmp->fnc_exec)(data, data->args, tmp->num_args_schema);
+			_handle_return_value(data, tmp->command, ret);
+		}
+		else if(!tmp->use_array_param)
+		{
+			ret = ((FUNCTION_RETURN(*)(console_data_t*, char*))tmp->fnc_exec)(data, ptr);
+			_handle_return_value(data, tmp->command, ret);
+		}
+		else
+		{
+			args_length = _tokenize(data, ptr, line + line_len);
+			ret = ((FUNCTION_RETURN(*)(console_data_t*, char**, uint8_t))tmp->fnc_exec)(data, data->args_ptr, args_length);
+			_handle_return_value(data, tmp->command, ret);
+		}
+
+		_clear_response(data);
+		return;
 	}
 
     if(data->debug_line)
@@ -496,13 +768,209 @@ static void console_handle_command(console_data_t* data, char* line)
         comm_printf(COMM_DEBUG, "\\.%s\n", line);
     }
 
-	if(!data->suppress_invalid_command)
+	if(!data->suppress_invalid_command || data->in_batch)
 	{
 		data->message = "Invalid Command"; 
 		_handle_return_value(data, line, FUNCTION_RETURN_NOT_FOUND);
 	}
 }
 
+static uint8_t _tokenize(console_data_t* data, char* ptr, char* end)
+{
+	uint8_t num = 0;
+	char* sep;
+
+	while(num < CONSOLE_MAX_ARGUMENTS)
+	{
+		while(ptr < end && *ptr == ' ')
+			ptr++;
+
+		if(ptr >= end)
+			break;
+
+		if(*ptr == '\"')
+		{
+			// Quoted argument ends at the next quote or at the end of the line.
+			ptr++;
+			sep = memchr(ptr, '\"', end - ptr);
+		}
+		else
+			sep = memchr(ptr, ' ', end - ptr);
+
+		if(sep == NULL)
+			sep = end;
+
+		*sep = 0;
+		data->args_ptr[num] = ptr;
+		data->args_len[num] = sep - ptr;
+		num++;
+		ptr = sep + 1;
+	}
+
+	// Like argv, the array ends with NULL if there is space for it.
+	if(num < CONSOLE_MAX_ARGUMENTS)
+		data->args_ptr[num] = NULL;
+
+	return num;
+}
+
+static FUNCTION_RETURN _parse_args(console_data_t* data, const console_command_t* cmd, uint8_t num)
+{
+	const console_arg_schema_t* schema;
+
+	if(cmd->num_args_schema > CONSOLE_MAX_ARGUMENTS)
+		return console_set_response_static(data, FUNCTION_RETURN_UNSUPPORTED, "Too many arguments in schema");
+
+	if(num > cmd->num_args_schema)
+		return console_set_response_static(data, FUNCTION_RETURN_PARAM_ERROR, "Too many arguments");
+
+	for(uint8_t i = 0; i < cmd->num_args_schema; i++)
+	{
+		schema = &cmd->args_schema[i];
+		memset(&data->args[i], 0, sizeof(console_arg_t));
+
+		if(i >= num)
+		{
+			if(!schema->optional)
+				return console_set_response_dynamic(data, FUNCTION_RETURN_PARAM_ERROR, 20 + strlen(schema->name), "Missing argument %s", schema->name);
+			continue;
+		}
+
+		if(!_parse_arg(schema, &data->args[i], data->args_ptr[i], data->args_len[i]))
+			return console_set_response_dynamic(data, FUNCTION_RETURN_PARAM_ERROR, 20 + strlen(schema->name), "Invalid argument %s", schema->name);
+
+		data->args[i].present = true;
+	}
+
+	return FUNCTION_RETURN_OK;
+}
+
+static bool _parse_arg(const console_arg_schema_t* schema, console_arg_t* arg, char* str, uint16_t len)
+{
+	bool has_limit = schema->min != 0 || schema->max != 0;
+	int64_t v;
+	char* end;
+	int8_t high, low;
+
+	switch(schema->type)
+	{
+		case CONSOLE_ARG_INT:
+		case CONSOLE_ARG_UINT:
+		case CONSOLE_ARG_HEX:
+			if(!_parse_integer(str, len, schema->type, &v) || (has_limit && (v < schema->min || v > schema->max)))
+				return false;
+
+			if(schema->type == CONSOLE_ARG_INT)
+				arg->i = (int32_t)v;
+			else
+				arg->u = (uint32_t)v;
+			return true;
+
+		case CONSOLE_ARG_FLOAT:
+			if(len == 0)
+				return false;
+#if MODULE_ENABLE_CONVERT_DTOA
+			arg->f = dtoa_parse_float(str, &end);
+#else
+			arg->f = strtof(str, &end);
+#endif
+			// The complete argument needs to be the number, "1.5x" is invalid.
+			if(end != str + len || (has_limit && (arg->f < schema->min || arg->f > schema->max)))
+				return false;
+			return true;
+
+		case CONSOLE_ARG_ENUM:
+			for(uint8_t i = 0; i < schema->num_enum_values; i++)
+			{
+				if(strncmp(schema->enum_values[i], str, len) == 0 && schema->enum_values[i][len] == 0)
+				{
+					arg->u = i;
+					return true;
+				}
+			}
+			return false;
+
+		case CONSOLE_ARG_STRING:
+			arg->str = str;
+			arg->len = len;
+			return !has_limit || (len >= schema->min && len <= schema->max);
+
+		case CONSOLE_ARG_BYTES:
+			if(len & 1)
+				return false;
+
+			// Every byte is written behind the two characters that were read, so the string can be decoded in place.
+			arg->bytes = (uint8_t*)str;
+			arg->len = len / 2;
+			for(uint16_t i = 0; i < arg->len; i++)
+			{
+				high = _digit_value(str[2 * i]);
+				low = _digit_value(str[2 * i + 1]);
+				if(high < 0 || low < 0)
+					return false;
+
+				arg->bytes[i] = (high << 4) | low;
+			}
+			return !has_limit || (arg->len >= schema->min && arg->len <= schema->max);
+
+		default:
+			return false;
+	}
+}
+
+static bool _parse_integer(const char* str, uint16_t len, CONSOLE_ARG_TYPE type, int64_t* v)
+{
+	uint8_t base = type == CONSOLE_ARG_HEX ? 16 : 10;
+	// A negative value can be one larger than a positive value.
+	uint64_t limit = type == CONSOLE_ARG_INT ? (uint64_t)INT32_MAX + 1 : UINT32_MAX;
+	bool negative = false;
+	uint64_t n = 0;
+	int8_t d;
+
+	if(type == CONSOLE_ARG_INT && len > 0 && (*str == '-' || *str == '+'))
+	{
+		negative = *str == '-';
+		str++;
+		len--;
+	}
+	else if(type == CONSOLE_ARG_HEX && len > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+	{
+		str += 2;
+		len -= 2;
+	}
+
+	if(len == 0)
+		return false;
+
+	while(len--)
+	{
+		d = _digit_value(*str++);
+		if(d < 0 || d >= base)
+			return false;
+
+		n = n * base + d;
+		if(n > limit)
+			return false;
+	}
+
+	if(type == CONSOLE_ARG_INT && !negative && n > INT32_MAX)
+		return false;
+
+	*v = negative ? -(int64_t)n : (int64_t)n;
+	return true;
+}
+
+static int8_t _digit_value(char c)
+{
+	if(c >= '0' && c <= '9')
+		return c - '0';
+	if(c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if(c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
 FUNCTION_RETURN console_help_execute(console_data_t* data, char* line)
 {
 	uint16_t j = 0;
@@ -531,9 +999,92 @@ FUNCTION_RETURN console_help_execute(console_data_t* data, char* line)
 	return FUNCTION_RETURN_OK;
 }
 
+static FUNCTION_RETURN _batch_execute(console_data_t* data, char* line)
+{
+	(void)line;
+	data->batch_sequence = 0;
+	return console_set_response_dynamic(data, FUNCTION_RETURN_OK, 8, "%u", CONSOLE_BATCH_WINDOW);
+}
+
+static void _handle_batch_line(console_data_t* data, char* line, uint16_t len)
+{
+	char* ptr;
+	unsigned long sequence = strtoul(line + 1, &ptr, 10);
+
+	// Without a sequence number there is nothing the response can be assigned to.
+	if(ptr == line + 1 || *ptr != ' ')
+	{
+		dbg_printf(DBG_STRING, "Drop batch line without sequence: \"%s\"\n", line);
+		return;
+	}
+
+	data->in_batch = true;
+	data->batch_current = (uint16_t)sequence;
+	_clear_response(data);
+
+#if CONSOLE_ENABLE_CRC
+	if(!data->crc_valid)
+	{
+		data->message = "Invalid CRC";
+		_handle_return_value(data, line, FUNCTION_RETURN_PARAM_ERROR);
+		data->in_batch = false;
+		return;
+	}
+
+	// The command does not see the crc.
+	len -= 4;
+	line[len] = 0;
+	while(len > 0 && line[len - 1] == ' ')
+		line[--len] = 0;
+#endif
+
+	if(data->batch_current != data->batch_sequence)
+	{
+		// The host has to send the lines again, starting with the expected one.
+		_handle_return_value(data, line, console_set_response_dynamic(data, FUNCTION_RETURN_NOT_READY, 20, "Expected #%u", data->batch_sequence));
+		_clear_response(data);
+	}
+	else
+	{
+		data->batch_sequence++;
+		while(*ptr == ' ')
+			ptr++;
+		console_handle_command(data, ptr);
+	}
+
+	data->in_batch = false;
+}
+
+static console_command_t* _find_command(const char* cmd, size_t len, uint32_t hash)
+{
+	console_command_t* tmp = hash_map_get_strn_hashed(&_command_map, cmd, len, hash);
+
+	if(tmp == NULL && _command_map_incomplete)
+	{
+		for(tmp = _first_command; tmp; tmp = (console_command_t*)tmp->next)
+		{
+			if(strncmp(tmp->command, cmd, len) == 0 && tmp->command[len] == 0)
+				break;
+		}
+	}
+
+	return tmp;
+}
+
+static void _clear_response(console_data_t* data)
+{
+	if(data->message_heap && data->message)
+		mcu_heap_free(data->message);
+
+	data->message = NULL;
+	data->message_heap = false;
+	data->has_response = false;
+	data->arena_used = 0;
+}
+
 static void _handle_return_value(console_data_t* data, char* cmd, FUNCTION_RETURN ret)
 {
-	if(!data->has_response)
+	if(!data->has_response && !data->in_batch)
 		return;
 		
 	const char* error_string = "UNKNOWN";
@@ -575,7 +1126,10 @@ static void _handle_return_value(console_data_t* data, char* cmd, FUNCTION_RETUR
 			break;
 	}
 
-	comm_printf(data->comm, "res %d \"%s\" \"%s\"\n", ret, error_string, data->message);
+	if(data->in_batch)
+		comm_printf(data->comm, "#%u res %d \"%s\" \"%s\"\n", data->batch_current, ret, error_string, data->message ? data->message : "");
+	else
+		comm_printf(data->comm, "res %d \"%s\" \"%s\"\n", ret, error_string, data->message);
 	comm_flush(data->comm);
 }
 
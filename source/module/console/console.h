@@ -22,6 +22,67 @@
 
 	@endcode
  *
+ *			Batch mode:
+ *			A host can send commands without waiting for the response of the previous command by prefixing the line with
+ *			'#' and a sequence number, e.g. "#0 app version 1A2B". With CONSOLE_ENABLE_CRC the crc at the end of the line
+ *			is mandatory. The sequence starts with 0 after console_init or the "batch" command and increases by 1 for each
+ *			line (16-bit, wraps around). Every batch line gets exactly one response like
+ *			"#0 res 0 "OK" "version 24.001"". A line with an invalid crc gets a PARAM_ERROR response and is not executed.
+ *			A line with an unexpected sequence number gets a NOT_READY response with the expected number and is not
+ *			executed, so the host has to send the lines again from the expected number on.
+ *			The host must not have more than CONSOLE_BATCH_WINDOW lines without response, so the lines fit into the
+ *			receive buffer. The "batch" command resets the sequence and responds with the window size.
+ *
+ *			Argument schema:
+ *			Instead of parsing the arguments in each command, a command can define the type of each argument in args_schema.
+ *			The console checks and converts the arguments before the command is called with an array of console_arg_t.
+ *			If an argument is invalid, the command is not called and the console responds with PARAM_ERROR.
+	@code
+	static const char* const _modes[] = {"off", "on", "blink"};
+	static const console_arg_schema_t _led_args[] = {
+		{.name = "index", .type = CONSOLE_ARG_UINT, .min = 0, .max = 3},
+		{.name = "mode", .type = CONSOLE_ARG_ENUM, .enum_values = _modes, .num_enum_values = 3},
+		{.name = "period", .type = CONSOLE_ARG_UINT, .optional = true},
+	};
+
+	static FUNCTION_RETURN _led_execute(console_data_t* data, const console_arg_t* args, uint8_t args_len)
+	{
+		led_set(args[0].u, args[1].u, args[2].present ? args[2].u : 500);
+		return FUNCTION_RETURN_OK;
+	}
+
+	_command.command = "led";
+	_command.fnc_exec = _led_execute;
+	_command.args_schema = _led_args;
+	_command.num_args_schema = 3;
+	@endcode
+ *
+ *			Sessions:
+ *			Each console_data_t is an independent session, e.g. one on the UART and one for each TCP or websocket client.
+ *			The registered commands are shared, but the line, the arguments, the whitelist, the batch sequence and the
+ *			response are stored per session. Responses created with console_set_response_dynamic are written into the
+ *			arena of the session (CONSOLE_RESPONSE_ARENA_SIZE), which is reset after each command, so the heap is only
+ *			used for responses that do not fit. Each session executes at most CONSOLE_MAX_LINES_PER_CALL lines before
+ *			the other tasks run, so a client sending many commands cannot block the other sessions.
+ *
+ *	@version	1.13 (18.10.2026)
+ * 	    - The arguments of a command are stored in console_data_t, so sessions do not share any command state
+ * 	    - Responses are created in a per-session arena instead of the heap, added console_arena_alloc
+ * 	    - A session executes at most CONSOLE_MAX_LINES_PER_CALL lines per call of its task
+ *	@version	1.12 (18.10.2026)
+ * 	    - Added args_schema to console_command_t, the console converts the arguments into console_arg_t
+ * 	    - Arguments are split with memchr, quoted arguments can also be the first argument
+ *	@version	1.11 (18.10.2026)
+ * 	    - Added the batch mode: Lines starting with "#<sequence> " are executed in the order of their sequence number
+ * 	      and always get a response tagged with the sequence number, so a host can send commands without waiting.
+ * 	    - Added the built-in command "batch", so "batch" is a reserved command name like "help". An application command
+ * 	      with this name is not executed.
+ *	@version	1.10 (18.10.2026)
+ * 	    - console_add_command and console_remove_command need constant time, the command list is doubly linked
+ * 	    - The whitelist is stored in a hash set, see console_set_whitelist
+ * 	    - Added console_complete_command for prefix completion
+ *	@version	1.09 (18.10.2026)
+ * 	    - Commands are found with a hash map instead of comparing each registered command
  *	@version	1.08 (17.01.2023)
  * 	    - Added CONSOLE_ASSERT_DYNAMIC and CONSOLE_ASSERT_STATIC
  *	@version	1.07 (19.01.2022)
@@ -53,13 +114,36 @@
 #if MODULE_ENABLE_CONSOLE
 #include "module/comm/comm.h"
 #include "module/enum/function_return.h"
+#include "module/util/hash_map.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Define
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /// Version of the uart_tls module
-#define CONSOLE_STR_VERSION "1.08"
+#define CONSOLE_STR_VERSION "1.13"
+
+#ifndef CONSOLE_BATCH_WINDOW
+/// Maximum number of batch commands a host sends without waiting for their responses.
+/// The console also executes at most this number of batch commands before it lets other tasks run.
+#define CONSOLE_BATCH_WINDOW				8
+#endif
+
+#ifndef CONSOLE_MAX_LINES_PER_CALL
+/// Maximum number of lines a console executes before it lets other tasks run. The remaining lines stay in the receive
+/// buffer, so each session gets its turn even if one client sends a lot of commands.
+#define CONSOLE_MAX_LINES_PER_CALL			8
+#endif
+
+#ifndef CONSOLE_RESPONSE_ARENA_SIZE
+/// Size of the arena in bytes that each console uses for dynamic responses and console_arena_alloc.
+#define CONSOLE_RESPONSE_ARENA_SIZE			256
+#endif
+
+#ifndef CONSOLE_COMMAND_MAP_SIZE
+/// Initial number of entries in the hash map of the registered commands. The map grows on the heap if more commands are registered.
+#define CONSOLE_COMMAND_MAP_SIZE			32
+#endif
 
 #if CONSOLE_ENABLE_CRC
 #include "module/crc/crc.h"
@@ -107,6 +191,77 @@
 // Structure
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @enum CONSOLE_ARG_TYPE
+ * @brief Type of an argument in the argument schema of a command.
+ */
+typedef enum
+{
+	/// Decimal signed 32-bit value like "-12". Is stored in console_arg_t.i.
+	CONSOLE_ARG_INT = 0,
+	/// Decimal unsigned 32-bit value like "12". Is stored in console_arg_t.u.
+	CONSOLE_ARG_UINT,
+	/// Hexadecimal unsigned 32-bit value like "1F" or "0x1F". Is stored in console_arg_t.u.
+	CONSOLE_ARG_HEX,
+	/// Float value like "1.5" or "1e-3". Is stored in console_arg_t.f.
+	CONSOLE_ARG_FLOAT,
+	/// One of the strings in enum_values. The index inside enum_values is stored in console_arg_t.u.
+	CONSOLE_ARG_ENUM,
+	/// String, can contain spaces if it is quoted. Is stored in console_arg_t.str and console_arg_t.len.
+	CONSOLE_ARG_STRING,
+	/// Hex string with 2 characters per byte like "01AB". The bytes are decoded inside the line buffer and stored in
+	/// console_arg_t.bytes and console_arg_t.len.
+	CONSOLE_ARG_BYTES
+}CONSOLE_ARG_TYPE;
+
+/**
+ * @struct console_arg_schema_t
+ * @brief Describes one argument of a command.
+ */
+typedef struct
+{
+	/// Name of the argument that is shown in the error response, e.g. "Invalid argument index".
+	const char*					name;
+	/// Type of the argument.
+	CONSOLE_ARG_TYPE			type;
+	/// If true, the argument can be omitted. Only the last arguments can be optional.
+	bool						optional;
+	/// Minimum and maximum value for numbers or minimum and maximum length for CONSOLE_ARG_STRING and CONSOLE_ARG_BYTES.
+	/// If both are 0, there is no limit.
+	int64_t						min;
+	/// @see min
+	int64_t						max;
+	/// Strings that are valid for CONSOLE_ARG_ENUM.
+	const char* const*			enum_values;
+	/// Number of strings in enum_values.
+	uint8_t						num_enum_values;
+}console_arg_schema_t;
+
+/**
+ * @struct console_arg_t
+ * @brief Converted argument that is passed to a command with args_schema.
+ */
+typedef struct
+{
+	/// false if an optional argument was omitted. The value is 0 then.
+	bool						present;
+	/// Number of characters for CONSOLE_ARG_STRING and number of bytes for CONSOLE_ARG_BYTES.
+	uint16_t					len;
+	union
+	{
+		/// Value for CONSOLE_ARG_INT.
+		int32_t					i;
+		/// Value for CONSOLE_ARG_UINT and CONSOLE_ARG_HEX or the index for CONSOLE_ARG_ENUM.
+		uint32_t				u;
+		/// Value for CONSOLE_ARG_FLOAT.
+		float					f;
+		/// Zero-terminated string inside the line buffer for CONSOLE_ARG_STRING.
+		const char*				str;
+		/// Bytes inside the line buffer for CONSOLE_ARG_BYTES.
+		uint8_t*				bytes;
+	};
+}console_arg_t;
+
 /**
  * @struct console_command_t
  * @brief Structure that is used to define a command line command. It consists of the command, an execution function and an explanation.
@@ -138,6 +293,18 @@ typedef struct
 	/// Do NOT change the value of this variable externally!
 	void* next;
 
+	/// Pointer to the previous console_command_t, so the command can be removed without searching the list.
+	/// Do NOT change the value of this variable externally!
+	void* prev;
+
+	/// If not NULL, the arguments are checked and converted as described in this array before fnc_exec is called and
+	/// use_array_param is ignored. fnc_exec is FUNCTION_RETURN (*)(console_data_t* data, const console_arg_t* args, uint8_t args_len)
+	/// then, where args_len is num_args_schema and args[i] belongs to args_schema[i].
+	const console_arg_schema_t* args_schema;
+
+	/// Number of arguments in args_schema. Must not be larger than CONSOLE_MAX_ARGUMENTS.
+	uint8_t num_args_schema;
+
 }console_command_t;
 
 /// Make the console data a type
@@ -177,11 +344,23 @@ struct console_data_s
     // const char*					custom_response_prefix;
 
     /// If not NULL, point this to an array that is used for whitelisted commands. All received commands not matching the whitelist will be ignored.
+    /// The hash set is only created again when the pointer or num_whitelist changes, so call console_set_whitelist after
+    /// modifying the array in place.
     const char**				command_whitelist;
 
     /// Number of commands in whitelist. Has to be > 0 when command_whitelist is not NULL.
     int 						num_whitelist;
 
+    /// Private: Hash set of the whitelisted commands. Is created from command_whitelist by console_set_whitelist or
+    /// on the first command after command_whitelist or num_whitelist were changed.
+    hash_map_t					whitelist_set;
+
+    /// Private: command_whitelist from which whitelist_set was created.
+    const char**				whitelist_set_source;
+
+    /// Private: num_whitelist from which whitelist_set was created.
+    int 						whitelist_set_num;
+
 	/// Handle of the uart to use
 	comm_t*						comm;
 
@@ -227,6 +406,30 @@ struct console_data_s
 	/// Is set when console_set_response is called. Otherwise no response is sent automatically.
 	bool 						has_response;
 
+	/// Sequence number that is expected for the next batch line.
+	uint16_t					batch_sequence;
+	/// Sequence number of the batch line that is currently executed.
+	uint16_t					batch_current;
+	/// Is set while a batch line is executed. The response is tagged with batch_current and is always sent.
+	bool						in_batch;
+
+#if MCU_TYPE == MCU_ESP32
+	/// Arena for dynamic responses. Is allocated when console is added and removed when console is stopped.
+	uint64_t*					arena;
+#else
+	/// Arena for dynamic responses and console_arena_alloc. Is reset after each command.
+	uint64_t					arena[(CONSOLE_RESPONSE_ARENA_SIZE + 7) / 8];
+#endif
+	/// Number of bytes used in arena.
+	size_t						arena_used;
+
+	/// Private: Arguments of the current command, they point into line_buffer.
+	char*						args_ptr[CONSOLE_MAX_ARGUMENTS];
+	/// Private: Length of the arguments in args_ptr.
+	uint16_t					args_len[CONSOLE_MAX_ARGUMENTS];
+	/// Private: Converted arguments for commands with an argument schema.
+	console_arg_t				args[CONSOLE_MAX_ARGUMENTS];
+
 	/// Can be set inside a console callback if the return value is FUNCTION_RETURN_OK. This is printed then as an argument to the response.
 	/// If this is not set, nothing will be automatically sent as a response. Only NULL will prevent sending, an empty string will trigger sending a response.
 	// const char*					success_message;
@@ -255,6 +458,8 @@ void console_stop(console_data_t* data);
  * 			command must be set to describe the command of the app (e.g. "mmc").
  * 			fnc_exec is the function callback that is called when a line with the command is received. The parameter is the complete line.
  * 			explanation is the explanation for the command that is shown if the help command is entered.
+ * 			If a command with the same name is already registered, the first one stays the one that is executed. The
+ * 			built-in commands "help" and "batch" are registered by the first console_init, so these names are reserved.
  *
  * @param cmd_obj			Pointer to the command structure for the application command.
  */
@@ -265,6 +470,30 @@ void console_add_command(console_command_t* cmd_obj);
  * @param cmd_obj			Pointer to the command structure for the application command.
  */
 void console_remove_command(console_command_t* cmd_obj);
+/**
+ * @brief	Sets the commands that are allowed on the console. All received commands not matching the whitelist will be ignored.
+ * 			The commands are stored in a hash set, so checking a command does not depend on the size of the whitelist.
+ * 			The strings are not copied and need to stay valid while the whitelist is set. The hash set is not updated when
+ * 			the array is modified in place, call this function again after changing the array.
+ *
+ * @param data				Pointer to the console data.
+ * @param whitelist			Array of the allowed commands or NULL to allow all commands.
+ * @param num				Number of commands in whitelist.
+ */
+void console_set_whitelist(console_data_t* data, const char** whitelist, int num);
+/**
+ * @brief	Searches the registered commands that start with a prefix, e.g. to complete a command on a terminal.
+ *
+ * @param data				Pointer to the console data. If not NULL, only commands that pass the whitelist of the console are returned.
+ * @param prefix			Pointer to the prefix. Does not need to be zero terminated.
+ * @param len				Length of the prefix.
+ * @param matches			Array that is filled with the matching commands in the order they were added. Can be NULL.
+ * @param max_matches		Number of elements in matches.
+ * @param common_len		If not NULL, it is set to the length of the part that all matching commands have in common.
+ * 							If it is longer than len, the prefix can be completed with these characters.
+ * @return					Number of matching commands. Can be more than max_matches.
+ */
+uint16_t console_complete_command(console_data_t* data, const char* prefix, size_t len, const console_command_t** matches, uint16_t max_matches, size_t* common_len);
 /**
  * @brief	Sets or clears an exclusive byte callback for the consoles uart.
  * 			When a callback function is set, the console just uses the callback for the received bytes and does not analyze the bytes itself.
@@ -299,8 +528,8 @@ void console_set_hold_callback(console_data_t* data, console_cb_hold f);
  * 
  * @param data				Pointer to the console data.
  * @param ret				Value that this function returns when the message can be set.
- * @param max_len 			Maximum buffer len to allocate in heap for the message. 
- * 							If set to 0, you can send a dynamically allocated buffer in format, that already is completely built. 
+ * @param max_len 			Maximum buffer len for the message. It is created in the arena of the console and only
+ * 							allocated in heap if the arena is full. If set to 0, you can send a dynamically allocated buffer in format, that already is completely built. 
  * 							It will then be sent without checking the format and afterwards the buffer will be freed. 
  * 							If the buffer is a static buffer, use console_set_response_static instead!
  * @param format 			Format buffer that is used internally with string_printf. @ref comm_vprintf for the different format variables.
@@ -318,6 +547,15 @@ FUNCTION_RETURN console_set_response_dynamic(console_data_t* data, FUNCTION_RETU
  * @return FUNCTION_RETURN 	ret when response is set or an error code if response cannot be set.
  */
 FUNCTION_RETURN console_set_response_static(console_data_t* data, FUNCTION_RETURN ret, const char* message);
+/**
+ * @brief	Allocates memory in the arena of the console, e.g. for a buffer that is used to create a response.
+ * 			The memory is valid until the response of the current command was sent and must not be freed.
+ *
+ * @param data				Pointer to the console data.
+ * @param size				Number of bytes.
+ * @return					Pointer to the memory aligned to 8 bytes or NULL if the arena is full.
+ */
+void* console_arena_alloc(console_data_t* data, size_t size);
 #if CONSOLE_ENABLE_CRC
 /**
  * Returns the last calculated CRC value of a received line excluding its last 4 byte.
@@ -89,6 +89,14 @@ FUNCTION_RETURN debug_app_execute(console_data_t* data, char** args, uint8_t arg
 			return console_set_response_dynamic(data, FUNCTION_RETURN_OK, 50, "heap %u", esp_get_free_heap_size());
 		}
 #endif
+#if defined(MCU_HEAP_DEBUG)
+		else if(strcmp(args[0], "heapprof") == 0)
+		{
+			// Optional second parameter limits the number of call sites that are printed.
+			mcu_heap_profiler_print(data->comm, args_len > 1 ? strtoul(args[1], NULL, 10) : 0);
+			return console_set_response_static(data, FUNCTION_RETURN_OK, "heapprof");
+		}
+#endif
 #if ENABLE_HASH
     else if(strcmp(args[0], "hash") == 0)
     {
@@ -6,6 +6,10 @@
  *
  *  @brief	Contains base64 encode and decode functions.
  *
+ *	@version	1.05 (18.10.2026)
+ *		- Added streaming encoder and decoder (base64_stream_t), which carry partial blocks across calls and use
+ *		  lookup tables for whole blocks.
+ *		- Added BASE64_USE_LARGE_TABLE for encoding two characters per table lookup.
  *	@version	1.04 (10.05.2022)
  *      - base64_encodeblock uses an internal 3 byte buffer if input pointer uses less than 3 byte.
  *	@version	1.03 (20.01.2020)
@@ -39,10 +43,35 @@
 // Configuration
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#ifndef BASE64_USE_LARGE_TABLE
+/// If true, the streaming encoder uses a 8 KiB table to encode 12 bit into two characters per lookup.
+/// If false, a 64 byte table is used with one lookup per character.
+#define BASE64_USE_LARGE_TABLE				false
+#endif
+
+/// Maximum number of bytes written by @see base64_encode_stream for len input bytes, including @see base64_encode_stream_finish.
+#define BASE64_ENCODE_STREAM_SIZE(len)		((((len) + 2) / 3) * 4)
+
+/// Maximum number of bytes written by @see base64_decode_stream for len input characters, including @see base64_decode_stream_finish.
+#define BASE64_DECODE_STREAM_SIZE(len)		((((len) + 3) / 4) * 3)
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Structure
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/// Context for encoding or decoding data that is received in multiple parts.
+typedef struct base64_stream_s
+{
+	/// Bytes (encoding) or 6-bit values (decoding) of the incomplete block from the last call.
+	uint8_t buffer[4];
+	/// Number of bytes in buffer.
+	uint8_t buffer_len;
+	/// Number of '=' that were decoded.
+	uint8_t padding;
+	/// Is set if the decoder found an invalid character.
+	bool error;
+}base64_stream_t;
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -123,6 +152,48 @@ void base64_decodestring_direct(char* str);
  * @return			Decoded uint32_t value.
  */
 uint32_t base64_decode_to_uint32_t(char* b64_buf);
+/**
+ * Initializes the context for @see base64_encode_stream or @see base64_decode_stream.
+ * @param s			Pointer to the context.
+ */
+void base64_stream_init(base64_stream_t* s);
+/**
+ * Encodes the next part of the data. Bytes that do not fill a complete block are kept in the context for the next call.
+ * A zero termination is not added!
+ * @param s			Pointer to the context.
+ * @param in		Pointer to the plain data.
+ * @param len		Number of bytes to encode.
+ * @param out		Pointer to the buffer where the result is stored. Must have BASE64_ENCODE_STREAM_SIZE(len) bytes
+ * 					and must not overlap with in.
+ * @return			Number of bytes written to out.
+ */
+uint32_t base64_encode_stream(base64_stream_t* s, const uint8_t* in, uint32_t len, uint8_t* out);
+/**
+ * Encodes the remaining bytes of the context with padding.
+ * @param s			Pointer to the context.
+ * @param out		Pointer to the buffer where the result is stored. Must have 4 bytes.
+ * @return			Number of bytes written to out (0 or 4).
+ */
+uint32_t base64_encode_stream_finish(base64_stream_t* s, uint8_t* out);
+/**
+ * Decodes the next part of a base64 string. Characters that do not fill a complete block are kept in the context for
+ * the next call. Whitespace and line breaks are ignored.
+ * @param s			Pointer to the context.
+ * @param in		Pointer to the encoded data.
+ * @param len		Number of characters to decode.
+ * @param out		Pointer to the buffer where the result is stored. Must have BASE64_DECODE_STREAM_SIZE(len) bytes
+ * 					and must not overlap with in.
+ * @return			Number of bytes written to out. Decoding stops at the first invalid character, which is reported by
+ * 					@see base64_decode_stream_finish.
+ */
+uint32_t base64_decode_stream(base64_stream_t* s, const uint8_t* in, uint32_t len, uint8_t* out);
+/**
+ * Finishes decoding. A last block without padding is decoded into out.
+ * @param s			Pointer to the context.
+ * @param out		Pointer to the buffer where the result is stored. Must have 3 bytes.
+ * @return			Number of bytes written to out or -1 if the data contained an invalid character or incomplete block.
+ */
+int32_t base64_decode_stream_finish(base64_stream_t* s, uint8_t* out);
 
 #endif
 
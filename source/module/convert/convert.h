@@ -13,6 +13,7 @@
 #include "sort.h"
 #include "base64.h"
 #include "bcd.h"
+#include "dtoa.h"
 
 
 #endif /* SRC_MODULE_CONVERT_CONVERT_H_ */
@@ -0,0 +1,1145 @@
+/**
+ * @file dtoa.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ */
+
+#include "module_public.h"
+#if MODULE_ENABLE_CONVERT_DTOA
+
+#include "dtoa.h"
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Decimal exponent of the first cached power.
+#define _CACHED_POWER_MIN_EXP10		-348
+/// Difference of the decimal exponents between two cached powers.
+#define _CACHED_POWER_STEP			8
+/// Number of cached powers.
+#define _CACHED_POWER_COUNT			87
+
+/// Number of significant digits that are stored while parsing. 19 digits always fit into uint64_t.
+#define _PARSE_MAX_DIGITS			19
+/// Largest exponent that is stored while parsing, so the exponent cannot overflow.
+#define _PARSE_MAX_EXPONENT			10000
+
+/// Maximum error of the 64-bit multiplication in units of the last bit.
+#define _PARSE_ERROR				16
+/// Maximum error if the digits were truncated to _PARSE_MAX_DIGITS.
+#define _PARSE_ERROR_TRUNCATED		64
+
+/// Maximum number of digits for a precision: 21 digits in front of the decimal point and DTOA_MAX_PRECISION behind it.
+#define _PRECISION_MAX_DIGITS		(21 + DTOA_MAX_PRECISION)
+/// Number of 32-bit words of a big number. The largest value is about 10 * 2^1074 for the smallest subnormal double.
+#define _BIGNUM_WORDS				36
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal structures and enums
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Floating point number with a 64-bit mantissa: f * 2^e.
+typedef struct _diy_fp_s
+{
+	/// Mantissa
+	uint64_t f;
+	/// Binary exponent
+	int32_t e;
+}_diy_fp_t;
+
+/// Normalized 64-bit approximation of a power of 10.
+typedef struct _cached_power_s
+{
+	/// Mantissa with the highest bit set.
+	uint64_t f;
+	/// Binary exponent
+	int16_t e;
+}_cached_power_t;
+
+/// Unsigned integer with up to _BIGNUM_WORDS * 32 bits.
+typedef struct _bignum_s
+{
+	/// Words, starting with the lowest one.
+	uint32_t w[_BIGNUM_WORDS];
+	/// Number of used words. The highest used word is never 0.
+	uint8_t len;
+}_bignum_t;
+
+/// Describes the binary format of float or double.
+typedef struct _format_s
+{
+	/// Number of stored mantissa bits without the hidden bit.
+	uint8_t mantissa_bits;
+	/// Bias of the exponent field.
+	int16_t exponent_bias;
+}_format_t;
+
+/// Type of a parsed number
+typedef enum
+{
+	_NUMBER_FINITE = 0,
+	_NUMBER_INFINITE,
+	_NUMBER_NAN
+}_NUMBER_TYPE_T;
+
+/// Result of parsing the characters of a number: mantissa * 10^exp10
+typedef struct _number_s
+{
+	/// Up to _PARSE_MAX_DIGITS significant digits.
+	uint64_t mantissa;
+	/// Decimal exponent
+	int32_t exp10;
+	/// true if the number is negative.
+	bool negative;
+	/// true if non-zero digits were dropped because there were more than _PARSE_MAX_DIGITS.
+	bool truncated;
+	/// Type of the number.
+	_NUMBER_TYPE_T type;
+}_number_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal variables
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// 10^-348, 10^-340, ..., 10^340 rounded to 64-bit.
+static const _cached_power_t _cached_powers[_CACHED_POWER_COUNT] =
+{
+	{0xFA8FD5A0081C0288, -1220}, {0xBAAEE17FA23EBF76, -1193}, {0x8B16FB203055AC76, -1166},
+	{0xCF42894A5DCE35EA, -1140}, {0x9A6BB0AA55653B2D, -1113}, {0xE61ACF033D1A45DF, -1087},
+	{0xAB70FE17C79AC6CA, -1060}, {0xFF77B1FCBEBCDC4F, -1034}, {0xBE5691EF416BD60C, -1007},
+	{0x8DD01FAD907FFC3C,  -980}, {0xD3515C2831559A83,  -954}, {0x9D71AC8FADA6C9B5,  -927},
+	{0xEA9C227723EE8BCB,  -901}, {0xAECC49914078536D,  -874}, {0x823C12795DB6CE57,  -847},
+	{0xC21094364DFB5637,  -821}, {0x9096EA6F3848984F,  -794}, {0xD77485CB25823AC7,  -768},
+	{0xA086CFCD97BF97F4,  -741}, {0xEF340A98172AACE5,  -715}, {0xB23867FB2A35B28E,  -688},
+	{0x84C8D4DFD2C63F3B,  -661}, {0xC5DD44271AD3CDBA,  -635}, {0x936B9FCEBB25C996,  -608},
+	{0xDBAC6C247D62A584,  -582}, {0xA3AB66580D5FDAF6,  -555}, {0xF3E2F893DEC3F126,  -529},
+	{0xB5B5ADA8AAFF80B8,  -502}, {0x87625F056C7C4A8B,  -475}, {0xC9BCFF6034C13053,  -449},
+	{0x964E858C91BA2655,  -422}, {0xDFF9772470297EBD,  -396}, {0xA6DFBD9FB8E5B88F,  -369},
+	{0xF8A95FCF88747D94,  -343}, {0xB94470938FA89BCF,  -316}, {0x8A08F0F8BF0F156B,  -289},
+	{0xCDB02555653131B6,  -263}, {0x993FE2C6D07B7FAC,  -236}, {0xE45C10C42A2B3B06,  -210},
+	{0xAA242499697392D3,  -183}, {0xFD87B5F28300CA0E,  -157}, {0xBCE5086492111AEB,  -130},
+	{0x8CBCCC096F5088CC,  -103}, {0xD1B71758E219652C,   -77}, {0x9C40000000000000,   -50},
+	{0xE8D4A51000000000,   -24}, {0xAD78EBC5AC620000,     3}, {0x813F3978F8940984,    30},
+	{0xC097CE7BC90715B3,    56}, {0x8F7E32CE7BEA5C70,    83}, {0xD5D238A4ABE98068,   109},
+	{0x9F4F2726179A2245,   136}, {0xED63A231D4C4FB27,   162}, {0xB0DE65388CC8ADA8,   189},
+	{0x83C7088E1AAB65DB,   216}, {0xC45D1DF942711D9A,   242}, {0x924D692CA61BE758,   269},
+	{0xDA01EE641A708DEA,   295}, {0xA26DA3999AEF774A,   322}, {0xF209787BB47D6B85,   348},
+	{0xB454E4A179DD1877,   375}, {0x865B86925B9BC5C2,   402}, {0xC83553C5C8965D3D,   428},
+	{0x952AB45CFA97A0B3,   455}, {0xDE469FBD99A05FE3,   481}, {0xA59BC234DB398C25,   508},
+	{0xF6C69A72A3989F5C,   534}, {0xB7DCBF5354E9BECE,   561}, {0x88FCF317F22241E2,   588},
+	{0xCC20CE9BD35C78A5,   614}, {0x98165AF37B2153DF,   641}, {0xE2A0B5DC971F303A,   667},
+	{0xA8D9D1535CE3B396,   694}, {0xFB9B7CD9A4A7443C,   720}, {0xBB764C4CA7A44410,   747},
+	{0x8BAB8EEFB6409C1A,   774}, {0xD01FEF10A657842C,   800}, {0x9B10A4E5E9913129,   827},
+	{0xE7109BFBA19C0C9D,   853}, {0xAC2820D9623BF429,   880}, {0x80444B5E7AA7CF85,   907},
+	{0xBF21E44003ACDD2D,   933}, {0x8E679C2F5E44FF8F,   960}, {0xD433179D9C8CB841,   986},
+	{0x9E19DB92B4E31BA9,  1013}, {0xEB96BF6EBADF77D9,  1039}, {0xAF87023B9BF0EE6B,  1066}
+};
+
+/// Powers of 10 that fit into 32-bit.
+static const uint32_t _pow10_32[10] =
+{
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/// Powers of 10 that fit into 64-bit.
+static const uint64_t _pow10_64[20] =
+{
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+	10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+	10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+/// Powers of 10 that are exact double values.
+static const double _pow10_double[23] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const _format_t _format_double = {52, 1023};
+
+static const _format_t _format_float = {23, 127};
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Multiplies two numbers and rounds the result to 64-bit.
+ */
+static _diy_fp_t _multiply(_diy_fp_t x, _diy_fp_t y);
+/**
+ * @brief Shifts the mantissa until the highest bit is set.
+ */
+static _diy_fp_t _normalize(_diy_fp_t x);
+/**
+ * @brief Returns the number of decimal digits of a value.
+ */
+static uint8_t _count_digits(uint32_t value);
+/**
+ * @brief Returns the cached power c, so the binary exponent of a normalized value with the binary exponent e
+ * multiplied with c is between -60 and -32.
+ *
+ * @param e				Binary exponent of the normalized value.
+ * @param c				Is set to the cached power.
+ * @return				Decimal exponent k that undoes the multiplication: value = value * c * 10^k
+ */
+static int32_t _cached_power(int32_t e, _diy_fp_t* c);
+/**
+ * @brief Creates the shortest digits for the value f * 2^e with Grisu2.
+ *
+ * @param f				Mantissa including the hidden bit.
+ * @param e				Binary exponent.
+ * @param lower_closer	true if the lower neighbour of the value is closer than the upper one (mantissa is a power of 2).
+ * @param digits		Buffer for at least 18 digits.
+ * @param k				Is set to the decimal exponent: value = digits * 10^k
+ * @return				Number of digits.
+ */
+static uint8_t _grisu2(uint64_t f, int32_t e, bool lower_closer, char* digits, int32_t* k);
+/**
+ * @brief Generates the digits of mp until they are inside the range of delta.
+ */
+static uint8_t _digit_gen(_diy_fp_t w, _diy_fp_t mp, uint64_t delta, char* digits, int32_t* k);
+/**
+ * @brief Decrements the last digit while the result gets closer to w and stays in the range of delta.
+ */
+static void _round_weed(char* digits, uint8_t len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w);
+/**
+ * @brief Creates the correctly rounded digits of the value f * 2^e for a precision.
+ *
+ * Tries the counted digit generation of Grisu first and uses the exact calculation with big numbers if Grisu cannot
+ * decide the rounding.
+ *
+ * @param f				Mantissa including the hidden bit.
+ * @param e				Binary exponent.
+ * @param precision		Number of decimals, at most DTOA_MAX_PRECISION.
+ * @param use_exponent	true: precision is the number of decimals of the mantissa in exponent notation.
+ * @param digits		Buffer for at least _PRECISION_MAX_DIGITS digits.
+ * @param k				Is set to the decimal exponent: value = digits * 10^k
+ * @return				Number of digits.
+ */
+static uint8_t _precision_digits(uint64_t f, int32_t e, int8_t precision, bool use_exponent, char* digits, int32_t* k);
+/**
+ * @brief Generates the digits of f * 2^e up to the rounding position of the precision with Grisu.
+ *
+ * @return				false if the error of the 64-bit calculation does not allow to decide the rounding.
+ */
+static bool _grisu_counted(uint64_t f, int32_t e, int8_t precision, bool use_exponent, char* digits, uint8_t* len, int32_t* k);
+/**
+ * @brief Rounds the counted digits up or down if the error of rest allows a safe decision.
+ *
+ * @param digits		Generated digits.
+ * @param len			Number of digits.
+ * @param rest			Remainder behind the last digit.
+ * @param ten_kappa		Value of 1 in the last digit in the same unit as rest.
+ * @param unit			Maximum error of rest.
+ * @param kappa			Decimal exponent of the last digit. Is incremented if rounding up adds a digit (999 -> 1000).
+ * @return				false if the rounding cannot be decided.
+ */
+static bool _round_weed_counted(char* digits, uint8_t len, uint64_t rest, uint64_t ten_kappa, uint64_t unit, int32_t* kappa);
+/**
+ * @brief Creates the correctly rounded digits of f * 2^e for a precision with exact big number arithmetic.
+ * Exact ties are rounded to the even digit like printf.
+ */
+static uint8_t _exact_digits(uint64_t f, int32_t e, int8_t precision, bool use_exponent, char* digits, int32_t* k);
+/**
+ * @brief Sets a big number to a 64-bit value.
+ */
+static void _bignum_set(_bignum_t* b, uint64_t value);
+/**
+ * @brief Multiplies a big number with a 32-bit value.
+ */
+static void _bignum_multiply(_bignum_t* b, uint32_t m);
+/**
+ * @brief Multiplies a big number with 10^n.
+ */
+static void _bignum_multiply_pow10(_bignum_t* b, int32_t n);
+/**
+ * @brief Multiplies a big number with 2^n.
+ */
+static void _bignum_shift_left(_bignum_t* b, int32_t n);
+/**
+ * @brief Returns -1, 0 or 1 if a is smaller, equal or bigger than b.
+ */
+static int _bignum_compare(const _bignum_t* a, const _bignum_t* b);
+/**
+ * @brief Subtracts b from a. a must not be smaller than b.
+ */
+static void _bignum_subtract(_bignum_t* a, const _bignum_t* b);
+/**
+ * @brief Writes the digits in fixed or exponent notation.
+ */
+static char* _format(char* str, bool negative, char* digits, uint8_t len, int32_t k, int8_t precision, bool use_exponent);
+/**
+ * @brief Writes nan, inf or -inf and returns the pointer to the terminating zero.
+ */
+static char* _format_special(char* str, bool negative, bool is_nan);
+/**
+ * @brief Reads the characters of a number.
+ *
+ * @param str			String that is parsed.
+ * @param end			If not NULL, it is set to the first character behind the number.
+ * @param n				Is filled with the number.
+ * @return				false if the string does not start with a number.
+ */
+static bool _parse_number(const char* str, char** end, _number_t* n);
+/**
+ * @brief Returns true if str starts with the lower case word, ignoring the case of str.
+ */
+static bool _match_word(const char* str, const char* word);
+/**
+ * @brief Converts a parsed number into the bits of a float or double.
+ *
+ * @param n				Parsed number.
+ * @param format		Format of the result.
+ * @param bits			Is set to the bits of the result without sign.
+ * @return				false if the result is too close to the middle of two values to be decided with 64-bit. The
+ * 						caller has to use strtod in this case.
+ */
+static bool _eisel_lemire(const _number_t* n, const _format_t* format, uint64_t* bits);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+char* dtoa_create_double_string(char* str, double value, int8_t precision, bool use_exponent)
+{
+	char digits[_PRECISION_MAX_DIGITS];
+	uint64_t bits, mantissa;
+	uint32_t exponent;
+	int32_t k = 0;
+	uint8_t len = 1;
+	bool negative;
+
+	memcpy(&bits, &value, sizeof(bits));
+	negative = (bits >> 63) != 0;
+	exponent = (bits >> 52) & 0x7FF;
+	mantissa = bits & ((1ULL << 52) - 1);
+
+	if(exponent == 0x7FF)	// Infinite or NaN
+		return _format_special(str, negative, mantissa != 0);
+
+	if(precision > DTOA_MAX_PRECISION)
+		precision = DTOA_MAX_PRECISION;
+
+	if(exponent == 0 && mantissa == 0)
+		digits[0] = '0';
+	else if(precision >= 0)
+		len = _precision_digits(exponent ? mantissa | (1ULL << 52) : mantissa, (exponent ? (int32_t)exponent : 1) - 1075, precision, use_exponent, digits, &k);
+	else if(exponent == 0)	// Subnormal
+		len = _grisu2(mantissa, 1 - 1075, false, digits, &k);
+	else
+		len = _grisu2(mantissa | (1ULL << 52), exponent - 1075, mantissa == 0 && exponent > 1, digits, &k);
+
+	return _format(str, negative, digits, len, k, precision, use_exponent);
+}
+
+char* dtoa_create_float_string(char* str, float value, int8_t precision, bool use_exponent)
+{
+	char digits[_PRECISION_MAX_DIGITS];
+	uint32_t bits, mantissa, exponent;
+	int32_t k = 0;
+	uint8_t len = 1;
+	bool negative;
+
+	memcpy(&bits, &value, sizeof(bits));
+	negative = (bits >> 31) != 0;
+	exponent = (bits >> 23) & 0xFF;
+	mantissa = bits & ((1UL << 23) - 1);
+
+	if(exponent == 0xFF)	// Infinite or NaN
+		return _format_special(str, negative, mantissa != 0);
+
+	if(precision > DTOA_MAX_PRECISION)
+		precision = DTOA_MAX_PRECISION;
+
+	if(exponent == 0 && mantissa == 0)
+		digits[0] = '0';
+	else if(precision >= 0)
+		len = _precision_digits(exponent ? mantissa | (1UL << 23) : mantissa, (exponent ? (int32_t)exponent : 1) - 150, precision, use_exponent, digits, &k);
+	else if(exponent == 0)	// Subnormal
+		len = _grisu2(mantissa, 1 - 150, false, digits, &k);
+	else
+		len = _grisu2(mantissa | (1UL << 23), (int32_t)exponent - 150, mantissa == 0 && exponent > 1, digits, &k);
+
+	return _format(str, negative, digits, len, k, precision, use_exponent);
+}
+
+double dtoa_parse_double(const char* str, char** end)
+{
+	_number_t n;
+	uint64_t bits;
+	double v;
+
+	if(!_parse_number(str, end, &n))
+		return 0;
+
+	// Clinger: Mantissa and power of 10 are exact doubles, so one operation gives the correctly rounded result.
+	if(n.type == _NUMBER_FINITE && !n.truncated && n.mantissa <= (1ULL << 53) && n.exp10 >= -22 && n.exp10 <= 22)
+	{
+		v = (double)n.mantissa;
+		v = (n.exp10 < 0) ? v / _pow10_double[-n.exp10] : v * _pow10_double[n.exp10];
+		return n.negative ? -v : v;
+	}
+
+	if(!_eisel_lemire(&n, &_format_double, &bits))
+		return strtod(str, end);
+
+	bits |= (uint64_t)n.negative << 63;
+	memcpy(&v, &bits, sizeof(v));
+
+	return v;
+}
+
+float dtoa_parse_float(const char* str, char** end)
+{
+	_number_t n;
+	uint64_t bits;
+	uint32_t bits32;
+	float v;
+
+	if(!_parse_number(str, end, &n))
+		return 0;
+
+	// Mantissa * 10^exp10 is an exact double, so it is only rounded once when it is converted to float.
+	if(n.type == _NUMBER_FINITE && !n.truncated && n.mantissa <= (1UL << 24) && n.exp10 >= 0 && n.exp10 <= 10)
+	{
+		v = (float)((double)n.mantissa * _pow10_double[n.exp10]);
+		return n.negative ? -v : v;
+	}
+
+	if(!_eisel_lemire(&n, &_format_float, &bits))
+		return strtof(str, end);
+
+	bits32 = (uint32_t)bits | ((uint32_t)n.negative << 31);
+	memcpy(&v, &bits32, sizeof(v));
+
+	return v;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static _diy_fp_t _multiply(_diy_fp_t x, _diy_fp_t y)
+{
+	const uint64_t mask = 0xFFFFFFFFULL;
+	uint64_t a = x.f >> 32, b = x.f & mask, c = y.f >> 32, d = y.f & mask;
+	uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+	uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask);
+	_diy_fp_t r;
+
+	tmp += 1ULL << 31;	// Round
+	r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	r.e = x.e + y.e + 64;
+
+	return r;
+}
+
+static _diy_fp_t _normalize(_diy_fp_t x)
+{
+	int shift;
+
+	if(x.f == 0)
+		return x;
+
+	shift = __builtin_clzll(x.f);
+	x.f <<= shift;
+	x.e -= shift;
+
+	return x;
+}
+
+static uint8_t _count_digits(uint32_t value)
+{
+	uint8_t len = 1;
+
+	while(len < 10 && value >= _pow10_32[len])
+		len++;
+
+	return len;
+}
+
+static int32_t _cached_power(int32_t e, _diy_fp_t* c)
+{
+	int32_t i;
+
+	i = (int32_t)(((int64_t)(-61 - e) * 78913) / 262144);	// log10(2) * (-61 - e)
+	i = (i - _CACHED_POWER_MIN_EXP10 + _CACHED_POWER_STEP - 1) / _CACHED_POWER_STEP;
+	if(i < 0)
+		i = 0;
+	if(i >= _CACHED_POWER_COUNT)
+		i = _CACHED_POWER_COUNT - 1;
+	while(i > 0 && e + _cached_powers[i].e + 64 > -32)
+		i--;
+	while(i < _CACHED_POWER_COUNT - 1 && e + _cached_powers[i].e + 64 < -60)
+		i++;
+
+	c->f = _cached_powers[i].f;
+	c->e = _cached_powers[i].e;
+
+	return -(_CACHED_POWER_MIN_EXP10 + i * _CACHED_POWER_STEP);
+}
+
+static uint8_t _grisu2(uint64_t f, int32_t e, bool lower_closer, char* digits, int32_t* k)
+{
+	_diy_fp_t v = {f, e};
+	_diy_fp_t plus = {(f << 1) + 1, e - 1};
+	_diy_fp_t minus;
+	_diy_fp_t c, w, wp, wm;
+
+	// Boundaries to the middle of the neighbouring values
+	plus = _normalize(plus);
+	if(lower_closer)
+	{
+		minus.f = (f << 2) - 1;
+		minus.e = e - 2;
+	}
+	else
+	{
+		minus.f = (f << 1) - 1;
+		minus.e = e - 1;
+	}
+	minus.f <<= minus.e - plus.e;
+	minus.e = plus.e;
+
+	// The binary exponent of the scaled upper boundary is between -60 and -32.
+	*k = _cached_power(plus.e, &c);
+
+	w = _multiply(_normalize(v), c);
+	wp = _multiply(plus, c);
+	wm = _multiply(minus, c);
+
+	// Shrink the range by the error of the multiplication, so the digits are always inside.
+	wm.f++;
+	wp.f--;
+
+	return _digit_gen(w, wp, wp.f - wm.f, digits, k);
+}
+
+static uint8_t _digit_gen(_diy_fp_t w, _diy_fp_t mp, uint64_t delta, char* digits, int32_t* k)
+{
+	const uint32_t shift = -mp.e;
+	const uint64_t one = 1ULL << shift;
+	const uint64_t wp_w = mp.f - w.f;
+	uint32_t p1 = (uint32_t)(mp.f >> shift);
+	uint64_t p2 = mp.f & (one - 1);
+	int32_t kappa = _count_digits(p1);
+	uint8_t len = 0;
+	uint32_t d;
+	uint64_t rest;
+
+	// Integer part
+	while(kappa > 0)
+	{
+		d = p1 / _pow10_32[kappa - 1];
+		p1 %= _pow10_32[kappa - 1];
+		if(d || len)
+			digits[len++] = '0' + d;
+		kappa--;
+
+		rest = ((uint64_t)p1 << shift) + p2;
+		if(rest <= delta)
+		{
+			*k += kappa;
+			_round_weed(digits, len, delta, rest, (uint64_t)_pow10_32[kappa] << shift, wp_w);
+			return len;
+		}
+	}
+
+	// Fractional part
+	for(;;)
+	{
+		p2 *= 10;
+		delta *= 10;
+		d = (uint32_t)(p2 >> shift);
+		if(d || len)
+			digits[len++] = '0' + d;
+		p2 &= one - 1;
+		kappa--;
+
+		if(p2 < delta)
+		{
+			*k += kappa;
+			_round_weed(digits, len, delta, p2, one, (-kappa < 20) ? wp_w * _pow10_64[-kappa] : 0);
+			return len;
+		}
+	}
+}
+
+static void _round_weed(char* digits, uint8_t len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+	while(rest < wp_w && delta - rest >= ten_kappa && (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+	{
+		digits[len - 1]--;
+		rest += ten_kappa;
+	}
+}
+
+static uint8_t _precision_digits(uint64_t f, int32_t e, int8_t precision, bool use_exponent, char* digits, int32_t* k)
+{
+	uint8_t len;
+
+	if(_grisu_counted(f, e, precision, use_exponent, digits, &len, k))
+		return len;
+
+	return _exact_digits(f, e, precision, use_exponent, digits, k);
+}
+
+static bool _grisu_counted(uint64_t f, int32_t e, int8_t precision, bool use_exponent, char* digits, uint8_t* len, int32_t* k)
+{
+	_diy_fp_t w = {f, e};
+	_diy_fp_t c;
+	uint32_t shift, p1;
+	uint64_t one, p2, rest, ten_kappa;
+	uint64_t unit = 1;	// The error of the multiplication is below 1 in the last bit.
+	int32_t k10, kappa, count;
+	uint8_t n = 0;
+
+	w = _normalize(w);
+	k10 = _cached_power(w.e, &c);
+	w = _multiply(w, c);
+
+	shift = -w.e;
+	one = 1ULL << shift;
+	p1 = (uint32_t)(w.f >> shift);
+	p2 = w.f & (one - 1);
+	kappa = _count_digits(p1);
+
+	// Number of digits up to the rounding position. The decimal point is behind the digits of p1 * 10^k10.
+	if(use_exponent || kappa + k10 > 21)
+		count = 1 + precision;
+	else
+		count = kappa + k10 + precision;
+
+	if(count < 0)	// Value is far below half of the last decimal
+	{
+		digits[0] = '0';
+		*len = 1;
+		*k = 0;
+		return true;
+	}
+
+	if(count == 0 || count > _PRECISION_MAX_DIGITS)
+		return false;
+
+	// Integer part
+	while(kappa > 0 && n < count)
+	{
+		digits[n++] = '0' + p1 / _pow10_32[kappa - 1];
+		p1 %= _pow10_32[kappa - 1];
+		kappa--;
+	}
+
+	// Fractional part, as long as the digits are not covered by the error.
+	while(n < count && p2 > unit)
+	{
+		p2 *= 10;
+		unit *= 10;
+		digits[n++] = '0' + (uint32_t)(p2 >> shift);
+		p2 &= one - 1;
+		kappa--;
+	}
+
+	if(n < count)
+		return false;
+
+	rest = ((uint64_t)p1 << shift) + p2;
+	ten_kappa = (kappa > 0) ? (uint64_t)_pow10_32[kappa] << shift : one;
+	if(!_round_weed_counted(digits, n, rest, ten_kappa, unit, &kappa))
+		return false;
+
+	*len = n;
+	*k = k10 + kappa;
+
+	return true;
+}
+
+static bool _round_weed_counted(char* digits, uint8_t len, uint64_t rest, uint64_t ten_kappa, uint64_t unit, int32_t* kappa)
+{
+	int32_t i;
+
+	// The error is too big to decide anything.
+	if(unit >= ten_kappa || ten_kappa - unit <= unit)
+		return false;
+
+	// Round down if rest + unit is below the middle.
+	if(ten_kappa - rest > rest && ten_kappa - 2 * rest > 2 * unit)
+		return true;
+
+	// Round up if rest - unit is above the middle.
+	if(rest > unit && ten_kappa - (rest - unit) < rest - unit)
+	{
+		digits[len - 1]++;
+		for(i = len - 1; i > 0 && digits[i] == '0' + 10; i--)
+		{
+			digits[i] = '0';
+			digits[i - 1]++;
+		}
+		if(digits[0] == '0' + 10)	// 999 -> 1000
+		{
+			digits[0] = '1';
+			(*kappa)++;
+		}
+		return true;
+	}
+
+	return false;
+}
+
+static uint8_t _exact_digits(uint64_t f, int32_t e, int8_t precision, bool use_exponent, char* digits, int32_t* k)
+{
+	_bignum_t r, s;
+	int32_t dp, count, i;
+	uint8_t len = 0, d;
+	int c = -1;
+
+	// Estimated position of the decimal point (value = 0.digits * 10^dp), which is corrected below.
+	dp = (int32_t)(((int64_t)(63 - __builtin_clzll(f) + e) * 78913) / 262144) + 1;	// log10(2) * (bits - 1)
+
+	// r / s = 10 * value / 10^dp, which has to be in [1, 10).
+	for(;;)
+	{
+		_bignum_set(&r, f);
+		_bignum_set(&s, 1);
+		if(e > 0)
+			_bignum_shift_left(&r, e);
+		else
+			_bignum_shift_left(&s, -e);
+		if(dp > 0)
+			_bignum_multiply_pow10(&s, dp);
+		else
+			_bignum_multiply_pow10(&r, -dp);
+
+		if(_bignum_compare(&r, &s) >= 0)
+		{
+			dp++;
+			continue;
+		}
+
+		_bignum_multiply(&r, 10);
+		if(_bignum_compare(&r, &s) >= 0)
+			break;
+		dp--;
+	}
+
+	if(use_exponent || dp > 21)
+		count = 1 + precision;
+	else
+		count = dp + precision;
+
+	for(i = 0; i < count; i++)
+	{
+		if(i > 0)
+			_bignum_multiply(&r, 10);
+		for(d = 0; _bignum_compare(&r, &s) >= 0; d++)
+			_bignum_subtract(&r, &s);
+		digits[len++] = '0' + d;
+	}
+
+	// Compare the rest with the half of the last digit. Without digits, r / s is 10 times the rest.
+	if(count >= 0)
+	{
+		_bignum_shift_left(&r, 1);
+		if(count == 0)
+			_bignum_multiply(&s, 10);
+		c = _bignum_compare(&r, &s);
+		if(c == 0)	// Exact tie, round to the even digit
+			c = (len > 0 && ((digits[len - 1] - '0') & 1)) ? 1 : -1;
+	}
+
+	if(c > 0)
+	{
+		// Round up and remove the trailing 9s
+		while(len > 0 && digits[len - 1] == '9')
+			len--;
+
+		if(len == 0)
+		{
+			digits[len++] = '1';
+			dp++;
+		}
+		else
+			digits[len - 1]++;
+	}
+
+	if(len == 0)
+	{
+		digits[len++] = '0';
+		dp = 1;
+	}
+
+	*k = dp - len;
+
+	return len;
+}
+
+static void _bignum_set(_bignum_t* b, uint64_t value)
+{
+	b->w[0] = (uint32_t)value;
+	b->w[1] = (uint32_t)(value >> 32);
+	b->len = b->w[1] ? 2 : (b->w[0] ? 1 : 0);
+}
+
+static void _bignum_multiply(_bignum_t* b, uint32_t m)
+{
+	uint64_t carry = 0;
+	uint8_t i;
+
+	for(i = 0; i < b->len; i++)
+	{
+		carry += (uint64_t)b->w[i] * m;
+		b->w[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+
+	if(carry)
+		b->w[b->len++] = (uint32_t)carry;
+}
+
+static void _bignum_multiply_pow10(_bignum_t* b, int32_t n)
+{
+	for(; n >= 9; n -= 9)
+		_bignum_multiply(b, _pow10_32[9]);
+
+	if(n > 0)
+		_bignum_multiply(b, _pow10_32[n]);
+}
+
+static void _bignum_shift_left(_bignum_t* b, int32_t n)
+{
+	const int32_t words = n / 32;
+	const uint32_t bits = n % 32;
+	int32_t i;
+
+	if(b->len == 0)
+		return;
+
+	// Bits that are shifted out of the highest word go into a new word.
+	b->w[b->len + words] = bits ? b->w[b->len - 1] >> (32 - bits) : 0;
+	for(i = b->len - 1; i > 0; i--)
+		b->w[i + words] = (b->w[i] << bits) | (bits ? b->w[i - 1] >> (32 - bits) : 0);
+	b->w[words] = b->w[0] << bits;
+	for(i = 0; i < words; i++)
+		b->w[i] = 0;
+
+	b->len += words + 1;
+	if(b->w[b->len - 1] == 0)
+		b->len--;
+}
+
+static int _bignum_compare(const _bignum_t* a, const _bignum_t* b)
+{
+	uint8_t i;
+
+	if(a->len != b->len)
+		return (a->len < b->len) ? -1 : 1;
+
+	for(i = a->len; i > 0; i--)
+	{
+		if(a->w[i - 1] != b->w[i - 1])
+			return (a->w[i - 1] < b->w[i - 1]) ? -1 : 1;
+	}
+
+	return 0;
+}
+
+static void _bignum_subtract(_bignum_t* a, const _bignum_t* b)
+{
+	uint64_t d;
+	uint32_t borrow = 0;
+	uint8_t i;
+
+	for(i = 0; i < a->len; i++)
+	{
+		d = (uint64_t)a->w[i] - ((i < b->len) ? b->w[i] : 0) - borrow;
+		a->w[i] = (uint32_t)d;
+		borrow = (uint32_t)(d >> 63);	// Wrapped around
+	}
+
+	while(a->len > 0 && a->w[a->len - 1] == 0)
+		a->len--;
+}
+
+static char* _format(char* str, bool negative, char* digits, uint8_t len, int32_t k, int8_t precision, bool use_exponent)
+{
+	int32_t dp = len + k;	// Position of the decimal point: value = 0.digits * 10^dp
+	int32_t decimals, i, exp;
+
+	if(negative)
+		*str++ = '-';
+
+	if(use_exponent || dp > 21 || (precision < 0 && dp <= -6))
+	{
+		decimals = (precision >= 0) ? precision : len - 1;
+		*str++ = digits[0];
+		if(decimals > 0)
+		{
+			*str++ = '.';
+			for(i = 1; i <= decimals; i++)
+				*str++ = (i < len) ? digits[i] : '0';
+		}
+
+		// Exponent without leading zeros, because every number is parsed correctly this way.
+		exp = (digits[0] == '0') ? 0 : dp - 1;
+		*str++ = 'e';
+		if(exp < 0)
+		{
+			*str++ = '-';
+			exp = -exp;
+		}
+		if(exp >= 100)
+			*str++ = '0' + exp / 100;
+		if(exp >= 10)
+			*str++ = '0' + (exp / 10) % 10;
+		*str++ = '0' + exp % 10;
+		*str = 0;
+
+		return str;
+	}
+
+	if(dp <= 0)
+		*str++ = '0';
+	for(i = 0; i < dp; i++)
+		*str++ = (i < len) ? digits[i] : '0';
+
+	decimals = (precision >= 0) ? precision : len - dp;
+	if(decimals > 0)
+	{
+		*str++ = '.';
+		for(i = dp; i < dp + decimals; i++)
+			*str++ = (i >= 0 && i < len) ? digits[i] : '0';
+	}
+	*str = 0;
+
+	return str;
+}
+
+static char* _format_special(char* str, bool negative, bool is_nan)
+{
+	if(is_nan)
+	{
+		memcpy(str, "nan", 3);
+		str += 3;
+	}
+	else
+	{
+		if(negative)
+			*str++ = '-';
+		memcpy(str, "inf", 3);
+		str += 3;
+	}
+	*str = 0;
+
+	return str;
+}
+
+static bool _parse_number(const char* str, char** end, _number_t* n)
+{
+	const char* p = str;
+	const char* q;
+	uint8_t digits = 0;
+	bool has_digits = false;
+	bool exp_negative = false;
+	int32_t exp = 0;
+	uint8_t d;
+
+	memset(n, 0, sizeof(_number_t));
+
+	while(*p == ' ' || (*p >= '\t' && *p <= '\r'))
+		p++;
+
+	if(*p == '-' || *p == '+')
+		n->negative = (*p++ == '-');
+
+	if(_match_word(p, "nan"))
+	{
+		n->type = _NUMBER_NAN;
+		p += 3;
+	}
+	else if(_match_word(p, "inf"))
+	{
+		n->type = _NUMBER_INFINITE;
+		p += _match_word(p, "infinity") ? 8 : 3;
+	}
+	else
+	{
+		// Leading zeros are not significant
+		while(*p == '0')
+		{
+			has_digits = true;
+			p++;
+		}
+
+		for(; *p >= '0' && *p <= '9'; p++)
+		{
+			d = *p - '0';
+			has_digits = true;
+			if(digits < _PARSE_MAX_DIGITS)
+			{
+				n->mantissa = n->mantissa * 10 + d;
+				digits++;
+			}
+			else
+			{
+				n->exp10++;
+				n->truncated |= (d != 0);
+			}
+		}
+
+		if(*p == '.')
+		{
+			p++;
+			for(; *p >= '0' && *p <= '9'; p++)
+			{
+				d = *p - '0';
+				has_digits = true;
+				if(digits == 0 && d == 0)		// Zeros in front of the first significant digit
+					n->exp10--;
+				else if(digits < _PARSE_MAX_DIGITS)
+				{
+					n->mantissa = n->mantissa * 10 + d;
+					n->exp10--;
+					digits++;
+				}
+				else
+					n->truncated |= (d != 0);
+			}
+		}
+
+		if(!has_digits)
+		{
+			if(end)
+				*end = (char*)str;
+			return false;
+		}
+
+		// The exponent is only used if it has digits, otherwise the 'e' is not part of the number.
+		if(*p == 'e' || *p == 'E')
+		{
+			q = p + 1;
+			if(*q == '-' || *q == '+')
+				exp_negative = (*q++ == '-');
+
+			if(*q >= '0' && *q <= '9')
+			{
+				for(; *q >= '0' && *q <= '9'; q++)
+				{
+					if(exp < _PARSE_MAX_EXPONENT)
+						exp = exp * 10 + (*q - '0');
+				}
+				n->exp10 += exp_negative ? -exp : exp;
+				p = q;
+			}
+		}
+	}
+
+	if(end)
+		*end = (char*)p;
+
+	return true;
+}
+
+static bool _match_word(const char* str, const char* word)
+{
+	while(*word)
+	{
+		if((*str | 0x20) != *word)
+			return false;
+		str++;
+		word++;
+	}
+
+	return true;
+}
+
+static bool _eisel_lemire(const _number_t* n, const _format_t* format, uint64_t* bits)
+{
+	const uint8_t precision = format->mantissa_bits + 1;
+	const uint64_t exponent_max = 2 * format->exponent_bias + 1;
+	_diy_fp_t w, c, p;
+	int32_t i, r, exponent, shift;
+	uint64_t mantissa, rest, half, error;
+
+	if(n->type == _NUMBER_NAN)
+	{
+		*bits = (exponent_max << format->mantissa_bits) | (1ULL << (format->mantissa_bits - 1));
+		return true;
+	}
+
+	if(n->type == _NUMBER_INFINITE || (n->mantissa != 0 && n->exp10 > 310))
+	{
+		*bits = exponent_max << format->mantissa_bits;
+		return true;
+	}
+
+	// 19 digits * 10^-343 is below half of the smallest subnormal double.
+	if(n->mantissa == 0 || n->exp10 < -343)
+	{
+		*bits = 0;
+		return true;
+	}
+
+	// 10^exp10 = cached power * 10^r
+	i = (n->exp10 - _CACHED_POWER_MIN_EXP10) / _CACHED_POWER_STEP;
+	r = n->exp10 - (_CACHED_POWER_MIN_EXP10 + i * _CACHED_POWER_STEP);
+	c.f = _cached_powers[i].f;
+	c.e = _cached_powers[i].e;
+	if(r > 0)
+	{
+		w.f = _pow10_32[r];
+		w.e = 0;
+		c = _normalize(_multiply(c, _normalize(w)));
+	}
+
+	w.f = n->mantissa;
+	w.e = 0;
+	p = _normalize(_multiply(_normalize(w), c));
+
+	// The value is in [2^exponent, 2^(exponent + 1)). Subnormal values have less mantissa bits.
+	exponent = p.e + 63;
+	shift = 64 - precision;
+	if(exponent < 1 - format->exponent_bias)
+		shift += (1 - format->exponent_bias) - exponent;
+
+	// Far below half of the smallest subnormal value
+	if(shift > 65)
+	{
+		*bits = 0;
+		return true;
+	}
+
+	if(shift >= 64)
+		return false;
+
+	mantissa = p.f >> shift;
+	rest = p.f & ((1ULL << shift) - 1);
+	half = 1ULL << (shift - 1);
+	error = n->truncated ? _PARSE_ERROR_TRUNCATED : _PARSE_ERROR;
+
+	// The exact value could be on the other side of the middle between two values.
+	if((rest > half ? rest - half : half - rest) <= error)
+		return false;
+
+	if(rest > half)
+		mantissa++;
+
+	if(mantissa >> precision)	// Rounding overflow, e.g. 1.111...1 -> 10.000...0
+	{
+		mantissa >>= 1;
+		exponent++;
+	}
+
+	if(exponent > format->exponent_bias)
+		*bits = exponent_max << format->mantissa_bits;
+	else if((mantissa >> format->mantissa_bits) == 0)	// Subnormal, the exponent field is 0
+		*bits = mantissa;
+	else
+		*bits = ((uint64_t)(exponent + format->exponent_bias) << format->mantissa_bits) | (mantissa & ((1ULL << format->mantissa_bits) - 1));
+
+	return true;
+}
+
+#endif
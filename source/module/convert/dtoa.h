@@ -0,0 +1,101 @@
+/**
+ * 	@file 	dtoa.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief
+ *			Converts float and double values into strings and back without sprintf/strtod.
+ *
+ *			Strings are created with the Grisu2 algorithm, which finds the shortest digits that are parsed back into
+ *			the same value (e.g. 0.1 instead of 0.10000000000000001). It only uses 64-bit integer operations and a
+ *			table of 87 cached powers of 10. Grisu2 always round-trips and is the shortest representation in more
+ *			than 99.9% of all values. With a precision the digits are created from the exact value with the counted
+ *			digit generation of Grisu and rounded like printf, e.g. 345.88499999999999 with 2 decimals is "345.88". If
+ *			the error of the 64-bit calculation is too big to decide the rounding, the digits are created with big
+ *			number arithmetic.
+ *
+ *			Parsing uses the exact double operation of Clinger for short numbers and otherwise multiplies the digits
+ *			with a cached power of 10 (like Eisel-Lemire, but with 64-bit). Results that are too close to the middle
+ *			of two values to be decided exactly are passed to strtod/strtof, which happens very rarely.
+ *
+ *	@version	1.01 (18.10.2026)
+ *		- Precision digits are created from the exact value instead of rounding the shortest digits again. Exact
+ *		  ties are rounded to the even digit like printf.
+ *	@version	1.00 (18.10.2026)
+ *		- Initial release
+ *
+ *	@par 	References
+ *			- Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers", 2010
+ *			- Daniel Lemire, "Number Parsing at a Gigabyte per Second", 2021
+ *
+ ******************************************************************************/
+#ifndef DTOA_H_
+#define DTOA_H_
+
+#include "module_public.h"
+#if MODULE_ENABLE_CONVERT_DTOA
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Maximum number of decimals. Higher precisions are limited to this value.
+#define DTOA_MAX_PRECISION			17
+
+/// Size of a buffer that can hold every string created by @see dtoa_create_double_string, including the terminating zero.
+#define DTOA_STRING_SIZE			42
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates a string from a double value.
+ *
+ * Without use_exponent, values below 1e21 are written in fixed notation (e.g. "1234.5"). Larger values and, if no
+ * precision is given, values below 1e-6 are written in exponent notation (e.g. "1.5e-7"). The decimal point is
+ * always '.', so the string can be parsed by other devices. NaN and infinity are written as "nan", "inf" and "-inf".
+ *
+ * @param str				Pointer to a buffer with at least DTOA_STRING_SIZE bytes.
+ * @param value				Value that is converted.
+ * @param precision			Number of decimals or -1 for the shortest string that is parsed back into the same value.
+ * @param use_exponent		true: Always use exponent notation, precision is the number of decimals of the mantissa.
+ * @return					Pointer to the terminating zero.
+ */
+char* dtoa_create_double_string(char* str, double value, int8_t precision, bool use_exponent);
+/**
+ * @brief Creates a string from a float value. Same as @see dtoa_create_double_string, but the shortest string is
+ * searched for the float, so 0.1f is written as "0.1".
+ *
+ * @param str				Pointer to a buffer with at least DTOA_STRING_SIZE bytes.
+ * @param value				Value that is converted.
+ * @param precision			Number of decimals or -1 for the shortest string that is parsed back into the same value.
+ * @param use_exponent		true: Always use exponent notation, precision is the number of decimals of the mantissa.
+ * @return					Pointer to the terminating zero.
+ */
+char* dtoa_create_float_string(char* str, float value, int8_t precision, bool use_exponent);
+/**
+ * @brief Parses a double value from a string. Leading whitespace is skipped. Accepts an optional sign, digits with an
+ * optional '.', an optional exponent ("e-5") as well as "inf", "infinity" and "nan".
+ *
+ * @param str				String that is parsed.
+ * @param end				If not NULL, it is set to the first character behind the number or to str if there is no number.
+ * @return					Correctly rounded value or 0 if there is no number.
+ */
+double dtoa_parse_double(const char* str, char** end);
+/**
+ * @brief Parses a float value from a string. Same as @see dtoa_parse_double, but the value is rounded directly to
+ * float without rounding to double first.
+ *
+ * @param str				String that is parsed.
+ * @param end				If not NULL, it is set to the first character behind the number or to str if there is no number.
+ * @return					Correctly rounded value or 0 if there is no number.
+ */
+float dtoa_parse_float(const char* str, char** end);
+
+#endif
+
+#endif /* DTOA_H_ */
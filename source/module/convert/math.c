@@ -9,6 +9,13 @@
 #if MODULE_ENABLE_CONVERT_MATH
 
 #include "math.h"
+#include <float.h>
+
+#if MATH_USE_ESP_DSP
+#include "dsps_dotprod.h"
+#include "dsps_mulc.h"
+#include "dsps_addc.h"
+#endif
 
 #if MATH_ENABLE_64BIT_OPERATIONS
 uint64_t math_pow_mod64(uint64_t basis, uint64_t exponent, uint64_t modulo)
@@ -68,26 +75,88 @@ int math_log2_int(int value)
 	return 31 - __builtin_clz(value);
 }
 
-uint32_t math_sum_u32(uint32_t* array, size_t num)
+uint32_t math_sum_u32(const uint32_t* array, size_t num)
 {
-	uint32_t sum = 0;
-	while(num > 0)
-	{
-		sum += array[num-1];
-		num--;
-	}
-	return sum;
+	return (uint32_t)math_array_sum_uint32(array, num);
 }
 
-int32_t math_sum_i32(int32_t* array, size_t num)
+int32_t math_sum_i32(const int32_t* array, size_t num)
 {
-	int32_t sum = 0;
-	while(num > 0)
-	{
-		sum += array[num-1];
-		num--;
-	}
-	return sum;
+	return (int32_t)(uint32_t)math_array_sum_int32(array, num);
 }
 
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Array functions, see math_array_typed.h
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#define MATH_ARRAY_TYPE					uint8_t
+#define MATH_ARRAY_SUFFIX				uint8
+#define MATH_ARRAY_SUM_TYPE				uint64_t
+#define MATH_ARRAY_CHUNK_TYPE			uint32_t
+#define MATH_ARRAY_CHUNK				(1UL << 24)
+#define MATH_ARRAY_TYPE_MIN				0
+#define MATH_ARRAY_TYPE_MAX				UINT8_MAX
+#define MATH_ARRAY_IS_FLOAT				false
+#include "math_array_typed.h"
+
+#define MATH_ARRAY_TYPE					int8_t
+#define MATH_ARRAY_SUFFIX				int8
+#define MATH_ARRAY_SUM_TYPE				int64_t
+#define MATH_ARRAY_CHUNK_TYPE			int32_t
+#define MATH_ARRAY_CHUNK				(1UL << 23)
+#define MATH_ARRAY_TYPE_MIN				INT8_MIN
+#define MATH_ARRAY_TYPE_MAX				INT8_MAX
+#define MATH_ARRAY_IS_FLOAT				false
+#include "math_array_typed.h"
+
+#define MATH_ARRAY_TYPE					uint16_t
+#define MATH_ARRAY_SUFFIX				uint16
+#define MATH_ARRAY_SUM_TYPE				uint64_t
+#define MATH_ARRAY_CHUNK_TYPE			uint32_t
+#define MATH_ARRAY_CHUNK				(1UL << 16)
+#define MATH_ARRAY_TYPE_MIN				0
+#define MATH_ARRAY_TYPE_MAX				UINT16_MAX
+#define MATH_ARRAY_IS_FLOAT				false
+#include "math_array_typed.h"
+
+#define MATH_ARRAY_TYPE					int16_t
+#define MATH_ARRAY_SUFFIX				int16
+#define MATH_ARRAY_SUM_TYPE				int64_t
+#define MATH_ARRAY_CHUNK_TYPE			int32_t
+#define MATH_ARRAY_CHUNK				(1UL << 15)
+#define MATH_ARRAY_TYPE_MIN				INT16_MIN
+#define MATH_ARRAY_TYPE_MAX				INT16_MAX
+#define MATH_ARRAY_IS_FLOAT				false
+#include "math_array_typed.h"
+
+#define MATH_ARRAY_TYPE					uint32_t
+#define MATH_ARRAY_SUFFIX				uint32
+#define MATH_ARRAY_SUM_TYPE				uint64_t
+#define MATH_ARRAY_CHUNK_TYPE			uint64_t
+#define MATH_ARRAY_CHUNK				SIZE_MAX
+#define MATH_ARRAY_TYPE_MIN				0
+#define MATH_ARRAY_TYPE_MAX				UINT32_MAX
+#define MATH_ARRAY_IS_FLOAT				false
+#include "math_array_typed.h"
+
+#define MATH_ARRAY_TYPE					int32_t
+#define MATH_ARRAY_SUFFIX				int32
+#define MATH_ARRAY_SUM_TYPE				int64_t
+#define MATH_ARRAY_CHUNK_TYPE			int64_t
+#define MATH_ARRAY_CHUNK				SIZE_MAX
+#define MATH_ARRAY_TYPE_MIN				INT32_MIN
+#define MATH_ARRAY_TYPE_MAX				INT32_MAX
+#define MATH_ARRAY_IS_FLOAT				false
+#include "math_array_typed.h"
+
+#define MATH_ARRAY_TYPE					float
+#define MATH_ARRAY_SUFFIX				float
+#define MATH_ARRAY_SUM_TYPE				float
+#define MATH_ARRAY_CHUNK_TYPE			float
+#define MATH_ARRAY_CHUNK				SIZE_MAX
+#define MATH_ARRAY_TYPE_MIN				(-FLT_MAX)
+#define MATH_ARRAY_TYPE_MAX				FLT_MAX
+#define MATH_ARRAY_IS_FLOAT				true
+#include "math_array_typed.h"
+
 #endif
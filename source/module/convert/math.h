@@ -8,6 +8,22 @@
  *			Contains mathematical functions.
  *			Extracted from the old ESoPe convert.c module.
  *
+ *			The math_array_<type> functions calculate sums, minimum, maximum, mean, variance and dot products of
+ *			arrays and clamp or scale them. Each is a single loop without data dependent branches, so the compiler
+ *			can vectorize it (SSE/NEON/Helium). Sums of 8 and 16-bit values are calculated in 32-bit chunks and
+ *			added to a 64-bit sum. With MATH_USE_ESP_DSP the float dot product and scale use esp-dsp, which uses
+ *			the SIMD instructions of the ESP32-S3.
+ * @code
+int16_t temperatures[64];
+size_t index;
+int16_t hottest = math_array_max_int16(temperatures, 64, &index);
+float mean;
+float variance = math_array_variance_int16(temperatures, 64, &mean);
+ * @endcode
+ *
+ *	@version	1.07 (18.10.2026)
+ *		- Added math_array_sum, min, max, mean, variance, dot, clamp and scale for 8, 16 and 32-bit integers and float
+ *		- math_sum_u32 and math_sum_i32 use math_array_sum
  *	@version	1.06 (19.01.2022)
  * 	    - Modified to be used in esopekernel
  *  @version    1.05 (24.11.2021)
@@ -35,9 +51,16 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <math.h>
+
+#ifndef MATH_USE_ESP_DSP
+/// Set to true to use the esp-dsp component for the float dot product and scale, which uses the SIMD instructions of the ESP32-S3.
+#define MATH_USE_ESP_DSP			false
+#endif
+
 /// Version of the math module
-#define MATH_STR_VERSION "1.06"
+#define MATH_STR_VERSION "1.07"
 
 /// Uses the maximum of x or y
 #define MATH_MAX(x, y)  ((x) > (y) ? (x) : (y))
@@ -98,7 +121,7 @@ int math_log2_int(int value);
  * @param num           Number of elements in the array
  * @return uint32_t     Sum of the elements in the array.
  */
-uint32_t math_sum_u32(uint32_t* array, size_t num);
+uint32_t math_sum_u32(const uint32_t* array, size_t num);
 
 /**
  * @brief Calculates the sum of an array from int32_t values.
@@ -107,7 +130,144 @@ uint32_t math_sum_u32(uint32_t* array, size_t num);
  * @param num           Number of elements in the array
  * @return int32_t     Sum of the elements in the array.
  */
-int32_t math_sum_i32(int32_t* array, size_t num);
+int32_t math_sum_i32(const int32_t* array, size_t num);
+
+/**
+ * @brief Calculates the sum of an array. There is a function for each type. Integers are added in 64-bit, so the sum
+ * does not overflow. Float values are added in 4 separate sums, so the result can differ slightly from a sequential
+ * loop.
+ *
+ * @param arr			Pointer to the array.
+ * @param num			Number of elements.
+ * @return				Sum of the elements or 0 if arr is NULL.
+ */
+uint64_t math_array_sum_uint8(const uint8_t* arr, size_t num);
+int64_t math_array_sum_int8(const int8_t* arr, size_t num);
+uint64_t math_array_sum_uint16(const uint16_t* arr, size_t num);
+int64_t math_array_sum_int16(const int16_t* arr, size_t num);
+uint64_t math_array_sum_uint32(const uint32_t* arr, size_t num);
+int64_t math_array_sum_int32(const int32_t* arr, size_t num);
+float math_array_sum_float(const float* arr, size_t num);
+
+/**
+ * @brief Returns the smallest element of an array. There is a function for each type.
+ *
+ * @param arr			Pointer to the array.
+ * @param num			Number of elements.
+ * @param index			If not NULL, the index of the first smallest element is stored here.
+ * @return				Smallest element or 0 if the array is empty.
+ */
+uint8_t math_array_min_uint8(const uint8_t* arr, size_t num, size_t* index);
+int8_t math_array_min_int8(const int8_t* arr, size_t num, size_t* index);
+uint16_t math_array_min_uint16(const uint16_t* arr, size_t num, size_t* index);
+int16_t math_array_min_int16(const int16_t* arr, size_t num, size_t* index);
+uint32_t math_array_min_uint32(const uint32_t* arr, size_t num, size_t* index);
+int32_t math_array_min_int32(const int32_t* arr, size_t num, size_t* index);
+float math_array_min_float(const float* arr, size_t num, size_t* index);
+
+/**
+ * @brief Returns the largest element of an array. There is a function for each type.
+ *
+ * @param arr			Pointer to the array.
+ * @param num			Number of elements.
+ * @param index			If not NULL, the index of the first largest element is stored here.
+ * @return				Largest element or 0 if the array is empty.
+ */
+uint8_t math_array_max_uint8(const uint8_t* arr, size_t num, size_t* index);
+int8_t math_array_max_int8(const int8_t* arr, size_t num, size_t* index);
+uint16_t math_array_max_uint16(const uint16_t* arr, size_t num, size_t* index);
+int16_t math_array_max_int16(const int16_t* arr, size_t num, size_t* index);
+uint32_t math_array_max_uint32(const uint32_t* arr, size_t num, size_t* index);
+int32_t math_array_max_int32(const int32_t* arr, size_t num, size_t* index);
+float math_array_max_float(const float* arr, size_t num, size_t* index);
+
+/**
+ * @brief Returns the mean of an array. There is a function for each type.
+ *
+ * @param arr			Pointer to the array.
+ * @param num			Number of elements.
+ * @return				Mean or 0 if the array is empty.
+ */
+float math_array_mean_uint8(const uint8_t* arr, size_t num);
+float math_array_mean_int8(const int8_t* arr, size_t num);
+float math_array_mean_uint16(const uint16_t* arr, size_t num);
+float math_array_mean_int16(const int16_t* arr, size_t num);
+float math_array_mean_uint32(const uint32_t* arr, size_t num);
+float math_array_mean_int32(const int32_t* arr, size_t num);
+float math_array_mean_float(const float* arr, size_t num);
+
+/**
+ * @brief Returns the population variance (divided by num) of an array. The standard deviation is the square root of
+ * it. There is a function for each type.
+ *
+ * @param arr			Pointer to the array.
+ * @param num			Number of elements.
+ * @param mean			If not NULL, the mean is stored here.
+ * @return				Variance or 0 if the array is empty.
+ */
+float math_array_variance_uint8(const uint8_t* arr, size_t num, float* mean);
+float math_array_variance_int8(const int8_t* arr, size_t num, float* mean);
+float math_array_variance_uint16(const uint16_t* arr, size_t num, float* mean);
+float math_array_variance_int16(const int16_t* arr, size_t num, float* mean);
+float math_array_variance_uint32(const uint32_t* arr, size_t num, float* mean);
+float math_array_variance_int32(const int32_t* arr, size_t num, float* mean);
+float math_array_variance_float(const float* arr, size_t num, float* mean);
+
+/**
+ * @brief Returns the dot product of two arrays: a[0] * b[0] + ... + a[num - 1] * b[num - 1]. There is a function for
+ * each type. Integers are multiplied and added in 64-bit.
+ *
+ * For 8 and 16-bit elements the result is exact for any num below 2^32. For 32-bit elements a single product can
+ * already need 62 (int32) or 64 (uint32) bits, so the result is only exact while the dot product fits into the
+ * return type, e.g. for num below 2^32 if all elements of both arrays are within +-2^15 (int32) or below 2^16 (uint32).
+ * A result outside of the return type wraps around modulo 2^64.
+ *
+ * @param a				Pointer to the first array.
+ * @param b				Pointer to the second array.
+ * @param num			Number of elements in each array.
+ * @return				Dot product or 0 if a pointer is NULL.
+ */
+uint64_t math_array_dot_uint8(const uint8_t* a, const uint8_t* b, size_t num);
+int64_t math_array_dot_int8(const int8_t* a, const int8_t* b, size_t num);
+uint64_t math_array_dot_uint16(const uint16_t* a, const uint16_t* b, size_t num);
+int64_t math_array_dot_int16(const int16_t* a, const int16_t* b, size_t num);
+uint64_t math_array_dot_uint32(const uint32_t* a, const uint32_t* b, size_t num);
+int64_t math_array_dot_int32(const int32_t* a, const int32_t* b, size_t num);
+float math_array_dot_float(const float* a, const float* b, size_t num);
+
+/**
+ * @brief Limits all elements of an array to min and max. There is a function for each type.
+ *
+ * @param arr			Pointer to the array.
+ * @param num			Number of elements.
+ * @param min			Minimum value.
+ * @param max			Maximum value.
+ */
+void math_array_clamp_uint8(uint8_t* arr, size_t num, uint8_t min, uint8_t max);
+void math_array_clamp_int8(int8_t* arr, size_t num, int8_t min, int8_t max);
+void math_array_clamp_uint16(uint16_t* arr, size_t num, uint16_t min, uint16_t max);
+void math_array_clamp_int16(int16_t* arr, size_t num, int16_t min, int16_t max);
+void math_array_clamp_uint32(uint32_t* arr, size_t num, uint32_t min, uint32_t max);
+void math_array_clamp_int32(int32_t* arr, size_t num, int32_t min, int32_t max);
+void math_array_clamp_float(float* arr, size_t num, float min, float max);
+
+/**
+ * @brief Calculates out = in * factor + offset for each element. There is a function for each type. For integers
+ * the factor has 16 fractional bits (65536 = 1.0) and the result is rounded and saturated to the range of the type.
+ *
+ * @param in			Pointer to the input array.
+ * @param out			Pointer to the output array. Can be the same as in.
+ * @param num			Number of elements.
+ * @param factor		Factor, for integers with 16 fractional bits.
+ * @param offset		Value that is added after multiplying.
+ */
+void math_array_scale_uint8(const uint8_t* in, uint8_t* out, size_t num, int32_t factor, int32_t offset);
+void math_array_scale_int8(const int8_t* in, int8_t* out, size_t num, int32_t factor, int32_t offset);
+void math_array_scale_uint16(const uint16_t* in, uint16_t* out, size_t num, int32_t factor, int32_t offset);
+void math_array_scale_int16(const int16_t* in, int16_t* out, size_t num, int32_t factor, int32_t offset);
+void math_array_scale_uint32(const uint32_t* in, uint32_t* out, size_t num, int32_t factor, int32_t offset);
+void math_array_scale_int32(const int32_t* in, int32_t* out, size_t num, int32_t factor, int32_t offset);
+void math_array_scale_float(const float* in, float* out, size_t num, float factor, float offset);
 
 #endif
 
@@ -0,0 +1,288 @@
+/**
+ * 	@file 	math_array_typed.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief
+ *			Internal file that is included by math.c once for each element type. It creates the array
+ *			functions of math.h for the type.
+ *
+ *			Each function is a single loop without branches that depend on the data, so compilers can vectorize it.
+ *			Indices are searched in a second loop, because a loop that tracks the index cannot be vectorized.
+ *
+ *			Needs the following definitions before it is included:
+ *			- MATH_ARRAY_TYPE: Type of the elements, e.g. int16_t.
+ *			- MATH_ARRAY_SUFFIX: Suffix of the function names, e.g. i16.
+ *			- MATH_ARRAY_SUM_TYPE: Type of sums and dot products, int64_t, uint64_t or float.
+ *			- MATH_ARRAY_CHUNK_TYPE: Type of the sum of a chunk. Smaller than MATH_ARRAY_SUM_TYPE for 8 and 16-bit
+ *			  elements, so the vectors do not need to be 64-bit.
+ *			- MATH_ARRAY_CHUNK: Number of elements whose sum fits into MATH_ARRAY_CHUNK_TYPE.
+ *			- MATH_ARRAY_TYPE_MIN, MATH_ARRAY_TYPE_MAX: Range of the type.
+ *			- MATH_ARRAY_IS_FLOAT: true for float.
+ *
+ *	@version	1.00 (18.10.2026)
+ *		- Initial release
+ *
+ ******************************************************************************/
+
+#define MATH_ARRAY_CONCAT_(a, b)		a##b
+#define MATH_ARRAY_CONCAT(a, b)			MATH_ARRAY_CONCAT_(a, b)
+/// Appends the type suffix to a function name.
+#define MATH_ARRAY_NAME(name)			MATH_ARRAY_CONCAT(name, MATH_ARRAY_SUFFIX)
+
+#if MATH_ARRAY_IS_FLOAT
+/// Type of the factor and offset of the scale function.
+#define MATH_ARRAY_SCALE_TYPE			float
+#else
+#define MATH_ARRAY_SCALE_TYPE			int32_t
+#endif
+
+MATH_ARRAY_SUM_TYPE MATH_ARRAY_NAME(math_array_sum_)(const MATH_ARRAY_TYPE* arr, size_t num)
+{
+#if MATH_ARRAY_IS_FLOAT
+	// 4 independent sums, because the compiler is not allowed to change the order of float additions.
+	float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+	size_t i;
+
+	if(arr == NULL)
+		return 0;
+
+	for(i = 0; i + 4 <= num; i += 4)
+	{
+		s0 += arr[i];
+		s1 += arr[i + 1];
+		s2 += arr[i + 2];
+		s3 += arr[i + 3];
+	}
+	for(; i < num; i++)
+		s0 += arr[i];
+
+	return (s0 + s1) + (s2 + s3);
+#else
+	MATH_ARRAY_SUM_TYPE sum = 0;
+	MATH_ARRAY_CHUNK_TYPE chunk_sum;
+	size_t i, n;
+
+	if(arr == NULL)
+		return 0;
+
+	while(num > 0)
+	{
+		n = num < (size_t)MATH_ARRAY_CHUNK ? num : (size_t)MATH_ARRAY_CHUNK;
+		chunk_sum = 0;
+
+		for(i = 0; i < n; i++)
+			chunk_sum += arr[i];
+
+		sum += chunk_sum;
+		arr += n;
+		num -= n;
+	}
+
+	return sum;
+#endif
+}
+
+MATH_ARRAY_TYPE MATH_ARRAY_NAME(math_array_min_)(const MATH_ARRAY_TYPE* arr, size_t num, size_t* index)
+{
+	MATH_ARRAY_TYPE v;
+	size_t i;
+
+	if(arr == NULL || num == 0)
+	{
+		if(index)
+			*index = 0;
+		return 0;
+	}
+
+	v = arr[0];
+	for(i = 1; i < num; i++)
+		v = arr[i] < v ? arr[i] : v;
+
+	if(index)
+	{
+		// Only a NaN at arr[0] is not found again.
+		for(i = 0; i < num && !(arr[i] == v); i++);
+		*index = i < num ? i : 0;
+	}
+
+	return v;
+}
+
+MATH_ARRAY_TYPE MATH_ARRAY_NAME(math_array_max_)(const MATH_ARRAY_TYPE* arr, size_t num, size_t* index)
+{
+	MATH_ARRAY_TYPE v;
+	size_t i;
+
+	if(arr == NULL || num == 0)
+	{
+		if(index)
+			*index = 0;
+		return 0;
+	}
+
+	v = arr[0];
+	for(i = 1; i < num; i++)
+		v = arr[i] > v ? arr[i] : v;
+
+	if(index)
+	{
+		// Only a NaN at arr[0] is not found again.
+		for(i = 0; i < num && !(arr[i] == v); i++);
+		*index = i < num ? i : 0;
+	}
+
+	return v;
+}
+
+float MATH_ARRAY_NAME(math_array_mean_)(const MATH_ARRAY_TYPE* arr, size_t num)
+{
+	if(arr == NULL || num == 0)
+		return 0.0f;
+
+	return (float)MATH_ARRAY_NAME(math_array_sum_)(arr, num) / (float)num;
+}
+
+float MATH_ARRAY_NAME(math_array_variance_)(const MATH_ARRAY_TYPE* arr, size_t num, float* mean)
+{
+#if MATH_ARRAY_IS_FLOAT
+	float m, d, s0 = 0.0f, s1 = 0.0f;
+#else
+	double m, d, s0 = 0.0, s1 = 0.0;
+#endif
+	size_t i;
+
+	if(arr == NULL || num == 0)
+	{
+		if(mean)
+			*mean = 0.0f;
+		return 0.0f;
+	}
+
+	// Two passes: The sum of the squared differences does not lose precision like sum(x^2) - sum(x)^2 / n.
+#if MATH_ARRAY_IS_FLOAT
+	m = MATH_ARRAY_NAME(math_array_sum_)(arr, num) / (float)num;
+#else
+	m = (double)MATH_ARRAY_NAME(math_array_sum_)(arr, num) / (double)num;
+#endif
+
+	for(i = 0; i + 2 <= num; i += 2)
+	{
+		d = arr[i] - m;
+		s0 += d * d;
+		d = arr[i + 1] - m;
+		s1 += d * d;
+	}
+	if(i < num)
+	{
+		d = arr[i] - m;
+		s0 += d * d;
+	}
+
+	if(mean)
+		*mean = (float)m;
+
+	return (float)((s0 + s1) / num);
+}
+
+MATH_ARRAY_SUM_TYPE MATH_ARRAY_NAME(math_array_dot_)(const MATH_ARRAY_TYPE* a, const MATH_ARRAY_TYPE* b, size_t num)
+{
+#if MATH_ARRAY_IS_FLOAT && MATH_USE_ESP_DSP
+	float result = 0.0f;
+
+	if(a == NULL || b == NULL)
+		return 0;
+
+	dsps_dotprod_f32(a, b, &result, (int)num);
+	return result;
+#elif MATH_ARRAY_IS_FLOAT
+	float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+	size_t i;
+
+	if(a == NULL || b == NULL)
+		return 0;
+
+	for(i = 0; i + 4 <= num; i += 4)
+	{
+		s0 += a[i] * b[i];
+		s1 += a[i + 1] * b[i + 1];
+		s2 += a[i + 2] * b[i + 2];
+		s3 += a[i + 3] * b[i + 3];
+	}
+	for(; i < num; i++)
+		s0 += a[i] * b[i];
+
+	return (s0 + s1) + (s2 + s3);
+#else
+	// Added as uint64_t, so a result outside of the return type wraps around instead of being an undefined signed overflow.
+	// Each product fits into MATH_ARRAY_SUM_TYPE, because the elements have 32 bits at most.
+	uint64_t sum = 0;
+	size_t i;
+
+	if(a == NULL || b == NULL)
+		return 0;
+
+	for(i = 0; i < num; i++)
+		sum += (uint64_t)((MATH_ARRAY_SUM_TYPE)a[i] * (MATH_ARRAY_SUM_TYPE)b[i]);
+
+	return (MATH_ARRAY_SUM_TYPE)sum;
+#endif
+}
+
+void MATH_ARRAY_NAME(math_array_clamp_)(MATH_ARRAY_TYPE* arr, size_t num, MATH_ARRAY_TYPE min, MATH_ARRAY_TYPE max)
+{
+	MATH_ARRAY_TYPE v;
+	size_t i;
+
+	if(arr == NULL)
+		return;
+
+	for(i = 0; i < num; i++)
+	{
+		v = arr[i] < min ? min : arr[i];
+		arr[i] = v > max ? max : v;
+	}
+}
+
+void MATH_ARRAY_NAME(math_array_scale_)(const MATH_ARRAY_TYPE* in, MATH_ARRAY_TYPE* out, size_t num, MATH_ARRAY_SCALE_TYPE factor, MATH_ARRAY_SCALE_TYPE offset)
+{
+#if !MATH_ARRAY_IS_FLOAT || !MATH_USE_ESP_DSP
+	size_t i;
+#endif
+#if !MATH_ARRAY_IS_FLOAT
+	int64_t v;
+#endif
+
+	if(in == NULL || out == NULL)
+		return;
+
+#if MATH_ARRAY_IS_FLOAT
+#if MATH_USE_ESP_DSP
+	dsps_mulc_f32(in, out, (int)num, factor, 1, 1);
+	dsps_addc_f32(out, out, (int)num, offset, 1, 1);
+#else
+	for(i = 0; i < num; i++)
+		out[i] = in[i] * factor + offset;
+#endif
+#else
+	for(i = 0; i < num; i++)
+	{
+		v = (((int64_t)in[i] * factor + 0x8000) >> 16) + offset;
+		v = v < MATH_ARRAY_TYPE_MIN ? MATH_ARRAY_TYPE_MIN : v;
+		out[i] = (MATH_ARRAY_TYPE)(v > MATH_ARRAY_TYPE_MAX ? MATH_ARRAY_TYPE_MAX : v);
+	}
+#endif
+}
+
+#undef MATH_ARRAY_TYPE
+#undef MATH_ARRAY_SUFFIX
+#undef MATH_ARRAY_SUM_TYPE
+#undef MATH_ARRAY_CHUNK_TYPE
+#undef MATH_ARRAY_CHUNK
+#undef MATH_ARRAY_TYPE_MIN
+#undef MATH_ARRAY_TYPE_MAX
+#undef MATH_ARRAY_IS_FLOAT
+#undef MATH_ARRAY_SCALE_TYPE
+#undef MATH_ARRAY_NAME
+#undef MATH_ARRAY_CONCAT
+#undef MATH_ARRAY_CONCAT_
@@ -8,24 +8,363 @@
 #if MODULE_ENABLE_CONVERT_SORT
 
 #include "sort.h"
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Ranges up to this number of elements are sorted with insertion sort.
+#define SORT_INSERTION_THRESHOLD		16
+
+/// Arrays below this number of elements are sorted with introsort by the radix functions, because clearing and summing
+/// up the histograms takes longer than sorting.
+#define SORT_RADIX_THRESHOLD			256
+
+/// Returns the address of element i of the generic array.
+#define SORT_GENERIC_AT(g, i)			((g)->arr + (i) * (g)->size)
+
+/// Returns true if element a is smaller than element b of the generic array.
+#define SORT_GENERIC_LESS(g, a, b)		((g)->f(SORT_GENERIC_AT(g, a), SORT_GENERIC_AT(g, b), (g)->obj) < 0)
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal structures and enums
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Parameters of the generic sort, so they do not need to be passed to each internal function.
+typedef struct _sort_generic_s
+{
+	/// Start of the current range.
+	uint8_t* arr;
+	/// Size of an element in bytes.
+	size_t size;
+	/// Compare function.
+	sort_compare_cb_t f;
+	/// User-defined pointer for f.
+	void* obj;
+}_sort_generic_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Returns the number of partitions introsort may use before switching to heapsort, which is 2 * log2(count).
+ *
+ * @param count					Number of elements.
+ * @return						Depth limit.
+ */
+static uint8_t _sort_depth_limit(size_t count);
+/**
+ * Swaps two elements of the generic array.
+ *
+ * @param g						Parameters of the generic sort.
+ * @param a						Index of the first element.
+ * @param b						Index of the second element.
+ */
+static void _sort_generic_swap(_sort_generic_t* g, size_t a, size_t b);
+/**
+ * Sorts the first count elements of the generic array with insertion sort.
+ *
+ * @param g						Parameters of the generic sort.
+ * @param count					Number of elements.
+ */
+static void _sort_generic_insertion(_sort_generic_t* g, size_t count);
+/**
+ * Moves the element at root down in the heap of the first count elements until its children are not greater.
+ *
+ * @param g						Parameters of the generic sort.
+ * @param root					Index of the element.
+ * @param count					Number of elements in the heap.
+ */
+static void _sort_generic_sift_down(_sort_generic_t* g, size_t root, size_t count);
+/**
+ * Sorts the first count elements of the generic array with heapsort.
+ *
+ * @param g						Parameters of the generic sort.
+ * @param count					Number of elements.
+ */
+static void _sort_generic_heapsort(_sort_generic_t* g, size_t count);
+/**
+ * Partitions the first count elements of the generic array around the median of the first, middle and last element.
+ *
+ * @param g						Parameters of the generic sort.
+ * @param count					Number of elements, at least 3.
+ * @return						Index of the pivot. Elements before are not greater, elements behind are not smaller.
+ */
+static size_t _sort_generic_partition(_sort_generic_t* g, size_t count);
+/**
+ * Sorts the first count elements of the generic array with introsort.
+ *
+ * @param g						Parameters of the generic sort. g->arr is modified.
+ * @param count					Number of elements.
+ * @param depth					Number of partitions before heapsort is used.
+ */
+static void _sort_generic_introsort(_sort_generic_t* g, size_t count, uint8_t depth);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void sort_uint32_array(uint32_t *arr, uint16_t number_of_elements)
 {
-	uint16_t i, j;
-	uint32_t tmp;
-	
-	for(i = 0; i < number_of_elements; i++)
+	sort_uint32(arr, number_of_elements);
+}
+
+#define SORT_TYPE					uint8_t
+#define SORT_SUFFIX					uint8
+#define SORT_RADIX_KEY_TYPE			uint8_t
+#define SORT_RADIX_SIGN_BIT			0
+#include "sort_typed.h"
+
+#define SORT_TYPE					int8_t
+#define SORT_SUFFIX					int8
+#define SORT_RADIX_KEY_TYPE			uint8_t
+#define SORT_RADIX_SIGN_BIT			0x80U
+#include "sort_typed.h"
+
+#define SORT_TYPE					uint16_t
+#define SORT_SUFFIX					uint16
+#define SORT_RADIX_KEY_TYPE			uint16_t
+#define SORT_RADIX_SIGN_BIT			0
+#include "sort_typed.h"
+
+#define SORT_TYPE					int16_t
+#define SORT_SUFFIX					int16
+#define SORT_RADIX_KEY_TYPE			uint16_t
+#define SORT_RADIX_SIGN_BIT			0x8000U
+#include "sort_typed.h"
+
+#define SORT_TYPE					uint32_t
+#define SORT_SUFFIX					uint32
+#define SORT_RADIX_KEY_TYPE			uint32_t
+#define SORT_RADIX_SIGN_BIT			0
+#include "sort_typed.h"
+
+#define SORT_TYPE					int32_t
+#define SORT_SUFFIX					int32
+#define SORT_RADIX_KEY_TYPE			uint32_t
+#define SORT_RADIX_SIGN_BIT			0x80000000UL
+#include "sort_typed.h"
+
+#define SORT_TYPE					uint64_t
+#define SORT_SUFFIX					uint64
+#define SORT_RADIX_KEY_TYPE			uint64_t
+#define SORT_RADIX_SIGN_BIT			0
+#include "sort_typed.h"
+
+#define SORT_TYPE					int64_t
+#define SORT_SUFFIX					int64
+#define SORT_RADIX_KEY_TYPE			uint64_t
+#define SORT_RADIX_SIGN_BIT			0x8000000000000000ULL
+#include "sort_typed.h"
+
+#define SORT_TYPE					float
+#define SORT_SUFFIX					float
+#include "sort_typed.h"
+
+#define SORT_TYPE					double
+#define SORT_SUFFIX					double
+#include "sort_typed.h"
+
+void sort_generic(void* arr, size_t count, size_t size, sort_compare_cb_t f, void* obj)
+{
+	_sort_generic_t g = {.arr = arr, .size = size, .f = f, .obj = obj};
+
+	if(arr == NULL || f == NULL || size == 0)
+		return;
+
+	_sort_generic_introsort(&g, count, _sort_depth_limit(count));
+}
+
+void* sort_select_generic(void* arr, size_t count, size_t size, size_t k, sort_compare_cb_t f, void* obj)
+{
+	_sort_generic_t g = {.arr = arr, .size = size, .f = f, .obj = obj};
+	uint8_t depth = _sort_depth_limit(count);
+	void* element;
+	size_t p;
+
+	if(arr == NULL || f == NULL || size == 0 || count == 0)
+		return NULL;
+
+	if(k >= count)
+		k = count - 1;
+
+	element = SORT_GENERIC_AT(&g, k);
+
+	while(count > SORT_INSERTION_THRESHOLD)
 	{
-		for(j = i; j < number_of_elements; j++)
+		if(depth == 0)
+		{
+			_sort_generic_heapsort(&g, count);
+			return element;
+		}
+		depth--;
+
+		p = _sort_generic_partition(&g, count);
+		if(k == p)
+			return element;
+
+		if(k < p)
+			count = p;
+		else
 		{
-			if(arr[i] > arr[j])
-			{
-				tmp = arr[i];
-				arr[i] = arr[j];
-				arr[j] = tmp;
-			}
+			g.arr = SORT_GENERIC_AT(&g, p + 1);
+			count -= p + 1;
+			k -= p + 1;
 		}
 	}
+
+	_sort_generic_insertion(&g, count);
+	return element;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint8_t _sort_depth_limit(size_t count)
+{
+	uint8_t depth = 0;
+
+	while(count > 1)
+	{
+		count >>= 1;
+		depth += 2;
+	}
+
+	return depth;
+}
+
+static void _sort_generic_swap(_sort_generic_t* g, size_t a, size_t b)
+{
+	uint8_t* pa = SORT_GENERIC_AT(g, a);
+	uint8_t* pb = SORT_GENERIC_AT(g, b);
+	uint8_t tmp[32];
+	size_t len;
+	size_t size = g->size;
+
+	while(size > 0)
+	{
+		len = size < sizeof(tmp) ? size : sizeof(tmp);
+		memcpy(tmp, pa, len);
+		memcpy(pa, pb, len);
+		memcpy(pb, tmp, len);
+		pa += len;
+		pb += len;
+		size -= len;
+	}
+}
+
+static void _sort_generic_insertion(_sort_generic_t* g, size_t count)
+{
+	size_t i, j;
+
+	for(i = 1; i < count; i++)
+	{
+		for(j = i; j > 0 && SORT_GENERIC_LESS(g, j, j - 1); j--)
+			_sort_generic_swap(g, j, j - 1);
+	}
+}
+
+static void _sort_generic_sift_down(_sort_generic_t* g, size_t root, size_t count)
+{
+	size_t child;
+
+	while((child = 2 * root + 1) < count)
+	{
+		if(child + 1 < count && SORT_GENERIC_LESS(g, child, child + 1))
+			child++;
+
+		if(!SORT_GENERIC_LESS(g, root, child))
+			break;
+
+		_sort_generic_swap(g, root, child);
+		root = child;
+	}
+}
+
+static void _sort_generic_heapsort(_sort_generic_t* g, size_t count)
+{
+	size_t i;
+
+	for(i = count / 2; i > 0; i--)
+		_sort_generic_sift_down(g, i - 1, count);
+
+	for(i = count - 1; i > 0; i--)
+	{
+		_sort_generic_swap(g, 0, i);
+		_sort_generic_sift_down(g, 0, i);
+	}
+}
+
+static size_t _sort_generic_partition(_sort_generic_t* g, size_t count)
+{
+	size_t mid = count / 2;
+	size_t i = 0;
+	size_t j = count;
+
+	// Median of three, afterwards the pivot is at index 0 and the last element is not smaller.
+	if(SORT_GENERIC_LESS(g, mid, 0))
+		_sort_generic_swap(g, mid, 0);
+	if(SORT_GENERIC_LESS(g, count - 1, mid))
+	{
+		_sort_generic_swap(g, mid, count - 1);
+		if(SORT_GENERIC_LESS(g, mid, 0))
+			_sort_generic_swap(g, mid, 0);
+	}
+	_sort_generic_swap(g, mid, 0);
+
+	for(;;)
+	{
+		do i++; while(SORT_GENERIC_LESS(g, i, 0));
+		do j--; while(SORT_GENERIC_LESS(g, 0, j));
+
+		if(i >= j)
+			break;
+
+		_sort_generic_swap(g, i, j);
+	}
+
+	_sort_generic_swap(g, 0, j);
+	return j;
+}
+
+static void _sort_generic_introsort(_sort_generic_t* g, size_t count, uint8_t depth)
+{
+	uint8_t* arr = g->arr;
+	size_t p;
+
+	while(count > SORT_INSERTION_THRESHOLD)
+	{
+		g->arr = arr;
+
+		if(depth == 0)
+		{
+			_sort_generic_heapsort(g, count);
+			return;
+		}
+		depth--;
+
+		p = _sort_generic_partition(g, count);
+
+		// Only the smaller part is sorted recursively, so the stack depth is limited to log2(count).
+		if(p < count - p - 1)
+		{
+			_sort_generic_introsort(g, p, depth);
+			arr += (p + 1) * g->size;
+			count -= p + 1;
+		}
+		else
+		{
+			g->arr = arr + (p + 1) * g->size;
+			_sort_generic_introsort(g, count - p - 1, depth);
+			count = p;
+		}
+	}
+
+	g->arr = arr;
+	_sort_generic_insertion(g, count);
 }
 
 #endif
@@ -8,12 +8,35 @@
  *			Contains sorting algorithms.
  *			Extracted from the old ESoPe convert.c module.
  *
+ *			- sort_<type> sorts an array of a number type ascending with introsort. It uses quicksort with the median of
+ *			  three, insertion sort for small ranges and switches to heapsort if the pivots are bad, so it needs
+ *			  O(n log n) in the worst case. The stack depth is limited to log2(count).
+ *			- sort_radix_<type> sorts large integer arrays with a LSD radix sort in O(n) using one byte per pass. It needs
+ *			  a second buffer with the same size and 256 * sizeof(size_t) bytes of stack.
+ *			- sort_select_<type> partially sorts an array, so the element k is at the position it would have in the
+ *			  sorted array (like std::nth_element). Is used for medians and percentiles in O(n).
+ *			- sort_generic and sort_select_generic are used for structs with a compare function.
+ *
+ *			C++ users can use sort.hpp, where the compare function is inlined.
+ * @code
+uint16_t samples[31];
+uint16_t median = sort_select_uint16(samples, 31, 31 / 2);
+uint16_t p90 = sort_select_uint16(samples, 31, 31 * 90 / 100);
+ * @endcode
+ *
+ *			The typed functions use the < operator, so float and double arrays must not contain NaN.
+ *
+ *	@version	1.02 (18.10.2026)
+ *		- Added introsort, radix sort and selection for 8, 16, 32 and 64-bit integers, float and double
+ *		- Added sort_generic and sort_select_generic
+ *		- sort_uint32_array uses sort_uint32 instead of an O(n^2) exchange sort
  *	@version	1.01 (07.06.2018)
  *		- Added module.h support
  *  @version	1.00 (28.09.2012)
  *  	- Intial release
  *
  *	@par 	References
+ *		- David R. Musser, "Introspective Sorting and Selection Algorithms", 1997
  *
  ******************************************************************************/
  
@@ -24,15 +47,114 @@
 #if MODULE_ENABLE_CONVERT_SORT
 
 #include <stdint.h>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Compares two elements for sort_generic and sort_select_generic.
+ *
+ * @param a						Pointer to the first element.
+ * @param b						Pointer to the second element.
+ * @param obj					User-defined pointer.
+ * @return						Negative value if a is before b, positive value if a is behind b or 0 if both are equal.
+ */
+typedef int (*sort_compare_cb_t)(const void* a, const void* b, void* obj);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
- *	Sorts an array with unsigned 32-bit numbers by ordering it ascending.
+ *	Sorts an array with unsigned 32-bit numbers by ordering it ascending. Same as sort_uint32.
  *
  * @param arr					Pointer to the start address of the array.
  * @param number_of_elements	Number of 32-bit values inside the array.
  **/
 void sort_uint32_array(uint32_t *arr, uint16_t number_of_elements);
 
+/**
+ * @brief Sorts an array ascending with introsort. There is a function for each number type, e.g. sort_int16 or
+ * sort_float. The order of equal elements is not kept.
+ *
+ * @param arr					Pointer to the array.
+ * @param count					Number of elements.
+ */
+void sort_uint8(uint8_t* arr, size_t count);
+void sort_int8(int8_t* arr, size_t count);
+void sort_uint16(uint16_t* arr, size_t count);
+void sort_int16(int16_t* arr, size_t count);
+void sort_uint32(uint32_t* arr, size_t count);
+void sort_int32(int32_t* arr, size_t count);
+void sort_uint64(uint64_t* arr, size_t count);
+void sort_int64(int64_t* arr, size_t count);
+void sort_float(float* arr, size_t count);
+void sort_double(double* arr, size_t count);
+
+/**
+ * @brief Moves element k to the position it would have in the sorted array. Elements before are not greater, elements
+ * behind are not smaller. There is a function for each number type.
+ *
+ * @param arr					Pointer to the array.
+ * @param count					Number of elements.
+ * @param k						Index of the element, e.g. count / 2 for the median. Is limited to count - 1.
+ * @return						Value of element k or 0 if the array is empty.
+ */
+uint8_t sort_select_uint8(uint8_t* arr, size_t count, size_t k);
+int8_t sort_select_int8(int8_t* arr, size_t count, size_t k);
+uint16_t sort_select_uint16(uint16_t* arr, size_t count, size_t k);
+int16_t sort_select_int16(int16_t* arr, size_t count, size_t k);
+uint32_t sort_select_uint32(uint32_t* arr, size_t count, size_t k);
+int32_t sort_select_int32(int32_t* arr, size_t count, size_t k);
+uint64_t sort_select_uint64(uint64_t* arr, size_t count, size_t k);
+int64_t sort_select_int64(int64_t* arr, size_t count, size_t k);
+float sort_select_float(float* arr, size_t count, size_t k);
+double sort_select_double(double* arr, size_t count, size_t k);
+
+/**
+ * @brief Sorts an integer array ascending with LSD radix sort. Passes where all elements have the same byte are
+ * skipped. There is a function for each integer type. The order of equal elements is kept.
+ *
+ * Arrays with less than 256 elements or without tmp are sorted with introsort.
+ *
+ * @param arr					Pointer to the array.
+ * @param tmp					Pointer to a buffer with count elements that is used during the sort or NULL.
+ * @param count					Number of elements.
+ */
+void sort_radix_uint8(uint8_t* arr, uint8_t* tmp, size_t count);
+void sort_radix_int8(int8_t* arr, int8_t* tmp, size_t count);
+void sort_radix_uint16(uint16_t* arr, uint16_t* tmp, size_t count);
+void sort_radix_int16(int16_t* arr, int16_t* tmp, size_t count);
+void sort_radix_uint32(uint32_t* arr, uint32_t* tmp, size_t count);
+void sort_radix_int32(int32_t* arr, int32_t* tmp, size_t count);
+void sort_radix_uint64(uint64_t* arr, uint64_t* tmp, size_t count);
+void sort_radix_int64(int64_t* arr, int64_t* tmp, size_t count);
+
+/**
+ * @brief Sorts an array of any type ascending with introsort.
+ *
+ * @param arr					Pointer to the array.
+ * @param count					Number of elements.
+ * @param size					Size of an element in bytes.
+ * @param f						Compare function.
+ * @param obj					User-defined pointer for f.
+ */
+void sort_generic(void* arr, size_t count, size_t size, sort_compare_cb_t f, void* obj);
+/**
+ * @brief Moves element k of an array of any type to the position it would have in the sorted array.
+ *
+ * @param arr					Pointer to the array.
+ * @param count					Number of elements.
+ * @param size					Size of an element in bytes.
+ * @param k						Index of the element. Is limited to count - 1.
+ * @param f						Compare function.
+ * @param obj					User-defined pointer for f.
+ * @return						Pointer to element k or NULL if the array is empty.
+ */
+void* sort_select_generic(void* arr, size_t count, size_t size, size_t k, sort_compare_cb_t f, void* obj);
+
 #endif
 
 #endif
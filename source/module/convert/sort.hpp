@@ -0,0 +1,241 @@
+/**
+ * 	@file 		sort.hpp
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		C++ front-end for the sort module. The same introsort and selection as in sort.c, but as templates, so the
+ *  			compare function is inlined for any type. Needs no allocation and only C++11.
+ * @code
+struct entry_t { uint32_t id; float value; };
+entry_t entries[100];
+sort_introsort(entries, 100, [](const entry_t& a, const entry_t& b) { return a.value < b.value; });
+ * @endcode
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef SORT_HPP_
+#define SORT_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Default compare function using the < operator.
+template<typename T>
+struct sort_less_t
+{
+	constexpr bool operator()(const T& a, const T& b) const
+	{
+		return a < b;
+	}
+};
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Ranges up to this number of elements are sorted with insertion sort.
+static const size_t _sort_insertion_threshold = 16;
+
+template<typename T>
+inline void _sort_swap(T& a, T& b)
+{
+	T tmp = a;
+	a = b;
+	b = tmp;
+}
+
+inline uint8_t _sort_depth(size_t count)
+{
+	uint8_t depth = 0;
+
+	for(; count > 1; count >>= 1)
+		depth += 2;
+
+	return depth;
+}
+
+template<typename T, typename Less>
+void _sort_insertion(T* arr, size_t count, Less& less)
+{
+	for(size_t i = 1; i < count; i++)
+	{
+		T v = arr[i];
+		size_t j = i;
+
+		for(; j > 0 && less(v, arr[j - 1]); j--)
+			arr[j] = arr[j - 1];
+
+		arr[j] = v;
+	}
+}
+
+template<typename T, typename Less>
+void _sort_sift_down(T* arr, size_t i, size_t count, Less& less)
+{
+	T v = arr[i];
+	size_t child;
+
+	while((child = 2 * i + 1) < count)
+	{
+		if(child + 1 < count && less(arr[child], arr[child + 1]))
+			child++;
+
+		if(!less(v, arr[child]))
+			break;
+
+		arr[i] = arr[child];
+		i = child;
+	}
+	arr[i] = v;
+}
+
+template<typename T, typename Less>
+void _sort_heapsort(T* arr, size_t count, Less& less)
+{
+	for(size_t i = count / 2; i > 0; i--)
+		_sort_sift_down(arr, i - 1, count, less);
+
+	for(size_t i = count - 1; i > 0; i--)
+	{
+		_sort_swap(arr[0], arr[i]);
+		_sort_sift_down(arr, 0, i, less);
+	}
+}
+
+/// Partitions around the median of the first, middle and last element and returns the index of the pivot.
+template<typename T, typename Less>
+size_t _sort_partition(T* arr, size_t count, Less& less)
+{
+	size_t mid = count / 2;
+	size_t i = 0;
+	size_t j = count;
+
+	if(less(arr[mid], arr[0]))
+		_sort_swap(arr[mid], arr[0]);
+	if(less(arr[count - 1], arr[mid]))
+	{
+		_sort_swap(arr[mid], arr[count - 1]);
+		if(less(arr[mid], arr[0]))
+			_sort_swap(arr[mid], arr[0]);
+	}
+	_sort_swap(arr[mid], arr[0]);
+
+	for(;;)
+	{
+		do i++; while(less(arr[i], arr[0]));
+		do j--; while(less(arr[0], arr[j]));
+
+		if(i >= j)
+			break;
+
+		_sort_swap(arr[i], arr[j]);
+	}
+
+	_sort_swap(arr[0], arr[j]);
+	return j;
+}
+
+template<typename T, typename Less>
+void _sort_introsort(T* arr, size_t count, uint8_t depth, Less& less)
+{
+	while(count > _sort_insertion_threshold)
+	{
+		if(depth == 0)
+		{
+			_sort_heapsort(arr, count, less);
+			return;
+		}
+		depth--;
+
+		size_t p = _sort_partition(arr, count, less);
+
+		if(p < count - p - 1)
+		{
+			_sort_introsort(arr, p, depth, less);
+			arr += p + 1;
+			count -= p + 1;
+		}
+		else
+		{
+			_sort_introsort(arr + p + 1, count - p - 1, depth, less);
+			count = p;
+		}
+	}
+
+	_sort_insertion(arr, count, less);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Sorts an array with introsort. Like sort_generic, but the compare function is inlined.
+ *
+ * @param arr			Pointer to the array.
+ * @param count			Number of elements.
+ * @param less			Function object that returns true if the first element is before the second element.
+ */
+template<typename T, typename Less = sort_less_t<T> >
+void sort_introsort(T* arr, size_t count, Less less = Less())
+{
+	if(arr == NULL)
+		return;
+
+	_sort_introsort(arr, count, _sort_depth(count), less);
+}
+
+/**
+ * @brief Moves element k to the position it would have in the sorted array. Like sort_select_generic, but the compare
+ * function is inlined.
+ *
+ * @param arr			Pointer to the array.
+ * @param count			Number of elements, must be at least 1.
+ * @param k				Index of the element. Is limited to count - 1.
+ * @param less			Function object that returns true if the first element is before the second element.
+ * @return				Reference to element k.
+ */
+template<typename T, typename Less = sort_less_t<T> >
+T& sort_nth_element(T* arr, size_t count, size_t k, Less less = Less())
+{
+	uint8_t depth = _sort_depth(count);
+
+	if(k >= count)
+		k = count - 1;
+
+	T& element = arr[k];
+
+	while(count > _sort_insertion_threshold)
+	{
+		if(depth == 0)
+		{
+			_sort_heapsort(arr, count, less);
+			return element;
+		}
+		depth--;
+
+		size_t p = _sort_partition(arr, count, less);
+		if(k == p)
+			return element;
+
+		if(k < p)
+			count = p;
+		else
+		{
+			arr += p + 1;
+			count -= p + 1;
+			k -= p + 1;
+		}
+	}
+
+	_sort_insertion(arr, count, less);
+	return element;
+}
+
+#endif /* SORT_HPP_ */
@@ -0,0 +1,261 @@
+/**
+ * 	@file 	sort_typed.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief
+ *			Internal file that is included by sort.c once for each element type. It creates the introsort, the
+ *			selection and optionally the radix sort for the type, so the comparison is a single instruction instead of
+ *			a function call.
+ *
+ *			Needs the following definitions before it is included:
+ *			- SORT_TYPE: Type of the elements, e.g. uint32_t.
+ *			- SORT_SUFFIX: Suffix of the function names, e.g. uint32.
+ *			- SORT_RADIX_KEY_TYPE: Optional, unsigned type with the same size for the radix sort.
+ *			- SORT_RADIX_SIGN_BIT: Optional, sign bit that is inverted in the radix key of signed types.
+ *
+ *	@version	1.00 (18.10.2026)
+ *		- Initial release
+ *
+ ******************************************************************************/
+
+#define SORT_CONCAT_(a, b)			a##b
+#define SORT_CONCAT(a, b)			SORT_CONCAT_(a, b)
+/// Appends the type suffix to a function name.
+#define SORT_NAME(name)				SORT_CONCAT(name, SORT_SUFFIX)
+
+static void SORT_NAME(_sort_insertion_)(SORT_TYPE* arr, size_t count)
+{
+	size_t i, j;
+
+	for(i = 1; i < count; i++)
+	{
+		SORT_TYPE v = arr[i];
+
+		for(j = i; j > 0 && v < arr[j - 1]; j--)
+			arr[j] = arr[j - 1];
+
+		arr[j] = v;
+	}
+}
+
+static void SORT_NAME(_sort_sift_down_)(SORT_TYPE* arr, size_t i, size_t count)
+{
+	SORT_TYPE v = arr[i];
+	size_t child;
+
+	while((child = 2 * i + 1) < count)
+	{
+		if(child + 1 < count && arr[child] < arr[child + 1])
+			child++;
+
+		if(!(v < arr[child]))
+			break;
+
+		arr[i] = arr[child];
+		i = child;
+	}
+	arr[i] = v;
+}
+
+static void SORT_NAME(_sort_heapsort_)(SORT_TYPE* arr, size_t count)
+{
+	size_t i;
+	SORT_TYPE tmp;
+
+	for(i = count / 2; i > 0; i--)
+		SORT_NAME(_sort_sift_down_)(arr, i - 1, count);
+
+	for(i = count - 1; i > 0; i--)
+	{
+		tmp = arr[0];
+		arr[0] = arr[i];
+		arr[i] = tmp;
+		SORT_NAME(_sort_sift_down_)(arr, 0, i);
+	}
+}
+
+static size_t SORT_NAME(_sort_partition_)(SORT_TYPE* arr, size_t count)
+{
+	size_t mid = count / 2;
+	size_t i = 0;
+	size_t j = count;
+	SORT_TYPE pivot, tmp;
+
+	// Median of three: Afterwards arr[0] <= arr[mid] <= arr[count - 1]
+	if(arr[mid] < arr[0])				{ tmp = arr[mid]; arr[mid] = arr[0]; arr[0] = tmp; }
+	if(arr[count - 1] < arr[mid])
+	{
+		tmp = arr[mid]; arr[mid] = arr[count - 1]; arr[count - 1] = tmp;
+		if(arr[mid] < arr[0])			{ tmp = arr[mid]; arr[mid] = arr[0]; arr[0] = tmp; }
+	}
+
+	// The median is the pivot at arr[0]. The last element is not smaller, so the first scan stops there.
+	pivot = arr[mid];
+	arr[mid] = arr[0];
+	arr[0] = pivot;
+
+	for(;;)
+	{
+		do i++; while(arr[i] < pivot);
+		do j--; while(pivot < arr[j]);
+
+		if(i >= j)
+			break;
+
+		tmp = arr[i];
+		arr[i] = arr[j];
+		arr[j] = tmp;
+	}
+
+	arr[0] = arr[j];
+	arr[j] = pivot;
+	return j;
+}
+
+static void SORT_NAME(_sort_introsort_)(SORT_TYPE* arr, size_t count, uint8_t depth)
+{
+	size_t p;
+
+	while(count > SORT_INSERTION_THRESHOLD)
+	{
+		// Too many bad pivots, heapsort limits the worst case to O(n log n).
+		if(depth == 0)
+		{
+			SORT_NAME(_sort_heapsort_)(arr, count);
+			return;
+		}
+		depth--;
+
+		p = SORT_NAME(_sort_partition_)(arr, count);
+
+		// Only the smaller part is sorted recursively, so the stack depth is limited to log2(count).
+		if(p < count - p - 1)
+		{
+			SORT_NAME(_sort_introsort_)(arr, p, depth);
+			arr += p + 1;
+			count -= p + 1;
+		}
+		else
+		{
+			SORT_NAME(_sort_introsort_)(arr + p + 1, count - p - 1, depth);
+			count = p;
+		}
+	}
+
+	SORT_NAME(_sort_insertion_)(arr, count);
+}
+
+void SORT_NAME(sort_)(SORT_TYPE* arr, size_t count)
+{
+	if(arr == NULL)
+		return;
+
+	SORT_NAME(_sort_introsort_)(arr, count, _sort_depth_limit(count));
+}
+
+SORT_TYPE SORT_NAME(sort_select_)(SORT_TYPE* arr, size_t count, size_t k)
+{
+	SORT_TYPE* element;
+	uint8_t depth = _sort_depth_limit(count);
+	size_t p;
+
+	if(arr == NULL || count == 0)
+		return 0;
+
+	if(k >= count)
+		k = count - 1;
+
+	element = &arr[k];
+
+	while(count > SORT_INSERTION_THRESHOLD)
+	{
+		if(depth == 0)
+		{
+			SORT_NAME(_sort_heapsort_)(arr, count);
+			return *element;
+		}
+		depth--;
+
+		// Only the part that contains k is partitioned further.
+		p = SORT_NAME(_sort_partition_)(arr, count);
+		if(k == p)
+			return *element;
+
+		if(k < p)
+			count = p;
+		else
+		{
+			arr += p + 1;
+			count -= p + 1;
+			k -= p + 1;
+		}
+	}
+
+	SORT_NAME(_sort_insertion_)(arr, count);
+	return *element;
+}
+
+#ifdef SORT_RADIX_KEY_TYPE
+
+void SORT_NAME(sort_radix_)(SORT_TYPE* arr, SORT_TYPE* tmp, size_t count)
+{
+	size_t histogram[256];
+	SORT_TYPE* src = arr;
+	SORT_TYPE* dst = tmp;
+	SORT_TYPE* swap;
+	size_t i, sum, c;
+	uint8_t shift;
+
+	if(arr == NULL)
+		return;
+
+	if(tmp == NULL || count < SORT_RADIX_THRESHOLD)
+	{
+		SORT_NAME(sort_)(arr, count);
+		return;
+	}
+
+	// The sign bit is inverted, so negative values are sorted before positive values.
+#define SORT_RADIX_DIGIT(v)		((uint8_t)(((SORT_RADIX_KEY_TYPE)(v) ^ (SORT_RADIX_KEY_TYPE)(SORT_RADIX_SIGN_BIT)) >> shift))
+
+	for(shift = 0; shift < sizeof(SORT_TYPE) * 8; shift += 8)
+	{
+		memset(histogram, 0, sizeof(histogram));
+		for(i = 0; i < count; i++)
+			histogram[SORT_RADIX_DIGIT(src[i])]++;
+
+		// All values have the same digit, this pass would not change the order.
+		if(histogram[SORT_RADIX_DIGIT(src[0])] == count)
+			continue;
+
+		for(i = 0, sum = 0; i < 256; i++)
+		{
+			c = histogram[i];
+			histogram[i] = sum;
+			sum += c;
+		}
+
+		for(i = 0; i < count; i++)
+			dst[histogram[SORT_RADIX_DIGIT(src[i])]++] = src[i];
+
+		swap = src;
+		src = dst;
+		dst = swap;
+	}
+
+#undef SORT_RADIX_DIGIT
+
+	if(src != arr)
+		memcpy(arr, src, count * sizeof(SORT_TYPE));
+}
+
+#endif
+
+#undef SORT_TYPE
+#undef SORT_SUFFIX
+#undef SORT_RADIX_KEY_TYPE
+#undef SORT_RADIX_SIGN_BIT
+#undef SORT_NAME
+#undef SORT_CONCAT
+#undef SORT_CONCAT_
@@ -18,6 +18,19 @@
 // Internal definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/// Returns the character c as uint8_t, folded to lower case if ignore_case is true.
+#define STRING_FOLD(c, ignore_case)		((ignore_case) ? string_fold_table[(uint8_t)(c)] : (uint8_t)(c))
+
+#if STRING_USE_SIMD && defined(__SSE2__)
+/// The hex conversion of arrays converts 16 bytes per step with SSE2, which every x86-64 cpu supports.
+#define _STRING_USE_SSE2				1
+#include <emmintrin.h>
+#elif STRING_USE_SIMD && defined(__ARM_NEON)
+/// The hex conversion of arrays converts 16 bytes per step with NEON.
+#define _STRING_USE_NEON				1
+#include <arm_neon.h>
+#endif
+
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal structures and enums
@@ -32,6 +45,86 @@
 /// Set to 'a' if an hex lower letter is used for conversion.
 static char string_hex_char = 'A';
 
+/// Two characters for each value from 0 to 99. Is used to convert two decimal digits with one division.
+static const char string_digits_dec[201] =
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+/// Two characters for each byte value with upper hex letters.
+static const char string_digits_hex_upper[513] =
+	"000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+	"202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+	"404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+	"606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+	"808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+	"A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+	"C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+	"E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+/// Two characters for each byte value with lower hex letters.
+static const char string_digits_hex_lower[513] =
+	"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+/// Powers of 10 for counting the decimal digits.
+static const uint64_t string_pow10[20] =
+{
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+	10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+	10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+/// ASCII letters folded to lower case, all other bytes are unchanged. Is used by the case-insensitive substring search.
+static const uint8_t string_fold_table[256] =
+{
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+	0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F,
+	0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+	0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C, 0x7D, 0x7E, 0x7F,
+	0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+	0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+	0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+	0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE, 0xBF,
+	0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF,
+	0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
+	0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+	0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
+};
+
+/// Value of each hex character or 0x80 for all other bytes. Invalid characters are detected by combining all values with OR.
+static const uint8_t string_hex_values[256] =
+{
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
 static char string_thousand_separator = '.';
 
 static char string_decimal_point = ',';
@@ -70,6 +163,17 @@ static void string_printf_puts(char* str, char* str2, uint16_t len);
 
 #endif
 
+#if _STRING_USE_NEON
+/**
+ * @brief	Converts 16 hex characters into their values.
+ *
+ * @param c						Characters.
+ * @param valid					Bytes are cleared for characters that are no hex characters.
+ * @return						Values 0 - 15.
+ */
+static inline uint8x16_t string_neon_hex_nibbles(uint8x16_t c, uint8x16_t* valid);
+#endif
+
 /**
  *  Creates an integer string from an an unsigned integer 32-bit value.
  *
@@ -100,6 +204,53 @@ static char* string_internal_create_int_string(char* str, uint32_t uval, uint8_t
  **/
 static char* string_internal_create_int64_string(char* str, uint64_t uval, uint8_t base, uint8_t min_letters, bool add_leading_zero, bool add_minus);
 
+/**
+ *  Returns the number of digits of a value. For base 10 and 16 the number of bits is used to estimate the digits instead
+ *  of dividing the value.
+ *
+ * @param uval                  Value.
+ * @param base                  Base of the number.
+ * @return                      Number of digits, at least 1.
+ **/
+static uint8_t string_internal_get_digit_count(uint64_t uval, uint8_t base);
+
+/**
+ *  Adds the padding and the minus in front of a number.
+ *
+ * @param str                   Pointer to a buffer where the string will be written to.
+ * @param len                   Number of digits of the number.
+ * @param min_letters           Minimum number of characters that must be shown.
+ * @param add_leading_zero      true: Leading 0 will be added, false: Spaces will be added.
+ * @param add_minus             true: A minus will be added right before the num string.
+ * @return                      Pointer to the address where the first digit is written to.
+ **/
+static char* string_internal_add_padding(char* str, uint8_t len, uint8_t min_letters, bool add_leading_zero, bool add_minus);
+
+/**
+ *  Writes the digits of a 32-bit value backwards, ending before end. Base 10 and 16 convert two digits per step using
+ *  string_digits_dec and string_digits_hex_*.
+ *
+ * @param end                   Pointer behind the last digit.
+ * @param uval                  Value that is converted.
+ * @param base                  Base of the number.
+ * @param min_digits            Minimum number of digits. Missing digits are filled with 0.
+ **/
+static void string_internal_write_digits(char* end, uint32_t uval, uint8_t base, uint8_t min_digits);
+
+/**
+ *  Searches find inside str with the Two-Way algorithm of Crochemore and Perrin, which needs less than 2 * str_len
+ *  comparisons in the worst case and only constant memory. The last character of each window is checked first and a
+ *  Horspool shift table skips windows that cannot match, so most characters of str are never compared.
+ *
+ * @param str                   Pointer to the string that is searched.
+ * @param str_len               Length of str.
+ * @param find                  Pointer to the string that is searched for.
+ * @param find_len              Length of find, must be at least 1.
+ * @param ignore_case           true: ASCII letters are compared without case.
+ * @return                      Pointer to the first occurrence of find or NULL if find is not part of str.
+ **/
+static const char* string_internal_find(const char* str, size_t str_len, const char* find, size_t find_len, bool ignore_case);
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -370,56 +521,36 @@ int16_t string_find_first_int(char *str)
 
 int16_t string_index_of_substring(const char *str, char *str_to_find)
 {
-    uint16_t i;
-    uint16_t inside_index = 0;
-    uint16_t str_len = strlen(str);
-    uint16_t str_to_find_len = strlen(str_to_find);
+    const char* ptr;
 
-    for(i=0; i < str_len; i++)
-    {
-        if(str[i] == str_to_find[inside_index])
-        {
-            inside_index++;
+    if(str == NULL || str_to_find == NULL || str_to_find[0] == 0)
+        return -1;
 
-            if(str_to_find_len == inside_index) // Last character is the same
-                return (i - inside_index + 1);
-        }
-        else
-            inside_index = 0;
-    }
+    ptr = string_internal_find(str, strlen(str), str_to_find, strlen(str_to_find), false);
 
-    return -1;
+    if(ptr == NULL || ptr - str > INT16_MAX)
+        return -1;
+
+    return (int16_t)(ptr - str);
 }
 
 uint16_t string_extract_between(char *str,
                                 char *target_str, uint16_t target_str_len,
                                 char extract_tag_begin, char extract_tag_end)
 {
-    uint8_t step = 0;
-    uint16_t str_len = strlen(str);
     uint16_t real_target_str_len = 0;
-    uint16_t tmp_str_len = 0;
 
-    while(tmp_str_len < str_len && real_target_str_len < target_str_len)
-    {
-        switch(step)
-        {
-        case 0:
-            if(str[tmp_str_len] == extract_tag_begin)
-                step++;
-        break;
+    // strchr does not need the length of the string and is vectorized in most C libraries.
+    if(extract_tag_begin != 0)
+        str = strchr(str, extract_tag_begin);
+    else
+        str = NULL;
 
-        case 1:
-            if(str[tmp_str_len] == extract_tag_end)
-            {
-                target_str[real_target_str_len] = 0;
-                return real_target_str_len;
-            }
-            target_str[real_target_str_len] = str[tmp_str_len];
-            real_target_str_len++;
-        break;
-        }
-        tmp_str_len++;
+    if(str != NULL)
+    {
+        str++;
+        while(*str != 0 && *str != extract_tag_end && real_target_str_len < target_str_len)
+            target_str[real_target_str_len++] = *str++;
     }
 
     if(real_target_str_len < target_str_len)
@@ -531,14 +662,155 @@ bool string_parse_hex_array(const char* str, uint8_t* v, uint16_t v_len)
 	if(str == NULL || v == NULL || v_len == 0)
 		return false;
 
-	for(int i = 0; i < v_len; i++, str+=2)
+	// The string is decoded in blocks, so it must not end before 2 * v_len characters.
+	if(memchr(str, 0, 2 * (size_t)v_len) != NULL)
+		return false;
+
+	return string_decode_hex_array(str, 2 * (size_t)v_len, v);
+}
+
+bool string_decode_hex_array(const char* str, size_t str_len, uint8_t* v)
+{
+	const uint8_t* s = (const uint8_t*)str;
+	size_t num = str_len / 2;
+	size_t i = 0;
+	uint8_t invalid = 0;
+
+	if(str == NULL || v == NULL || (str_len & 1))
+		return false;
+
+#if _STRING_USE_SSE2
 	{
-		if(str[0] == 0 || str[1] == 0)
+		const __m128i lower = _mm_set1_epi8(0x20);
+		const __m128i low_byte = _mm_set1_epi16(0x00FF);
+		__m128i valid = _mm_set1_epi8(-1);
+		__m128i c, l, is_digit, is_letter, nibbles, bytes;
+
+		for(; i + 8 <= num; i += 8)
+		{
+			c = _mm_loadu_si128((const __m128i*)&s[2 * i]);
+			// Letters are folded to lower case. Digits already have the bit 0x20 set, so they are not changed.
+			l = _mm_or_si128(c, lower);
+			// Signed compare, bytes above 0x7F are negative and therefore invalid.
+			is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+			is_letter = _mm_and_si128(_mm_cmpgt_epi8(l, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(l, _mm_set1_epi8('f' + 1)));
+			valid = _mm_and_si128(valid, _mm_or_si128(is_digit, is_letter));
+
+			nibbles = _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+									_mm_and_si128(is_letter, _mm_sub_epi8(l, _mm_set1_epi8('a' - 10))));
+			// Each 16-bit lane contains the high nibble in the lower byte and the low nibble in the upper byte.
+			bytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, low_byte), 4), _mm_srli_epi16(nibbles, 8));
+			_mm_storel_epi64((__m128i*)&v[i], _mm_packus_epi16(bytes, bytes));
+		}
+
+		if(_mm_movemask_epi8(valid) != 0xFFFF)
 			return false;
+	}
+#elif _STRING_USE_NEON
+	{
+		uint8x16_t valid = vdupq_n_u8(0xFF);
+		uint8x16x2_t c;
+		uint8x8_t valid_half;
 
-		v[i] = (string_ascii_to_uint8(str[0]) << 4) + string_ascii_to_uint8(str[1]);
+		for(; i + 16 <= num; i += 16)
+		{
+			// Loads 32 characters, val[0] contains the high and val[1] the low characters of 16 bytes.
+			c = vld2q_u8(&s[2 * i]);
+			vst1q_u8(&v[i], vorrq_u8(vshlq_n_u8(string_neon_hex_nibbles(c.val[0], &valid), 4), string_neon_hex_nibbles(c.val[1], &valid)));
+		}
+
+		valid_half = vand_u8(vget_low_u8(valid), vget_high_u8(valid));
+		if(vget_lane_u64(vreinterpret_u64_u8(valid_half), 0) != UINT64_MAX)
+			return false;
+	}
+#endif
+
+	// All values are combined, so the loop does not need a branch for each character.
+	for(; i < num; i++)
+	{
+		uint8_t high = string_hex_values[s[2 * i]];
+		uint8_t low = string_hex_values[s[2 * i + 1]];
+		invalid |= high | low;
+		v[i] = (uint8_t)((high << 4) | (low & 0x0F));
 	}
-	return true;
+
+	return (invalid & 0x80) == 0;
+}
+
+char* string_create_hex_array_string(char* str, const uint8_t* v, size_t v_len, char separator)
+{
+	const char* digits = (string_hex_char == 'a') ? string_digits_hex_lower : string_digits_hex_upper;
+	size_t i = 0;
+
+	if(str == NULL)
+		return NULL;
+
+	if(v == NULL || v_len == 0)
+	{
+		*str = 0;
+		return str;
+	}
+
+	if(separator)
+	{
+		for(i = 0; i < v_len; i++, str += 3)
+		{
+			memcpy(str, &digits[v[i] * 2], 2);
+			str[2] = separator;
+		}
+		// There is no separator behind the last byte.
+		*--str = 0;
+		return str;
+	}
+
+#if _STRING_USE_SSE2
+	{
+		const __m128i mask = _mm_set1_epi8(0x0F);
+		const __m128i nine = _mm_set1_epi8(9);
+		const __m128i zero_char = _mm_set1_epi8('0');
+		// Distance from '0' + 10 to the letter 'A' or 'a'.
+		const __m128i letter_offset = _mm_set1_epi8(string_hex_char - '0' - 10);
+		__m128i b, high, low;
+
+		for(; i + 16 <= v_len; i += 16, str += 32)
+		{
+			b = _mm_loadu_si128((const __m128i*)&v[i]);
+			high = _mm_and_si128(_mm_srli_epi16(b, 4), mask);
+			low = _mm_and_si128(b, mask);
+			high = _mm_add_epi8(_mm_add_epi8(high, zero_char), _mm_and_si128(_mm_cmpgt_epi8(high, nine), letter_offset));
+			low = _mm_add_epi8(_mm_add_epi8(low, zero_char), _mm_and_si128(_mm_cmpgt_epi8(low, nine), letter_offset));
+			_mm_storeu_si128((__m128i*)str, _mm_unpacklo_epi8(high, low));
+			_mm_storeu_si128((__m128i*)(str + 16), _mm_unpackhi_epi8(high, low));
+		}
+	}
+#elif _STRING_USE_NEON
+	{
+		const uint8x16_t mask = vdupq_n_u8(0x0F);
+		const uint8x16_t nine = vdupq_n_u8(9);
+		const uint8x16_t zero_char = vdupq_n_u8('0');
+		// Distance from '0' + 10 to the letter 'A' or 'a'.
+		const uint8x16_t letter_offset = vdupq_n_u8(string_hex_char - '0' - 10);
+		uint8x16_t b;
+		uint8x16x2_t out;
+
+		for(; i + 16 <= v_len; i += 16, str += 32)
+		{
+			b = vld1q_u8(&v[i]);
+			out.val[0] = vshrq_n_u8(b, 4);
+			out.val[1] = vandq_u8(b, mask);
+			out.val[0] = vaddq_u8(vaddq_u8(out.val[0], zero_char), vandq_u8(vcgtq_u8(out.val[0], nine), letter_offset));
+			out.val[1] = vaddq_u8(vaddq_u8(out.val[1], zero_char), vandq_u8(vcgtq_u8(out.val[1], nine), letter_offset));
+			// Stores the high and low characters interleaved.
+			vst2q_u8((uint8_t*)str, out);
+		}
+	}
+#endif
+
+	for(; i < v_len; i++, str += 2)
+		memcpy(str, &digits[v[i] * 2], 2);
+
+	*str = 0;
+	return str;
 }
 
 char string_to_lower(char letter)
@@ -565,12 +837,10 @@ char* string_create_int_string(char* str, int32_t val, uint8_t base, uint8_t min
     bool add_minus = false;
 
     if(val < 0)
-    {
         add_minus = true;
-        val *= -1;
-    }
 
-    return string_internal_create_int_string(str, (uint32_t)val, base, min_letters, add_leading_zero, add_minus);
+    // Negation as unsigned, so INT32_MIN does not overflow
+    return string_internal_create_int_string(str, add_minus ? 0U - (uint32_t)val : (uint32_t)val, base, min_letters, add_leading_zero, add_minus);
 }
 
 char* string_create_uint64_string(char* str, uint64_t val, uint8_t base, uint8_t min_letters, bool add_leading_zero)
@@ -583,12 +853,10 @@ char* string_create_int64_string(char* str, int64_t val, uint8_t base, uint8_t m
     bool add_minus = false;
 
     if(val < 0)
-    {
         add_minus = true;
-        val *= -1;
-    }
 
-    return string_internal_create_int64_string(str, (uint64_t)val, base, min_letters, add_leading_zero, add_minus);
+    // Negation as unsigned, so INT64_MIN does not overflow
+    return string_internal_create_int64_string(str, add_minus ? 0ULL - (uint64_t)val : (uint64_t)val, base, min_letters, add_leading_zero, add_minus);
 }
 
 #if !STRING_USE_COMM_MINIMUM
@@ -734,42 +1002,39 @@ int string_strncasecmp(const char *s1, const char* s2, uint16_t len)
 
 char* string_strcasestr(const char *s, const char *find)
 {
-    char sc;
-    uint16_t len;
-    char c;
-
     if(s == NULL || find == NULL || find[0] == 0)
         return NULL;
 
-    if ((c = *find++) != 0) {
-        c = (char)string_to_lower((unsigned char)c);
-        len = strlen(find);
-        do {
-            do {
-                if ((sc = *s++) == 0)
-                    return (NULL);
-            } while ((char)string_to_lower((unsigned char)sc) != c);
-        } while (string_strncasecmp(s, find, len) != 0);
-        s--;
-    }
-    return ((char *)s);
+    return (char*)string_internal_find(s, strlen(s), find, strlen(find), true);
 }
 
 char* string_strstr_end(const char* haystack, const char* needle)
 {
+    size_t needle_len;
+    const char* ptr;
+
     if(haystack == NULL || needle == NULL || needle[0] == 0)
         return NULL;
 
-    char* ptr = strstr(haystack, needle);
+    needle_len = strlen(needle);
+    ptr = string_internal_find(haystack, strlen(haystack), needle, needle_len, false);
 
 //  DBG_VERBOSE("string_strstr_end(%s, %s) -> %s\n", haystack, needle, ptr ? ptr : NULL);
 
     if(ptr)
-        return ptr + strlen(needle);
+        return (char*)ptr + needle_len;
 
     return NULL;
 }
 
+char* string_find_substring(const char* str, size_t str_len, const char* find, size_t find_len, bool ignore_case)
+{
+    if(str == NULL || find == NULL || find_len == 0)
+        return NULL;
+
+    return (char*)string_internal_find(str, str_len, find, find_len, ignore_case);
+}
+
 bool string_is_valid_num_array(const char* str, char* min, char* max, uint16_t max_entries, bool is_hex)
 {
     if(str == NULL)
@@ -1472,6 +1737,20 @@ FUNCTION_RETURN string_unescape(const char *src, size_t src_len, char *dest, siz
 // Internal Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#if _STRING_USE_NEON
+static inline uint8x16_t string_neon_hex_nibbles(uint8x16_t c, uint8x16_t* valid)
+{
+	// The subtraction wraps around for smaller characters, so a single unsigned compare checks the range.
+	uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+	uint8x16_t letter = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+	uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+	uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+
+	*valid = vandq_u8(*valid, vorrq_u8(is_digit, is_letter));
+	return vorrq_u8(vandq_u8(is_digit, digit), vandq_u8(is_letter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+#endif
+
 #if STRING_BUILD_PRINTF
 
 static void string_printf_putc(char* str, int ch)
@@ -1502,41 +1781,91 @@ static void string_printf_puts(char* str, char* str2, uint16_t len)
 
 static char* string_internal_create_int_string(char* str, uint32_t uval, uint8_t base, uint8_t min_letters, bool add_leading_zero, bool add_minus)
 {
-    uint8_t len = 10;
-    uint32_t max_val = 1000000000;
+    uint8_t len = string_internal_get_digit_count(uval, base);
+
+    str = string_internal_add_padding(str, len, min_letters, add_leading_zero, add_minus);
+    str += len;
+    string_internal_write_digits(str, uval, base, len);
+    *str = 0;
+
+    return str;
+}
+
+static char* string_internal_create_int64_string(char* str, uint64_t uval, uint8_t base, uint8_t min_letters, bool add_leading_zero, bool add_minus)
+{
+    uint8_t len;
+    char* end;
+
+    // 64-bit divisions are slow on 32-bit controllers, so small values use the 32-bit conversion.
+    if(uval <= UINT32_MAX)
+        return string_internal_create_int_string(str, (uint32_t)uval, base, min_letters, add_leading_zero, add_minus);
+
+    len = string_internal_get_digit_count(uval, base);
+    str = string_internal_add_padding(str, len, min_letters, add_leading_zero, add_minus);
+    str += len;
+    end = str;
 
     switch(base)
     {
-        case 2:
-            len = 32;
-            max_val = 0x80000000;
-        break;
-
         case 10:
-            len = 10;
-            max_val = 1000000000;
+            // Parts of 9 digits fit into 32-bit, so at most two 64-bit divisions are needed.
+            while(uval > UINT32_MAX)
+            {
+                string_internal_write_digits(end, (uint32_t)(uval % 1000000000), 10, 9);
+                uval /= 1000000000;
+                end -= 9;
+            }
         break;
 
         case 16:
-            len = 8;
-            max_val = 0x10000000;
+            string_internal_write_digits(end, (uint32_t)uval, 16, 8);
+            uval >>= 32;
+            end -= 8;
+        break;
+
+        default:
+            while(uval > UINT32_MAX)
+            {
+                *--end = string_uint8_to_ascii(uval % base);
+                uval /= base;
+            }
         break;
     }
 
-    for(; len > 0; len--)
-    {
-        if(uval >= max_val)
-            break;
+    string_internal_write_digits(end, (uint32_t)uval, base, 1);
+    *str = 0;
 
-        max_val /= base;
-    }
+    return str;
+}
 
-    if(len == 0)
+static uint8_t string_internal_get_digit_count(uint64_t uval, uint8_t base)
+{
+    uint8_t bits = 64 - __builtin_clzll(uval | 1);
+    uint8_t len;
+
+    switch(base)
     {
-        len = 1;
-        max_val = 1;
+        case 2:
+            return bits;
+
+        case 10:
+            // bits * log10(2) is the number of digits or one less. 0 still needs one digit.
+            len = (bits * 1233) >> 12;
+            len += (uval >= string_pow10[len]);
+            return len ? len : 1;
+
+        case 16:
+            return (bits + 3) / 4;
+
+        default:
+            for(len = 1; uval >= base; len++)
+                uval /= base;
+            return len;
     }
+}
 
+static char* string_internal_add_padding(char* str, uint8_t len, uint8_t min_letters, bool add_leading_zero, bool add_minus)
+{
     if(min_letters > 0 && min_letters > (len + add_minus))
     {
         min_letters -= (len + add_minus);
@@ -1547,101 +1876,214 @@ static char* string_internal_create_int_string(char* str, uint32_t uval, uint8_t
             add_minus = false;
         }
 
-        while(min_letters > 0)
-        {
-            if(add_leading_zero)
-                *str++ = '0';       // Add leading 0
-            else
-                *str++ = ' ';       // Add Space
-            min_letters--;
-        }
+        memset(str, add_leading_zero ? '0' : ' ', min_letters);     // Add leading 0 or spaces
+        str += min_letters;
     }
 
     if(add_minus)
         *str++ = '-';
 
-    while(len > 0)
-    {
-        *str++ = string_uint8_to_ascii((uval / max_val) % base);
-        max_val /= base;
-        len--;
-    }
-
-    *str = 0;
-
     return str;
 }
 
-static char* string_internal_create_int64_string(char* str, uint64_t uval, uint8_t base, uint8_t min_letters, bool add_leading_zero, bool add_minus)
+static void string_internal_write_digits(char* end, uint32_t uval, uint8_t base, uint8_t min_digits)
 {
-    uint8_t len = 20;
-    uint64_t max_val = 10000000000000000000ULL;
+    char* start = end - min_digits;
+    const char* digits;
+    uint32_t i;
 
     switch(base)
     {
-        case 2:
-            len = 64;
-            max_val = 0x8000000000000000;
-        break;
-
         case 10:
-            len = 20;
-            max_val = 10000000000000000000ULL;
+            while(uval >= 100)
+            {
+                i = (uval % 100) * 2;
+                uval /= 100;
+                *--end = string_digits_dec[i + 1];
+                *--end = string_digits_dec[i];
+            }
+
+            if(uval >= 10)
+            {
+                *--end = string_digits_dec[uval * 2 + 1];
+                *--end = string_digits_dec[uval * 2];
+            }
+            else
+                *--end = '0' + uval;
         break;
 
         case 16:
-            len = 16;
-            max_val = 0x1000000000000000;
+            digits = (string_hex_char == 'a') ? string_digits_hex_lower : string_digits_hex_upper;
+
+            while(uval >= 0x100)
+            {
+                i = (uval & 0xFF) * 2;
+                uval >>= 8;
+                *--end = digits[i + 1];
+                *--end = digits[i];
+            }
+
+            *--end = digits[uval * 2 + 1];
+            if(uval >= 0x10)
+                *--end = digits[uval * 2];
+        break;
+
+        default:
+            do
+            {
+                *--end = string_uint8_to_ascii(uval % base);
+                uval /= base;
+            }while(uval > 0);
         break;
     }
 
-    for(; len > 0; len--)
-    {
-        if(uval >= max_val)
-            break;
+    while(end > start)
+        *--end = '0';
+}
 
-        max_val /= base;
-    }
+static const char* string_internal_find(const char* str, size_t str_len, const char* find, size_t find_len, bool ignore_case)
+{
+    const uint8_t* h = (const uint8_t*)str;
+    const uint8_t* h_end = h + str_len;
+    const uint8_t* n = (const uint8_t*)find;
+    uint8_t shift[256];
+    size_t ip, jp, k, p, p0, ms, mem, mem0;
 
-    if(len == 0)
+    if(find_len > str_len)
+        return NULL;
+
+    if(!ignore_case || string_fold_table[n[0]] < 'a' || string_fold_table[n[0]] > 'z')
     {
-        len = 1;
-        max_val = 1;
+        // The first character has only one case, so memchr can skip to the first possible match. memchr is
+        // vectorized in most C libraries.
+        h = memchr(h, n[0], str_len - find_len + 1);
+        if(h == NULL || find_len == 1)
+            return (const char*)h;
+    }
+    else if(find_len == 1)
+    {
+        for(; h < h_end; h++)
+        {
+            if(string_fold_table[*h] == string_fold_table[n[0]])
+                return (const char*)h;
+        }
+        return NULL;
     }
 
-    if(min_letters > 0 && min_letters > (len + add_minus))
+    // Distance of the last occurrence of each character to the end of find, limited to 255 to keep the table small.
+    // A smaller shift is always safe.
+    memset(shift, find_len < 255 ? find_len : 255, sizeof(shift));
+    for(k = 0; k < find_len; k++)
+        shift[STRING_FOLD(n[k], ignore_case)] = (find_len - 1 - k) < 255 ? (find_len - 1 - k) : 255;
+
+    // Maximal suffix of find for the "<" order. ip starts at -1 and wraps, so ip + k is the index k - 1.
+    ip = (size_t)-1; jp = 0; k = p = 1;
+    while(jp + k < find_len)
     {
-        min_letters -= (len + add_minus);
+        uint8_t a = STRING_FOLD(n[ip + k], ignore_case);
+        uint8_t b = STRING_FOLD(n[jp + k], ignore_case);
 
-        if(add_leading_zero && add_minus)
+        if(a == b)
         {
-            *str++ = '-';
-            add_minus = false;
+            if(k == p)
+            {
+                jp += p;
+                k = 1;
+            }
+            else
+                k++;
+        }
+        else if(a > b)
+        {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else
+        {
+            ip = jp++;
+            k = p = 1;
         }
+    }
+    ms = ip;
+    p0 = p;
+
+    // Maximal suffix for the ">" order. The longer one is the critical factorization.
+    ip = (size_t)-1; jp = 0; k = p = 1;
+    while(jp + k < find_len)
+    {
+        uint8_t a = STRING_FOLD(n[ip + k], ignore_case);
+        uint8_t b = STRING_FOLD(n[jp + k], ignore_case);
 
-        while(min_letters > 0)
+        if(a == b)
         {
-            if(add_leading_zero)
-                *str++ = '0';       // Add leading 0
+            if(k == p)
+            {
+                jp += p;
+                k = 1;
+            }
             else
-                *str++ = ' ';       // Add Space
-            min_letters--;
+                k++;
+        }
+        else if(a < b)
+        {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else
+        {
+            ip = jp++;
+            k = p = 1;
         }
     }
+    if(ip + 1 > ms + 1)
+        ms = ip;
+    else
+        p = p0;
 
-    if(add_minus)
-        *str++ = '-';
-
-    while(len > 0)
+    // If the left half is repeated with the period, the matched part of a window is remembered in mem when shifting
+    // by the period. Otherwise a shift by the larger half is safe.
+    for(k = 0; k < ms + 1 && STRING_FOLD(n[k], ignore_case) == STRING_FOLD(n[k + p], ignore_case); k++);
+    if(k < ms + 1)
     {
-        *str++ = string_uint8_to_ascii((uval / max_val) % base);
-        max_val /= base;
-        len--;
+        mem0 = 0;
+        p = (ms > find_len - ms - 1 ? ms : find_len - ms - 1) + 1;
     }
+    else
+        mem0 = find_len - p;
+    mem = 0;
 
-    *str = 0;
+    while((size_t)(h_end - h) >= find_len)
+    {
+        // Check the last character of the window first
+        k = shift[STRING_FOLD(h[find_len - 1], ignore_case)];
+        if(k)
+        {
+            h += (k < mem) ? mem : k;
+            mem = 0;
+            continue;
+        }
 
-    return str;
+        // Compare the right half
+        for(k = (ms + 1 > mem) ? ms + 1 : mem; k < find_len && STRING_FOLD(n[k], ignore_case) == STRING_FOLD(h[k], ignore_case); k++);
+        if(k < find_len)
+        {
+            h += k - ms;
+            mem = 0;
+            continue;
+        }
+
+        // Compare the left half
+        for(k = ms + 1; k > mem && STRING_FOLD(n[k - 1], ignore_case) == STRING_FOLD(h[k - 1], ignore_case); k--);
+        if(k <= mem)
+            return (const char*)h;
+
+        h += p;
+        mem = mem0;
+    }
+
+    return NULL;
 }
 
 #endif
@@ -8,6 +8,18 @@
  *          Contains helping functions to work with Strings.
  *          Extracted from the old ESoPe convert.c module.
  *
+ *	@version	1.15 (18.10.2026)
+ *	    - Added string_create_hex_array_string and string_decode_hex_array, which convert 16 bytes per step with SSE2
+ *	      or NEON and two characters per byte with a lookup table otherwise
+ *	    - string_parse_hex_array returns false for characters that are no hex characters
+ *	@version	1.14 (18.10.2026)
+ *	    - string_index_of_substring, string_strcasestr and string_strstr_end use the Two-Way algorithm, which is linear
+ *	      in the worst case and skips most characters with a shift table. string_index_of_substring finds matches that
+ *	      start inside a partial match (e.g. "aab" in "aaab").
+ *	    - Added string_find_substring for strings that are not terminated
+ *	@version	1.13 (18.10.2026)
+ *	    - string_create_*_string converts two digits per step for base 10 and 16 and counts the digits from the number
+ *	      of bits. 64-bit values only use 64-bit divisions for the upper digits.
  *	@version	1.12 (19.01.2022)
  * 	    - Modified to be used in esopekernel
  *  @version    1.11 (02.09.2021)
@@ -72,7 +84,12 @@
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /// Version of the string module
-#define STRING_STR_VERSION "1.12"
+#define STRING_STR_VERSION "1.15"
+
+#ifndef STRING_USE_SIMD
+/// Set to true to use SSE2 or NEON for the hex conversion of arrays if the compiler supports it.
+#define STRING_USE_SIMD			true
+#endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Structure
@@ -355,10 +372,32 @@ uint8_t string_ascii_to_uint8(char letter);
  * @param str					ASCII character 0 - F.
  * @param v						Pointer to the array where the value shall be stored.
  * @param v_len					Maximum length of buffer v.
- * @return						true if str has the correct len.
+ * @return						true if str has the correct len and contains only hex characters.
  */
 bool string_parse_hex_array(const char* str, uint8_t* v, uint16_t v_len);
 
+/**
+ * Decodes a hex string with two characters per byte like "01aB" into a byte array. The string does not need to be
+ * terminated. All characters are checked at once after decoding, so the content of v is undefined if false is returned.
+ * @param str					Hex string.
+ * @param str_len				Number of characters in str, must be even.
+ * @param v						Pointer to an array with at least str_len / 2 bytes.
+ * @return						true if str_len is even and str contains only hex characters.
+ */
+bool string_decode_hex_array(const char* str, size_t str_len, uint8_t* v);
+
+/**
+ * Creates a hex string from a byte array like "01AB" or "01 AB" with a separator. Letters are upper or lower case as
+ * set with string_set_hex_letter_size.
+ * @param str					Pointer to a buffer with at least 2 * v_len + 1 characters or 3 * v_len characters if
+ * 								a separator is used.
+ * @param v						Bytes that are converted.
+ * @param v_len					Number of bytes in v.
+ * @param separator				Character that is added between the bytes or 0 for none.
+ * @return						Pointer to the terminating zero.
+ */
+char* string_create_hex_array_string(char* str, const uint8_t* v, size_t v_len, char separator);
+
 /**
  * Returns the lower case character of a letter
  * @param letter        Letter
@@ -487,6 +526,18 @@ char* string_strcasestr(const char *s, const char *find);
  * @return          NULL if needle is not finde inside haystack. If needle is found in haystack, the return value points to the character behind needle.
  */
 char* string_strstr_end(const char* haystack, const char* needle);
+/**
+ * Searches for find in the first str_len bytes of str. The bytes do not need to be terminated and may contain zeros,
+ * so it can be used on receive buffers. Needs 256 bytes of stack for the shift table.
+ *
+ * @param str           Pointer to the data that is searched.
+ * @param str_len       Number of bytes in str.
+ * @param find          Pointer to the bytes that are searched for.
+ * @param find_len      Number of bytes in find.
+ * @param ignore_case   true: ASCII letters are compared without case.
+ * @return              Pointer to the first occurrence of find in str or NULL if find is not part of str or find_len is 0.
+ */
+char* string_find_substring(const char* str, size_t str_len, const char* find, size_t find_len, bool ignore_case);
 /**
  * Checks whether the string is a valid array consisting of numbers.
  *  The array is valid if there are only whitespaces, linefeeds, carriage returns, commas and numbers (hex/dex).
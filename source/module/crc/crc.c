@@ -142,6 +142,17 @@ void crc_init_handler(crc_t *c, uint16_t polynom, uint16_t initial, uint16_t fin
 	c->initial = initial;
 	c->final_xor = final_xor;
 	c->reverse = false;
+
+	switch(polynom)
+	{
+#if CRC_USE_TABLE_X16_X12_X5_1
+		case 0x1021:	c->table = crc_table_x16_x12_x5_1;	break;
+#endif
+#if CRC_USE_TABLE_X16_X15_X2_1
+		case 0x8005:	c->table = crc_table_x16_x15_x2_1;	break;
+#endif
+		default:		c->table = NULL;					break;
+	}
 }
 void crc_init_handler_reversed(crc_t *c, uint16_t polynom, uint16_t initial, uint16_t final_xor)
 {
@@ -149,6 +160,24 @@ void crc_init_handler_reversed(crc_t *c, uint16_t polynom, uint16_t initial, uin
 	c->initial = initial;
 	c->final_xor = final_xor;
 	c->reverse = true;
+
+	switch(polynom)
+	{
+#if CRC_USE_TABLE_X16_X12_X5_1_REVERSED
+		case 0x8408:	c->table = crc_table_x16_x12_x8_1;	break;
+#endif
+		default:		c->table = NULL;					break;
+	}
+}
+
+void crc_init_table(crc_t *c, const uint16_t* table, uint16_t initial, uint16_t final_xor, bool reversed)
+{
+	// The entry for the single top bit is the polynom itself.
+	c->polynom = reversed ? table[0x80] : table[0x01];
+	c->initial = initial;
+	c->final_xor = final_xor;
+	c->reverse = reversed;
+	c->table = table;
 }
 
 uint16_t crc_calc(crc_t *c, const uint8_t *data, uint16_t data_len)
@@ -168,51 +197,29 @@ uint16_t crc_calc_byte(crc_t *c, uint16_t crc, uint8_t b)
 
 	if(c->reverse)
 	{
-		switch(c->polynom)
-			{
-#if CRC_USE_TABLE_X16_X12_X5_1_REVERSED
-				case 0x8408:
-					crc = (uint16_t)( (crc >> 8) ^ crc_table_x16_x12_x8_1[(crc ^ b) & 0xFF]);
-				break;
-#endif
-
-				default:
-				    for ( i = 0; i < 8; i++)
-				    {
-				        bool c15 = (crc & 0x0001);
-						crc >>= 1;
-						if ( ( (b >> i ) & 1) ^ c15)
-							crc ^= c->polynom;
-				    }
-				break;
-			}
+		if(c->table)
+			return (uint16_t)( (crc >> 8) ^ c->table[(crc ^ b) & 0xFF]);
+
+		for ( i = 0; i < 8; i++)
+		{
+			bool c15 = (crc & 0x0001);
+			crc >>= 1;
+			if ( ( (b >> i ) & 1) ^ c15)
+				crc ^= c->polynom;
+		}
 	}
 	else
 	{
-		switch(c->polynom)
-			{
-#if CRC_USE_TABLE_X16_X12_X5_1
-				case 0x1021:
-					crc = (uint16_t)( (crc << 8) ^ crc_table_x16_x12_x5_1[(crc >> 8) ^ (b & 0xFF)]);
-				break;
-#endif
-
-#if CRC_USE_TABLE_X16_X15_X2_1
-				case 0x8005:
-					crc = (uint16_t)( (crc << 8) ^ crc_table_x16_x15_x2_1[(crc >> 8) ^ (b & 0xFF)]);
-				break;
-#endif
-
-				default:
-				    for ( i = 0; i < 8; i++)
-				    {
-				        bool c15 = (crc & 0x8000) >> 15;
-						crc <<= 1;
-						if ( ( (b >> (7-i) ) & 1) ^ c15)
-							crc ^= c->polynom;
-				    }
-				break;
-			}
+		if(c->table)
+			return (uint16_t)( (crc << 8) ^ c->table[(crc >> 8) ^ (b & 0xFF)]);
+
+		for ( i = 0; i < 8; i++)
+		{
+			bool c15 = (crc & 0x8000) >> 15;
+			crc <<= 1;
+			if ( ( (b >> (7-i) ) & 1) ^ c15)
+				crc ^= c->polynom;
+		}
 	}
 
     return crc;
@@ -10,6 +10,9 @@
  *  				CRC-CCITT reversed: 	0x8408 (x^16 + x^12 + x^5 + 1)
  *  				CRC16:					0x8005 (x^16 + x^15 + x^2 + 1)
  *
+ *	@version	1.08 (18.10.2026)
+ *		- Added crc_init_table to use a constant table for any polynom (see crc_table.hpp and crc_table_gen.py).
+ *		- The built-in tables are selected in the init functions, crc_calc_byte only checks for a table.
  *	@version	1.07 (19.12.2022)
  * 	    - data parameter in crc_calc is now const, because it is not modified inside the function.
  *	@version	1.06 (19.01.2022)
@@ -40,7 +43,7 @@
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /// Version of the crc module
-#define CRC_STR_VERSION "1.07"
+#define CRC_STR_VERSION "1.08"
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Structure
@@ -57,6 +60,7 @@ typedef struct{
 	uint16_t initial;		///< Initial value for the crc word before adding the first byte.
 	uint16_t final_xor;		///< Final value that is calculated xor the calculated crc.
 	bool reverse;			///< Reverses the crc calculation
+	const uint16_t* table;	///< Lookup table used for the calculation or NULL if the crc is calculated bitwise.
 }crc_t;
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -89,6 +93,19 @@ void crc_init_handler(crc_t *c, uint16_t polynom, uint16_t initial, uint16_t fin
  */
 void crc_init_handler_reversed(crc_t *c, uint16_t polynom, uint16_t initial, uint16_t final_xor);
 
+/**
+ * 	@brief		Initializes the crc_t with a constant lookup table, so any polynom is calculated table driven without
+ * 				using the heap. The table can be generated at compile time with crc_table_make from crc_table.hpp or
+ * 				with crc_table_gen.py.
+ *
+ * 	@param c			Pointer to the crc_t structure that needs to be intialized.
+ * 	@param table		Lookup table with 256 entries for the polynom. Must stay valid while the crc_t is used.
+ * 	@param initial		Initial value for the crc word before adding the first byte.
+ * 	@param final_xor	Final value that is calculated xor the calculated crc.
+ * 	@param reversed		true if the table was generated for the reflected calculation.
+ */
+void crc_init_table(crc_t *c, const uint16_t* table, uint16_t initial, uint16_t final_xor, bool reversed);
+
 /**
  *	@brief		Calculates a crc over the data using the crc_t.
  *
@@ -4,6 +4,10 @@
  * 
  * @brief 
  * 
+ * @version 1.01 (18.10.2026)
+ * 	- Added slicing by 8 and hardware calculation for the default polynom
+ * 	- Added crc32_combine
+ * 	- Added crc32_init_table to use a constant table for other polynoms without the heap
  * @version 1.00 (24.04.2025)
  * 	- Intial release
  * 
@@ -23,7 +27,7 @@
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /// Version of the crc32 module
-#define CRC32_STR_VERSION "1.00"	
+#define CRC32_STR_VERSION "1.01"
 
 /// Default polynom used for CRC32 calculation
 #define CRC32_POLYNOM_DEFAULT	0xedb88320
@@ -40,6 +44,16 @@
 // Configuration
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#ifndef CRC32_USE_SLICING_BY_8
+/// If true, the default polynom is calculated with 8 bytes per step using 7 KiB of additional constant tables.
+#define CRC32_USE_SLICING_BY_8      true
+#endif
+
+#ifndef CRC32_USE_HARDWARE
+/// If true, the default polynom is calculated with CPU instructions where available (PCLMULQDQ on x86 PC_EMU, ARMv8 CRC32).
+#define CRC32_USE_HARDWARE          true
+#endif
+
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Enumeration
@@ -63,7 +77,8 @@ typedef struct crc32_s
 	uint32_t final_xor;		///< Final value that is calculated xor the calculated crc.
 	bool reverse;			///< Reverses the crc calculation
 	uint32_t crc;			///< Current crc value
-    uint32_t* table;            ///< Table used for the calculation. If the table is not used, this value is NULL.
+	const uint32_t* table;	///< Table used for the calculation.
+	bool use_hardware;		///< Set by crc32_init if the cpu can calculate the polynom. Can be cleared to force the table calculation.
 }crc32_t;
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -74,6 +89,17 @@ typedef struct crc32_s
  * Intializes the module with the given parameters. The default values are used if the parameters are not set.
 **/
 void crc32_init(crc32_t* crc, uint32_t polynom, uint32_t initial, uint32_t final_xor);
+/**
+ * @brief Initializes the module with a constant lookup table. In contrast to @see crc32_init no table is allocated on the
+ * heap for polynoms other than the default. The table can be generated at compile time with crc_table_make from
+ * crc_table.hpp or with crc_table_gen.py and must be generated for the reflected calculation.
+ * 
+ * @param crc       Pointer to the crc32_t structure that needs to be initialized.
+ * @param table     Lookup table with 256 entries for the reversed polynom. Must stay valid while the crc32_t is used.
+ * @param initial   Initial value for the crc word before adding the first byte.
+ * @param final_xor Final value that is calculated xor the calculated crc.
+ */
+void crc32_init_table(crc32_t* crc, const uint32_t* table, uint32_t initial, uint32_t final_xor);
 /**
  * @brief Start a CRC calculation. The initial value is set and the crc is reset to the initial value.
  * 
@@ -95,6 +121,16 @@ void crc32_update(crc32_t* crc, const uint8_t* data, size_t length);
  * @return uint32_t  The calculated CRC value.
  */
 uint32_t crc32_finish(crc32_t* crc);
+/**
+ * @brief Calculates the CRC of the concatenation of two blocks from the CRC of each block. Only valid for the default
+ * polynom, initial value and final value. Can be used to calculate the CRC of large data in parallel chunks.
+ * 
+ * @param crc_a     CRC of the first block.
+ * @param crc_b     CRC of the second block.
+ * @param len_b     Length of the second block in bytes.
+ * @return uint32_t  CRC of the first block followed by the second block.
+ */
+uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t len_b);
 
 #endif // MODULE_ENABLE_CRC32
 
@@ -18,6 +18,17 @@ void crc8_init(crc8_t *c, uint8_t polynom, uint8_t initial, uint8_t final_xor, b
 	c->initial = initial;
 	c->final_xor = final_xor;
 	c->reverse = reversed;
+	c->table = NULL;
+}
+
+void crc8_init_table(crc8_t *c, const uint8_t* table, uint8_t initial, uint8_t final_xor, bool reversed)
+{
+	// The entry for the single top bit is the polynom itself.
+	c->polynom = reversed ? table[0x80] : table[0x01];
+	c->initial = initial;
+	c->final_xor = final_xor;
+	c->reverse = reversed;
+	c->table = table;
 }
 
 uint8_t crc8_calc(crc8_t *c, const uint8_t *data, size_t data_len)
@@ -33,12 +44,16 @@ uint8_t crc8_calc(crc8_t *c, const uint8_t *data, size_t data_len)
 
 uint8_t crc8_calc_byte(crc8_t *c, uint8_t crc, uint8_t b)
 {
+	if(c->table)
+	{
+		// For 8 bit the register is shifted out completely, so both directions use the same lookup.
+		return c->table[crc ^ b];
+	}
+
 	if(c->reverse)
 	{
 		switch(c->polynom)
 			{
-				// Lookup tables?
-
 				default:
 					for (uint8_t i = 8; i; i--) 
 					{
@@ -55,8 +70,6 @@ uint8_t crc8_calc_byte(crc8_t *c, uint8_t crc, uint8_t b)
 	{
 		switch(c->polynom)
 			{
-				// Lookup tables?
-
 				default:
 					for (uint8_t i = 8; i; i--) 
 					{
@@ -7,6 +7,8 @@
  *  			Standard CRC polynoms:
  *  				CRC-CCITT: 				0x07 (x^8 + x^2 + x^1 + 1)
  *
+ *  @version	1.01 (18.10.2026)
+ *  	- Added crc8_init_table to use a constant lookup table for any polynom.
  *  @version	1.00 (22.02.2024)
  *  	- Intial release
  *
@@ -22,7 +24,7 @@
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /// Version of the crc module
-#define CRC8_STR_VERSION "1.00"
+#define CRC8_STR_VERSION "1.01"
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Structure
@@ -44,6 +46,8 @@ typedef struct
 	uint8_t final_xor;		
 	/// Reverses the crc calculation
 	uint8_t reverse;		
+	/// Lookup table used for the calculation or NULL if the crc is calculated bitwise.
+	const uint8_t* table;
 }crc8_t;
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -62,6 +66,18 @@ typedef struct
  *  @param reversed		Can be set to calculate the reversed CRC.
  */
 void crc8_init(crc8_t *c, uint8_t polynom, uint8_t initial, uint8_t final_xor, bool reversed);
+/**
+ * 	@brief		Initializes the crc8_t with a constant lookup table, so the crc is calculated table driven without
+ * 				using the heap. The table can be generated at compile time with crc_table_make from crc_table.hpp or
+ * 				with crc_table_gen.py.
+ *
+ * 	@param c			Pointer to the @c crc8_t structure that needs to be intialized.
+ * 	@param table		Lookup table with 256 entries for the polynom. Must stay valid while the crc8_t is used.
+ * 	@param initial		Initial value for the crc word before adding the first byte.
+ * 	@param final_xor	Final value that is calculated xor the calculated crc.
+ *  @param reversed		true if the table was generated for the reflected calculation.
+ */
+void crc8_init_table(crc8_t *c, const uint8_t* table, uint8_t initial, uint8_t final_xor, bool reversed);
 
 /**
  *	@brief		Calculates a crc over the data using the crc_t.
@@ -0,0 +1,108 @@
+/**
+ * 	@file 		crc_table.hpp
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Generates CRC lookup tables at compile time for C++ users. The tables are constexpr, so they are placed
+ *  			in flash/rodata and can be passed to crc_init_table, crc8_init_table or crc32_init_table.
+ *
+ *  			The polynom is given the same way as for the C functions, so for reflected calculation the reversed
+ *  			polynom is used (e.g. 0x8408 for CRC-CCITT or 0xEDB88320 for CRC-32).
+ * @code
+static constexpr crc_table_t<uint16_t> table = crc_table_make<uint16_t, 0x1021, false>();
+crc_t crc;
+crc_init_table(&crc, table.data, 0xFFFF, 0x0000, false);
+ * @endcode
+ *
+ *  			Only needs C++11. C users can generate the same tables with crc_table_gen.py.
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef CRC_TABLE_HPP_
+#define CRC_TABLE_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Lookup table with one entry for each byte value.
+ * @tparam T    uint8_t, uint16_t or uint32_t for CRC-8, CRC-16 or CRC-32.
+ */
+template<typename T>
+struct crc_table_t
+{
+	/// Entries of the table
+	T data[256];
+};
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// List of indices used to expand the entries of the table.
+template<size_t... I>
+struct _crc_table_index {};
+
+/// Builds _crc_table_index<0, 1, ..., N - 1>.
+template<size_t N, size_t... I>
+struct _crc_table_make_index : _crc_table_make_index<N - 1, N - 1, I...> {};
+
+template<size_t... I>
+struct _crc_table_make_index<0, I...>
+{
+	typedef _crc_table_index<I...> type;
+};
+
+/// Shifts one bit through the crc register.
+template<typename T, T Polynom, bool Reflected>
+constexpr T _crc_table_step(T c)
+{
+	return Reflected ? (T)((c & 1) ? (c >> 1) ^ Polynom : (c >> 1)) :
+					   (T)(((c >> (sizeof(T) * 8 - 1)) & 1) ? (T)(c << 1) ^ Polynom : (T)(c << 1));
+}
+
+/// Shifts n bits through the crc register.
+template<typename T, T Polynom, bool Reflected>
+constexpr T _crc_table_shift(T c, int n)
+{
+	return n == 0 ? c : _crc_table_shift<T, Polynom, Reflected>(_crc_table_step<T, Polynom, Reflected>(c), n - 1);
+}
+
+/// Calculates the entry for one byte value.
+template<typename T, T Polynom, bool Reflected>
+constexpr T _crc_table_entry(size_t i)
+{
+	return _crc_table_shift<T, Polynom, Reflected>(Reflected ? (T)i : (T)((T)i << (sizeof(T) * 8 - 8)), 8);
+}
+
+template<typename T, T Polynom, bool Reflected, size_t... I>
+constexpr crc_table_t<T> _crc_table_make(_crc_table_index<I...>)
+{
+	return crc_table_t<T>{{ _crc_table_entry<T, Polynom, Reflected>(I)... }};
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Generates the lookup table for a polynom at compile time.
+ *
+ * @tparam T            uint8_t, uint16_t or uint32_t for CRC-8, CRC-16 or CRC-32.
+ * @tparam Polynom      Generator polynom. Must be the reversed polynom if Reflected is true.
+ * @tparam Reflected    true for the reflected (LSB first) calculation.
+ * @return              Lookup table.
+ */
+template<typename T, T Polynom, bool Reflected>
+constexpr crc_table_t<T> crc_table_make()
+{
+	return _crc_table_make<T, Polynom, Reflected>(typename _crc_table_make_index<256>::type());
+}
+
+#endif /* CRC_TABLE_HPP_ */
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Generates a CRC lookup table as a constant C array, so it is placed in flash/rodata and needs no heap or calculation at
+startup. The table can be passed to crc_init_table, crc8_init_table or crc32_init_table.
+
+The polynom is given the same way as for the C functions, so for reflected calculation the reversed polynom is used
+(e.g. 0x8408 for CRC-CCITT or 0xEDB88320 for CRC-32).
+
+Example:
+    python3 crc_table_gen.py --width 16 --polynom 0x1021 --name crc_table_ccitt > crc_table_ccitt.h
+
+Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+"""
+import argparse
+import sys
+
+
+def crc_table(width, polynom, reflected):
+    """Returns the 256 entries of the lookup table."""
+    mask = (1 << width) - 1
+    top = 1 << (width - 1)
+    table = []
+
+    for i in range(256):
+        c = i if reflected else i << (width - 8)
+        for _ in range(8):
+            if reflected:
+                c = (c >> 1) ^ polynom if c & 1 else c >> 1
+            else:
+                c = ((c << 1) ^ polynom if c & top else c << 1) & mask
+        table.append(c)
+
+    return table
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates a constant CRC lookup table for C.")
+    parser.add_argument("--width", type=int, choices=[8, 16, 32], required=True, help="Width of the crc in bits")
+    parser.add_argument("--polynom", type=lambda x: int(x, 0), required=True, help="Generator polynom, reversed if --reflected is used")
+    parser.add_argument("--reflected", action="store_true", help="Generate the table for the reflected (LSB first) calculation")
+    parser.add_argument("--name", required=True, help="Name of the array")
+    args = parser.parse_args()
+
+    if args.polynom >> args.width:
+        sys.exit("Polynom does not fit into %d bits" % args.width)
+
+    digits = args.width // 4
+    per_line = {8: 16, 16: 8, 32: 8}[args.width]
+    table = crc_table(args.width, args.polynom, args.reflected)
+
+    print("/// CRC-%d table for polynom 0x%0*X, %s. Generated with crc_table_gen.py."
+          % (args.width, digits, args.polynom, "reflected" if args.reflected else "not reflected"))
+    print("static const uint%d_t %s[256] =" % (args.width, args.name))
+    print("{")
+    for i in range(0, 256, per_line):
+        line = ", ".join("0x%0*X" % (digits, v) for v in table[i:i + per_line])
+        print("\t" + line + ("," if i + per_line < 256 else ""))
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -294,7 +294,7 @@ error:
         esp_lcd_panel_del(mcu->panel_handle);
 
     if(mcu)
-        mcu_heap_free(mcu);
+        heap_caps_free(mcu);
 
     return NULL;
 }
@@ -0,0 +1,16 @@
+/**
+ * @file filter.h
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ * @author Tim Koczwara
+ */
+
+#ifndef SRC_MODULE_FILTER_FILTER_H_
+#define SRC_MODULE_FILTER_FILTER_H_
+
+#include "filter_common.h"
+#include "filter_fir.h"
+#include "filter_biquad.h"
+#include "filter_average.h"
+
+
+#endif /* SRC_MODULE_FILTER_FILTER_H_ */
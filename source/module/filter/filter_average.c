@@ -0,0 +1,222 @@
+/**
+ * @file filter_average.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ */
+
+#include "module_public.h"
+#if MODULE_ENABLE_FILTER
+
+#include "filter_average.h"
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal function prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Divides the sum by the number of samples and rounds half away from zero.
+ *
+ * @param sum			Sum of the samples.
+ * @param count			Number of samples, at least 1.
+ * @return				Rounded average.
+ */
+static int32_t _average_divide(int64_t sum, uint16_t count);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool filter_average_init(filter_average_t* f, int32_t* buffer, uint16_t length, uint16_t decimation)
+{
+	if(f == NULL || buffer == NULL || length == 0 || decimation == 0)
+		return false;
+
+	f->buffer = buffer;
+	f->length = length;
+	f->decimation = decimation;
+	filter_average_reset(f);
+	return true;
+}
+
+void filter_average_reset(filter_average_t* f)
+{
+	if(f == NULL)
+		return;
+
+	f->sum = 0;
+	f->pos = 0;
+	f->count = 0;
+	f->phase = f->decimation - 1;
+	memset(f->buffer, 0, f->length * sizeof(int32_t));
+}
+
+int32_t filter_average_add(filter_average_t* f, int32_t sample)
+{
+	if(f == NULL)
+		return 0;
+
+	// Samples that were not written yet are 0, so the sum is correct while the buffer is filled.
+	f->sum += (int64_t)sample - f->buffer[f->pos];
+	f->buffer[f->pos] = sample;
+
+	if(++f->pos == f->length)
+		f->pos = 0;
+
+	if(f->count < f->length)
+		f->count++;
+
+	return _average_divide(f->sum, f->count);
+}
+
+size_t filter_average_process(filter_average_t* f, const int32_t* in, int32_t* out, size_t count)
+{
+	int32_t* buffer;
+	int64_t sum;
+	size_t i, n, filled, out_count = 0;
+	uint16_t pos, phase;
+
+	if(f == NULL || in == NULL || out == NULL)
+		return 0;
+
+	buffer = f->buffer;
+	sum = f->sum;
+	pos = f->pos;
+	phase = f->phase;
+
+	while(count > 0)
+	{
+		// Process until the end of the ring buffer, so the index does not need to be checked for each sample.
+		n = f->length - pos;
+		if(n > count)
+			n = count;
+
+		filled = f->count;
+
+		for(i = 0; i < n; i++)
+		{
+			sum += (int64_t)in[i] - buffer[pos + i];
+			buffer[pos + i] = in[i];
+
+			if(phase == 0)
+			{
+				// While the buffer is filled the average is over the samples that were written so far.
+				out[out_count++] = _average_divide(sum, (uint16_t)(filled + i + 1 < f->length ? filled + i + 1 : f->length));
+				phase = f->decimation;
+			}
+			phase--;
+		}
+
+		f->count = (uint16_t)(filled + n < f->length ? filled + n : f->length);
+
+		pos = (uint16_t)(pos + n == f->length ? 0 : pos + n);
+		in += n;
+		count -= n;
+	}
+
+	f->sum = sum;
+	f->pos = pos;
+	f->phase = phase;
+	return out_count;
+}
+
+void filter_ema_init(filter_ema_t* f, q15_t alpha)
+{
+	if(f == NULL)
+		return;
+
+	f->value = 0;
+	f->alpha = alpha < 0 ? 0 : alpha;
+	f->initialized = false;
+}
+
+int32_t filter_ema_add(filter_ema_t* f, int32_t sample)
+{
+	return filter_ema_process(f, &sample, NULL, 1);
+}
+
+int32_t filter_ema_process(filter_ema_t* f, const int32_t* in, int32_t* out, size_t count)
+{
+	int64_t value, alpha;
+	size_t i;
+
+	if(f == NULL)
+		return 0;
+
+	if(in == NULL || count == 0)
+		return (int32_t)((f->value + 0x8000) >> 16);
+
+	if(!f->initialized)
+	{
+		f->value = (int64_t)in[0] * 65536;
+		f->initialized = true;
+	}
+
+	value = f->value;
+	alpha = f->alpha;
+
+	for(i = 0; i < count; i++)
+	{
+		// Difference is at most 2^48, multiplied with alpha it is below 2^63.
+		value += (((int64_t)in[i] * 65536 - value) * alpha) >> 15;
+		if(out)
+			out[i] = (int32_t)((value + 0x8000) >> 16);
+	}
+
+	f->value = value;
+	return (int32_t)((value + 0x8000) >> 16);
+}
+
+void filter_ema_float_init(filter_ema_float_t* f, float alpha)
+{
+	if(f == NULL)
+		return;
+
+	f->value = 0.0f;
+	f->alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+	f->initialized = false;
+}
+
+float filter_ema_float_process(filter_ema_float_t* f, const float* in, float* out, size_t count)
+{
+	float value, alpha;
+	size_t i;
+
+	if(f == NULL)
+		return 0.0f;
+
+	if(in == NULL || count == 0)
+		return f->value;
+
+	if(!f->initialized)
+	{
+		f->value = in[0];
+		f->initialized = true;
+	}
+
+	value = f->value;
+	alpha = f->alpha;
+
+	for(i = 0; i < count; i++)
+	{
+		value += alpha * (in[i] - value);
+		if(out)
+			out[i] = value;
+	}
+
+	f->value = value;
+	return value;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static int32_t _average_divide(int64_t sum, uint16_t count)
+{
+	if(sum < 0)
+		return (int32_t)-((-sum + count / 2) / count);
+
+	return (int32_t)((sum + count / 2) / count);
+}
+
+#endif
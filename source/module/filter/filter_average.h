@@ -0,0 +1,155 @@
+/**
+ * 	@file 		filter_average.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Moving average and exponential smoothing for integer and float samples.
+ *
+ *  			The moving average keeps a running sum, so each sample needs one addition and one subtraction
+ *  			independent of the length. With a decimation factor equal to the length it is a boxcar decimator, e.g. to
+ *  			reduce 16 times oversampled ADC values.
+ *
+ *  			Exponential smoothing calculates value += alpha * (sample - value). The integer version stores the
+ *  			value with 16 fractional bits, so small alphas do not get stuck a few steps below the input.
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef FILTER_AVERAGE_H_
+#define FILTER_AVERAGE_H_
+
+#include "filter_common.h"
+
+#if MODULE_ENABLE_FILTER
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Moving average over the last length samples.
+typedef struct filter_average_s
+{
+	/// Ring buffer with length samples.
+	int32_t* buffer;
+	/// Sum of the samples in the buffer.
+	int64_t sum;
+	/// Number of samples that are averaged.
+	uint16_t length;
+	/// Index in the buffer where the next sample is written.
+	uint16_t pos;
+	/// Number of valid samples in the buffer. Is below length until the buffer was filled once.
+	uint16_t count;
+	/// Only every decimation-th average is returned by filter_average_process.
+	uint16_t decimation;
+	/// Number of samples until the next output of filter_average_process.
+	uint16_t phase;
+}filter_average_t;
+
+/// Exponential smoothing for integer samples.
+typedef struct filter_ema_s
+{
+	/// Smoothed value with 16 fractional bits.
+	int64_t value;
+	/// Weight of a new sample in Q15.
+	q15_t alpha;
+	/// false until the first sample was added.
+	bool initialized;
+}filter_ema_t;
+
+/// Exponential smoothing for float samples.
+typedef struct filter_ema_float_s
+{
+	/// Smoothed value.
+	float value;
+	/// Weight of a new sample between 0.0 and 1.0.
+	float alpha;
+	/// false until the first sample was added.
+	bool initialized;
+}filter_ema_float_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a moving average.
+ *
+ * @param f				Pointer to the filter.
+ * @param buffer		Buffer with length samples.
+ * @param length		Number of samples that are averaged, at least 1.
+ * @param decimation	1 to return every average in filter_average_process or the factor by which the number of samples is
+ * 						reduced.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_average_init(filter_average_t* f, int32_t* buffer, uint16_t length, uint16_t decimation);
+/**
+ * @brief Removes all samples from the moving average.
+ *
+ * @param f				Pointer to the filter.
+ */
+void filter_average_reset(filter_average_t* f);
+/**
+ * @brief Adds a sample to the moving average. Ignores the decimation.
+ *
+ * @param f				Pointer to the filter.
+ * @param sample		New sample.
+ * @return				Rounded average of the last length samples or of all samples while the buffer is not full.
+ */
+int32_t filter_average_add(filter_average_t* f, int32_t sample);
+/**
+ * @brief Adds a block of samples to the moving average.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for the averages. Needs count / decimation + 1 entries. Can be the same as in.
+ * @param count			Number of input samples.
+ * @return				Number of averages in out.
+ */
+size_t filter_average_process(filter_average_t* f, const int32_t* in, int32_t* out, size_t count);
+/**
+ * @brief Initializes an exponential smoothing. The first sample is used as start value.
+ *
+ * @param f				Pointer to the filter.
+ * @param alpha			Weight of a new sample in Q15, e.g. FILTER_Q15(0.1).
+ */
+void filter_ema_init(filter_ema_t* f, q15_t alpha);
+/**
+ * @brief Adds a sample to the exponential smoothing.
+ *
+ * @param f				Pointer to the filter.
+ * @param sample		New sample.
+ * @return				Rounded smoothed value.
+ */
+int32_t filter_ema_add(filter_ema_t* f, int32_t sample);
+/**
+ * @brief Adds a block of samples to the exponential smoothing.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for count smoothed values. Can be the same as in or NULL if only the last value is needed.
+ * @param count			Number of samples.
+ * @return				Last smoothed value.
+ */
+int32_t filter_ema_process(filter_ema_t* f, const int32_t* in, int32_t* out, size_t count);
+/**
+ * @brief Initializes an exponential smoothing for float samples. The first sample is used as start value.
+ *
+ * @param f				Pointer to the filter.
+ * @param alpha			Weight of a new sample between 0.0 and 1.0.
+ */
+void filter_ema_float_init(filter_ema_float_t* f, float alpha);
+/**
+ * @brief Adds a block of float samples to the exponential smoothing.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for count smoothed values. Can be the same as in or NULL if only the last value is needed.
+ * @param count			Number of samples.
+ * @return				Last smoothed value.
+ */
+float filter_ema_float_process(filter_ema_float_t* f, const float* in, float* out, size_t count);
+
+#endif // MODULE_ENABLE_FILTER
+
+#endif /* FILTER_AVERAGE_H_ */
@@ -0,0 +1,171 @@
+/**
+ * @file filter_biquad.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ */
+
+#include "module_public.h"
+#if MODULE_ENABLE_FILTER
+
+#include "filter_biquad.h"
+#include <string.h>
+
+#if FILTER_USE_ESP_DSP
+#include "dsps_biquad.h"
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool filter_biquad_q15_init(filter_biquad_q15_t* f, const int16_t* coeffs, q15_t* state, uint8_t num_stages)
+{
+	if(f == NULL || coeffs == NULL || state == NULL || num_stages == 0)
+		return false;
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->num_stages = num_stages;
+	memset(state, 0, 4 * num_stages * sizeof(q15_t));
+	return true;
+}
+
+void filter_biquad_q15_process(filter_biquad_q15_t* f, const q15_t* in, q15_t* out, size_t count)
+{
+	const q15_t* src = in;
+	const int16_t* c;
+	q15_t* s;
+	int32_t b0, b1, b2, a1, a2;
+	int32_t x1, x2, y1, y2, x0;
+	int64_t acc;
+	uint8_t stage;
+	size_t i;
+
+	if(f == NULL || in == NULL || out == NULL)
+		return;
+
+	for(stage = 0; stage < f->num_stages; stage++)
+	{
+		c = &f->coeffs[stage * FILTER_BIQUAD_COEFFS];
+		s = &f->state[stage * 4];
+		b0 = c[0]; b1 = c[1]; b2 = c[2]; a1 = c[3]; a2 = c[4];
+		x1 = s[0]; x2 = s[1]; y1 = s[2]; y2 = s[3];
+
+		for(i = 0; i < count; i++)
+		{
+			x0 = src[i];
+			acc = (int64_t)b0 * x0 + (int64_t)b1 * x1 + (int64_t)b2 * x2 - (int64_t)a1 * y1 - (int64_t)a2 * y2;
+			x2 = x1;
+			x1 = x0;
+			y2 = y1;
+			y1 = filter_saturate_q15((acc + (1L << 13)) >> 14);
+			out[i] = (q15_t)y1;
+		}
+
+		s[0] = (q15_t)x1; s[1] = (q15_t)x2; s[2] = (q15_t)y1; s[3] = (q15_t)y2;
+		// The following stages filter the output of the previous stage in place.
+		src = out;
+	}
+}
+
+bool filter_biquad_q31_init(filter_biquad_q31_t* f, const int32_t* coeffs, q31_t* state, uint8_t num_stages)
+{
+	if(f == NULL || coeffs == NULL || state == NULL || num_stages == 0)
+		return false;
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->num_stages = num_stages;
+	memset(state, 0, 4 * num_stages * sizeof(q31_t));
+	return true;
+}
+
+void filter_biquad_q31_process(filter_biquad_q31_t* f, const q31_t* in, q31_t* out, size_t count)
+{
+	const q31_t* src = in;
+	const int32_t* c;
+	q31_t* s;
+	int64_t b0, b1, b2, a1, a2;
+	int64_t x1, x2, y1, y2, x0;
+	int64_t acc;
+	uint8_t stage;
+	size_t i;
+
+	if(f == NULL || in == NULL || out == NULL)
+		return;
+
+	for(stage = 0; stage < f->num_stages; stage++)
+	{
+		c = &f->coeffs[stage * FILTER_BIQUAD_COEFFS];
+		s = &f->state[stage * 4];
+		b0 = c[0]; b1 = c[1]; b2 = c[2]; a1 = c[3]; a2 = c[4];
+		x1 = s[0]; x2 = s[1]; y1 = s[2]; y2 = s[3];
+
+		for(i = 0; i < count; i++)
+		{
+			x0 = src[i];
+			// Each product is below 2^62, the sum of 5 products is divided by 4 first so it cannot overflow.
+			acc = ((b0 * x0) >> 2) + ((b1 * x1) >> 2) + ((b2 * x2) >> 2) - ((a1 * y1) >> 2) - ((a2 * y2) >> 2);
+			x2 = x1;
+			x1 = x0;
+			y2 = y1;
+			y1 = filter_saturate_q31((acc + (1LL << 27)) >> 28);
+			out[i] = (q31_t)y1;
+		}
+
+		s[0] = (q31_t)x1; s[1] = (q31_t)x2; s[2] = (q31_t)y1; s[3] = (q31_t)y2;
+		src = out;
+	}
+}
+
+bool filter_biquad_float_init(filter_biquad_float_t* f, const float* coeffs, float* state, uint8_t num_stages)
+{
+	if(f == NULL || coeffs == NULL || state == NULL || num_stages == 0)
+		return false;
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->num_stages = num_stages;
+	memset(state, 0, 2 * num_stages * sizeof(float));
+	return true;
+}
+
+void filter_biquad_float_process(filter_biquad_float_t* f, const float* in, float* out, size_t count)
+{
+	const float* src = in;
+	uint8_t stage;
+#if !FILTER_USE_ESP_DSP
+	const float* c;
+	float* w;
+	float b0, b1, b2, a1, a2;
+	float w0, w1, w2;
+	size_t i;
+#endif
+
+	if(f == NULL || in == NULL || out == NULL)
+		return;
+
+	for(stage = 0; stage < f->num_stages; stage++)
+	{
+#if FILTER_USE_ESP_DSP
+		dsps_biquad_f32(src, out, (int)count, (float*)&f->coeffs[stage * FILTER_BIQUAD_COEFFS], &f->state[stage * 2]);
+#else
+		c = &f->coeffs[stage * FILTER_BIQUAD_COEFFS];
+		w = &f->state[stage * 2];
+		b0 = c[0]; b1 = c[1]; b2 = c[2]; a1 = c[3]; a2 = c[4];
+		w1 = w[0]; w2 = w[1];
+
+		for(i = 0; i < count; i++)
+		{
+			w0 = src[i] - a1 * w1 - a2 * w2;
+			out[i] = b0 * w0 + b1 * w1 + b2 * w2;
+			w2 = w1;
+			w1 = w0;
+		}
+
+		w[0] = w1; w[1] = w2;
+#endif
+		src = out;
+	}
+}
+
+#endif
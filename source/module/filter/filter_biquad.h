@@ -0,0 +1,146 @@
+/**
+ * 	@file 		filter_biquad.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Cascaded biquad (second order IIR) filters for Q15, Q31 and float samples.
+ *
+ *  			Each stage has the coefficients b0, b1, b2, a1, a2 with a0 normalized to 1:
+ *  			y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] - a1 * y[n-1] - a2 * y[n-2]
+ *
+ *  			The whole block is passed through one stage before the next stage starts, so the coefficients and the
+ *  			state of a stage stay in registers. The float filter uses the direct form II with 2 state values per stage,
+ *  			which is the same layout as dsps_biquad_f32 of esp-dsp. If FILTER_USE_ESP_DSP is set, esp-dsp is used
+ *  			for the float filter, which uses the DSP instructions of the ESP32-S3.
+ *
+ *  			The fixed-point filters use the direct form I, which has no internal overflow. Since a1 is often between
+ *  			-2 and -1, the coefficients have one integer bit: Q14 for the Q15 filter and Q30 for the Q31 filter. They
+ *  			must be at least -2.0 and below 2.0. If a stage has larger b coefficients (e.g. 1, 2, 1 of a lowpass), the
+ *  			gain must be moved into another stage.
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef FILTER_BIQUAD_H_
+#define FILTER_BIQUAD_H_
+
+#include "filter_common.h"
+
+#if MODULE_ENABLE_FILTER
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Number of coefficients per stage.
+#define FILTER_BIQUAD_COEFFS						5
+
+/// Converts a coefficient from -2.0 to below 2.0 into Q14 for the Q15 biquad.
+#define FILTER_BIQUAD_Q14(x)						((int16_t)((x) * 16384.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+/// Converts a coefficient from -2.0 to below 2.0 into Q30 for the Q31 biquad.
+#define FILTER_BIQUAD_Q30(x)						((int32_t)((x) * 1073741824.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Biquad cascade for Q15 samples.
+typedef struct filter_biquad_q15_s
+{
+	/// Q14 coefficients b0, b1, b2, a1, a2 for each stage.
+	const int16_t* coeffs;
+	/// 4 values per stage: x[n-1], x[n-2], y[n-1], y[n-2].
+	q15_t* state;
+	/// Number of stages.
+	uint8_t num_stages;
+}filter_biquad_q15_t;
+
+/// Biquad cascade for Q31 samples.
+typedef struct filter_biquad_q31_s
+{
+	/// Q30 coefficients b0, b1, b2, a1, a2 for each stage.
+	const int32_t* coeffs;
+	/// 4 values per stage: x[n-1], x[n-2], y[n-1], y[n-2].
+	q31_t* state;
+	/// Number of stages.
+	uint8_t num_stages;
+}filter_biquad_q31_t;
+
+/// Biquad cascade for float samples.
+typedef struct filter_biquad_float_s
+{
+	/// Coefficients b0, b1, b2, a1, a2 for each stage.
+	const float* coeffs;
+	/// 2 values per stage: w[n-1], w[n-2].
+	float* state;
+	/// Number of stages.
+	uint8_t num_stages;
+}filter_biquad_float_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a Q15 biquad cascade and clears the state.
+ *
+ * @param f				Pointer to the filter.
+ * @param coeffs		5 * num_stages Q14 coefficients, must stay valid while the filter is used.
+ * @param state			Buffer with 4 * num_stages values.
+ * @param num_stages	Number of stages, at least 1.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_biquad_q15_init(filter_biquad_q15_t* f, const int16_t* coeffs, q15_t* state, uint8_t num_stages);
+/**
+ * @brief Filters a block of Q15 samples.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for count output samples. Can be the same as in.
+ * @param count			Number of samples.
+ */
+void filter_biquad_q15_process(filter_biquad_q15_t* f, const q15_t* in, q15_t* out, size_t count);
+/**
+ * @brief Initializes a Q31 biquad cascade and clears the state.
+ *
+ * @param f				Pointer to the filter.
+ * @param coeffs		5 * num_stages Q30 coefficients, must stay valid while the filter is used.
+ * @param state			Buffer with 4 * num_stages values.
+ * @param num_stages	Number of stages, at least 1.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_biquad_q31_init(filter_biquad_q31_t* f, const int32_t* coeffs, q31_t* state, uint8_t num_stages);
+/**
+ * @brief Filters a block of Q31 samples.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for count output samples. Can be the same as in.
+ * @param count			Number of samples.
+ */
+void filter_biquad_q31_process(filter_biquad_q31_t* f, const q31_t* in, q31_t* out, size_t count);
+/**
+ * @brief Initializes a float biquad cascade and clears the state.
+ *
+ * @param f				Pointer to the filter.
+ * @param coeffs		5 * num_stages coefficients, must stay valid while the filter is used.
+ * @param state			Buffer with 2 * num_stages values.
+ * @param num_stages	Number of stages, at least 1.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_biquad_float_init(filter_biquad_float_t* f, const float* coeffs, float* state, uint8_t num_stages);
+/**
+ * @brief Filters a block of float samples.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for count output samples. Can be the same as in.
+ * @param count			Number of samples.
+ */
+void filter_biquad_float_process(filter_biquad_float_t* f, const float* in, float* out, size_t count);
+
+#endif // MODULE_ENABLE_FILTER
+
+#endif /* FILTER_BIQUAD_H_ */
@@ -0,0 +1,86 @@
+/**
+ * 	@file 		filter_common.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Fixed-point types and helpers that are used by all filters of the filter module.
+ *
+ *  			Q15 values are int16_t with 15 fractional bits (-1.0 to 0.99997), Q31 values are int32_t with 31 fractional
+ *  			bits. Results are saturated instead of wrapping around.
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef FILTER_COMMON_H_
+#define FILTER_COMMON_H_
+
+#include "module_public.h"
+
+#if MODULE_ENABLE_FILTER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Configuration
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef FILTER_USE_ESP_DSP
+/// Set to true to use the esp-dsp component for float biquad filters, which uses the DSP instructions of the ESP32-S3.
+#define FILTER_USE_ESP_DSP				false
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Version of the filter module
+#define FILTER_STR_VERSION				"1.00"
+
+/// Converts a constant between -1.0 and 1.0 into Q15, e.g. FILTER_Q15(0.25).
+#define FILTER_Q15(x)					((q15_t)((x) >= 0.999969482421875 ? INT16_MAX : (x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+/// Converts a constant between -1.0 and 1.0 into Q31, e.g. FILTER_Q31(0.25).
+#define FILTER_Q31(x)					((q31_t)((x) >= 0.9999999995343387 ? INT32_MAX : (x) * 2147483648.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Fixed-point value with 15 fractional bits.
+typedef int16_t q15_t;
+
+/// Fixed-point value with 31 fractional bits.
+typedef int32_t q31_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Limits a value to the range of Q15.
+ *
+ * @param v			Value.
+ * @return			Value between INT16_MIN and INT16_MAX.
+ */
+static inline q15_t filter_saturate_q15(int64_t v)
+{
+	return (q15_t)(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+/**
+ * @brief Limits a value to the range of Q31.
+ *
+ * @param v			Value.
+ * @return			Value between INT32_MIN and INT32_MAX.
+ */
+static inline q31_t filter_saturate_q31(int64_t v)
+{
+	return (q31_t)(v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : v));
+}
+
+#endif // MODULE_ENABLE_FILTER
+
+#endif /* FILTER_COMMON_H_ */
@@ -0,0 +1,220 @@
+/**
+ * @file filter_fir.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ */
+
+#include "module_public.h"
+#if MODULE_ENABLE_FILTER
+
+#include "filter_fir.h"
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal function prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Calculates one Q15 output as dot product of the samples and the time reversed coefficients.
+ *
+ * @param x				Oldest sample, x[num_taps - 1] is the newest sample.
+ * @param b				Coefficients, b[0] is multiplied with the oldest sample.
+ * @param num_taps		Number of coefficients.
+ * @return				Saturated output.
+ */
+static q15_t _fir_q15_dot(const q15_t* x, const q15_t* b, uint16_t num_taps);
+/**
+ * @brief Calculates one Q31 output as dot product of the samples and the time reversed coefficients.
+ *
+ * @param x				Oldest sample, x[num_taps - 1] is the newest sample.
+ * @param b				Coefficients, b[0] is multiplied with the oldest sample.
+ * @param num_taps		Number of coefficients.
+ * @return				Saturated output.
+ */
+static q31_t _fir_q31_dot(const q31_t* x, const q31_t* b, uint16_t num_taps);
+/**
+ * @brief Calculates one float output as dot product of the samples and the time reversed coefficients.
+ *
+ * @param x				Oldest sample, x[num_taps - 1] is the newest sample.
+ * @param b				Coefficients, b[0] is multiplied with the oldest sample.
+ * @param num_taps		Number of coefficients.
+ * @return				Output.
+ */
+static float _fir_float_dot(const float* x, const float* b, uint16_t num_taps);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool filter_fir_q15_init(filter_fir_q15_t* f, const q15_t* coeffs, uint16_t num_taps, q15_t* state, uint16_t block_size, uint8_t decimation)
+{
+	if(f == NULL || coeffs == NULL || state == NULL || num_taps == 0 || block_size == 0 || decimation == 0)
+		return false;
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->num_taps = num_taps;
+	f->block_size = block_size;
+	f->decimation = decimation;
+	// The first output is created by the decimation-th sample, like a decimator that waits for a full set of samples.
+	f->phase = decimation - 1;
+	memset(state, 0, FILTER_FIR_STATE_SIZE(num_taps, block_size) * sizeof(q15_t));
+	return true;
+}
+
+size_t filter_fir_q15_process(filter_fir_q15_t* f, const q15_t* in, q15_t* out, size_t count)
+{
+	size_t history, n, i;
+	size_t out_count = 0;
+
+	if(f == NULL || in == NULL || out == NULL)
+		return 0;
+
+	history = f->num_taps - 1;
+
+	while(count > 0)
+	{
+		n = count < f->block_size ? count : f->block_size;
+
+		// The new samples are appended to the history, so the filter window is always contiguous.
+		memcpy(&f->state[history], in, n * sizeof(q15_t));
+
+		for(i = f->phase; i < n; i += f->decimation)
+			out[out_count++] = _fir_q15_dot(&f->state[i], f->coeffs, f->num_taps);
+
+		f->phase = (uint8_t)(i - n);
+
+		memmove(f->state, &f->state[n], history * sizeof(q15_t));
+		in += n;
+		count -= n;
+	}
+
+	return out_count;
+}
+
+bool filter_fir_q31_init(filter_fir_q31_t* f, const q31_t* coeffs, uint16_t num_taps, q31_t* state, uint16_t block_size, uint8_t decimation)
+{
+	if(f == NULL || coeffs == NULL || state == NULL || num_taps == 0 || block_size == 0 || decimation == 0)
+		return false;
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->num_taps = num_taps;
+	f->block_size = block_size;
+	f->decimation = decimation;
+	f->phase = decimation - 1;
+	memset(state, 0, FILTER_FIR_STATE_SIZE(num_taps, block_size) * sizeof(q31_t));
+	return true;
+}
+
+size_t filter_fir_q31_process(filter_fir_q31_t* f, const q31_t* in, q31_t* out, size_t count)
+{
+	size_t history, n, i;
+	size_t out_count = 0;
+
+	if(f == NULL || in == NULL || out == NULL)
+		return 0;
+
+	history = f->num_taps - 1;
+
+	while(count > 0)
+	{
+		n = count < f->block_size ? count : f->block_size;
+
+		memcpy(&f->state[history], in, n * sizeof(q31_t));
+
+		for(i = f->phase; i < n; i += f->decimation)
+			out[out_count++] = _fir_q31_dot(&f->state[i], f->coeffs, f->num_taps);
+
+		f->phase = (uint8_t)(i - n);
+
+		memmove(f->state, &f->state[n], history * sizeof(q31_t));
+		in += n;
+		count -= n;
+	}
+
+	return out_count;
+}
+
+bool filter_fir_float_init(filter_fir_float_t* f, const float* coeffs, uint16_t num_taps, float* state, uint16_t block_size, uint8_t decimation)
+{
+	if(f == NULL || coeffs == NULL || state == NULL || num_taps == 0 || block_size == 0 || decimation == 0)
+		return false;
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->num_taps = num_taps;
+	f->block_size = block_size;
+	f->decimation = decimation;
+	f->phase = decimation - 1;
+	memset(state, 0, FILTER_FIR_STATE_SIZE(num_taps, block_size) * sizeof(float));
+	return true;
+}
+
+size_t filter_fir_float_process(filter_fir_float_t* f, const float* in, float* out, size_t count)
+{
+	size_t history, n, i;
+	size_t out_count = 0;
+
+	if(f == NULL || in == NULL || out == NULL)
+		return 0;
+
+	history = f->num_taps - 1;
+
+	while(count > 0)
+	{
+		n = count < f->block_size ? count : f->block_size;
+
+		memcpy(&f->state[history], in, n * sizeof(float));
+
+		for(i = f->phase; i < n; i += f->decimation)
+			out[out_count++] = _fir_float_dot(&f->state[i], f->coeffs, f->num_taps);
+
+		f->phase = (uint8_t)(i - n);
+
+		memmove(f->state, &f->state[n], history * sizeof(float));
+		in += n;
+		count -= n;
+	}
+
+	return out_count;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static q15_t _fir_q15_dot(const q15_t* x, const q15_t* b, uint16_t num_taps)
+{
+	// Each product is at most 2^30 and the sum of the coefficients is below 2.0, so 32-bit is enough.
+	int32_t acc = 0;
+	uint16_t i;
+
+	for(i = 0; i < num_taps; i++)
+		acc += (int32_t)x[i] * (int32_t)b[i];
+
+	return filter_saturate_q15(((int64_t)acc + (1L << 14)) >> 15);
+}
+
+static q31_t _fir_q31_dot(const q31_t* x, const q31_t* b, uint16_t num_taps)
+{
+	int64_t acc = 0;
+	uint16_t i;
+
+	for(i = 0; i < num_taps; i++)
+		acc += (int64_t)x[i] * (int64_t)b[i];
+
+	return filter_saturate_q31((acc >> 31) + ((acc >> 30) & 1));
+}
+
+static float _fir_float_dot(const float* x, const float* b, uint16_t num_taps)
+{
+	float acc = 0.0f;
+	uint16_t i;
+
+	for(i = 0; i < num_taps; i++)
+		acc += x[i] * b[i];
+
+	return acc;
+}
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * 	@file 		filter_fir.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		FIR filters and FIR decimators for Q15, Q31 and float samples.
+ *
+ *  			Samples are processed in blocks. Each block is copied behind the last num_taps - 1 samples in the state
+ *  			buffer, so every output is a plain dot product over contiguous memory without ring buffer indices. Compilers
+ *  			can vectorize this loop (e.g. SMLAD on Cortex-M4 or SIMD on the PC). Like in CMSIS-DSP the coefficients are
+ *  			stored in time reversed order, so samples and coefficients are read in the same direction. Symmetric
+ *  			(linear phase) filters are the same in both orders.
+ *
+ *  			With a decimation factor M only every M-th output is calculated, so the filter is also an anti-aliasing
+ *  			decimator that does not waste time on outputs that are thrown away.
+ * @code
+static const q15_t coeffs[5] = {FILTER_Q15(0.1), FILTER_Q15(0.2), FILTER_Q15(0.4), FILTER_Q15(0.2), FILTER_Q15(0.1)};
+static q15_t state[5 - 1 + 64];
+filter_fir_q15_t fir;
+
+filter_fir_q15_init(&fir, coeffs, 5, state, 64, 4);	// Decimates by 4
+n = filter_fir_q15_process(&fir, adc_samples, filtered, 256);	// n = 64
+ * @endcode
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef FILTER_FIR_H_
+#define FILTER_FIR_H_
+
+#include "filter_common.h"
+
+#if MODULE_ENABLE_FILTER
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Number of samples that are needed in the state buffer.
+#define FILTER_FIR_STATE_SIZE(num_taps, block_size)		((num_taps) - 1 + (block_size))
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// FIR filter for Q15 samples.
+typedef struct filter_fir_q15_s
+{
+	/// Coefficients in time reversed order, coeffs[num_taps - 1] is multiplied with the newest sample.
+	const q15_t* coeffs;
+	/// Buffer with FILTER_FIR_STATE_SIZE(num_taps, block_size) samples.
+	q15_t* state;
+	/// Number of coefficients.
+	uint16_t num_taps;
+	/// Maximum number of samples that are processed at once.
+	uint16_t block_size;
+	/// Only every decimation-th output is calculated.
+	uint8_t decimation;
+	/// Index of the next input sample in the next block that creates an output.
+	uint8_t phase;
+}filter_fir_q15_t;
+
+/// FIR filter for Q31 samples.
+typedef struct filter_fir_q31_s
+{
+	/// Coefficients in time reversed order, coeffs[num_taps - 1] is multiplied with the newest sample.
+	const q31_t* coeffs;
+	/// Buffer with FILTER_FIR_STATE_SIZE(num_taps, block_size) samples.
+	q31_t* state;
+	/// Number of coefficients.
+	uint16_t num_taps;
+	/// Maximum number of samples that are processed at once.
+	uint16_t block_size;
+	/// Only every decimation-th output is calculated.
+	uint8_t decimation;
+	/// Index of the next input sample in the next block that creates an output.
+	uint8_t phase;
+}filter_fir_q31_t;
+
+/// FIR filter for float samples.
+typedef struct filter_fir_float_s
+{
+	/// Coefficients in time reversed order, coeffs[num_taps - 1] is multiplied with the newest sample.
+	const float* coeffs;
+	/// Buffer with FILTER_FIR_STATE_SIZE(num_taps, block_size) samples.
+	float* state;
+	/// Number of coefficients.
+	uint16_t num_taps;
+	/// Maximum number of samples that are processed at once.
+	uint16_t block_size;
+	/// Only every decimation-th output is calculated.
+	uint8_t decimation;
+	/// Index of the next input sample in the next block that creates an output.
+	uint8_t phase;
+}filter_fir_float_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a Q15 FIR filter and clears the state. The sum of the absolute coefficients must be below 2.0,
+ * because the products are summed up in 32-bit.
+ *
+ * @param f				Pointer to the filter.
+ * @param coeffs		Coefficients in time reversed order, must stay valid while the filter is used.
+ * @param num_taps		Number of coefficients, at least 1.
+ * @param state			Buffer with FILTER_FIR_STATE_SIZE(num_taps, block_size) samples.
+ * @param block_size	Maximum number of samples that are processed at once. Larger inputs are split.
+ * @param decimation	1 for a normal filter or the factor by which the number of samples is reduced.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_fir_q15_init(filter_fir_q15_t* f, const q15_t* coeffs, uint16_t num_taps, q15_t* state, uint16_t block_size, uint8_t decimation);
+/**
+ * @brief Filters a block of Q15 samples.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for the output samples. Needs count / decimation + 1 entries. Can be the same as in.
+ * @param count			Number of input samples.
+ * @return				Number of output samples.
+ */
+size_t filter_fir_q15_process(filter_fir_q15_t* f, const q15_t* in, q15_t* out, size_t count);
+/**
+ * @brief Initializes a Q31 FIR filter and clears the state. The sum of the absolute coefficients must be below 2.0.
+ *
+ * @param f				Pointer to the filter.
+ * @param coeffs		Coefficients in time reversed order, must stay valid while the filter is used.
+ * @param num_taps		Number of coefficients, at least 1.
+ * @param state			Buffer with FILTER_FIR_STATE_SIZE(num_taps, block_size) samples.
+ * @param block_size	Maximum number of samples that are processed at once. Larger inputs are split.
+ * @param decimation	1 for a normal filter or the factor by which the number of samples is reduced.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_fir_q31_init(filter_fir_q31_t* f, const q31_t* coeffs, uint16_t num_taps, q31_t* state, uint16_t block_size, uint8_t decimation);
+/**
+ * @brief Filters a block of Q31 samples.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for the output samples. Needs count / decimation + 1 entries. Can be the same as in.
+ * @param count			Number of input samples.
+ * @return				Number of output samples.
+ */
+size_t filter_fir_q31_process(filter_fir_q31_t* f, const q31_t* in, q31_t* out, size_t count);
+/**
+ * @brief Initializes a float FIR filter and clears the state.
+ *
+ * @param f				Pointer to the filter.
+ * @param coeffs		Coefficients in time reversed order, must stay valid while the filter is used.
+ * @param num_taps		Number of coefficients, at least 1.
+ * @param state			Buffer with FILTER_FIR_STATE_SIZE(num_taps, block_size) samples.
+ * @param block_size	Maximum number of samples that are processed at once. Larger inputs are split.
+ * @param decimation	1 for a normal filter or the factor by which the number of samples is reduced.
+ * @return				false if a parameter is invalid.
+ */
+bool filter_fir_float_init(filter_fir_float_t* f, const float* coeffs, uint16_t num_taps, float* state, uint16_t block_size, uint8_t decimation);
+/**
+ * @brief Filters a block of float samples.
+ *
+ * @param f				Pointer to the filter.
+ * @param in			Input samples.
+ * @param out			Buffer for the output samples. Needs count / decimation + 1 entries. Can be the same as in.
+ * @param count			Number of input samples.
+ * @return				Number of output samples.
+ */
+size_t filter_fir_float_process(filter_fir_float_t* f, const float* in, float* out, size_t count);
+
+#endif // MODULE_ENABLE_FILTER
+
+#endif /* FILTER_FIR_H_ */
@@ -0,0 +1,512 @@
+/**
+ * @file flash_integrity.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ */
+
+#include "flash_integrity.h"
+
+#if MODULE_ENABLE_FLASH_INTEGRITY && MCU_PERIPHERY_ENABLE_FLASH
+
+#include "module/comm/dbg.h"
+#include "module/crc/crc32.h"
+#include "module/util/assert.h"
+#include "module/util/bit_array.h"
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Marks a stored index. Is changed when the layout of the index changes.
+#define _INDEX_MAGIC				0x46494931
+
+/// Size of the buffer on the stack that is used for reading the flash.
+#define _READ_BUFFER_SIZE			256
+
+#ifdef MCU_CONTROLLER_FLASH_MIN_STEPPING
+/// The index is written in multiples of this size.
+#define _WRITE_STEPPING				MCU_CONTROLLER_FLASH_MIN_STEPPING
+#else
+#define _WRITE_STEPPING				1
+#endif
+
+#ifdef MCU_CONTROLLER_FLASH_BLOCK_SIZE
+/// Size of a block that is erased by mcu_flash_erase.
+#define _ERASE_SIZE					MCU_CONTROLLER_FLASH_BLOCK_SIZE
+#else
+#define _ERASE_SIZE					4096
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal structures and enums
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Header of the index in flash. Is followed by the CRC of each block.
+typedef struct _index_header_s
+{
+	/// Is _INDEX_MAGIC for a stored index.
+	uint32_t magic;
+	/// Start address of the region.
+	uint32_t address;
+	/// Size of the region.
+	uint32_t size;
+	/// Size of the blocks.
+	uint32_t block_size;
+	/// CRC over the block CRCs.
+	uint32_t crc;
+}_index_header_t;
+
+/// Context of a flash region.
+struct flash_integrity_s
+{
+	/// Configuration of the region.
+	flash_integrity_config_t config;
+	/// Number of blocks in the region.
+	size_t block_count;
+	/// Index as it is stored in the flash. Contains the header followed by the block CRCs.
+	_index_header_t* index;
+	/// Points to the block CRCs behind the header.
+	uint32_t* block_crc;
+	/// Number of bytes of the index that are written into the flash.
+	uint32_t index_size;
+	/// Blocks that were modified since the last commit.
+	bit_array_handle_t dirty;
+	/// true if the flash contains an index that matches the ram.
+	bool index_stored;
+	/// Next block that is checked by the scrub task.
+	size_t scrub_block;
+	/// Tick count of the last scrub step.
+	uint32_t scrub_timestamp;
+	/// Task for the scrub.
+	system_task_t task;
+};
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the flash address of a block.
+ */
+static uint32_t _block_address(flash_integrity_handle_t h, size_t block);
+/**
+ * @brief Returns the size of a block. Only the last block can be smaller than the block size.
+ */
+static uint32_t _block_size(flash_integrity_handle_t h, size_t block);
+/**
+ * @brief Calculates the CRC of a block from the flash.
+ *
+ * @param h				Handle of the region.
+ * @param block			Index of the block.
+ * @param crc			Pointer where the CRC is stored.
+ * @return				false if the flash could not be read.
+ */
+static bool _calc_block(flash_integrity_handle_t h, size_t block, uint32_t* crc);
+/**
+ * @brief Checks a block and calls the error callback if it is damaged.
+ */
+static bool _check_block(flash_integrity_handle_t h, size_t block);
+/**
+ * @brief Calculates the CRC over the block CRCs that is stored in the header.
+ */
+static uint32_t _calc_index_crc(flash_integrity_handle_t h);
+/**
+ * @brief Erases all erasable blocks between start and end.
+ *
+ * @param start			Flash address of the first byte. Is rounded down to the erasable block.
+ * @param end			Flash address behind the last byte.
+ * @return				false if an erase failed.
+ */
+static bool _erase_range(uint32_t start, uint32_t end);
+/**
+ * @brief Erases the stored index, so an interrupted update is detected at the next start.
+ */
+static void _invalidate_index(flash_integrity_handle_t h);
+/**
+ * @brief Task for the scrub. Checks one block per FLASH_INTEGRITY_SCRUB_INTERVAL_MS.
+ */
+static void _handle_scrub(void* obj);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+flash_integrity_handle_t flash_integrity_create(const flash_integrity_config_t* config)
+{
+	flash_integrity_handle_t h;
+	uint32_t block_size;
+	size_t index_size;
+	size_t block_count;
+	uint32_t index_start, index_end;
+
+	ASSERT_RET(config && config->size > 0, NO_ACTION, NULL, "Invalid flash integrity config\n");
+
+	block_size = config->block_size ? config->block_size : FLASH_INTEGRITY_BLOCK_SIZE;
+	block_count = (config->size + block_size - 1) / block_size;
+	index_size = sizeof(_index_header_t) + block_count * sizeof(uint32_t);
+	index_size = ((index_size + _WRITE_STEPPING - 1) / _WRITE_STEPPING) * _WRITE_STEPPING;
+
+	// The index can span several erasable blocks, which are all erased when it is saved.
+	index_start = config->index_address - config->index_address % _ERASE_SIZE;
+	index_end = config->index_address + index_size + (_ERASE_SIZE - 1);
+	index_end -= index_end % _ERASE_SIZE;
+	ASSERT_RET(config->index_address == FLASH_INTEGRITY_NO_INDEX
+				|| index_end <= config->address || index_start >= config->address + config->size,
+				NO_ACTION, NULL, "Index cannot overlap the region\n");
+
+	h = mcu_heap_calloc(1, sizeof(struct flash_integrity_s));
+	ASSERT_RET_NOT_NULL(h, NO_ACTION, NULL);
+
+	memcpy(&h->config, config, sizeof(flash_integrity_config_t));
+	h->config.block_size = block_size;
+	h->block_count = block_count;
+	h->index_size = index_size;
+	h->index = mcu_heap_calloc(1, index_size);
+	h->dirty = bit_array_create(h->block_count);
+
+	if(h->index == NULL || h->dirty == NULL)
+	{
+		DBG_ERROR("Not enough memory for the flash integrity index\n");
+		flash_integrity_free(h);
+		return NULL;
+	}
+
+	// Padding is written like erased flash.
+	memset(h->index, 0xFF, index_size);
+	h->block_crc = (uint32_t*)(h->index + 1);
+	h->index->magic = _INDEX_MAGIC;
+	h->index->address = config->address;
+	h->index->size = config->size;
+	h->index->block_size = block_size;
+
+	bit_array_set_range(h->dirty, 0, h->block_count);
+
+	system_task_init_handle(&h->task, false, _handle_scrub, h);
+	system_task_set_name(&h->task, "flash_integrity");
+
+	return h;
+}
+
+void flash_integrity_free(flash_integrity_handle_t h)
+{
+	if(h == NULL)
+		return;
+
+	flash_integrity_scrub_stop(h);
+
+	if(h->dirty)
+		bit_array_free(h->dirty);
+
+	if(h->index)
+		mcu_heap_free(h->index);
+
+	mcu_heap_free(h);
+}
+
+FUNCTION_RETURN_T flash_integrity_load(flash_integrity_handle_t h)
+{
+	_index_header_t header;
+
+	ASSERT_RET(h && h->config.index_address != FLASH_INTEGRITY_NO_INDEX, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Region has no index\n");
+
+	// Check the header first, so a wrong index does not overwrite the block CRCs.
+	if(!mcu_flash_read((FLASH_PTR_TYPE)h->config.index_address, (BUF_PTR_TYPE)&header, sizeof(header))
+		|| header.magic != h->index->magic
+		|| header.address != h->index->address
+		|| header.size != h->index->size
+		|| header.block_size != h->index->block_size)
+	{
+		bit_array_set_range(h->dirty, 0, h->block_count);
+		return FUNCTION_RETURN_NOT_FOUND;
+	}
+
+	if(!mcu_flash_read((FLASH_PTR_TYPE)(h->config.index_address + sizeof(_index_header_t)), (BUF_PTR_TYPE)h->block_crc, h->block_count * sizeof(uint32_t))
+		|| _calc_index_crc(h) != header.crc)
+	{
+		bit_array_set_range(h->dirty, 0, h->block_count);
+		return FUNCTION_RETURN_NOT_FOUND;
+	}
+
+	h->index->crc = header.crc;
+	h->index_stored = true;
+	bit_array_clear_all(h->dirty);
+
+	return FUNCTION_RETURN_OK;
+}
+
+bool flash_integrity_write(flash_integrity_handle_t h, uint32_t address, const uint8_t* data, uint32_t size)
+{
+	ASSERT_RET(h && data, NO_ACTION, false, "Invalid flash integrity write\n");
+	ASSERT_RET(address >= h->config.address && size <= h->config.size && address - h->config.address <= h->config.size - size,
+				NO_ACTION, false, "Write is outside of the region\n");
+
+	// Mark before writing, so the stored index is already invalid if the write is interrupted.
+	flash_integrity_mark_dirty(h, address, size);
+
+	return mcu_flash_write((FLASH_PTR_TYPE)address, (BUF_PTR_TYPE)data, size);
+}
+
+bool flash_integrity_erase(flash_integrity_handle_t h, uint32_t address, uint32_t size)
+{
+	uint32_t start, end;
+
+	ASSERT_RET(h, NO_ACTION, false, "Invalid flash integrity handle\n");
+
+	if(size == 0)
+		return true;
+
+	// Whole erasable blocks are erased, so the rounded range must be inside the region.
+	start = address - address % _ERASE_SIZE;
+	end = address + size + (_ERASE_SIZE - 1);
+	end -= end % _ERASE_SIZE;
+	ASSERT_RET(start >= h->config.address && end > start && end - h->config.address <= h->config.size,
+				NO_ACTION, false, "Erase is outside of the region\n");
+
+	flash_integrity_mark_dirty(h, start, end - start);
+
+	return _erase_range(start, end);
+}
+
+void flash_integrity_mark_dirty(flash_integrity_handle_t h, uint32_t address, uint32_t size)
+{
+	uint32_t start, end;
+
+	if(h == NULL)
+		return;
+
+	// Clip to the region
+	start = address > h->config.address ? address : h->config.address;
+	end = address + size < h->config.address + h->config.size ? address + size : h->config.address + h->config.size;
+	if(start >= end)
+		return;
+
+	_invalidate_index(h);
+
+	start = (start - h->config.address) / h->config.block_size;
+	end = (end - 1 - h->config.address) / h->config.block_size;
+	bit_array_set_range(h->dirty, start, end - start + 1);
+}
+
+FUNCTION_RETURN_T flash_integrity_commit(flash_integrity_handle_t h)
+{
+	ASSERT_RET_NOT_NULL(h, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR);
+
+	for(size_t i = bit_array_find_next_set(h->dirty, 0); i != BIT_ARRAY_NOT_FOUND; i = bit_array_find_next_set(h->dirty, i + 1))
+	{
+		if(!_calc_block(h, i, &h->block_crc[i]))
+			return FUNCTION_RETURN_READ_ERROR;
+
+		bit_array_clear(h->dirty, i);
+	}
+
+	h->index->crc = _calc_index_crc(h);
+
+	if(h->config.index_address == FLASH_INTEGRITY_NO_INDEX)
+		return FUNCTION_RETURN_OK;
+
+	// The old index is always erased, because it might be a damaged one from a previous start.
+	if(!_erase_range(h->config.index_address, h->config.index_address + h->index_size)
+		|| !mcu_flash_write((FLASH_PTR_TYPE)h->config.index_address, (BUF_PTR_TYPE)h->index, h->index_size))
+	{
+		DBG_ERROR("Saving the flash integrity index failed\n");
+		return FUNCTION_RETURN_WRITE_ERROR;
+	}
+
+	h->index_stored = true;
+
+	return FUNCTION_RETURN_OK;
+}
+
+bool flash_integrity_verify_block(flash_integrity_handle_t h, size_t block)
+{
+	uint32_t crc;
+
+	if(h == NULL || block >= h->block_count || bit_array_is_set(h->dirty, block))
+		return true;
+
+	return _calc_block(h, block, &crc) && crc == h->block_crc[block];
+}
+
+size_t flash_integrity_verify(flash_integrity_handle_t h)
+{
+	size_t errors = 0;
+
+	if(h == NULL)
+		return 0;
+
+	for(size_t i = 0; i < h->block_count; i++)
+	{
+		if(!_check_block(h, i))
+			errors++;
+	}
+
+	return errors;
+}
+
+bool flash_integrity_scrub_step(flash_integrity_handle_t h)
+{
+	size_t block;
+
+	if(h == NULL)
+		return true;
+
+	block = h->scrub_block;
+	h->scrub_block = (block + 1) % h->block_count;
+
+	return _check_block(h, block);
+}
+
+void flash_integrity_scrub_start(flash_integrity_handle_t h)
+{
+	if(h == NULL)
+		return;
+
+	h->scrub_timestamp = system_get_tick_count();
+	system_task_add(&h->task);
+}
+
+void flash_integrity_scrub_stop(flash_integrity_handle_t h)
+{
+	if(h == NULL)
+		return;
+
+	system_task_remove(&h->task);
+}
+
+FUNCTION_RETURN_T flash_integrity_get_crc(flash_integrity_handle_t h, uint32_t* crc)
+{
+	uint32_t c;
+
+	ASSERT_RET(h && crc, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid parameter\n");
+
+	if(bit_array_has_any_set(h->dirty))
+		return FUNCTION_RETURN_NOT_READY;
+
+	c = h->block_crc[0];
+	for(size_t i = 1; i < h->block_count; i++)
+		c = crc32_combine(c, h->block_crc[i], _block_size(h, i));
+
+	*crc = c;
+
+	return FUNCTION_RETURN_OK;
+}
+
+size_t flash_integrity_get_block_count(flash_integrity_handle_t h)
+{
+	if(h == NULL)
+		return 0;
+
+	return h->block_count;
+}
+
+size_t flash_integrity_get_dirty_count(flash_integrity_handle_t h)
+{
+	if(h == NULL)
+		return 0;
+
+	return bit_array_count(h->dirty);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint32_t _block_address(flash_integrity_handle_t h, size_t block)
+{
+	return h->config.address + block * h->config.block_size;
+}
+
+static uint32_t _block_size(flash_integrity_handle_t h, size_t block)
+{
+	uint32_t offset = block * h->config.block_size;
+	uint32_t size = h->config.size - offset;
+
+	return size < h->config.block_size ? size : h->config.block_size;
+}
+
+static bool _calc_block(flash_integrity_handle_t h, size_t block, uint32_t* crc)
+{
+	uint8_t buffer[_READ_BUFFER_SIZE];
+	uint32_t address = _block_address(h, block);
+	uint32_t remaining = _block_size(h, block);
+	crc32_t c;
+
+	CRC32_INIT_DEFAULT(&c);
+	crc32_start(&c);
+
+	while(remaining)
+	{
+		uint32_t len = remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+
+		if(!mcu_flash_read((FLASH_PTR_TYPE)address, (BUF_PTR_TYPE)buffer, len))
+			return false;
+
+		crc32_update(&c, buffer, len);
+		address += len;
+		remaining -= len;
+	}
+
+	*crc = crc32_finish(&c);
+
+	return true;
+}
+
+static bool _check_block(flash_integrity_handle_t h, size_t block)
+{
+	if(flash_integrity_verify_block(h, block))
+		return true;
+
+	DBG_ERROR("Flash block at %08x is damaged\n", _block_address(h, block));
+
+	if(h->config.f_error)
+		h->config.f_error(h, _block_address(h, block), _block_size(h, block), h->config.obj);
+
+	return false;
+}
+
+static uint32_t _calc_index_crc(flash_integrity_handle_t h)
+{
+	crc32_t c;
+
+	CRC32_INIT_DEFAULT(&c);
+	crc32_start(&c);
+	crc32_update(&c, (const uint8_t*)h->block_crc, h->block_count * sizeof(uint32_t));
+
+	return crc32_finish(&c);
+}
+
+static bool _erase_range(uint32_t start, uint32_t end)
+{
+	for(uint32_t address = start - start % _ERASE_SIZE; address < end; address += _ERASE_SIZE)
+	{
+		if(!mcu_flash_erase((ERASE_PTR_TYPE)address))
+			return false;
+	}
+
+	return true;
+}
+
+static void _invalidate_index(flash_integrity_handle_t h)
+{
+	if(!h->index_stored)
+		return;
+
+	h->index_stored = false;
+
+	if(h->config.index_address != FLASH_INTEGRITY_NO_INDEX)
+		_erase_range(h->config.index_address, h->config.index_address + h->index_size);
+}
+
+static void _handle_scrub(void* obj)
+{
+	flash_integrity_handle_t h = (flash_integrity_handle_t)obj;
+	uint32_t now = system_get_tick_count();
+
+	if(now - h->scrub_timestamp < FLASH_INTEGRITY_SCRUB_INTERVAL_MS)
+		return;
+
+	h->scrub_timestamp = now;
+	flash_integrity_scrub_step(h);
+}
+
+#endif // MODULE_ENABLE_FLASH_INTEGRITY
@@ -0,0 +1,232 @@
+/**
+ * 	@file 		flash_integrity.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Keeps a CRC32 for each block of a flash region, so the integrity of the region can be checked without
+ *  			calculating the CRC over the whole region every time.
+ *
+ *  			The block CRCs (the index) are stored in a separate flash block. At startup @see flash_integrity_load only
+ *  			reads and checks the index, which takes milliseconds instead of a full pass over the region. Writes
+ *  			through @see flash_integrity_write mark the touched blocks as dirty and @see flash_integrity_commit only
+ *  			recalculates these blocks and saves the index again. The stored index is erased on the first write after
+ *  			a commit, so an update that is interrupted by a reset is detected at the next start. Writes that bypass the
+ *  			module, e.g. direct mcu_flash_write calls, are not tracked and need @see flash_integrity_mark_dirty.
+ *
+ *  			Bit errors that occur later are found by @see flash_integrity_verify or by the scrub task, which checks one
+ *  			block per FLASH_INTEGRITY_SCRUB_INTERVAL_MS in the background and calls the error callback for each
+ *  			damaged block.
+ * @code
+flash_integrity_config_t config = {.address = BLOCK(16), .size = 64 * 4096, .index_address = BLOCK(15)};
+flash_integrity_handle_t h = flash_integrity_create(&config);
+
+if(flash_integrity_load(h) != FUNCTION_RETURN_OK)
+	flash_integrity_commit(h);	// No valid index, calculate all blocks once.
+
+flash_integrity_scrub_start(h);
+ * @endcode
+ *
+ *  @version	1.01 (18.10.2026)
+ *  	- The index can span several erasable blocks and must not overlap the region
+ *  	- flash_integrity_erase erases all erasable blocks in the given range
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ ******************************************************************************/
+#ifndef FLASH_INTEGRITY_H_
+#define FLASH_INTEGRITY_H_
+
+#include "module_public.h"
+
+#if MODULE_ENABLE_FLASH_INTEGRITY && MCU_PERIPHERY_ENABLE_FLASH
+
+#include "module/enum/function_return.h"
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Configuration
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef FLASH_INTEGRITY_BLOCK_SIZE
+/// Default size of the blocks that have their own CRC in bytes.
+#define FLASH_INTEGRITY_BLOCK_SIZE				4096
+#endif
+
+#ifndef FLASH_INTEGRITY_SCRUB_INTERVAL_MS
+/// Interval in milliseconds in which the scrub task checks one block.
+#define FLASH_INTEGRITY_SCRUB_INTERVAL_MS		10
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Version of the flash_integrity module
+#define FLASH_INTEGRITY_STR_VERSION				"1.01"
+
+/// Can be used as index_address if the index should only be kept in ram.
+#define FLASH_INTEGRITY_NO_INDEX				0xFFFFFFFF
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Handle for a flash region.
+typedef struct flash_integrity_s* flash_integrity_handle_t;
+
+/**
+ * @brief Is called when the content of a block does not match its CRC.
+ *
+ * @param h				Handle of the region.
+ * @param address		Flash address of the damaged block.
+ * @param size			Size of the damaged block.
+ * @param obj			User-defined pointer from the configuration.
+ */
+typedef void (*flash_integrity_error_cb_t)(flash_integrity_handle_t h, uint32_t address, uint32_t size, void* obj);
+
+/// Configuration of a flash region.
+typedef struct flash_integrity_config_s
+{
+	/// Flash address where the region starts.
+	uint32_t address;
+	/// Size of the region in bytes.
+	uint32_t size;
+	/// Flash address where the index is stored. The index needs 20 + 4 bytes per block and all erasable blocks it spans
+	/// are erased when it is saved, so they must not overlap the region.
+	/// Use FLASH_INTEGRITY_NO_INDEX to keep the index only in ram.
+	uint32_t index_address;
+	/// Size of the blocks in bytes. If 0, FLASH_INTEGRITY_BLOCK_SIZE is used.
+	uint32_t block_size;
+	/// Optional callback for damaged blocks.
+	flash_integrity_error_cb_t f_error;
+	/// User-defined pointer for f_error.
+	void* obj;
+}flash_integrity_config_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates the handle for a flash region. All blocks are marked as dirty until the index is loaded or committed.
+ *
+ * @param config		Configuration of the region. Is copied into the handle.
+ * @return				Handle or NULL if the configuration is invalid or there is not enough memory.
+ */
+flash_integrity_handle_t flash_integrity_create(const flash_integrity_config_t* config);
+/**
+ * @brief Stops the scrub task and frees the handle. Does not modify the flash.
+ *
+ * @param h				Handle of the region.
+ */
+void flash_integrity_free(flash_integrity_handle_t h);
+/**
+ * @brief Loads the index from the flash. Only the index is read and checked, not the region itself.
+ *
+ * @param h				Handle of the region.
+ * @retval FUNCTION_RETURN_OK					Index was loaded, all blocks are clean.
+ * @retval FUNCTION_RETURN_NOT_FOUND			No valid index was found, e.g. because it was never saved or an update
+ * 												was interrupted. All blocks are dirty, call @see flash_integrity_commit to
+ * 												calculate them.
+ * @retval FUNCTION_RETURN_PARAM_ERROR			Handle is NULL or has no index address.
+ */
+FUNCTION_RETURN_T flash_integrity_load(flash_integrity_handle_t h);
+/**
+ * @brief Writes into the region using mcu_flash_write and marks the touched blocks as dirty.
+ *
+ * @param h				Handle of the region.
+ * @param address		Flash address inside the region.
+ * @param data			Data that is written.
+ * @param size			Number of bytes.
+ * @return				Return value of mcu_flash_write or false if the data is not inside the region.
+ */
+bool flash_integrity_write(flash_integrity_handle_t h, uint32_t address, const uint8_t* data, uint32_t size);
+/**
+ * @brief Erases all erasable flash blocks that contain the range using mcu_flash_erase and marks them as dirty.
+ *
+ * @param h				Handle of the region.
+ * @param address		Flash address of the first byte that is erased.
+ * @param size			Number of bytes that are erased. The range is extended to whole erasable blocks.
+ * @return				false if an erase failed or the extended range is not inside the region.
+ */
+bool flash_integrity_erase(flash_integrity_handle_t h, uint32_t address, uint32_t size);
+/**
+ * @brief Marks blocks as dirty. Needs to be called if the region was modified without @see flash_integrity_write.
+ *
+ * @param h				Handle of the region.
+ * @param address		Flash address of the modified data.
+ * @param size			Number of modified bytes.
+ */
+void flash_integrity_mark_dirty(flash_integrity_handle_t h, uint32_t address, uint32_t size);
+/**
+ * @brief Calculates the CRC of all dirty blocks and saves the index.
+ *
+ * @param h				Handle of the region.
+ * @retval FUNCTION_RETURN_OK					All blocks are clean and the index was saved.
+ * @retval FUNCTION_RETURN_READ_ERROR			A block could not be read.
+ * @retval FUNCTION_RETURN_WRITE_ERROR			The index could not be saved.
+ * @retval FUNCTION_RETURN_PARAM_ERROR			Handle is NULL.
+ */
+FUNCTION_RETURN_T flash_integrity_commit(flash_integrity_handle_t h);
+/**
+ * @brief Checks a single block against its CRC. Dirty blocks are always reported as valid.
+ *
+ * @param h				Handle of the region.
+ * @param block			Index of the block.
+ * @return				true if the block matches its CRC.
+ */
+bool flash_integrity_verify_block(flash_integrity_handle_t h, size_t block);
+/**
+ * @brief Checks all blocks of the region and calls the error callback for each damaged block.
+ *
+ * @param h				Handle of the region.
+ * @return				Number of damaged blocks.
+ */
+size_t flash_integrity_verify(flash_integrity_handle_t h);
+/**
+ * @brief Checks the next block of the region. Is called by the scrub task, but can also be called manually.
+ *
+ * @param h				Handle of the region.
+ * @return				true if the block matches its CRC.
+ */
+bool flash_integrity_scrub_step(flash_integrity_handle_t h);
+/**
+ * @brief Starts the scrub task, which checks one block each FLASH_INTEGRITY_SCRUB_INTERVAL_MS in the system task list.
+ *
+ * @param h				Handle of the region.
+ */
+void flash_integrity_scrub_start(flash_integrity_handle_t h);
+/**
+ * @brief Stops the scrub task.
+ *
+ * @param h				Handle of the region.
+ */
+void flash_integrity_scrub_stop(flash_integrity_handle_t h);
+/**
+ * @brief Returns the CRC32 of the whole region, which is combined from the block CRCs without reading the flash.
+ * Can be compared with the CRC of an image, e.g. after a software update.
+ *
+ * @param h				Handle of the region.
+ * @param crc			Pointer where the CRC is stored.
+ * @retval FUNCTION_RETURN_OK					CRC was stored.
+ * @retval FUNCTION_RETURN_NOT_READY			There are dirty blocks, call @see flash_integrity_commit first.
+ * @retval FUNCTION_RETURN_PARAM_ERROR			Handle or crc is NULL.
+ */
+FUNCTION_RETURN_T flash_integrity_get_crc(flash_integrity_handle_t h, uint32_t* crc);
+/**
+ * @brief Returns the number of blocks of the region.
+ *
+ * @param h				Handle of the region.
+ * @return				Number of blocks.
+ */
+size_t flash_integrity_get_block_count(flash_integrity_handle_t h);
+/**
+ * @brief Returns the number of blocks that were modified since the last commit.
+ *
+ * @param h				Handle of the region.
+ * @return				Number of dirty blocks.
+ */
+size_t flash_integrity_get_dirty_count(flash_integrity_handle_t h);
+
+#endif // MODULE_ENABLE_FLASH_INTEGRITY
+
+#endif /* FLASH_INTEGRITY_H_ */
@@ -151,6 +151,7 @@ bool eve_init(eve_t* obj, eve_hw_interface_t* hw, EVE_DISPLAY_TYPE type, bool ro
 #endif
 #endif
 	memset(obj->memory_files, 0, sizeof(obj->memory_files));
+	hash_map_init(&obj->memory_files_map, HASH_MAP_KEY_STRING, obj->memory_files_map_entries, HASH_MAP_CAPACITY(EVE_MEMORY_FILES_MAX));
 #if EVE_COPRO_DEBUG_COMMAND_COUNT
 	obj->eve_copro_cmd_cnt = 0;
 #endif
@@ -57,6 +57,7 @@
 #include "module_public.h"
 #if MODULE_ENABLE_GUI
 #include "mcu/sys.h"
+#include "module/util/hash_map.h"
 #include "../eve_ui/color.h"
 #include "eve_register.h"
 #include "eve_errorcodes.h"
@@ -333,6 +334,12 @@ typedef struct
 	///
 	eve_memory_file_t memory_files[EVE_MEMORY_FILES_MAX];
 
+	/// Index of memory_files by their filename.
+	hash_map_t memory_files_map;
+
+	/// Storage for memory_files_map.
+	hash_map_entry_t memory_files_map_entries[HASH_MAP_CAPACITY(EVE_MEMORY_FILES_MAX)];
+
 	/// Pointer to a structure that can be set for the error callback.
 	void* error_obj;
 
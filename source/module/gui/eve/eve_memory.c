@@ -62,6 +62,15 @@ static bool _load_from_file(eve_t* eve, eve_memory_file_t* obj);
  */
 static bool _load_from_flash(eve_t* eve, eve_memory_file_t* obj);
 
+/**
+ * @brief	Returns the memory object with the filename or the next unused memory object.
+ *
+ * @param eve		Pointer to the eve
+ * @param filename	Filename of the memory object.
+ * @return			Registered memory object, unused memory object with filename NULL or NULL if all memory objects are used.
+ */
+static eve_memory_file_t* _get_file(eve_t* eve, const char* filename);
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -84,56 +93,42 @@ void eve_memory_clear(eve_t* eve)
 
 eve_memory_file_t* eve_memory_register(eve_t* eve, const char* filename, const uint8_t* data, uint32_t length)
 {
-	uint16_t i;
+	eve_memory_file_t* mf;
 	if(eve == NULL)
 		return NULL;
 
-	for(i = 0; i < EVE_MEMORY_FILES_MAX; i++)
+	mf = _get_file(eve, filename);
+	// New memory object!
+	if(mf && mf->filename == NULL)
 	{
-		// New memory object!
-		if(eve->memory_files[i].filename == NULL)
-		{
-			eve->memory_files[i].filename = filename;
-			eve->memory_files[i].data = data;
-			eve->memory_files[i].data_length = length;
-			eve->memory_files[i].flash_address = 0;	// Set to invalid address
-//			dbg_printf(DBG_STRING, "Register %s at %d\n", filename, i);
-			return &eve->memory_files[i];
-		}
-		if(strcmp(eve->memory_files[i].filename, filename) == 0)
-		{
-//			dbg_printf(DBG_STRING, "Return %s at %d\n", filename, i);
-			return &eve->memory_files[i];
-		}
+		mf->filename = filename;
+		mf->data = data;
+		mf->data_length = length;
+		mf->flash_address = 0;	// Set to invalid address
+//		dbg_printf(DBG_STRING, "Register %s\n", filename);
+		hash_map_put_str(&eve->memory_files_map, filename, mf);
 	}
-	return NULL;
+	return mf;
 }
 
 eve_memory_file_t* eve_memory_register_from_external_flash(eve_t* eve, const char* filename, uint32_t flash_address, uint32_t length)
 {
-	uint16_t i;
+	eve_memory_file_t* mf;
 	if(eve == NULL)
 		return NULL;
 
-	for(i = 0; i < EVE_MEMORY_FILES_MAX; i++)
+	mf = _get_file(eve, filename);
+	// New memory object!
+	if(mf && mf->filename == NULL)
 	{
-		// New memory object!
-		if(eve->memory_files[i].filename == NULL)
-		{
-			eve->memory_files[i].filename = filename;
-			eve->memory_files[i].flash_address = flash_address;
-			eve->memory_files[i].data = NULL;
-			eve->memory_files[i].data_length = length;
-//			dbg_printf(DBG_STRING, "Register %s at %d\n", filename, i);
-			return &eve->memory_files[i];
-		}
-		if(strcmp(eve->memory_files[i].filename, filename) == 0)
-		{
-//			dbg_printf(DBG_STRING, "Return %s at %d\n", filename, i);
-			return &eve->memory_files[i];
-		}
+		mf->filename = filename;
+		mf->flash_address = flash_address;
+		mf->data = NULL;
+		mf->data_length = length;
+//		dbg_printf(DBG_STRING, "Register %s\n", filename);
+		hash_map_put_str(&eve->memory_files_map, filename, mf);
 	}
-	return NULL;
+	return mf;
 }
 
 uint32_t eve_memory_get_address(eve_t* eve, uint32_t space_needed)
@@ -202,6 +197,22 @@ bool eve_memory_write_file_to(eve_t* eve, eve_memory_file_t* mfo)
 // Internal Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+static eve_memory_file_t* _get_file(eve_t* eve, const char* filename)
+{
+	uint16_t i;
+	eve_memory_file_t* mf = hash_map_get_str(&eve->memory_files_map, filename);
+
+	if(mf)
+		return mf;
+
+	// Memory objects are used in order, so the map has the count of used objects.
+	i = hash_map_count(&eve->memory_files_map);
+	if(i < EVE_MEMORY_FILES_MAX)
+		return &eve->memory_files[i];
+
+	return NULL;
+}
+
 
 #if EVE_MMC_READ_BUFFER_SIZE > 0
 static bool _load_from_file(eve_t* eve, eve_memory_file_t* obj)
@@ -8,6 +8,7 @@
 #if MODULE_ENABLE_LED
 #include "mcu/sys.h"
 #include "module/list/list.h"
+#include "module/util/hash_map.h"
 
 #if MODULE_ENABLE_DEBUG_CONSOLE
 #include "module/console/console.h"
@@ -49,6 +50,8 @@ static FUNCTION_RETURN _console(console_data_t* data, char** args, uint8_t args_
 
 /// List of initialized LED's.
 static list_t _list = {0};
+/// LED's by their name for led_get_pointer. Is empty if it could not be allocated, then _list is searched.
+static hash_map_t _map = {0};
 /// Is cleared when led_register is called for the first time. Is used to ensure the list is initialized only once and the led console is only added once.
 static bool _first_register = true;
 /// Structure for the console command
@@ -88,16 +91,27 @@ FUNCTION_RETURN led_register(led_t* s, const char* name)
 	{
 		_first_register = false;
 		list_init(&_list, s, &s->next);
+		hash_map_init_dynamic(&_map, HASH_MAP_KEY_STRING, 8);
 		console_add_command(&_cmd);
 	}
 	s->task.name = name;
-	return list_add(&_list, s);
+
+	FUNCTION_RETURN ret = list_add(&_list, s);
+	// Like searching the list, the first LED with a name is found, so a duplicate name is not added to the map.
+	if(ret == FUNCTION_RETURN_OK && name != NULL && hash_map_get_str(&_map, name) == NULL && hash_map_put_str(&_map, name, s) != FUNCTION_RETURN_OK)
+	{
+		// Fall back to searching the list
+		hash_map_free(&_map);
+	}
+	return ret;
 }
 
 led_t* led_get_pointer(const char* name)
 {
 	if(name == NULL)
 		return NULL;
+	if(_map.entries)
+		return hash_map_get_str(&_map, name);
 	led_t* ptr = list_get_first(&_list);
 	while(ptr)
 	{
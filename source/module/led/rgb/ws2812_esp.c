@@ -145,9 +145,9 @@ void ws2812_free(ws2812_handle_t ws2812)
         spi_bus_free(2);
     }
 
-    mcu_heap_free(ws2812->led_buffer[0].buffer);
+    heap_caps_free(ws2812->led_buffer[0].buffer);
 #if WS2812_USE_DOUBLE_BUFFER
-    mcu_heap_free(ws2812->led_buffer[1].buffer);
+    heap_caps_free(ws2812->led_buffer[1].buffer);
 #endif
     mcu_heap_free(ws2812);
 }
@@ -0,0 +1,193 @@
+/**
+ * 	@file 	dlist.c
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ */
+
+#include "dlist.h"
+
+//------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//------------------------------------------------------------------------------------------------------------
+
+/// Returns the node of an element
+#define _NODE(list, s)			((dlist_node_t*)((uintptr_t)(s) + (list)->offset_node))
+/// Returns the element of a node or NULL if the node is NULL
+#define _ELEMENT(list, n)		((n) ? (void*)((uintptr_t)(n) - (list)->offset_node) : NULL)
+
+//------------------------------------------------------------------------------------------------------------
+// Prototypes
+//------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Returns true if the node is linked inside the list.
+ */
+static bool _is_linked(dlist_t* list, dlist_node_t* n);
+
+/**
+ * @brief Links the node n in front of the node pos. If pos is NULL, n is added at the end.
+ */
+static void _link_before(dlist_t* list, dlist_node_t* n, dlist_node_t* pos);
+
+//------------------------------------------------------------------------------------------------------------
+// External functions
+//------------------------------------------------------------------------------------------------------------
+
+FUNCTION_RETURN dlist_init(dlist_t* list, void* s, void* s_node)
+{
+	if(list == NULL)
+		return FUNCTION_RETURN_PARAM_ERROR;
+
+	list->first = NULL;
+	list->last = NULL;
+	list->offset_node = (uintptr_t)s_node - (uintptr_t)s;
+	list->count = 0;
+
+	return FUNCTION_RETURN_OK;
+}
+
+FUNCTION_RETURN dlist_add_element(dlist_t* list, void* s)
+{
+	if(list == NULL || s == NULL)
+		return FUNCTION_RETURN_PARAM_ERROR;
+
+	if(_is_linked(list, _NODE(list, s)))
+		return FUNCTION_RETURN_NOT_READY;
+
+	_link_before(list, _NODE(list, s), NULL);
+
+	return FUNCTION_RETURN_OK;
+}
+
+FUNCTION_RETURN dlist_insert_sorted(dlist_t* list, void* s, dlist_compare_cb_t compare)
+{
+	dlist_node_t* pos;
+
+	if(list == NULL || s == NULL || compare == NULL)
+		return FUNCTION_RETURN_PARAM_ERROR;
+
+	if(_is_linked(list, _NODE(list, s)))
+		return FUNCTION_RETURN_NOT_READY;
+
+	// Search from the end for the last element that is not ordered after s. s is added behind it.
+	pos = list->last;
+	while(pos && compare(_ELEMENT(list, pos), s) > 0)
+	{
+		pos = pos->prev;
+	}
+
+	_link_before(list, _NODE(list, s), pos ? pos->next : list->first);
+
+	return FUNCTION_RETURN_OK;
+}
+
+FUNCTION_RETURN dlist_remove_element(dlist_t* list, void* s)
+{
+	dlist_node_t* n;
+
+	if(list == NULL || s == NULL)
+		return FUNCTION_RETURN_PARAM_ERROR;
+
+	n = _NODE(list, s);
+
+	if(!_is_linked(list, n))
+		return FUNCTION_RETURN_NOT_FOUND;
+
+	if(n->prev)
+		n->prev->next = n->next;
+	else
+		list->first = n->next;
+
+	if(n->next)
+		n->next->prev = n->prev;
+	else
+		list->last = n->prev;
+
+	n->next = NULL;
+	n->prev = NULL;
+	list->count--;
+
+	return FUNCTION_RETURN_OK;
+}
+
+void* dlist_pop_first(dlist_t* list)
+{
+	void* s = dlist_first_element(list);
+
+	if(s)
+		dlist_remove_element(list, s);
+
+	return s;
+}
+
+void* dlist_first_element(dlist_t* list)
+{
+	if(list == NULL)
+		return NULL;
+
+	return _ELEMENT(list, list->first);
+}
+
+void* dlist_last_element(dlist_t* list)
+{
+	if(list == NULL)
+		return NULL;
+
+	return _ELEMENT(list, list->last);
+}
+
+void* dlist_next_element(dlist_t* list, void* s)
+{
+	if(list == NULL || s == NULL)
+		return NULL;
+
+	return _ELEMENT(list, _NODE(list, s)->next);
+}
+
+void* dlist_prev_element(dlist_t* list, void* s)
+{
+	if(list == NULL || s == NULL)
+		return NULL;
+
+	return _ELEMENT(list, _NODE(list, s)->prev);
+}
+
+size_t dlist_count(dlist_t* list)
+{
+	if(list == NULL)
+		return 0;
+
+	return list->count;
+}
+
+//------------------------------------------------------------------------------------------------------------
+// Internal functions
+//------------------------------------------------------------------------------------------------------------
+
+static bool _is_linked(dlist_t* list, dlist_node_t* n)
+{
+	// Only the first element has no predecessor, so a node without one is only linked if it is the first.
+	return n->prev != NULL || list->first == n;
+}
+
+static void _link_before(dlist_t* list, dlist_node_t* n, dlist_node_t* pos)
+{
+	n->next = pos;
+
+	if(pos)
+	{
+		n->prev = pos->prev;
+		pos->prev = n;
+	}
+	else
+	{
+		n->prev = list->last;
+		list->last = n;
+	}
+
+	if(n->prev)
+		n->prev->next = n;
+	else
+		list->first = n;
+
+	list->count++;
+}
@@ -0,0 +1,187 @@
+/**
+ * 	@file 	dlist.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ * 	@author Tim Koczwara
+ *
+ *  @brief
+ *  		Doubly linked variant of the list module. Like the list module it works on your own structures, which need to
+ *  		contain a dlist_node_t that is used by this module. Do not manipulate the node manually.
+ *
+ *  		In contrast to list_t, adding to the end and removing an element are O(1), because the list keeps a pointer to
+ *  		the last element and each element knows its predecessor. dlist_insert_sorted keeps the list ordered by a compare
+ *  		function, which can be used for deadline ordered lists. It searches from the end, so inserting elements that
+ *  		are mostly in order is fast.
+ *
+ *  		The node of an element must be zero initialized (e.g. with mcu_heap_calloc or memset) before it is added the first
+ *  		time. After removal the node is zeroed again by this module.
+ *
+ *  		Elements can be removed while iterating, as long as the next element is retrieved before removing the current one:
+ * @code
+void* it = dlist_first_element(&list);
+while(it)
+{
+	void* next = dlist_next_element(&list, it);
+	if(must_remove(it))
+		dlist_remove_element(&list, it);
+	it = next;
+}
+ * @endcode
+ *
+ *  @version  	1.00 (18.10.2026)
+ *  	- Initial release
+ *
+ ******************************************************************************/
+
+#ifndef MODULE_LIST_DLIST_H_
+#define MODULE_LIST_DLIST_H_
+
+#include "module_public.h"
+
+#include "module/enum/function_return.h"
+
+//------------------------------------------------------------------------------------------------------------
+// Structures
+//------------------------------------------------------------------------------------------------------------
+
+/**
+ * Type for the node that needs to be inside the structure of the list elements.
+ */
+typedef struct dlist_node_s dlist_node_t;
+
+/**
+ * @struct dlist_node_s
+ * @brief Links an element to its neighbors. Must be zero initialized before the element is added the first time.
+ */
+struct dlist_node_s
+{
+	/// Pointer to the node of the next element.
+	dlist_node_t* next;
+	/// Pointer to the node of the previous element.
+	dlist_node_t* prev;
+};
+
+/**
+ * Type for the list structure.
+ */
+typedef struct dlist_s dlist_t;
+
+/**
+ * @struct dlist_s
+ * @brief Contains the context for all dlist functions. Use @see dlist_init to initialize the context.
+ */
+struct dlist_s
+{
+	/// Pointer to the node of the first element.
+	dlist_node_t* first;
+	/// Pointer to the node of the last element.
+	dlist_node_t* last;
+	/// Offset to the node inside the structure that is used for the list.
+	uintptr_t offset_node;
+	/// Number of elements in the list.
+	size_t count;
+};
+
+/**
+ * @brief Compares two elements for @see dlist_insert_sorted.
+ *
+ * @param a								Pointer to the first element.
+ * @param b								Pointer to the second element.
+ * @return								Negative if a is ordered before b, 0 if both are equal and positive if a is ordered after b.
+ */
+typedef int (*dlist_compare_cb_t)(const void* a, const void* b);
+
+//------------------------------------------------------------------------------------------------------------
+// External functions
+//------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes the list.
+ * Works like @see list_init, but the pointer to the dlist_node_t inside your structure is used instead of the next pointer.
+ * @code
+struct test_s
+{
+	// ... your variables
+	dlist_node_t node;
+};
+
+dlist_t list;
+struct test_s* element = NULL;
+
+dlist_init(&list, element, &element->node);
+ * @endcode
+ * @param list							Pointer to the list structure that needs to be initialized.
+ * @param s								Pointer to your structure. Is only used for calculating the offset.
+ * @param s_node						Pointer to the node inside your structure.
+ * @retval FUNCTION_RETURN_OK			List was initialized successfully.
+ * @retval FUNCTION_RETURN_PARAM_ERROR	List is NULL.
+ */
+FUNCTION_RETURN dlist_init(dlist_t* list, void* s, void* s_node);
+/**
+ * @brief Adds an element at the end of the list in O(1).
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @param s								Pointer to the structure that needs to be added to the list.
+ * @retval FUNCTION_RETURN_OK			Element was added to the list.
+ * @retval FUNCTION_RETURN_NOT_READY	Element is already inside the list.
+ * @retval FUNCTION_RETURN_PARAM_ERROR	List or s are NULL.
+ */
+FUNCTION_RETURN dlist_add_element(dlist_t* list, void* s);
+/**
+ * @brief Adds an element in front of the first element that is ordered after it, so equal elements keep the order in which
+ * they were added. The search starts at the end of the list.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @param s								Pointer to the structure that needs to be added to the list.
+ * @param compare						Function that compares two elements.
+ * @retval FUNCTION_RETURN_OK			Element was added to the list.
+ * @retval FUNCTION_RETURN_NOT_READY	Element is already inside the list.
+ * @retval FUNCTION_RETURN_PARAM_ERROR	List, s or compare are NULL.
+ */
+FUNCTION_RETURN dlist_insert_sorted(dlist_t* list, void* s, dlist_compare_cb_t compare);
+/**
+ * @brief Removes an element from the list in O(1).
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @param s								Pointer to the structure that needs to be removed from the list.
+ * @retval FUNCTION_RETURN_OK			Element was removed from the list.
+ * @retval FUNCTION_RETURN_NOT_FOUND	Element is not inside the list.
+ * @retval FUNCTION_RETURN_PARAM_ERROR	List or s are NULL.
+ */
+FUNCTION_RETURN dlist_remove_element(dlist_t* list, void* s);
+/**
+ * @brief Removes the first element from the list and returns it.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @return								NULL if the list is empty, otherwise the removed element.
+ */
+void* dlist_pop_first(dlist_t* list);
+/**
+ * @brief Returns the first element of the list.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @return								NULL if no element is present in the list, otherwise it is a pointer to the first element.
+ */
+void* dlist_first_element(dlist_t* list);
+/**
+ * @brief Returns the last element of the list.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @return								NULL if no element is present in the list, otherwise it is a pointer to the last element.
+ */
+void* dlist_last_element(dlist_t* list);
+/**
+ * @brief Returns the element that follows s in the list.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @param s								Pointer to the structure that is inside the list.
+ * @return								NULL if s is the last element, otherwise it is a pointer to the next element.
+ */
+void* dlist_next_element(dlist_t* list, void* s);
+/**
+ * @brief Returns the element in front of s in the list.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @param s								Pointer to the structure that is inside the list.
+ * @return								NULL if s is the first element, otherwise it is a pointer to the previous element.
+ */
+void* dlist_prev_element(dlist_t* list, void* s);
+/**
+ * @brief Returns the number of elements in the list.
+ * @param list							Pointer to the list that was initialized with @see dlist_init.
+ * @return								Number of elements in the list.
+ */
+size_t dlist_count(dlist_t* list);
+
+#endif /* MODULE_LIST_DLIST_H_ */
@@ -11,12 +11,30 @@
 #include <string.h>
 #include "module/comm/dbg.h"
 
+#if MCU_ENABLE_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 #define _SIMULATE_FRACTIONS		1
 
+#if MCU_ENABLE_FREERTOS && defined(ESP_PLATFORM)
+/// Spinlock for the daylight saving time cache, because it also works between the cores.
+static portMUX_TYPE _dst_lock = portMUX_INITIALIZER_UNLOCKED;
+#define _DST_LOCK()				taskENTER_CRITICAL(&_dst_lock)
+#define _DST_UNLOCK()			taskEXIT_CRITICAL(&_dst_lock)
+#elif MCU_ENABLE_FREERTOS
+#define _DST_LOCK()				vTaskSuspendAll()
+#define _DST_UNLOCK()			xTaskResumeAll()
+#else
+#define _DST_LOCK()				do{}while(0)
+#define _DST_UNLOCK()			do{}while(0)
+#endif
+
 #if MCU_PERIPHERY_ENABLE_RTC
 
 #if defined(MCU_RTC_ALLOWS_FRACTIONS) && MCU_RTC_ALLOWS_FRACTIONS
@@ -29,6 +47,19 @@
 // Internal structures and enums
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/// Daylight saving time transitions of a year as UTC timestamps in seconds since 1.1.1900.
+typedef struct _dst_year_s
+{
+	/// 1.1. 00:00 UTC of the year.
+	int64_t begin;
+	/// 1.1. 00:00 UTC of the next year.
+	int64_t end;
+	/// Start of the daylight saving time: Last sunday of march 01:00 UTC.
+	int64_t dst_start;
+	/// End of the daylight saving time: Last sunday of october 01:00 UTC.
+	int64_t dst_end;
+}_dst_year_t;
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal variables
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -57,6 +88,12 @@ static bool _in_sync_external_rtc = false;
 /// Indicates whether rtc was synchronized at some point.
 static bool _was_synchronized = false;
 
+/// Cached daylight saving time transitions, the index is the year modulo RTC_DST_CACHE_SIZE. Empty entries have begin == end.
+/// Is shared between tasks, so entries are only copied while _DST_LOCK is held.
+static _dst_year_t _dst_cache[RTC_DST_CACHE_SIZE] = {0};
+/// Entry of _dst_cache that was used last.
+static const _dst_year_t* _dst_last = &_dst_cache[0];
+
 /// Lookup table for the number of days inside a month.
 /// Index 1 is 0 if the year is not a leap year or 1 if the year is a leap year.
 /// Index 2 is for the month - 1 (0 - 11).
@@ -85,6 +122,48 @@ static bool _simulation_running = false;
  */
 static void _trigger_observer_event(RTC_EVENT_T event);
 
+/**
+ * Sets the date fields (tm_year, tm_mon, tm_mday, tm_wday and tm_yday) of t from the number of days since 1.1.1900.
+ * @param t         Pointer to the time structure.
+ * @param days      Days since 1.1.1900.
+ */
+static void _set_date_from_days(rtc_time_t* t, int32_t days);
+
+/**
+ * Sets the time of day (tm_hour, tm_min and tm_sec) of t and returns the days since 1.1.1900.
+ * @param t         Pointer to the time structure.
+ * @param seconds   Seconds since 1.1.1900. Negative values are handled as 0.
+ * @return          Days since 1.1.1900.
+ */
+static int32_t _set_time_of_day(rtc_time_t* t, int64_t seconds);
+
+/**
+ * Copies the cached daylight saving time transitions of the year of the timestamp. Calculates them if the year is
+ * not in the cache and adds them to the cache.
+ * @param utc       UTC timestamp in seconds since 1.1.1900.
+ * @param y         Pointer where the transitions are copied to.
+ */
+static void _get_dst_year(int64_t utc, _dst_year_t* y);
+
+/**
+ * Checks if the UTC timestamp is inside the daylight saving time.
+ * @param utc       UTC timestamp in seconds since 1.1.1900.
+ * @param y         Transitions of the caller. Is updated if utc is not inside its year. Entries with begin == end
+ *                  are updated on the first call.
+ * @return          true if utc is inside the daylight saving time.
+ */
+static bool _is_dst(int64_t utc, _dst_year_t* y);
+
+/**
+ * Returns the number of seconds that are added to an UTC timestamp for the local time.
+ * @param utc       UTC timestamp in seconds since 1.1.1900.
+ * @param timezone  Offset of the standard time to UTC in hours.
+ * @param has_daylight_saving_time  true: An hour is added during the daylight saving time.
+ * @param y         Transitions of the caller, @see _is_dst.
+ * @return          Offset in seconds.
+ */
+static int32_t _get_local_offset(int64_t utc, int8_t timezone, bool has_daylight_saving_time, _dst_year_t* y);
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -106,6 +185,7 @@ void rtc_set_simulation_time(rtc_time_t* t)
 
 	_simulated_time = *t;
 	_simulation_running	= true;
+	_trigger_observer_event(RTC_EVENT_TIME_SET);
 }
 
 bool rtc_is_null(const rtc_time_t* t)
@@ -274,14 +354,14 @@ void rtc_set_utc_time_from_gmt(rtc_time_t* time, int64_t epoch, int8_t timezone,
     {
         return;
     }
-	t2 = rtc_time(t1);
+	t1 -= (3600L * (int32_t)timezone); // Subtract x hours based on timezone
 
-	if(has_daylight_saving_time && rtc_is_daylight_saving_time(&t2))
+	// The local time is in the daylight saving time if the time one hour earlier is after the transition.
+	if(has_daylight_saving_time && rtc_is_daylight_saving_time_utc(t1 - 3600L))
 	{
 		t1 -= 3600L; // Subtract 1 hour for daylight saving time
 	}
-	t1 -= (3600L * (int32_t)timezone); // Subtract x hours based on timezone
-	
+
 	t2 = rtc_time(t1);
 	t2.tm_timezone = 0;
 	if(time)
@@ -303,13 +383,9 @@ void rtc_set_gmt_time_from_utc(rtc_time_t* time, int64_t epoch, int8_t timezone,
     }
 
 	rtc_time_t t2;
-	t1 += (3600L * (int32_t)timezone); // Add 1 hour for CET (Central European Time)
+	_dst_year_t y = {0};
+	t1 += _get_local_offset(t1, timezone, has_daylight_saving_time, &y);
 	t2 = rtc_time(t1);
-	if(has_daylight_saving_time && rtc_is_daylight_saving_time(&t2))
-	{
-		t1 += 3600L; // Add 1 hour for daylight saving time
-		t2 = rtc_time(t1);
-	}
 	t2.tm_timezone = timezone;
 	if(time)
 		t2.tm_msec = time->tm_msec;
@@ -321,33 +397,66 @@ bool rtc_is_daylight_saving_time(rtc_time_t* time)
 	if(time == NULL)
 		return false;
 
-	// Jan, Feb, Nov and Dec are out.
-	if (time->tm_mon < 2 || time->tm_mon > 9)
-		return false;
-	// April to September are in
-	if (time->tm_mon > 2 && time->tm_mon < 9)
-		return true;
-	// Only March and October remain
+	// The time is the standard time of CET, which is UTC + 1.
+	return rtc_is_daylight_saving_time_utc(rtc_mktime(time) - 3600L);
+}
+
+bool rtc_is_daylight_saving_time_utc(int64_t utc)
+{
+	_dst_year_t y;
+
+	_DST_LOCK();
+	y = *_dst_last;
+	_DST_UNLOCK();
+
+	return _is_dst(utc, &y);
+}
+
+void rtc_utc_to_local_array(const int64_t* utc, int64_t* local, size_t count, int8_t timezone, bool has_daylight_saving_time, bool is_ms)
+{
+	int32_t scale = is_ms ? 1000 : 1;
+	_dst_year_t y = {0};
+	size_t i;
+
+	if(utc == NULL || local == NULL)
+		return;
+
+	for(i = 0; i < count; i++)
+		local[i] = utc[i] + (int64_t)_get_local_offset(utc[i] / scale, timezone, has_daylight_saving_time, &y) * scale;
+}
+
+void rtc_local_time_array(const int64_t* utc, rtc_time_t* times, size_t count, int8_t timezone, bool has_daylight_saving_time, bool is_ms)
+{
+	rtc_time_t t1 = {0};
+	_dst_year_t y = {0};
+	int32_t scale = is_ms ? 1000 : 1;
+	int32_t last_days = -1;
+	int32_t days, offset;
+	int64_t local;
+	size_t i;
+
+	if(utc == NULL || times == NULL)
+		return;
+
+	t1.tm_timezone = timezone;
+
+	for(i = 0; i < count; i++)
 	{
-		uint16_t year = time->tm_year < RTC_EPOCH_YR ? time->tm_year + RTC_EPOCH_YR : time->tm_year;
-		uint8_t date_last_sunday = rtc_get_days(time->tm_mon, year/*time->tm_year*/);
-		uint8_t dow = rtc_get_day_of_week( year/*time->tm_year*/, time->tm_mon, date_last_sunday);
-		date_last_sunday -= dow;
-
-		// Before last sunday in march and after last sunday in october -> No Daylight saving time
-		if((time->tm_mon == 2 && time->tm_mday < date_last_sunday) || (time->tm_mon == 9 && time->tm_mday > date_last_sunday))
-			return false;
-
-		// After last sunday in march and before last sunday in october -> Daylight saving time
-		if((time->tm_mon == 2 && time->tm_mday > date_last_sunday) || (time->tm_mon == 9 && time->tm_mday < date_last_sunday))
-			return true;
-
-		// Now it is the day where the daylight saving time changes!
-		// Daylight saving time before 3 am
-		if(time->tm_mon == 2)
-			return time->tm_hour >= 2;
-		// Daylight saving time before 2 am
-		return time->tm_hour < 2;
+		offset = _get_local_offset(utc[i] / scale, timezone, has_daylight_saving_time, &y);
+		local = utc[i] + (int64_t)offset * scale;
+
+		t1.tm_isdst = offset != 3600L * timezone;
+		t1.tm_msec = (is_ms && local > 0) ? local % 1000 : 0;
+		days = _set_time_of_day(&t1, local / scale);
+
+		// Same as rtc_time_array: The date is only calculated when the day changes.
+		if(days != last_days)
+		{
+			_set_date_from_days(&t1, days);
+			last_days = days;
+		}
+
+		times[i] = t1;
 	}
 }
 
@@ -392,29 +501,10 @@ void rtc_go_back_days(rtc_time_t* t, uint16_t days)
 
 int64_t rtc_mktime(const rtc_time_t *t)
 {
-    int64_t val = 0;
-    uint16_t i;
-
     if(t->tm_mday == 0)
     	return 0;
 
-    for(i = t->tm_year; i > 0; i--)
-    {
-    	val += 365;
-        if( rtc_is_a_leap_year(i - 1) )
-        	val++;
-    }
-
-    for(i = 0; i < t->tm_mon; i++)
-    	val += rtc_ytab[(int)rtc_is_a_leap_year(t->tm_year)][i];
-
-    val += t->tm_mday - 1;
-    val *= 86400L;
-    val += (t->tm_hour * 3600L);
-    val += (t->tm_min * 60L);
-    val += t->tm_sec;
-
-    return val;
+    return rtc_civil_seconds_from_date(t->tm_year + RTC_EPOCH_YR, t->tm_mon, t->tm_mday, t->tm_hour, t->tm_min, t->tm_sec);
 }
 
 int64_t rtc_mktime_ms(const rtc_time_t* t)
@@ -445,63 +535,10 @@ rtc_time_t rtc_time_ms(int64_t t)
 {
 	rtc_time_t t1 = {0};
 
-	uint32_t t2 = (uint32_t)(t / 1000UL);
-	
-	t1.tm_msec = t % 1000UL;
-
-	// Remove the seconds from t
-	t1.tm_sec = t2 % 60U;
-	t2 /= 60U;
-
-	// Remove the minutes from t2
-	if(t2 > 0)
-	{
-		t1.tm_min = t2 % 60U;
-		t2 /= 60U;
-	}
-
-	// Remove the hours from t2
-	if(t2 > 0)
-	{
-		t1.tm_hour = t2 % 24U;
-		t2 /= 24U;
-	}
-
-	// Remove the years from t2
-	while(t2 >= 365)
-	{
-		if( rtc_is_a_leap_year(t1.tm_year) )
-		{
-			if(t2 >= 366)
-			{
-				t1.tm_year++;
-				t2 -= 366U;
-			}
-			else
-				break; // It is not a leap year so it must be 31.12. in the leap year before
-		}
-		else
-		{
-			t1.tm_year++;
-			t2 -= 365U;
-		}
-	}
+	if(t > 0)
+		t1.tm_msec = t % 1000;
 
-	// Left in t2: months in dates -> Remove the months!
-	t1.tm_mon = 0;
-	if(t2 > 0)
-	{
-		uint16_t i = 0;
-		while(t2 >= rtc_ytab[(int)rtc_is_a_leap_year(t1.tm_year)][i])
-		{
-			t2 -= (uint32_t)rtc_ytab[(int)rtc_is_a_leap_year(t1.tm_year)][i];
-			t1.tm_mon++;
-			i++;
-		}
-	}
-
-	// Left in t2: dates
-	t1.tm_mday = t2 + 1;
+	_set_date_from_days(&t1, _set_time_of_day(&t1, t / 1000));
 
 	return t1;
 }
@@ -510,63 +547,60 @@ rtc_time_t rtc_time(int64_t t)
 {
 	rtc_time_t t1 = {0};
 
-	uint32_t t2 = (uint32_t) t;
+	_set_date_from_days(&t1, _set_time_of_day(&t1, t));
 
-	// Remove the seconds from t
-	t1.tm_sec = t2 % 60U;
-	t2 /= 60U;
+	return t1;
+}
 
-	// Remove the minutes from t2
-	if(t2 > 0)
-	{
-		t1.tm_min = t2 % 60U;
-		t2 /= 60U;
-	}
+void rtc_time_array(const int64_t* t, rtc_time_t* times, size_t count, bool is_ms)
+{
+	rtc_time_t t1 = {0};
+	int32_t last_days = -1;
+	int32_t days;
+	size_t i;
 
-	// Remove the hours from t2
-	if(t2 > 0)
+	for(i = 0; i < count; i++)
 	{
-		t1.tm_hour = t2 % 24U;
-		t2 /= 24U;
-	}
+		t1.tm_msec = (is_ms && t[i] > 0) ? t[i] % 1000 : 0;
+		days = _set_time_of_day(&t1, is_ms ? t[i] / 1000 : t[i]);
 
-	// Remove the years from t2
-	while(t2 >= 365)
-	{
-		if( rtc_is_a_leap_year(t1.tm_year) )
-		{
-			if(t2 >= 366)
-			{
-				t1.tm_year++;
-				t2 -= 366U;
-			}
-			else
-				break; // It is not a leap year so it must be 31.12. in the leap year before
-		}
-		else
+		// Logged timestamps are mostly sorted, so the date only needs to be calculated when the day changes.
+		if(days != last_days)
 		{
-			t1.tm_year++;
-			t2 -= 365U;
+			_set_date_from_days(&t1, days);
+			last_days = days;
 		}
+
+		times[i] = t1;
 	}
+}
 
-	// Left in t2: months in dates -> Remove the months!
-	t1.tm_mon = 0;
-	if(t2 > 0)
+void rtc_mktime_array(const rtc_time_t* times, int64_t* t, size_t count, bool is_ms)
+{
+	const rtc_time_t* last = NULL;
+	int64_t day_seconds = 0;
+	size_t i;
+
+	for(i = 0; i < count; i++)
 	{
-		uint16_t i = 0;
-		while(t2 >= rtc_ytab[(int)rtc_is_a_leap_year(t1.tm_year)][i])
+		const rtc_time_t* t1 = &times[i];
+
+		if(t1->tm_mday == 0)
 		{
-			t2 -= (uint32_t)rtc_ytab[(int)rtc_is_a_leap_year(t1.tm_year)][i];
-			t1.tm_mon++;
-			i++;
+			t[i] = 0;
+			continue;
 		}
-	}
 
-	// Left in t2: dates
-	t1.tm_mday = t2 + 1;
+		if(last == NULL || t1->tm_mday != last->tm_mday || t1->tm_mon != last->tm_mon || t1->tm_year != last->tm_year)
+		{
+			day_seconds = (int64_t)rtc_civil_days_from_date(t1->tm_year + RTC_EPOCH_YR, t1->tm_mon, t1->tm_mday) * SECONDS_IN_DAY;
+			last = t1;
+		}
 
-	return t1;
+		t[i] = day_seconds + t1->tm_hour * 3600L + t1->tm_min * 60L + t1->tm_sec;
+		if(is_ms)
+			t[i] = t[i] * 1000 + t1->tm_msec;
+	}
 }
 
 bool rtc_is_a_leap_year(uint32_t year)
@@ -728,4 +762,93 @@ static void _trigger_observer_event(RTC_EVENT_T event)
     }
 }
 
+static void _set_date_from_days(rtc_time_t* t, int32_t days)
+{
+	// Same calculation as the rtc_civil functions, but each step is only done once.
+	int32_t doe = rtc_civil_internal_day_of_era(days);
+	int32_t yoe = rtc_civil_internal_year_of_era(doe);
+	int32_t doy = rtc_civil_internal_day_of_year(doe);
+	int32_t mp = rtc_civil_internal_month_of_march_year(doy);
+	int32_t year = (days + RTC_CIVIL_DAYS_TO_EPOCH) / RTC_CIVIL_DAYS_PER_ERA * 400 + yoe + (mp >= 10);
+
+	t->tm_year = year - RTC_EPOCH_YR;
+	t->tm_mon = (mp + 2) % 12;
+	t->tm_mday = doy - (153 * mp + 2) / 5 + 1;
+	t->tm_wday = rtc_civil_wday_from_days(days);
+	// Day of the year from march + days of january and february, wrapped at the end of the year.
+	t->tm_yday = (mp >= 10) ? doy - 306 : doy + 59 + rtc_is_a_leap_year(year);
+}
+
+static int32_t _set_time_of_day(rtc_time_t* t, int64_t seconds)
+{
+	uint32_t sec;
+
+	if(seconds < 0)
+		seconds = 0;
+
+	sec = (uint32_t)(seconds % SECONDS_IN_DAY);
+	t->tm_hour = sec / SECONDS_IN_HOUR;
+	t->tm_min = (sec / SECONDS_IN_MINUTE) % 60;
+	t->tm_sec = sec % 60;
+
+	return (int32_t)(seconds / SECONDS_IN_DAY);
+}
+
+static void _get_dst_year(int64_t utc, _dst_year_t* y)
+{
+	int32_t year, days;
+	uint8_t i;
+
+	if(utc < 0)
+		utc = 0;
+
+	_DST_LOCK();
+	for(i = 0; i < RTC_DST_CACHE_SIZE; i++)
+	{
+		if(utc >= _dst_cache[i].begin && utc < _dst_cache[i].end)
+		{
+			_dst_last = &_dst_cache[i];
+			*y = _dst_cache[i];
+			_DST_UNLOCK();
+			return;
+		}
+	}
+	_DST_UNLOCK();
+
+	// Calculated outside of the lock and published as a whole, so no other task sees a partially written entry.
+	year = rtc_civil_year_from_days((int32_t)(utc / SECONDS_IN_DAY));
+
+	y->begin = (int64_t)rtc_civil_days_from_date(year, 0, 1) * SECONDS_IN_DAY;
+	y->end = (int64_t)rtc_civil_days_from_date(year + 1, 0, 1) * SECONDS_IN_DAY;
+
+	// Last sunday of march and october: The 31st minus its day of the week.
+	days = rtc_civil_days_from_date(year, 2, 31);
+	y->dst_start = (int64_t)(days - rtc_civil_wday_from_days(days)) * SECONDS_IN_DAY + SECONDS_IN_HOUR;
+	days = rtc_civil_days_from_date(year, 9, 31);
+	y->dst_end = (int64_t)(days - rtc_civil_wday_from_days(days)) * SECONDS_IN_DAY + SECONDS_IN_HOUR;
+
+	_DST_LOCK();
+	_dst_cache[year % RTC_DST_CACHE_SIZE] = *y;
+	_dst_last = &_dst_cache[year % RTC_DST_CACHE_SIZE];
+	_DST_UNLOCK();
+}
+
+static bool _is_dst(int64_t utc, _dst_year_t* y)
+{
+	if(utc < y->begin || utc >= y->end)
+		_get_dst_year(utc, y);
+
+	return utc >= y->dst_start && utc < y->dst_end;
+}
+
+static int32_t _get_local_offset(int64_t utc, int8_t timezone, bool has_daylight_saving_time, _dst_year_t* y)
+{
+	int32_t offset = SECONDS_IN_HOUR * (int32_t)timezone;
+
+	if(has_daylight_saving_time && _is_dst(utc, y))
+		offset += SECONDS_IN_HOUR;
+
+	return offset;
+}
+
 #endif
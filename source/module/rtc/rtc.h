@@ -6,6 +6,19 @@
  *
  *  @brief		Some functions from the original rtc module -> Not the complete module!
  *
+ *  @version    1.39 (18.10.2026, Tim Koczwara)
+ *              - \ref rtc_set_simulation_time informs the observers with RTC_EVENT_TIME_SET.
+ *  @version    1.38 (18.10.2026, Tim Koczwara)
+ *              - The daylight saving time transitions are cached per year, so \ref rtc_is_daylight_saving_time,
+ *                \ref rtc_set_gmt_time_from_utc and \ref rtc_set_utc_time_from_gmt only compare timestamps.
+ *              - The cache entries are calculated outside and copied inside a critical section, so the functions can be
+ *                used by multiple tasks.
+ *              - Added \ref rtc_is_daylight_saving_time_utc, \ref rtc_utc_to_local_array and \ref rtc_local_time_array
+ *  @version    1.37 (18.10.2026, Tim Koczwara)
+ *              - \ref rtc_mktime, \ref rtc_time and \ref rtc_time_ms calculate the date in constant time with the
+ *                functions from rtc_civil.h instead of looping over years and months. rtc_time works after 2036 and
+ *                sets tm_wday and tm_yday.
+ *              - Added \ref rtc_time_array and \ref rtc_mktime_array
  *  @version    1.36 (23.03.2023, Tim Koczwara)
  *              - Added \ref rtc_was_synchronized
  *  @version    1.35 (03.03.2023, Tim Koczwara)
@@ -45,6 +58,8 @@
 /// Number of seconds in a day
 #define SECONDS_IN_DAY			(86400)
 
+#include "module/rtc/rtc_civil.h"
+
 #if MODULE_ENABLE_RTC
 
 #include "module/enum/function_return.h"
@@ -67,6 +82,11 @@
 #define RTC_SYNCHRONIZE_DURATION    (60 * 60)
 #endif
 
+#ifndef RTC_DST_CACHE_SIZE
+/// Number of years for which the daylight saving time transitions are cached.
+#define RTC_DST_CACHE_SIZE			4
+#endif
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -176,6 +196,7 @@ void rtc_stop_simulation(void);
  * 
  * This can be used for testing purposes, when no hardware is available.
  * The simulation is stopped when the function rtc_stop_simulation is called. 
+ * The observers are informed with RTC_EVENT_TIME_SET.
  * 
  * @param t		Pointer to the structure that contains the time.
  */
@@ -280,11 +301,44 @@ inline void rtc_set_utc_time(rtc_time_t* time, int64_t epoch, int8_t timezone)
 }
 /**
  * Calculates if the date is in the daylight saving time (MESZ) or not (MEZ / CET).
- * @param time	Pointer to the time that should be checked.
+ * @param time	Pointer to the time that should be checked. It is the standard time of CET (UTC + 1) without the
+ * 				daylight saving hour.
  * @return		true: MESZ should be used
  * 				false: MEZ / CET should be used
  */
 bool rtc_is_daylight_saving_time(rtc_time_t* time);
+/**
+ * Checks if an UTC timestamp is in the european daylight saving time, which starts on the last sunday of march and
+ * ends on the last sunday of october at 01:00 UTC. The transitions are cached for RTC_DST_CACHE_SIZE years, so
+ * timestamps of cached years are only compared.
+ *
+ * @param utc		UTC timestamp in seconds since 1.1.1900.
+ * @return			true if the daylight saving time is active.
+ */
+bool rtc_is_daylight_saving_time_utc(int64_t utc);
+/**
+ * Converts an array of UTC timestamps into local timestamps of the timezone.
+ *
+ * @param utc		Array of UTC timestamps since 1.1.1900.
+ * @param local		Array where the local timestamps are written to. Can be the same as utc.
+ * @param count		Number of timestamps.
+ * @param timezone	Offset of the standard time of the timezone to UTC in hours, e.g. 1 for CET.
+ * @param has_daylight_saving_time	true: Adds an hour during the european daylight saving time.
+ * @param is_ms		true: Timestamps are in milliseconds, false: Timestamps are in seconds.
+ */
+void rtc_utc_to_local_array(const int64_t* utc, int64_t* local, size_t count, int8_t timezone, bool has_daylight_saving_time, bool is_ms);
+/**
+ * Converts an array of UTC timestamps into time structures of the local time like \ref rtc_utc_to_local_array and
+ * \ref rtc_time_array. tm_isdst and tm_timezone are set.
+ *
+ * @param utc		Array of UTC timestamps since 1.1.1900.
+ * @param times		Array where the time structures are written to.
+ * @param count		Number of timestamps.
+ * @param timezone	Offset of the standard time of the timezone to UTC in hours, e.g. 1 for CET.
+ * @param has_daylight_saving_time	true: Adds an hour during the european daylight saving time.
+ * @param is_ms		true: Timestamps are in milliseconds, false: Timestamps are in seconds.
+ */
+void rtc_local_time_array(const int64_t* utc, rtc_time_t* times, size_t count, int8_t timezone, bool has_daylight_saving_time, bool is_ms);
 
 /**
  * Returns the number of days inside the given month of the given year.
@@ -304,10 +358,11 @@ uint8_t rtc_get_days(uint8_t month, uint16_t year);
 void rtc_go_back_days(rtc_time_t* t, uint16_t days);
 
 /**
- * Creates an timestamp out of the rtc_time_t. The timestamp is the number of seconds that passed since the 1.1.2000.
+ * Creates an timestamp out of the rtc_time_t. The timestamp is the number of seconds that passed since the 1.1.1900.
+ * Use \ref rtc_civil_seconds_from_date if the timestamp is needed as a constant.
  *
  * @param t					Pointer to the time structure containing the time that needs to be converted.
- * @return					Timestamp in seconds since 1.1.2000.
+ * @return					Timestamp in seconds since 1.1.1900 or 0 if tm_mday is 0.
  */
 int64_t rtc_mktime(const rtc_time_t *t);
 /**
@@ -339,10 +394,30 @@ rtc_time_t rtc_time_ms(int64_t t);
 /**
  * Creates a rtc_time_t structure from an int64_t timestamp that was created with rtc_mktime.
  *
- * @param t					Timestamp in seconds since 1.1.2000.
+ * @param t					Timestamp in seconds since 1.1.1900. Negative values are handled as 0.
  * @return					Time structure containing the time from the timestamp.
  */
 rtc_time_t rtc_time(int64_t t);
+/**
+ * Converts an array of timestamps like \ref rtc_time or \ref rtc_time_ms. The date is only calculated again when the
+ * day changes, so it is faster for sorted timestamps like in a log.
+ *
+ * @param t					Array of timestamps since 1.1.1900.
+ * @param times				Array where the time structures are written to.
+ * @param count				Number of timestamps.
+ * @param is_ms				true: Timestamps are in milliseconds, false: Timestamps are in seconds.
+ */
+void rtc_time_array(const int64_t* t, rtc_time_t* times, size_t count, bool is_ms);
+/**
+ * Converts an array of time structures like \ref rtc_mktime or \ref rtc_mktime_ms. The days are only calculated again
+ * when the date changes.
+ *
+ * @param times				Array of time structures.
+ * @param t					Array where the timestamps since 1.1.1900 are written to.
+ * @param count				Number of time structures.
+ * @param is_ms				true: Timestamps are in milliseconds, false: Timestamps are in seconds.
+ */
+void rtc_mktime_array(const rtc_time_t* times, int64_t* t, size_t count, bool is_ms);
 
 /**
  * Checks if the year in the parameter is a leap year.
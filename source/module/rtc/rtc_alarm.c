@@ -14,6 +14,8 @@
 // Internal definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/// Number of alarms the heap can hold after the first alarm was setup. The heap doubles its size when it is full.
+#define RTC_ALARM_HEAP_INITIAL_SIZE		16
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal structures and enums
@@ -28,8 +30,12 @@ struct rtc_alarm_s
     bool is_added;
     /// Is set when alarm is triggered from task and cleared on `rtc_alarm_stop`.
     bool triggered;
-    /// Pointer to the next alarm is multiple alarms are set-up.
-    rtc_alarm_handle_t next;
+    /// Alarm time in milliseconds since 1900 (rtc_mktime_ms). Is the key of the heap.
+    int64_t deadline;
+    /// Number of the setup. Alarms with the same deadline are triggered in the order they were setup.
+    uint32_t sequence;
+    /// Position inside the heap while the alarm is added. Is used to stop the alarm without searching for it.
+    size_t heap_index;
 };
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -37,13 +43,43 @@ struct rtc_alarm_s
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
- * @brief Task for the alarm. Checks if the next alarm can be triggered and triggers it's callback function.
- * When no further alarm is set, the task stops automatically.
+ * @brief Task for the alarm. Triggers all alarms that are due and waits until the deadline of the next alarm, a new
+ * first alarm or a change of the time. When no further alarm is set, the task stops automatically.
  * 
  * @param pt        Pointer to protothread.
  * @return int      Protothread return value.
  */
 static int _handle_alarm(struct pt* pt);
+/**
+ * @brief Observer for the rtc. Wakes up the task when the time was changed, because the deadline might be reached.
+ * 
+ * @param o         Pointer to the observer.
+ * @param event     Event of the rtc.
+ */
+static void _rtc_event(rtc_observer_t* o, RTC_EVENT_T event);
+/**
+ * @brief Returns true if alarm a has to be triggered before alarm b.
+ */
+static bool _is_before(const rtc_alarm_handle_t a, const rtc_alarm_handle_t b);
+/**
+ * @brief Puts the alarm on position i of the heap and updates its heap_index.
+ */
+static void _heap_set(size_t i, rtc_alarm_handle_t alarm);
+/**
+ * @brief Moves the alarm on position i to the top until its parent is triggered before it.
+ */
+static void _heap_sift_up(size_t i);
+/**
+ * @brief Moves the alarm on position i to the bottom until its children are triggered after it.
+ */
+static void _heap_sift_down(size_t i);
+/**
+ * @brief Doubles the size of the heap if it is full.
+ * 
+ * @retval FUNCTION_RETURN_OK                   One more alarm fits into the heap.
+ * @retval FUNCTION_RETURN_INSUFFICIENT_MEMORY  The heap is full and could not be enlarged.
+ */
+static FUNCTION_RETURN_T _heap_reserve(void);
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal variables
@@ -51,10 +87,22 @@ static int _handle_alarm(struct pt* pt);
 
 /// Single task for all alarms.
 static system_task_t _task = {.name = "rtc_alarm"};
+/// Observer to wake up the task when the time is changed.
+static rtc_observer_t _observer;
 /// Is set to true when first alarm was created and therefore the task was initialized.
 static bool _initialized = false;
-/// The first alarm or the larm that will be triggered next. Is set when `rtc_alarm_setup` is called.
-static rtc_alarm_handle_t _first_alarm = NULL;
+/// Binary min-heap of the setup alarms. The alarm that will be triggered next is always _heap[0].
+static rtc_alarm_handle_t* _heap = NULL;
+/// Number of alarms inside the heap.
+static size_t _heap_count = 0;
+/// Number of alarms that fit into the heap.
+static size_t _heap_size = 0;
+/// Counter for rtc_alarm_s.sequence.
+static uint32_t _sequence = 0;
+/// Is set when the task has to calculate the time to wait again, because the first alarm or the time changed.
+static bool _wakeup = false;
+/// Milliseconds the task waits for the next alarm.
+static uint32_t _wait_ms = 0;
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
@@ -66,6 +114,7 @@ rtc_alarm_handle_t rtc_alarm_create(void)
     {
         _initialized = true;
         system_task_init_protothread(&_task, false, _handle_alarm, NULL);
+        rtc_register_observer(&_observer, _rtc_event);
     }
 
     rtc_alarm_handle_t alarm = mcu_heap_calloc(1, sizeof(struct rtc_alarm_s));
@@ -87,52 +136,21 @@ FUNCTION_RETURN_T rtc_alarm_setup(rtc_alarm_handle_t alarm, const rtc_alarm_conf
     ASSERT_RET(!alarm->is_added, NO_ACTION, FUNCTION_RETURN_NOT_READY, "Alarm handle cannot be null\n");
     rtc_time_t time_null = {0};
     ASSERT_RET(rtc_compare(&time_null, &config->alarm_time) < 0, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid alarm time\n");
+    ASSERT_RET(_heap_reserve() == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_INSUFFICIENT_MEMORY, "Cannot enlarge alarm heap\n");
 
     memcpy(&alarm->config, config, sizeof(rtc_alarm_config_t));
     alarm->triggered = false;
+    alarm->deadline = rtc_mktime_ms(&config->alarm_time);
+    alarm->sequence = _sequence++;
+
+    _heap_set(_heap_count, alarm);
+    _heap_count++;
+    _heap_sift_up(alarm->heap_index);
+
+    // The task waits for the old first alarm and has to calculate the time again.
+    if(_heap[0] == alarm)
+        _wakeup = true;
 
-    if(_first_alarm == NULL)
-    {
-        _first_alarm = alarm;
-        alarm->next = NULL;
-    }
-    else
-    {
-        // Alarms are always in the order of the next trigger time.
-        // The one that is triggered next is always the first in the list.
-        
-        if(rtc_compare(&config->alarm_time, &_first_alarm->config.alarm_time) < 0)
-        {
-            // New alarm is first one!
-            alarm->next = _first_alarm;
-            _first_alarm = alarm;
-        }
-        else
-        {
-            // New alarm is later than the first!
-            // We look for the first one inside the list that should trigger after this alarm and put ours before it.
-            rtc_alarm_handle_t a = _first_alarm;
-            rtc_alarm_handle_t a_old;
-            do
-            {
-                a_old = a;
-                a = a->next;
-            }while(a && rtc_compare(&config->alarm_time, &a->config.alarm_time) >= 0);
-
-            if(a)
-            {
-                // a_old should trigger before alarm and a should trigger after alarm.
-                a_old->next = alarm;
-                alarm->next = a;
-            }
-            else
-            {
-                // a is NULL, so we are the last one inside the list.
-                a_old->next = alarm;
-                alarm->next = NULL;
-            }
-        }
-    }
     alarm->is_added = true;
     system_task_add(&_task);
     return FUNCTION_RETURN_OK;
@@ -148,30 +166,27 @@ FUNCTION_RETURN_T rtc_alarm_stop(rtc_alarm_handle_t alarm)
     alarm->is_added = false;
     alarm->triggered = false;
 
-    if(_first_alarm == alarm)
+    // The last alarm takes the place of the removed alarm and is moved up or down to restore the order.
+    size_t i = alarm->heap_index;
+    _heap_count--;
+    if(i < _heap_count)
     {
-        _first_alarm = alarm->next;
-    }
-    else
-    {
-        rtc_alarm_handle_t a = _first_alarm;
-        // Skip until a points to the alarm before the target.
-        while(a && a->next != alarm)
-        {
-            a = a->next;
-        }
-        // If alarm was found -> Take the alarm out of the list.
-        if(a && a->next == alarm)
-        {
-            a->next = alarm->next;
-        }
+        _heap_set(i, _heap[_heap_count]);
+        if(i > 0 && _is_before(_heap[i], _heap[(i - 1) / 2]))
+            _heap_sift_up(i);
+        else
+            _heap_sift_down(i);
     }
+    _heap[_heap_count] = NULL;
 
-    alarm->next = NULL;
-
-    // Remove task if last alarm was removed.
-    if(_first_alarm == NULL)
+    // Remove task and heap if last alarm was removed.
+    if(_heap_count == 0)
+    {
         system_remove_task(&_task);
+        mcu_heap_free(_heap);
+        _heap = NULL;
+        _heap_size = 0;
+    }
 
     return FUNCTION_RETURN_OK;
 }
@@ -182,10 +197,61 @@ bool rtc_alarm_is_triggered(rtc_alarm_handle_t alarm)
     return alarm->triggered;
 }
 
+int64_t rtc_alarm_process(int64_t now_ms)
+{
+    rtc_alarm_handle_t alarm;
+    // Alarms that are set-up in a callback get a newer sequence and are processed in the next call, otherwise an
+    // alarm that is set-up again with a reached deadline would be triggered forever.
+    uint32_t sequence_end = _sequence;
+
+    while(_heap_count > 0 && _heap[0]->deadline <= now_ms && (int32_t)(_heap[0]->sequence - sequence_end) < 0)
+    {
+        alarm = _heap[0];
+        // Stop first to ensure rtc_alarm_setup can be used in the callback!
+        rtc_alarm_stop(alarm);
+        // Trigger the callback
+        alarm->triggered = true;
+        // Trigger only the callback if callback is set.
+        if(alarm->config.f)
+            alarm->config.f(alarm, &alarm->config);
+    }
+
+    if(_heap_count == 0)
+        return -1;
+
+    if(_heap[0]->deadline <= now_ms)
+        return 0;
+
+    return _heap[0]->deadline - now_ms;
+}
+
+size_t rtc_alarm_get_count(void)
+{
+    return _heap_count;
+}
+
 #if RTC_ALARM_SELFTEST
+/**
+ * @brief Checks that no alarm is triggered after one of its children and that every heap_index is correct.
+ */
+static bool _heap_is_valid(void)
+{
+    size_t i;
+
+    for(i = 0; i < _heap_count; i++)
+    {
+        if(_heap[i]->heap_index != i || !_heap[i]->is_added)
+            return false;
+
+        if(i > 0 && _is_before(_heap[i], _heap[(i - 1) / 2]))
+            return false;
+    }
+    return true;
+}
+
 FUNCTION_RETURN_T rtc_alarm_selfcheck(void)
 {
-    DBG_ASSERT(_first_alarm == NULL && !system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Cannot start selfcheck when alarm already in use!\n");
+    DBG_ASSERT(_heap_count == 0 && !system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Cannot start selfcheck when alarm already in use!\n");
 
     rtc_alarm_handle_t alarm1 = rtc_alarm_create();
     DBG_ASSERT(alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "error creating handle\n");
@@ -194,7 +260,7 @@ FUNCTION_RETURN_T rtc_alarm_selfcheck(void)
     rtc_alarm_handle_t alarm3 = rtc_alarm_create();
     DBG_ASSERT(alarm3, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "error creating handle\n");
     rtc_alarm_handle_t alarm4 = rtc_alarm_create();
-    DBG_ASSERT(alarm3, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "error creating handle\n");
+    DBG_ASSERT(alarm4, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "error creating handle\n");
     
     // Check error handling on wrong parameter
     rtc_alarm_config_t config_invalid = {0};    
@@ -207,82 +273,49 @@ FUNCTION_RETURN_T rtc_alarm_selfcheck(void)
     DBG_ASSERT(rtc_alarm_stop(alarm1) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop on unset alarm failed\n");
 
     // Check setting a first config
-    rtc_alarm_config_t config1 = {.alarm_time = RTC_INIT(2022, 3, 2, 12, 30, 0, 0)};    
+    rtc_alarm_config_t config1 = {.alarm_time = RTC_INIT(2022, 3, 2, 12, 30, 0, 0)};
+    rtc_alarm_config_t config2 = {.alarm_time = RTC_INIT(2022, 3, 2, 13, 30, 0, 0)};
+    rtc_alarm_config_t config3 = {.alarm_time = RTC_INIT(2022, 3, 2, 11, 30, 0, 0)};
+    rtc_alarm_config_t config4 = {.alarm_time = RTC_INIT(2022, 3, 2, 14, 30, 0, 0)};
     DBG_ASSERT(rtc_alarm_setup(alarm1, &config1) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    DBG_ASSERT(_first_alarm == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    DBG_ASSERT(rtc_compare(&_first_alarm->config.alarm_time, &config1.alarm_time) == 0, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
+    DBG_ASSERT(_heap_count == 1 && _heap[0] == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
+    DBG_ASSERT(rtc_compare(&_heap[0]->config.alarm_time, &config1.alarm_time) == 0, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
+    DBG_ASSERT(rtc_alarm_setup(alarm1, &config1) == FUNCTION_RETURN_NOT_READY, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup twice check failed\n");
     DBG_ASSERT(system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
 
     // Check stop the first alarm
     DBG_ASSERT(rtc_alarm_stop(alarm1) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
-    DBG_ASSERT(_first_alarm == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
+    DBG_ASSERT(_heap_count == 0 && _heap == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
     DBG_ASSERT(!system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
 
-    // Add alarm again and check with further alarms: alarm3 < alarm1 < alarm2, but added in order alarm1, alarm2, alarm3
+    // Add alarms in order alarm1, alarm2, alarm3, alarm4. Trigger order is alarm3 < alarm1 < alarm2 < alarm4.
     DBG_ASSERT(rtc_alarm_setup(alarm1, &config1) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    DBG_ASSERT(_first_alarm == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    rtc_alarm_config_t config2 = {.alarm_time = RTC_INIT(2022, 3, 2, 13, 30, 0, 0)};    
     DBG_ASSERT(rtc_alarm_setup(alarm2, &config2) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Adding alarm failed\n");
-    // Ensure above order: alarm1 < alarm2
-    DBG_ASSERT(_first_alarm == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    DBG_ASSERT(alarm1->next == alarm2, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-
-    rtc_alarm_config_t config3 = {.alarm_time = RTC_INIT(2022, 3, 2, 11, 30, 0, 0)};    
+    DBG_ASSERT(_heap[0] == alarm1 && _heap_is_valid(), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
     DBG_ASSERT(rtc_alarm_setup(alarm3, &config3) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Adding alarm failed\n");
-    DBG_ASSERT(system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    // Ensure above order: alarm3 < alarm1 < alarm2
-    DBG_ASSERT(_first_alarm == alarm3, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->next == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm1->next == alarm2, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm2->next == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-
-    rtc_alarm_config_t config4 = {.alarm_time = RTC_INIT(2022, 3, 2, 14, 30, 0, 0)};    
+    DBG_ASSERT(_heap[0] == alarm3 && _heap_is_valid(), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
     DBG_ASSERT(rtc_alarm_setup(alarm4, &config4) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Adding alarm failed\n");
-    DBG_ASSERT(system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
-    // Ensure all are added
-    DBG_ASSERT(alarm1->is_added == true, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm2->is_added == true, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->is_added == true, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm4->is_added == true, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-
-    // Ensure above order: alarm3 < alarm1 < alarm2 < alarm4
-    DBG_ASSERT(_first_alarm == alarm3, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->next == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm1->next == alarm2, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm2->next == alarm4, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm4->next == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
+    DBG_ASSERT(_heap[0] == alarm3 && _heap_is_valid(), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
+    DBG_ASSERT(_heap_count == 4 && system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Setup alarm failed\n");
 
     // Test removing from between
     DBG_ASSERT(rtc_alarm_stop(alarm2) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
-    // Ensure above order: alarm3 < alarm1 < alarm4
-    DBG_ASSERT(_first_alarm == alarm3, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->next == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm1->next == alarm4, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm4->next == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
+    DBG_ASSERT(_heap_count == 3 && _heap[0] == alarm3 && _heap_is_valid(), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
     DBG_ASSERT(alarm2->is_added == false, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
 
-    // Test removing from end
-    DBG_ASSERT(rtc_alarm_stop(alarm4) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
-    // Ensure above order: alarm3 < alarm1
-    DBG_ASSERT(_first_alarm == alarm3, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->next == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm1->next == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm4->is_added == false, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-
     // Test removing from start
     DBG_ASSERT(rtc_alarm_stop(alarm3) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
-    // Ensure above order: alarm1
-    DBG_ASSERT(_first_alarm == alarm1, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->next == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm1->next == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm3->is_added == false, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Ensure task still active failed\n");
+    DBG_ASSERT(_heap_count == 2 && _heap[0] == alarm1 && _heap_is_valid(), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
+
+    // Test triggering: Only alarm1 is due.
+    DBG_ASSERT(rtc_alarm_process(alarm1->deadline) == alarm4->deadline - alarm1->deadline, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Process failed\n");
+    DBG_ASSERT(rtc_alarm_is_triggered(alarm1) && !rtc_alarm_is_triggered(alarm4), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Trigger failed\n");
+    DBG_ASSERT(_heap_count == 1 && _heap[0] == alarm4 && system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Trigger failed\n");
 
     // Test removing last one
-    DBG_ASSERT(rtc_alarm_stop(alarm1) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
-    // Ensure above order: alarm1
-    DBG_ASSERT(_first_alarm == NULL, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
-    DBG_ASSERT(alarm1->is_added == false, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
+    DBG_ASSERT(rtc_alarm_stop(alarm4) == FUNCTION_RETURN_OK, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
+    DBG_ASSERT(_heap_count == 0 && alarm4->is_added == false, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Order check failed\n");
+    DBG_ASSERT(rtc_alarm_process(alarm4->deadline) < 0, NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Process failed\n");
     DBG_ASSERT(!system_task_is_active(&_task), NO_ACTION, FUNCTION_RETURN_EXECUTION_ERROR, "Stop alarm failed\n");
 
     // Free handles
@@ -302,26 +335,106 @@ FUNCTION_RETURN_T rtc_alarm_selfcheck(void)
 
 static int _handle_alarm(struct pt* pt)
 {
+    int64_t remaining;
+
     PT_BEGIN(pt);
 
     do
     {
-        // Wait until alarm time is reached
-        PT_YIELD_UNTIL(pt, rtc_reached_timestamp(&_first_alarm->config.alarm_time));
-        // Stop alarm and trigger it's callback.
-        // Use temporary variable because _first_alarm pointer might change in rtc_alarm_stop.
-        rtc_alarm_handle_t alarm = _first_alarm;
-        // Stop first to ensure rtc_alarm_setup can be used in the callback!
-        rtc_alarm_stop(alarm);
-        // Trigger the callback
-        alarm->triggered = true;
-        // Trigger only the callback if callback is set.
-        if(alarm->config.f)
-            alarm->config.f(alarm, &alarm->config);
+        // Trigger all alarms that are due and wait for the next one. The waiting time is limited, because the
+        // tick count and the rtc might drift apart.
+        _wakeup = false;
+        remaining = rtc_alarm_process(rtc_get_current_time_ms());
+        if(remaining < 0)
+            break;
+
+        _wait_ms = remaining > RTC_ALARM_MAX_SLEEP_MS ? RTC_ALARM_MAX_SLEEP_MS : (uint32_t)remaining;
+        PT_YIELD_MS_OR_UNTIL(pt, _wait_ms, _wakeup);
     }
-    while(_first_alarm);
+    while(_heap_count > 0);
 
     PT_END(pt);
 }
 
+static void _rtc_event(rtc_observer_t* o, RTC_EVENT_T event)
+{
+    (void)o;
+    (void)event;
+    _wakeup = true;
+}
+
+static bool _is_before(const rtc_alarm_handle_t a, const rtc_alarm_handle_t b)
+{
+    if(a->deadline != b->deadline)
+        return a->deadline < b->deadline;
+
+    // Difference instead of comparison, so the order is kept when the sequence overflows.
+    return (int32_t)(a->sequence - b->sequence) < 0;
+}
+
+static void _heap_set(size_t i, rtc_alarm_handle_t alarm)
+{
+    _heap[i] = alarm;
+    alarm->heap_index = i;
+}
+
+static void _heap_sift_up(size_t i)
+{
+    rtc_alarm_handle_t alarm = _heap[i];
+    size_t parent;
+
+    while(i > 0)
+    {
+        parent = (i - 1) / 2;
+        if(!_is_before(alarm, _heap[parent]))
+            break;
+
+        _heap_set(i, _heap[parent]);
+        i = parent;
+    }
+    _heap_set(i, alarm);
+}
+
+static void _heap_sift_down(size_t i)
+{
+    rtc_alarm_handle_t alarm = _heap[i];
+    size_t child;
+
+    while((child = 2 * i + 1) < _heap_count)
+    {
+        if(child + 1 < _heap_count && _is_before(_heap[child + 1], _heap[child]))
+            child++;
+
+        if(!_is_before(_heap[child], alarm))
+            break;
+
+        _heap_set(i, _heap[child]);
+        i = child;
+    }
+    _heap_set(i, alarm);
+}
+
+static FUNCTION_RETURN_T _heap_reserve(void)
+{
+    rtc_alarm_handle_t* heap;
+    size_t size;
+
+    if(_heap_count < _heap_size)
+        return FUNCTION_RETURN_OK;
+
+    size = _heap_size ? _heap_size * 2 : RTC_ALARM_HEAP_INITIAL_SIZE;
+    heap = mcu_heap_calloc(size, sizeof(rtc_alarm_handle_t));
+    if(heap == NULL)
+        return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
+
+    if(_heap)
+    {
+        memcpy(heap, _heap, _heap_count * sizeof(rtc_alarm_handle_t));
+        mcu_heap_free(_heap);
+    }
+    _heap = heap;
+    _heap_size = size;
+    return FUNCTION_RETURN_OK;
+}
+
 #endif
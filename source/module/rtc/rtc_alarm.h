@@ -8,6 +8,12 @@
  *              Uses a background task that triggers the next alarm one the time for the alarm is reached.
  *              When using a mcu that supports rtc alarm, this will be used as a trigger instead of the background task (Current implementation only uses background task!).
  *
+ *  @version	1.01 (18.10.2026, Tim Koczwara)
+ *              - Alarms are kept in a binary min-heap with the alarm time in milliseconds as key, so setup and stop
+ *                need O(log n) instead of O(n) and thousands of alarms can be used.
+ *              - The task waits for the deadline of the next alarm instead of comparing the time on every call.
+ *              - Added rtc_alarm_process and rtc_alarm_get_count.
+ *              - rtc_alarm_process only triggers alarms that were set-up before it was called.
  *  @version	1.00 (01.02.2023, Tim Koczwara)
  *              - Initial implementation
  *
@@ -42,6 +48,12 @@
 // Configuration
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#ifndef RTC_ALARM_MAX_SLEEP_MS
+/// Maximum time in milliseconds the alarm task waits before it compares the deadline with the rtc again.
+/// The task waits using the tick count, so this limits the error when the tick count and the rtc drift apart.
+#define RTC_ALARM_MAX_SLEEP_MS      1000
+#endif
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -105,6 +117,7 @@ void rtc_alarm_free(rtc_alarm_handle_t alarm);
  * @retval FUNCTION_RETURN_OK           Alarm was setup and callback will be triggered when set time is reached.
  * @retval FUNCTION_RETURN_PARAM_ERROR  The handle or config pointer were NULL. Is also returned if the function callback in the config is NULL or the alarm_time in the config is 0.
  * @retval FUNCTION_RETURN_NOT_READY    Is returned if an alarm was already set-up. You need to stop the current using `rtc_alarm_stop` before setting it again.
+ * @retval FUNCTION_RETURN_INSUFFICIENT_MEMORY  The list of alarms could not be enlarged.
  */
 FUNCTION_RETURN_T rtc_alarm_setup(rtc_alarm_handle_t alarm, const rtc_alarm_config_t* config);
 /**
@@ -124,6 +137,22 @@ FUNCTION_RETURN_T rtc_alarm_stop(rtc_alarm_handle_t alarm);
  * @return false    Alarm was not triggered.
  */
 bool rtc_alarm_is_triggered(rtc_alarm_handle_t alarm);
+/**
+ * @brief Triggers all alarms whose time is reached at the given time, in the order of their alarm time.
+ * Is called by the alarm task with the current time of the rtc. It can be called directly to process alarms with
+ * another clock, e.g. to test with an accelerated time or to calculate the time until a low power mode has to end.
+ * Alarms that are set-up again inside a callback are only triggered by the next call, even if their time is reached.
+ * 
+ * @param now_ms    Current time in milliseconds since 1900 like `rtc_get_current_time_ms`.
+ * @return          Milliseconds until the next alarm is due, 0 if an alarm is already due or -1 if no alarm is set-up.
+ */
+int64_t rtc_alarm_process(int64_t now_ms);
+/**
+ * @brief Returns the number of alarms that are set-up and not triggered yet.
+ * 
+ * @return          Number of alarms.
+ */
+size_t rtc_alarm_get_count(void);
 #if RTC_ALARM_SELFTEST
 /**
  * @brief Execute selfcheck of the rtc alarm module.
@@ -0,0 +1,180 @@
+/**
+ * 	@file 		rtc_civil.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief		Converts between dates and the number of days since 1.1.1900 (RTC_EPOCH_YR) in constant time.
+ *
+ *  			The calculation counts the years from the 1st of march, so the leap day is the last day of the year and
+ *  			the days before a month follow the formula (153 * m + 2) / 5. There are no loops over years or months,
+ *  			so the time needed does not grow with the date.
+ *
+ *  			Each function consists of a single return statement, so they are static inline functions in C and
+ *  			constexpr functions in C++11:
+ * @code
+static_assert(rtc_civil_seconds_from_date(2000, 0, 1, 0, 0, 0) == 3155673600LL, "1.1.2000");
+ * @endcode
+ *
+ *  			Valid for the years 1 to 65535 + RTC_EPOCH_YR. Months are 0 - 11 like in rtc_time_t.
+ *
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ *  @par 	References
+ *  		- Howard Hinnant, "chrono-Compatible Low-Level Date Algorithms"
+ *
+ ******************************************************************************/
+#ifndef RTC_CIVIL_H_
+#define RTC_CIVIL_H_
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+/// Functions can be used in constant expressions in C++.
+#define RTC_CIVIL_FUNC					constexpr
+#else
+/// Functions are inlined in C.
+#define RTC_CIVIL_FUNC					static inline
+#endif
+
+/// Number of days from 1.3.0000 to 1.1.1900.
+#define RTC_CIVIL_DAYS_TO_EPOCH			693901
+
+/// Number of days in 400 years.
+#define RTC_CIVIL_DAYS_PER_ERA			146097
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Number of days from 1.3.0000 to the 1st of march of the given year.
+RTC_CIVIL_FUNC int32_t rtc_civil_internal_days_before_year(int32_t y)
+{
+	return 365 * y + y / 4 - y / 100 + y / 400;
+}
+
+/// Day of the year counted from the 1st of march (0 - 365) for a month 0 - 11.
+RTC_CIVIL_FUNC int32_t rtc_civil_internal_day_of_march_year(uint8_t mon, uint8_t mday)
+{
+	return (153 * ((mon + 10) % 12) + 2) / 5 + mday - 1;
+}
+
+/// Day of the 400 year era (0 - 146096) for the days since 1.1.1900.
+RTC_CIVIL_FUNC int32_t rtc_civil_internal_day_of_era(int32_t days)
+{
+	return (days + RTC_CIVIL_DAYS_TO_EPOCH) % RTC_CIVIL_DAYS_PER_ERA;
+}
+
+/// Year of the 400 year era (0 - 399) for the day of the era. The leap days are removed before dividing by 365.
+RTC_CIVIL_FUNC int32_t rtc_civil_internal_year_of_era(int32_t doe)
+{
+	return (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+}
+
+/// Day of the year counted from the 1st of march (0 - 365) for the day of the era.
+RTC_CIVIL_FUNC int32_t rtc_civil_internal_day_of_year(int32_t doe)
+{
+	return doe - rtc_civil_internal_days_before_year(rtc_civil_internal_year_of_era(doe));
+}
+
+/// Month counted from march (0 - 11) for the day of the year counted from the 1st of march.
+RTC_CIVIL_FUNC int32_t rtc_civil_internal_month_of_march_year(int32_t doy)
+{
+	return (5 * doy + 2) / 153;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Returns the number of days from 1.1.1900 to the given date.
+ *
+ * @param year			Year like 2024.
+ * @param mon			Month 0 - 11.
+ * @param mday			Day of the month 1 - 31.
+ * @return				Days since 1.1.1900. Negative for dates before.
+ */
+RTC_CIVIL_FUNC int32_t rtc_civil_days_from_date(int32_t year, uint8_t mon, uint8_t mday)
+{
+	return rtc_civil_internal_days_before_year(year - (mon < 2)) + rtc_civil_internal_day_of_march_year(mon, mday) - RTC_CIVIL_DAYS_TO_EPOCH;
+}
+
+/**
+ * @brief Returns the number of seconds from 1.1.1900 00:00:00 to the given date and time. Is the same as rtc_mktime.
+ *
+ * @param year			Year like 2024.
+ * @param mon			Month 0 - 11.
+ * @param mday			Day of the month 1 - 31.
+ * @param hour			Hour 0 - 23.
+ * @param min			Minute 0 - 59.
+ * @param sec			Second 0 - 59.
+ * @return				Seconds since 1.1.1900.
+ */
+RTC_CIVIL_FUNC int64_t rtc_civil_seconds_from_date(int32_t year, uint8_t mon, uint8_t mday, uint8_t hour, uint8_t min, uint8_t sec)
+{
+	return (int64_t)rtc_civil_days_from_date(year, mon, mday) * 86400 + hour * 3600L + min * 60L + sec;
+}
+
+/**
+ * @brief Returns the year of the day.
+ *
+ * @param days			Days since 1.1.1900.
+ * @return				Year like 2024.
+ */
+RTC_CIVIL_FUNC int32_t rtc_civil_year_from_days(int32_t days)
+{
+	return (days + RTC_CIVIL_DAYS_TO_EPOCH) / RTC_CIVIL_DAYS_PER_ERA * 400 + rtc_civil_internal_year_of_era(rtc_civil_internal_day_of_era(days))
+			+ (rtc_civil_internal_month_of_march_year(rtc_civil_internal_day_of_year(rtc_civil_internal_day_of_era(days))) >= 10);
+}
+
+/**
+ * @brief Returns the month of the day.
+ *
+ * @param days			Days since 1.1.1900.
+ * @return				Month 0 - 11.
+ */
+RTC_CIVIL_FUNC uint8_t rtc_civil_mon_from_days(int32_t days)
+{
+	return (uint8_t)((rtc_civil_internal_month_of_march_year(rtc_civil_internal_day_of_year(rtc_civil_internal_day_of_era(days))) + 2) % 12);
+}
+
+/**
+ * @brief Returns the day of the month of the day.
+ *
+ * @param days			Days since 1.1.1900.
+ * @return				Day of the month 1 - 31.
+ */
+RTC_CIVIL_FUNC uint8_t rtc_civil_mday_from_days(int32_t days)
+{
+	return (uint8_t)(rtc_civil_internal_day_of_year(rtc_civil_internal_day_of_era(days))
+			- (153 * rtc_civil_internal_month_of_march_year(rtc_civil_internal_day_of_year(rtc_civil_internal_day_of_era(days))) + 2) / 5 + 1);
+}
+
+/**
+ * @brief Returns the day of the week of the day. 1.1.1900 was a monday.
+ *
+ * @param days			Days since 1.1.1900.
+ * @return				Day of the week 0 - 6, starting with sunday.
+ */
+RTC_CIVIL_FUNC uint8_t rtc_civil_wday_from_days(int32_t days)
+{
+	return (uint8_t)((days % 7 + 8) % 7);
+}
+
+/**
+ * @brief Returns the day of the year of the day.
+ *
+ * @param days			Days since 1.1.1900.
+ * @return				Day of the year 0 - 365.
+ */
+RTC_CIVIL_FUNC uint16_t rtc_civil_yday_from_days(int32_t days)
+{
+	return (uint16_t)(days - rtc_civil_days_from_date(rtc_civil_year_from_days(days), 0, 1));
+}
+
+#endif /* RTC_CIVIL_H_ */
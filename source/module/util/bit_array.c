@@ -6,10 +6,56 @@
 #include "module/util/assert.h"
 #include <string.h>
 
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Native word that is used for scanning. Bit i of the array is bit (i % _WORD_BITS) of the loaded little endian word.
+typedef unsigned long _word_t;
+
+#define _WORD_BYTES                     sizeof(_word_t)
+#define _WORD_BITS                      (_WORD_BYTES * 8)
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#if __SIZEOF_LONG__ == 8
+#define _WORD_FROM_LE(w)                __builtin_bswap64(w)
+#else
+#define _WORD_FROM_LE(w)                __builtin_bswap32(w)
+#endif
+#else
+#define _WORD_FROM_LE(w)                (w)
+#endif
+
+/// Function for combining two bytes of bit arrays
+typedef enum _bit_op_e
+{
+    _BIT_OP_AND,
+    _BIT_OP_OR,
+    _BIT_OP_XOR,
+    _BIT_OP_ANDNOT
+}_bit_op_t;
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Prototypes
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Loads a word from an unaligned position of the array with bit 0 of the first byte as bit 0 of the word.
+ */
+static inline _word_t _load_word(const uint8_t* p);
+/**
+ * @brief Returns the first bit at or after index whose value is not equal to the bits in invert (0 to find set bits, all ones for cleared bits).
+ */
+static size_t _find_next(bit_array_handle_t ba, size_t index, _word_t invert);
+/**
+ * @brief Sets or clears a range of bits.
+ */
+static FUNCTION_RETURN_T _set_range(bit_array_handle_t ba, size_t index, size_t num, bool value);
+/**
+ * @brief Combines dst with src using op and stores the result in dst.
+ */
+static FUNCTION_RETURN_T _combine(bit_array_handle_t dst, bit_array_handle_t src, _bit_op_t op);
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal variables
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -139,12 +185,7 @@ bool bit_array_has_any_set(bit_array_handle_t ba)
 {
     ASSERT_RET(ba, NO_ACTION, false, "Invalid bit array handle\n");
 
-    for(int i = 0; i < ba->size; i++)
-    {
-        if(ba->array[i])
-            return true;
-    }
-    return false;
+    return _find_next(ba, 0, 0) != BIT_ARRAY_NOT_FOUND;
 }
 
 int bit_array_compare(bit_array_handle_t ba1, bit_array_handle_t ba2)
@@ -160,7 +201,183 @@ int bit_array_compare(bit_array_handle_t ba1, bit_array_handle_t ba2)
 	return memcmp(ba1->array, ba2->array, ba1->size);
 }
 
+size_t bit_array_count(bit_array_handle_t ba)
+{
+    ASSERT_RET(ba, NO_ACTION, 0, "Invalid bit array handle\n");
+
+    size_t cnt = 0;
+    size_t i = 0;
+
+    // The byte order does not matter for counting, so the words are not converted.
+    for(; i + _WORD_BYTES <= ba->size; i += _WORD_BYTES)
+    {
+        _word_t w;
+        memcpy(&w, &ba->array[i], _WORD_BYTES);
+        cnt += __builtin_popcountl(w);
+    }
+
+    for(; i < ba->size; i++)
+    {
+        cnt += __builtin_popcount(ba->array[i]);
+    }
+
+    return cnt;
+}
+
+size_t bit_array_find_next_set(bit_array_handle_t ba, size_t index)
+{
+    ASSERT_RET(ba, NO_ACTION, BIT_ARRAY_NOT_FOUND, "Invalid bit array handle\n");
+
+    return _find_next(ba, index, 0);
+}
+
+size_t bit_array_find_next_clear(bit_array_handle_t ba, size_t index)
+{
+    ASSERT_RET(ba, NO_ACTION, BIT_ARRAY_NOT_FOUND, "Invalid bit array handle\n");
+
+    return _find_next(ba, index, ~(_word_t)0);
+}
+
+FUNCTION_RETURN_T bit_array_set_range(bit_array_handle_t ba, size_t index, size_t num)
+{
+    return _set_range(ba, index, num, true);
+}
+
+FUNCTION_RETURN_T bit_array_clear_range(bit_array_handle_t ba, size_t index, size_t num)
+{
+    return _set_range(ba, index, num, false);
+}
+
+FUNCTION_RETURN_T bit_array_and(bit_array_handle_t dst, bit_array_handle_t src)
+{
+    return _combine(dst, src, _BIT_OP_AND);
+}
+
+FUNCTION_RETURN_T bit_array_or(bit_array_handle_t dst, bit_array_handle_t src)
+{
+    return _combine(dst, src, _BIT_OP_OR);
+}
+
+FUNCTION_RETURN_T bit_array_xor(bit_array_handle_t dst, bit_array_handle_t src)
+{
+    return _combine(dst, src, _BIT_OP_XOR);
+}
+
+FUNCTION_RETURN_T bit_array_andnot(bit_array_handle_t dst, bit_array_handle_t src)
+{
+    return _combine(dst, src, _BIT_OP_ANDNOT);
+}
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+static inline _word_t _load_word(const uint8_t* p)
+{
+    _word_t w;
+    memcpy(&w, p, _WORD_BYTES);
+    return _WORD_FROM_LE(w);
+}
+
+static size_t _find_next(bit_array_handle_t ba, size_t index, _word_t invert)
+{
+    size_t i = index >> 3;
+    uint8_t b;
+
+    if(i >= ba->size)
+        return BIT_ARRAY_NOT_FOUND;
+
+    // Bits in front of index inside the first byte are masked out.
+    b = (ba->array[i] ^ (uint8_t)invert) & (uint8_t)(0xFF << (index & 7));
+    if(b)
+        return (i << 3) + __builtin_ctz(b);
+
+    for(i++; i + _WORD_BYTES <= ba->size; i += _WORD_BYTES)
+    {
+        _word_t w = _load_word(&ba->array[i]) ^ invert;
+        if(w)
+            return (i << 3) + __builtin_ctzl(w);
+    }
+
+    for(; i < ba->size; i++)
+    {
+        b = ba->array[i] ^ (uint8_t)invert;
+        if(b)
+            return (i << 3) + __builtin_ctz(b);
+    }
+
+    return BIT_ARRAY_NOT_FOUND;
+}
+
+static FUNCTION_RETURN_T _set_range(bit_array_handle_t ba, size_t index, size_t num, bool value)
+{
+    ASSERT_RET(ba, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid bit array handle\n");
+    ASSERT_RET(index + num >= index && index + num <= (ba->size << 3), NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid bit array range\n");
+
+    if(num == 0)
+        return FUNCTION_RETURN_OK;
+
+    size_t end = index + num - 1;
+    size_t first = index >> 3;
+    size_t last = end >> 3;
+    uint8_t first_mask = 0xFF << (index & 7);
+    uint8_t last_mask = 0xFF >> (7 - (end & 7));
+
+    if(first == last)
+    {
+        first_mask &= last_mask;
+    }
+    else
+    {
+        // Complete bytes between the first and last byte
+        memset(&ba->array[first + 1], value ? 0xFF : 0x00, last - first - 1);
+
+        if(value)
+            ba->array[last] |= last_mask;
+        else
+            ba->array[last] &= ~last_mask;
+    }
+
+    if(value)
+        ba->array[first] |= first_mask;
+    else
+        ba->array[first] &= ~first_mask;
+
+    return FUNCTION_RETURN_OK;
+}
+
+static FUNCTION_RETURN_T _combine(bit_array_handle_t dst, bit_array_handle_t src, _bit_op_t op)
+{
+    ASSERT_RET(dst && src, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid bit array handle\n");
+    ASSERT_RET(dst->size == src->size, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Bit array sizes differ\n");
+
+    uint8_t* d = dst->array;
+    const uint8_t* s = src->array;
+    size_t n = dst->size;
+
+    // Simple loops per operation, so the compiler can vectorize them.
+    switch(op)
+    {
+        case _BIT_OP_AND:
+            for(size_t i = 0; i < n; i++)
+                d[i] &= s[i];
+            break;
+
+        case _BIT_OP_OR:
+            for(size_t i = 0; i < n; i++)
+                d[i] |= s[i];
+            break;
+
+        case _BIT_OP_XOR:
+            for(size_t i = 0; i < n; i++)
+                d[i] ^= s[i];
+            break;
+
+        case _BIT_OP_ANDNOT:
+            for(size_t i = 0; i < n; i++)
+                d[i] &= ~s[i];
+            break;
+    }
+
+    return FUNCTION_RETURN_OK;
+}
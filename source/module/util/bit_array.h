@@ -6,6 +6,8 @@
  *  @brief
  *			Function to store large bitmask in an array with functions to set and clear the bit as well as checking if it is set.
  *
+ *  @version	1.01 (18.10.2026)
+ *  	- Added word based functions for counting, searching, ranges and combining bit arrays
  *  @version	1.00 (31.01.2023)
  *  	- Intial release
  *
@@ -22,6 +24,9 @@
 // Defines
 //------------------------------------------------------------------------------------------------------------
 
+/// Returned by the find functions if no matching bit was found.
+#define BIT_ARRAY_NOT_FOUND             SIZE_MAX
+
 //------------------------------------------------------------------------------------------------------------
 // Type Definition
 //------------------------------------------------------------------------------------------------------------
@@ -142,5 +147,85 @@ bool bit_array_has_any_set(bit_array_handle_t ba);
  * 							Otherwise they differ in some way
  */
 int bit_array_compare(bit_array_handle_t ba1, bit_array_handle_t ba2);
+/**
+ * @brief Counts the number of bits that are set inside the bit array.
+ *
+ * @param ba                    Handle for the bit array as created using `bit_array_create`.
+ * @return                      Number of bits that are set to 1.
+ */
+size_t bit_array_count(bit_array_handle_t ba);
+/**
+ * @brief Returns the index of the first bit that is set at or after index.
+ * Can be used to iterate all set bits:
+ * @code
+for(size_t i = bit_array_find_next_set(ba, 0); i != BIT_ARRAY_NOT_FOUND; i = bit_array_find_next_set(ba, i + 1))
+{
+    // Bit i is set
+}
+ * @endcode
+ *
+ * @param ba                    Handle for the bit array as created using `bit_array_create`.
+ * @param index                 Index of the first bit that is checked.
+ * @return                      Index of the set bit or BIT_ARRAY_NOT_FOUND if no bit is set at or after index.
+ */
+size_t bit_array_find_next_set(bit_array_handle_t ba, size_t index);
+/**
+ * @brief Returns the index of the first bit that is cleared at or after index. Useful to find a free slot.
+ *
+ * @param ba                    Handle for the bit array as created using `bit_array_create`.
+ * @param index                 Index of the first bit that is checked.
+ * @return                      Index of the cleared bit or BIT_ARRAY_NOT_FOUND if no bit is cleared at or after index.
+ */
+size_t bit_array_find_next_clear(bit_array_handle_t ba, size_t index);
+/**
+ * @brief Sets a range of bits inside the bit array.
+ *
+ * @param ba                    Handle for the bit array as created using `bit_array_create`.
+ * @param index                 Index of the first bit that should be set.
+ * @param num                   Number of bits that should be set.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or parameter error if the range is outside the bit array.
+ */
+FUNCTION_RETURN_T bit_array_set_range(bit_array_handle_t ba, size_t index, size_t num);
+/**
+ * @brief Clears a range of bits inside the bit array.
+ *
+ * @param ba                    Handle for the bit array as created using `bit_array_create`.
+ * @param index                 Index of the first bit that should be cleared.
+ * @param num                   Number of bits that should be cleared.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or parameter error if the range is outside the bit array.
+ */
+FUNCTION_RETURN_T bit_array_clear_range(bit_array_handle_t ba, size_t index, size_t num);
+/**
+ * @brief Combines two bit arrays of the same size with a bitwise and. The result is stored in dst.
+ *
+ * @param dst                   Handle for the bit array that is modified.
+ * @param src                   Handle for the second bit array.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or parameter error if a handle is invalid or the sizes differ.
+ */
+FUNCTION_RETURN_T bit_array_and(bit_array_handle_t dst, bit_array_handle_t src);
+/**
+ * @brief Combines two bit arrays of the same size with a bitwise or. The result is stored in dst.
+ *
+ * @param dst                   Handle for the bit array that is modified.
+ * @param src                   Handle for the second bit array.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or parameter error if a handle is invalid or the sizes differ.
+ */
+FUNCTION_RETURN_T bit_array_or(bit_array_handle_t dst, bit_array_handle_t src);
+/**
+ * @brief Combines two bit arrays of the same size with a bitwise exclusive or. The result is stored in dst.
+ *
+ * @param dst                   Handle for the bit array that is modified.
+ * @param src                   Handle for the second bit array.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or parameter error if a handle is invalid or the sizes differ.
+ */
+FUNCTION_RETURN_T bit_array_xor(bit_array_handle_t dst, bit_array_handle_t src);
+/**
+ * @brief Clears all bits in dst that are set in src. Both bit arrays need the same size.
+ *
+ * @param dst                   Handle for the bit array that is modified.
+ * @param src                   Handle for the bit array with the bits that should be cleared.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or parameter error if a handle is invalid or the sizes differ.
+ */
+FUNCTION_RETURN_T bit_array_andnot(bit_array_handle_t dst, bit_array_handle_t src);
 
 #endif // __UTIL_BIT_ARRAY__FIRST_INCL
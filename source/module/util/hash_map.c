@@ -0,0 +1,362 @@
+/***
+ * @file hash_map.c
+ * @copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ **/
+#include "hash_map.h"
+#include "module/util/assert.h"
+#include <string.h>
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal definitions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Minimum number of entries of a dynamic map.
+#define _MIN_DYNAMIC_CAPACITY           8
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal structures and enums
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Key that is searched, so the internal functions can be used for both key types.
+typedef struct _key_s
+{
+    /// Pointer to the string key
+    const char* str;
+    /// Length of the string key
+    size_t len;
+    /// Integer key
+    uintptr_t num;
+    /// Hash of the key
+    uint32_t hash;
+}_key_t;
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Creates the key for a string.
+ */
+static _key_t _key_str(const char* key, size_t len);
+/**
+ * @brief Creates the key for an integer.
+ */
+static _key_t _key_int(uintptr_t key);
+/**
+ * @brief Returns the index of the entry with the key or the index of the empty entry where the search stopped.
+ */
+static size_t _find(const hash_map_t* map, const _key_t* k);
+/**
+ * @brief Adds or replaces the key.
+ */
+static FUNCTION_RETURN_T _put(hash_map_t* map, const _key_t* k, void* value);
+/**
+ * @brief Removes the key and shifts the following entries back, so no deleted marker is needed.
+ */
+static FUNCTION_RETURN_T _remove(hash_map_t* map, const _key_t* k);
+/**
+ * @brief Moves all entries into a new array with the given capacity.
+ */
+static FUNCTION_RETURN_T _resize(hash_map_t* map, size_t capacity);
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// External Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+FUNCTION_RETURN_T hash_map_init(hash_map_t* map, HASH_MAP_KEY_TYPE key_type, hash_map_entry_t* entries, size_t capacity)
+{
+    ASSERT_RET(map && entries, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid hash map\n");
+    ASSERT_RET(capacity >= 2 && (capacity & (capacity - 1)) == 0, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Hash map capacity must be a power of two\n");
+
+    map->entries = entries;
+    map->capacity = capacity;
+    map->key_type = key_type;
+    map->is_dynamic = false;
+    hash_map_clear(map);
+
+    return FUNCTION_RETURN_OK;
+}
+
+FUNCTION_RETURN_T hash_map_init_dynamic(hash_map_t* map, HASH_MAP_KEY_TYPE key_type, size_t capacity)
+{
+    size_t c = _MIN_DYNAMIC_CAPACITY;
+
+    ASSERT_RET(map, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid hash map\n");
+
+    while(c < capacity)
+        c <<= 1;
+
+    map->entries = mcu_heap_calloc(c, sizeof(hash_map_entry_t));
+    if(map->entries == NULL)
+        return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
+
+    map->capacity = c;
+    map->count = 0;
+    map->key_type = key_type;
+    map->is_dynamic = true;
+
+    return FUNCTION_RETURN_OK;
+}
+
+void hash_map_free(hash_map_t* map)
+{
+    if(map == NULL || !map->is_dynamic)
+        return;
+
+    mcu_heap_free(map->entries);
+    map->entries = NULL;
+    map->capacity = 0;
+    map->count = 0;
+}
+
+void hash_map_clear(hash_map_t* map)
+{
+    if(map == NULL || map->entries == NULL)
+        return;
+
+    memset(map->entries, 0, map->capacity * sizeof(hash_map_entry_t));
+    map->count = 0;
+}
+
+FUNCTION_RETURN_T hash_map_put_str(hash_map_t* map, const char* key, void* value)
+{
+    ASSERT_RET(map && key && map->key_type == HASH_MAP_KEY_STRING, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid hash map key\n");
+
+    _key_t k = _key_str(key, strlen(key));
+    return _put(map, &k, value);
+}
+
+FUNCTION_RETURN_T hash_map_put_int(hash_map_t* map, uintptr_t key, void* value)
+{
+    ASSERT_RET(map && map->key_type == HASH_MAP_KEY_INT, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid hash map key\n");
+
+    _key_t k = _key_int(key);
+    return _put(map, &k, value);
+}
+
+void* hash_map_get_str(const hash_map_t* map, const char* key)
+{
+    if(key == NULL)
+        return NULL;
+
+    return hash_map_get_strn(map, key, strlen(key));
+}
+
+void* hash_map_get_strn(const hash_map_t* map, const char* key, size_t len)
+{
+    if(map == NULL || key == NULL || map->entries == NULL || map->key_type != HASH_MAP_KEY_STRING)
+        return NULL;
+
+    _key_t k = _key_str(key, len);
+    return map->entries[_find(map, &k)].value;
+}
+
+void* hash_map_get_strn_hashed(const hash_map_t* map, const char* key, size_t len, uint32_t hash)
+{
+    if(map == NULL || key == NULL || map->entries == NULL || map->key_type != HASH_MAP_KEY_STRING)
+        return NULL;
+
+    _key_t k = {.str = key, .len = len, .num = 0, .hash = hash};
+    return map->entries[_find(map, &k)].value;
+}
+
+void* hash_map_get_int(const hash_map_t* map, uintptr_t key)
+{
+    if(map == NULL || map->entries == NULL || map->key_type != HASH_MAP_KEY_INT)
+        return NULL;
+
+    _key_t k = _key_int(key);
+    return map->entries[_find(map, &k)].value;
+}
+
+FUNCTION_RETURN_T hash_map_remove_str(hash_map_t* map, const char* key)
+{
+    ASSERT_RET(map && key && map->key_type == HASH_MAP_KEY_STRING, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid hash map key\n");
+
+    _key_t k = _key_str(key, strlen(key));
+    return _remove(map, &k);
+}
+
+FUNCTION_RETURN_T hash_map_remove_int(hash_map_t* map, uintptr_t key)
+{
+    ASSERT_RET(map && map->key_type == HASH_MAP_KEY_INT, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid hash map key\n");
+
+    _key_t k = _key_int(key);
+    return _remove(map, &k);
+}
+
+size_t hash_map_count(const hash_map_t* map)
+{
+    if(map == NULL)
+        return 0;
+
+    return map->count;
+}
+
+uint32_t hash_map_hash_str(const char* key, size_t len)
+{
+    // FNV-1a
+    uint32_t h = 2166136261u;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        h ^= (uint8_t)key[i];
+        h *= 16777619u;
+    }
+
+    return h ? h : 1;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Internal Functions
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static _key_t _key_str(const char* key, size_t len)
+{
+    _key_t k = {.str = key, .len = len, .num = 0, .hash = hash_map_hash_str(key, len)};
+    return k;
+}
+
+static _key_t _key_int(uintptr_t key)
+{
+    // Finalizer of murmur3, so keys that only differ in the upper bits are spread over the table.
+    uint32_t h = (uint32_t)key ^ (uint32_t)((uint64_t)key >> 32);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+
+    _key_t k = {.str = NULL, .len = 0, .num = key, .hash = h ? h : 1};
+    return k;
+}
+
+static size_t _find(const hash_map_t* map, const _key_t* k)
+{
+    size_t mask = map->capacity - 1;
+    size_t i = k->hash & mask;
+
+    // Terminates, because there is always at least one empty entry.
+    while(map->entries[i].hash != 0)
+    {
+        const hash_map_entry_t* e = &map->entries[i];
+
+        if(e->hash == k->hash)
+        {
+            if(map->key_type == HASH_MAP_KEY_INT)
+            {
+                if(e->key.num == k->num)
+                    return i;
+            }
+            else if(strncmp(e->key.str, k->str, k->len) == 0 && e->key.str[k->len] == 0)
+            {
+                return i;
+            }
+        }
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+static FUNCTION_RETURN_T _put(hash_map_t* map, const _key_t* k, void* value)
+{
+    size_t i;
+
+    if(map->entries == NULL)
+        return FUNCTION_RETURN_NOT_READY;
+
+    i = _find(map, k);
+
+    if(map->entries[i].hash == 0)
+    {
+        // Dynamic maps grow at 75%, fixed maps keep one entry empty.
+        if(map->is_dynamic && (map->count + 1) * 4 > map->capacity * 3)
+        {
+            if(_resize(map, map->capacity * 2) != FUNCTION_RETURN_OK)
+                return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
+
+            i = _find(map, k);
+        }
+        else if(map->count + 1 >= map->capacity)
+        {
+            return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
+        }
+
+        map->entries[i].hash = k->hash;
+        if(map->key_type == HASH_MAP_KEY_INT)
+            map->entries[i].key.num = k->num;
+        else
+            map->entries[i].key.str = k->str;
+        map->count++;
+    }
+
+    map->entries[i].value = value;
+
+    return FUNCTION_RETURN_OK;
+}
+
+static FUNCTION_RETURN_T _remove(hash_map_t* map, const _key_t* k)
+{
+    size_t mask;
+    size_t i, j;
+
+    if(map->entries == NULL)
+        return FUNCTION_RETURN_NOT_FOUND;
+
+    mask = map->capacity - 1;
+    i = _find(map, k);
+
+    if(map->entries[i].hash == 0)
+        return FUNCTION_RETURN_NOT_FOUND;
+
+    // Move following entries into the gap if the gap lies between their home position and their current position.
+    j = i;
+    while(true)
+    {
+        j = (j + 1) & mask;
+        if(map->entries[j].hash == 0)
+            break;
+
+        size_t home = map->entries[j].hash & mask;
+        if(((j - home) & mask) >= ((j - i) & mask))
+        {
+            map->entries[i] = map->entries[j];
+            i = j;
+        }
+    }
+
+    memset(&map->entries[i], 0, sizeof(hash_map_entry_t));
+    map->count--;
+
+    return FUNCTION_RETURN_OK;
+}
+
+static FUNCTION_RETURN_T _resize(hash_map_t* map, size_t capacity)
+{
+    hash_map_entry_t* old = map->entries;
+    size_t old_capacity = map->capacity;
+    hash_map_entry_t* entries = mcu_heap_calloc(capacity, sizeof(hash_map_entry_t));
+
+    if(entries == NULL)
+        return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
+
+    map->entries = entries;
+    map->capacity = capacity;
+
+    for(size_t i = 0; i < old_capacity; i++)
+    {
+        if(old[i].hash != 0)
+        {
+            // Keys are unique, so the first empty entry of the probe sequence is the new position.
+            size_t j = old[i].hash & (capacity - 1);
+            while(entries[j].hash != 0)
+                j = (j + 1) & (capacity - 1);
+            entries[j] = old[i];
+        }
+    }
+
+    mcu_heap_free(old);
+
+    return FUNCTION_RETURN_OK;
+}
@@ -0,0 +1,211 @@
+/**
+ * 	@file 	hash_map.h
+ * 	@copyright Urheberrecht 2026 ESoPe GmbH, Alle Rechte vorbehalten. Released under an Apache 2.0 license.
+ *  @author 	Tim Koczwara
+ *
+ *  @brief
+ *			Open addressing hash map with linear probing for looking up pointers by a string or integer key.
+ *
+ *			The map can either work on a fixed array of entries given by the caller, which needs no heap at all, or
+ *			allocate its entries on the heap and grow when it is filled to 75%. Removing uses backward shifting, so there are no
+ *			deleted markers that slow down the lookup over time.
+ *
+ *			String keys are not copied. Only the pointer is stored, so the string needs to stay valid while it is in the map.
+ *
+ *  @version	1.01 (18.10.2026)
+ *  	- Added hash_map_get_strn_hashed to look up a key whose hash was already calculated
+ *  @version	1.00 (18.10.2026)
+ *  	- Intial release
+ *
+ *	@par 	References
+ *
+ ******************************************************************************/
+#ifndef __UTIL_HASH_MAP__FIRST_INCL
+#define __UTIL_HASH_MAP__FIRST_INCL
+
+#include "module_public.h"
+#include "module/enum/function_return.h"
+
+//------------------------------------------------------------------------------------------------------------
+// Defines
+//------------------------------------------------------------------------------------------------------------
+
+/// Smallest power of two that is at least twice n. Can be used at compile time to size a fixed map for n keys with a load of 50% or less.
+#define HASH_MAP_CAPACITY(n)            (_HASH_MAP_SMEAR16(2 * (n) - 1) + 1)
+
+#define _HASH_MAP_SMEAR1(x)             ((x) | ((x) >> 1))
+#define _HASH_MAP_SMEAR2(x)             (_HASH_MAP_SMEAR1(x) | (_HASH_MAP_SMEAR1(x) >> 2))
+#define _HASH_MAP_SMEAR4(x)             (_HASH_MAP_SMEAR2(x) | (_HASH_MAP_SMEAR2(x) >> 4))
+#define _HASH_MAP_SMEAR8(x)             (_HASH_MAP_SMEAR4(x) | (_HASH_MAP_SMEAR4(x) >> 8))
+#define _HASH_MAP_SMEAR16(x)            (_HASH_MAP_SMEAR8(x) | (_HASH_MAP_SMEAR8(x) >> 16))
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Structure and Enum
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+/// Type of the keys inside a hash map.
+typedef enum HASH_MAP_KEY_TYPE_E
+{
+    /// Keys are zero terminated strings.
+    HASH_MAP_KEY_STRING = 0,
+    /// Keys are integers.
+    HASH_MAP_KEY_INT
+}HASH_MAP_KEY_TYPE;
+
+/// Entry inside the hash map. Only used to provide the storage for the map, do not access the members directly.
+typedef struct hash_map_entry_s
+{
+    /// Key of the entry.
+    union
+    {
+        /// Key for HASH_MAP_KEY_STRING.
+        const char* str;
+        /// Key for HASH_MAP_KEY_INT.
+        uintptr_t num;
+    }key;
+    /// Value that is stored for the key.
+    void* value;
+    /// Hash of the key. 0 marks an empty entry.
+    uint32_t hash;
+}hash_map_entry_t;
+
+/// Context of a hash map. Initialize with hash_map_init or hash_map_init_dynamic.
+typedef struct hash_map_s
+{
+    /// Array of entries.
+    hash_map_entry_t* entries;
+    /// Number of entries in the array. Is always a power of two.
+    size_t capacity;
+    /// Number of keys that are stored.
+    size_t count;
+    /// Type of the keys.
+    HASH_MAP_KEY_TYPE key_type;
+    /// true if the entries are allocated by the map and it can grow.
+    bool is_dynamic;
+}hash_map_t;
+
+//------------------------------------------------------------------------------------------------------------
+// External functions
+//------------------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Initializes a hash map on a fixed array of entries. The map does not allocate memory and can store up to capacity - 1 keys.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key_type              Type of the keys.
+ * @param entries               Array of entries used as storage.
+ * @param capacity              Number of elements in entries. Must be a power of two and at least 2.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success or FUNCTION_RETURN_PARAM_ERROR on invalid parameters.
+ */
+FUNCTION_RETURN_T hash_map_init(hash_map_t* map, HASH_MAP_KEY_TYPE key_type, hash_map_entry_t* entries, size_t capacity);
+/**
+ * @brief Initializes a hash map that allocates its entries on the heap and grows when needed.
+ * Call @see hash_map_free if the map is not needed anymore.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key_type              Type of the keys.
+ * @param capacity              Initial number of entries. Is rounded up to a power of two.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success, FUNCTION_RETURN_INSUFFICIENT_MEMORY if the entries cannot be allocated.
+ */
+FUNCTION_RETURN_T hash_map_init_dynamic(hash_map_t* map, HASH_MAP_KEY_TYPE key_type, size_t capacity);
+/**
+ * @brief Frees the entries of a map that was initialized with @see hash_map_init_dynamic. Does nothing for fixed maps.
+ *
+ * @param map                   Pointer to the map context.
+ */
+void hash_map_free(hash_map_t* map);
+/**
+ * @brief Removes all keys from the map.
+ *
+ * @param map                   Pointer to the map context.
+ */
+void hash_map_clear(hash_map_t* map);
+/**
+ * @brief Adds a string key to the map or replaces the value if the key already exists.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Zero terminated key. Only the pointer is stored.
+ * @param value                 Value for the key.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success, FUNCTION_RETURN_INSUFFICIENT_MEMORY if the map is full and cannot grow
+ *                              or FUNCTION_RETURN_PARAM_ERROR on invalid parameters.
+ */
+FUNCTION_RETURN_T hash_map_put_str(hash_map_t* map, const char* key, void* value);
+/**
+ * @brief Adds an integer key to the map or replaces the value if the key already exists.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Key
+ * @param value                 Value for the key.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK on success, FUNCTION_RETURN_INSUFFICIENT_MEMORY if the map is full and cannot grow
+ *                              or FUNCTION_RETURN_PARAM_ERROR on invalid parameters.
+ */
+FUNCTION_RETURN_T hash_map_put_int(hash_map_t* map, uintptr_t key, void* value);
+/**
+ * @brief Returns the value of a string key.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Zero terminated key.
+ * @return                      Value of the key or NULL if the key is not in the map.
+ */
+void* hash_map_get_str(const hash_map_t* map, const char* key);
+/**
+ * @brief Returns the value of a string key that is not zero terminated, for example a word inside a line.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Pointer to the key.
+ * @param len                   Length of the key.
+ * @return                      Value of the key or NULL if the key is not in the map.
+ */
+void* hash_map_get_strn(const hash_map_t* map, const char* key, size_t len);
+/**
+ * @brief Same as hash_map_get_strn, but with the hash of the key from hash_map_hash_str. Use it to look up the same key
+ * in multiple maps without hashing it again.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Pointer to the key.
+ * @param len                   Length of the key.
+ * @param hash                  Hash of the key calculated by hash_map_hash_str.
+ * @return                      Value of the key or NULL if the key is not in the map.
+ */
+void* hash_map_get_strn_hashed(const hash_map_t* map, const char* key, size_t len, uint32_t hash);
+/**
+ * @brief Returns the value of an integer key.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Key
+ * @return                      Value of the key or NULL if the key is not in the map.
+ */
+void* hash_map_get_int(const hash_map_t* map, uintptr_t key);
+/**
+ * @brief Removes a string key from the map.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Zero terminated key.
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK if the key was removed or FUNCTION_RETURN_NOT_FOUND if it was not in the map.
+ */
+FUNCTION_RETURN_T hash_map_remove_str(hash_map_t* map, const char* key);
+/**
+ * @brief Removes an integer key from the map.
+ *
+ * @param map                   Pointer to the map context.
+ * @param key                   Key
+ * @return FUNCTION_RETURN_T    FUNCTION_RETURN_OK if the key was removed or FUNCTION_RETURN_NOT_FOUND if it was not in the map.
+ */
+FUNCTION_RETURN_T hash_map_remove_int(hash_map_t* map, uintptr_t key);
+/**
+ * @brief Returns the number of keys in the map.
+ *
+ * @param map                   Pointer to the map context.
+ * @return                      Number of keys.
+ */
+size_t hash_map_count(const hash_map_t* map);
+/**
+ * @brief Calculates the hash of a string the same way the hash map does. Can be used to pre-hash keys.
+ *
+ * @param key                   Pointer to the string.
+ * @param len                   Length of the string.
+ * @return                      Hash of the string. Is never 0.
+ */
+uint32_t hash_map_hash_str(const char* key, size_t len);
+
+#endif // __UTIL_HASH_MAP__FIRST_INCL
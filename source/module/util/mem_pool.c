@@ -11,17 +11,37 @@
 #if MCU_ENABLE_FREERTOS
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/task.h"
 #endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal definitions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#if MEM_POOL_CORE_CACHE_SIZE > 0 && MCU_ENABLE_FREERTOS && defined(ESP_PLATFORM) && portNUM_PROCESSORS > 1
+/// Core caches are only used on multi-core targets, where the semaphore is contended by both cores.
+#define MEM_POOL_USE_CORE_CACHE         1
+#else
+#define MEM_POOL_USE_CORE_CACHE         0
+#endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal structures and enums
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+#if MEM_POOL_USE_CORE_CACHE
+/// Cache of single free chunks that belongs to one core.
+typedef struct mem_pool_core_cache_s
+{
+    /// Spinlock protecting this cache. Is only contended when a cache is drained by the other core.
+    portMUX_TYPE lock;
+    /// Number of chunks in the cache.
+    size_t num;
+    /// Cached chunks
+    mem_pool_chunk_handle_t chunks[MEM_POOL_CORE_CACHE_SIZE];
+}mem_pool_core_cache_t;
+#endif
+
 /// Data for the memory pool
 struct mem_pool_s
 {
@@ -31,17 +51,94 @@ struct mem_pool_s
     size_t chunk_size;
     /// Pointer an array of chunks that is allocated when the pool is created. 
     mem_pool_chunk_t* chunks;
+    /// First chunk of the free list. Free chunks are linked via their `next` pointer.
+    mem_pool_chunk_handle_t free_list;
+    /// Number of chunks in the free list.
+    size_t chunks_free;
+    /// Highest number of chunks taken from the free list at the same time.
+    size_t chunks_used_max;
+    /// Number of failed allocations.
+    uint32_t alloc_failures;
 
 #if MCU_ENABLE_FREERTOS
     /// Semaphore used to synchronize allocations and deallocations.
     SemaphoreHandle_t x_semaphore;
 #endif
+#if MEM_POOL_USE_CORE_CACHE
+    /// Caches for single chunks per core.
+    mem_pool_core_cache_t core_cache[portNUM_PROCESSORS];
+#endif
 };
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Prototypes
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+/**
+ * @brief Puts a chunk at the head of the free list of the pool. Semaphore must be taken.
+ * 
+ * @param pool          Handle for the pool.
+ * @param chunk         Chunk that is put into the free list.
+ */
+static void _push_free_chunk(mem_pool_handle_t pool, mem_pool_chunk_handle_t chunk);
+/**
+ * @brief Takes a number of chunks from the free list and chains them. Semaphore must be taken and enough chunks must be free.
+ * 
+ * @param pool          Handle for the pool.
+ * @param last_chunk    Chunk the taken chunks are appended to or NULL if a new chain is created.
+ * @param num           Number of chunks to take.
+ * @return              First chunk that was taken.
+ */
+static mem_pool_chunk_handle_t _take_chunks(mem_pool_handle_t pool, mem_pool_chunk_handle_t last_chunk, size_t num);
+/**
+ * @brief Returns the number of chunks needed for the given size.
+ * 
+ * @param pool          Handle for the pool.
+ * @param size          Size in bytes.
+ * @return              Number of chunks.
+ */
+static size_t _get_chunk_count(mem_pool_handle_t pool, size_t size);
+
+#if MODULE_ENABLE_CRC
+/**
+ * @brief Segment callback that feeds a segment into crc32_update.
+ * 
+ * @param ctx           Pointer to the crc32_t structure.
+ * @param data          Pointer to the data of the segment.
+ * @param len           Number of bytes in the segment.
+ */
+static void _crc32_update_segment(void* ctx, const uint8_t* data, size_t len);
+#endif
+
+#if MEM_POOL_USE_CORE_CACHE
+/**
+ * @brief Takes a chunk from the cache of the current core.
+ * 
+ * @param pool          Handle for the pool.
+ * @return              Chunk from the cache or NULL if the cache was empty.
+ */
+static mem_pool_chunk_handle_t _core_cache_pop(mem_pool_handle_t pool);
+/**
+ * @brief Puts a single chunk into the cache of the current core.
+ * 
+ * @param pool          Handle for the pool.
+ * @param chunk         Chunk to put into the cache.
+ * @return              true if the chunk was cached, false if the cache is full.
+ */
+static bool _core_cache_push(mem_pool_handle_t pool, mem_pool_chunk_handle_t chunk);
+/**
+ * @brief Fills half of the cache of the current core with chunks from the free list. Semaphore must be taken.
+ * 
+ * @param pool          Handle for the pool.
+ */
+static void _core_cache_refill(mem_pool_handle_t pool);
+/**
+ * @brief Moves all chunks of all core caches back into the free list. Semaphore must be taken.
+ * 
+ * @param pool          Handle for the pool.
+ */
+static void _core_cache_drain(mem_pool_handle_t pool);
+#endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Internal variables
@@ -82,7 +179,17 @@ FUNCTION_RETURN mem_pool_init(mem_pool_handle_t* pool, size_t num, size_t chunk_
                     p->chunks[i].pool = p;
                     ptr += chunk_size;
                 }
-                *pool = p;
+                // Build the free list backwards, so the chunks are handed out in ascending order.
+                for(size_t i = num; i > 0; i--)
+                {
+                    _push_free_chunk(p, &p->chunks[i - 1]);
+                }
+#if MEM_POOL_USE_CORE_CACHE
+                for(size_t i = 0; i < portNUM_PROCESSORS; i++)
+                {
+                    spinlock_initialize(&p->core_cache[i].lock);
+                }
+#endif
                 
 #if MCU_ENABLE_FREERTOS
                 // Create a semaphore so mem_pool is task save!
@@ -90,17 +197,19 @@ FUNCTION_RETURN mem_pool_init(mem_pool_handle_t* pool, size_t num, size_t chunk_
                 if(p->x_semaphore)
                 {
                     // Ready to use!
+                    *pool = p;
                     return FUNCTION_RETURN_OK;
                 }
                 // Failed with the semaphore, free the chunks
                 mcu_heap_free(p->chunks);
 #else
                 // Ready to use!
+                *pool = p;
                 return FUNCTION_RETURN_OK;
 #endif
             }
             // Failed with the chunks, free the pool
-            mcu_heap_free(pool);
+            mcu_heap_free(p);
         }
         // Failed with pool or chunks, free the buffer
         mcu_heap_free(buffer);
@@ -120,6 +229,10 @@ FUNCTION_RETURN mem_pool_free(mem_pool_handle_t pool, bool force)
 #endif
     if(force == false)
     {
+#if MEM_POOL_USE_CORE_CACHE
+        // Cached chunks are free, so put them back before locking.
+        _core_cache_drain(pool);
+#endif
         size_t num_used = 0;
         for(size_t i = 0; i < pool->chunks_num; i++)
         {
@@ -128,6 +241,7 @@ FUNCTION_RETURN mem_pool_free(mem_pool_handle_t pool, bool force)
                 case MEM_POOL_FREE:
                     // This chunk is not in use, lock it!
                     pool->chunks[i].usage = MEM_POOL_LOCKED;
+                    pool->chunks[i].next = NULL;
                     break;
                 case MEM_POOL_USED:
                     // Woops, we cannot free the pool! There are chunks in use!
@@ -138,9 +252,15 @@ FUNCTION_RETURN mem_pool_free(mem_pool_handle_t pool, bool force)
                     break;
             }
         }
+        // Locked chunks must not be handed out anymore.
+        pool->free_list = NULL;
+        pool->chunks_free = 0;
 
         if(num_used > 0)
         {
+#if MCU_ENABLE_FREERTOS
+            xSemaphoreGive(pool->x_semaphore);
+#endif
             // As said above: Woops
             return FUNCTION_RETURN_NOT_READY;
         }
@@ -168,21 +288,36 @@ FUNCTION_RETURN mem_pool_alloc_chunk(mem_pool_handle_t pool, mem_pool_chunk_hand
     DBG_ASSERT(pool != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid pool\n");
     DBG_ASSERT(size > 0, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid size\n");
 
+    size_t num = _get_chunk_count(pool, size);
+
+#if MEM_POOL_USE_CORE_CACHE
+    if(num == 1)
+    {
+        // Single chunks are taken from the cache of this core without touching the semaphore.
+        *chunk = _core_cache_pop(pool);
+        if(*chunk)
+        {
+            return FUNCTION_RETURN_OK;
+        }
+    }
+#endif
+
 #if MCU_ENABLE_FREERTOS
 	if(!xSemaphoreTake(pool->x_semaphore, portMAX_DELAY)) // Semaphore is blocked too long...
 		return FUNCTION_RETURN_NOT_READY;
 #endif
 
-    size_t buffersize_collected = 0;
-    // Loop all chunks or until enough buffersize was collected from the chunks
-    for(size_t i = 0; i < pool->chunks_num && buffersize_collected < size; i++)
+#if MEM_POOL_USE_CORE_CACHE
+    if(pool->chunks_free < num)
     {
-        if(pool->chunks[i].usage == MEM_POOL_FREE)
-            buffersize_collected += pool->chunk_size;
+        // Chunks might be parked in the core caches
+        _core_cache_drain(pool);
     }
+#endif
 
-    if(buffersize_collected < size)
+    if(pool->chunks_free < num)
     {
+        pool->alloc_failures++;
 #if MCU_ENABLE_FREERTOS
 	    xSemaphoreGive(pool->x_semaphore);
 #endif
@@ -190,38 +325,15 @@ FUNCTION_RETURN mem_pool_alloc_chunk(mem_pool_handle_t pool, mem_pool_chunk_hand
         return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
     }
 
-    buffersize_collected = 0;
-    mem_pool_chunk_handle_t chunk_current = NULL;
-    // Loop all chunks or until enough buffersize was collected from the chunks
-    for(size_t i = 0; i < pool->chunks_num && buffersize_collected < size; i++)
+    *chunk = _take_chunks(pool, NULL, num);
+
+#if MEM_POOL_USE_CORE_CACHE
+    if(num == 1)
     {
-        if(pool->chunks[i].usage == MEM_POOL_FREE)
-        {
-            // Set chunk to used and clear the chunk from previous stuff
-            pool->chunks[i].usage = MEM_POOL_USED;
-            pool->chunks[i].next = NULL;
-            pool->chunks[i].used_size = 0;
-            // Increment collected buffersize
-            buffersize_collected += pool->chunk_size;
-
-            // No chunk allocated yet
-            if(*chunk == NULL)
-            {
-                // Set chunk i as first chunk.
-                *chunk = &pool->chunks[i];
-                chunk_current = *chunk;
-                chunk_current->previous = NULL;
-            }
-            else if(chunk_current)
-            {
-                // A previous chunk was set -> Set chunk i as the next chunk after previous known chunk.
-                chunk_current->next = &pool->chunks[i];
-                pool->chunks[i].previous = chunk_current;
-                // Set this chunk as the previous known chunk for next iteration
-                chunk_current = chunk_current->next;
-            }
-        }
+        // Cache missed -> Fill it, so the next allocations on this core are fast.
+        _core_cache_refill(pool);
     }
+#endif
 
 #if MCU_ENABLE_FREERTOS
     xSemaphoreGive(pool->x_semaphore);
@@ -241,46 +353,46 @@ FUNCTION_RETURN mem_pool_realloc_chunk(mem_pool_chunk_handle_t chunk, size_t siz
 		return FUNCTION_RETURN_NOT_READY;
 #endif
 
-    size_t total_size = mem_pool_get_chunk_total_size(chunk);
+    size_t num_current = 0;
+    mem_pool_chunk_t* last_chunk = chunk;
+    // Skip to last chunk and count the chunks on the way
+    while(last_chunk->next)
+    {
+        num_current++;
+        last_chunk = last_chunk->next;
+    }
+    num_current++;
+
+    size_t num_needed = _get_chunk_count(pool, size);
     
-    if(total_size > size)
+    if(num_current > num_needed)
     {
         // We can free chunks
-        size_t size_not_needed = total_size - size;
-
-        mem_pool_chunk_t* last_chunk = chunk;
-        // Skip to last chunk
-        while(last_chunk->next)
+        while(num_current > num_needed)
         {
-            last_chunk = last_chunk->next;
-        }
-
-        while(size_not_needed >= pool->chunk_size)
-        {
-            size_not_needed -= pool->chunk_size;
+            num_current--;
             mem_pool_chunk_t* chunk = last_chunk->previous;
             chunk->next = NULL;
-            last_chunk->previous = NULL;
-            last_chunk->usage = MEM_POOL_FREE;
-            last_chunk->used_size = 0;
-
+            _push_free_chunk(pool, last_chunk);
             last_chunk = chunk;
         }        
     }
-    else if(total_size < size)
+    else if(num_current < num_needed)
     {
         // We need to allocate more chunks! Check fist how much is available
-        size_t size_needed = size - total_size;
-        size_t buffersize_collected = 0;
-        // Loop all chunks or until enough buffersize was collected from the chunks
-        for(size_t i = 0; i < pool->chunks_num && buffersize_collected < size_needed; i++)
+        size_t num_missing = num_needed - num_current;
+
+#if MEM_POOL_USE_CORE_CACHE
+        if(pool->chunks_free < num_missing)
         {
-            if(pool->chunks[i].usage == MEM_POOL_FREE)
-                buffersize_collected += pool->chunk_size;
+            // Chunks might be parked in the core caches
+            _core_cache_drain(pool);
         }
+#endif
 
-        if(buffersize_collected < size_needed)
+        if(pool->chunks_free < num_missing)
         {
+            pool->alloc_failures++;
 #if MCU_ENABLE_FREERTOS
             xSemaphoreGive(pool->x_semaphore);
 #endif  
@@ -288,31 +400,7 @@ FUNCTION_RETURN mem_pool_realloc_chunk(mem_pool_chunk_handle_t chunk, size_t siz
             return FUNCTION_RETURN_INSUFFICIENT_MEMORY;
         }
 
-        mem_pool_chunk_t* last_chunk = chunk;
-        // Skip to last chunk
-        while(last_chunk->next)
-        {
-            last_chunk = last_chunk->next;
-        }
-
-        buffersize_collected = 0;
-        // Loop all chunks or until enough buffersize was collected from the chunks
-        for(size_t i = 0; i < pool->chunks_num && buffersize_collected < size_needed; i++)
-        {
-            if(pool->chunks[i].usage == MEM_POOL_FREE)
-            {
-                // Set chunk to used and clear the chunk from previous stuff
-                pool->chunks[i].usage = MEM_POOL_USED;
-                pool->chunks[i].next = NULL;
-                pool->chunks[i].used_size = 0;
-                // Increment collected buffersize
-                buffersize_collected += pool->chunk_size;
-
-                last_chunk->next = &pool->chunks[i];
-                pool->chunks[i].previous = last_chunk;
-                last_chunk = &pool->chunks[i];
-            }
-        }
+        _take_chunks(pool, last_chunk, num_missing);
     }
 
 #if MCU_ENABLE_FREERTOS
@@ -327,6 +415,18 @@ FUNCTION_RETURN mem_pool_free_chunk(mem_pool_chunk_handle_t chunk)
     DBG_ASSERT(chunk != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid chunk\n");
     mem_pool_handle_t pool = chunk->pool;
 
+#if MEM_POOL_USE_CORE_CACHE
+    if(chunk->next == NULL && chunk->previous == NULL)
+    {
+        chunk->usage = MEM_POOL_FREE;
+        chunk->used_size = 0;
+        if(_core_cache_push(pool, chunk))
+        {
+            return FUNCTION_RETURN_OK;
+        }
+    }
+#endif
+
 #if MCU_ENABLE_FREERTOS
 	if(!xSemaphoreTake(pool->x_semaphore, portMAX_DELAY)) // Semaphore is blocked too long...
 		return FUNCTION_RETURN_NOT_READY;
@@ -338,9 +438,7 @@ FUNCTION_RETURN mem_pool_free_chunk(mem_pool_chunk_handle_t chunk)
         last_chunk = chunk->next;
 
         chunk->previous = NULL;
-        chunk->next = NULL;
-        chunk->usage = MEM_POOL_FREE;
-        chunk->used_size = 0;
+        _push_free_chunk(pool, chunk);
 
         chunk = last_chunk;
 
@@ -493,38 +591,179 @@ size_t mem_pool_read_chunk(mem_pool_chunk_handle_t chunk, size_t chunk_offset, v
 {
     DBG_ASSERT(chunk != NULL, NO_ACTION, 0, "Invalid chunk\n");
 
-    size_t chunk_size = chunk->pool->chunk_size;
     size_t read = 0;
-    size_t offset = 0;
-    
-    while(chunk && size > 0)
+    mem_pool_view_t view;
+    mem_pool_segment_t segment;
+
+    mem_pool_view_init(&view, chunk, chunk_offset, size);
+    while(mem_pool_view_next(&view, &segment))
     {
-        if(chunk_offset >= chunk_size)
+        memcpy((uint8_t*)data + read, segment.ptr, segment.len);
+        read += segment.len;
+    }
+
+    return read;
+}
+
+FUNCTION_RETURN mem_pool_view_init(mem_pool_view_t* view, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size)
+{
+    DBG_ASSERT(view != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid view\n");
+    view->chunk = NULL;
+    view->offset = 0;
+    view->remaining = 0;
+    DBG_ASSERT(chunk != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid chunk\n");
+
+    size_t chunk_size = chunk->pool->chunk_size;
+
+    // Skip the chunks before the offset
+    while(chunk && chunk_offset >= chunk_size)
+    {
+        chunk_offset -= chunk_size;
+        chunk = chunk->next;
+    }
+
+    view->chunk = chunk;
+    view->offset = chunk_offset;
+    view->remaining = size;
+
+    return FUNCTION_RETURN_OK;
+}
+
+bool mem_pool_view_next(mem_pool_view_t* view, mem_pool_segment_t* segment)
+{
+    if(view == NULL || segment == NULL || view->chunk == NULL || view->remaining == 0)
+        return false;
+
+    size_t len = view->chunk->pool->chunk_size - view->offset;
+    if(len > view->remaining)
+    {
+        len = view->remaining;
+    }
+
+    segment->ptr = (uint8_t*)view->chunk->buffer + view->offset;
+    segment->len = len;
+
+    view->remaining -= len;
+    view->offset = 0;
+    view->chunk = view->chunk->next;
+
+    return true;
+}
+
+size_t mem_pool_view_get_segments(mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size, mem_pool_segment_t* segments, size_t num)
+{
+    DBG_ASSERT(segments != NULL, NO_ACTION, 0, "Invalid segments\n");
+
+    size_t count = 0;
+    mem_pool_view_t view;
+
+    if(mem_pool_view_init(&view, chunk, chunk_offset, size) != FUNCTION_RETURN_OK)
+        return 0;
+
+    while(count < num && mem_pool_view_next(&view, &segments[count]))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+size_t mem_pool_view_foreach(mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size, mem_pool_segment_cb_t f, void* ctx)
+{
+    DBG_ASSERT(f != NULL, NO_ACTION, 0, "Invalid callback\n");
+
+    size_t processed = 0;
+    mem_pool_view_t view;
+    mem_pool_segment_t segment;
+
+    if(mem_pool_view_init(&view, chunk, chunk_offset, size) != FUNCTION_RETURN_OK)
+        return 0;
+
+    while(mem_pool_view_next(&view, &segment))
+    {
+        f(ctx, segment.ptr, segment.len);
+        processed += segment.len;
+    }
+
+    return processed;
+}
+
+size_t mem_pool_put_chunk(comm_t* comm, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size)
+{
+    DBG_ASSERT(comm != NULL, NO_ACTION, 0, "Invalid comm\n");
+
+    size_t written = 0;
+    mem_pool_view_t view;
+    mem_pool_segment_t segment;
+
+    if(mem_pool_view_init(&view, chunk, chunk_offset, size) != FUNCTION_RETURN_OK)
+        return 0;
+
+    while(mem_pool_view_next(&view, &segment))
+    {
+        // comm_put is limited to 16-Bit lengths
+        while(segment.len > 0)
         {
-            // Skip this chunk completely
-            chunk_offset -= chunk_size;
+            uint16_t len = segment.len > 0xFFFF ? 0xFFFF : (uint16_t)segment.len;
+            comm_put(comm, segment.ptr, len);
+            segment.ptr += len;
+            segment.len -= len;
+            written += len;
         }
-        else
-        {
-            offset = chunk_offset;
-            chunk_offset = 0;
+    }
 
-            // Well, start in this chunk
-            while(size > 0 && offset < chunk_size)
-            {                
-                // Fill remaining
-                *(uint8_t*)data = ((uint8_t*)chunk->buffer)[offset];
-                offset++;
-                data++;
-                read++;
-                size--;
-            }
-        }
+    return written;
+}
 
-        chunk = chunk->next;
+#if MODULE_ENABLE_CRC
+size_t mem_pool_crc32_update(crc32_t* crc, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size)
+{
+    DBG_ASSERT(crc != NULL, NO_ACTION, 0, "Invalid crc\n");
+
+    return mem_pool_view_foreach(chunk, chunk_offset, size, _crc32_update_segment, crc);
+}
+#endif
+
+#if MCU_PERIPHERY_DEVICE_COUNT_SPI > 0
+FUNCTION_RETURN mem_pool_spi_transaction_add(mcu_spi_t h, MCU_SPI_TRANS_FLAGS_T flags, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size)
+{
+    DBG_ASSERT(h != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid spi\n");
+
+    FUNCTION_RETURN ret;
+    mem_pool_view_t view;
+    mem_pool_segment_t segment;
+
+    ret = mem_pool_view_init(&view, chunk, chunk_offset, size);
+    
+    while(ret == FUNCTION_RETURN_OK && mem_pool_view_next(&view, &segment))
+    {
+        ret = mcu_spi_transaction_add_(h, .flags = flags, .w_buf = segment.ptr, .w_buf_length = segment.len);
     }
 
-    return read;
+    return ret;
+}
+#endif
+
+FUNCTION_RETURN mem_pool_get_stats(mem_pool_handle_t pool, mem_pool_stats_t* stats)
+{
+    DBG_ASSERT(pool != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid pool\n");
+    DBG_ASSERT(stats != NULL, NO_ACTION, FUNCTION_RETURN_PARAM_ERROR, "Invalid stats\n");
+
+#if MCU_ENABLE_FREERTOS
+	if(!xSemaphoreTake(pool->x_semaphore, portMAX_DELAY)) // Semaphore is blocked too long...
+		return FUNCTION_RETURN_NOT_READY;
+#endif
+
+    stats->chunks_num = pool->chunks_num;
+    stats->chunks_free = pool->chunks_free;
+    stats->chunks_used_max = pool->chunks_used_max;
+    stats->alloc_failures = pool->alloc_failures;
+
+#if MCU_ENABLE_FREERTOS
+    xSemaphoreGive(pool->x_semaphore);
+#endif
+
+    return FUNCTION_RETURN_OK;
 }
 
 void mem_pool_print_usage(comm_t* comm, mem_pool_handle_t pool)
@@ -536,6 +775,7 @@ void mem_pool_print_usage(comm_t* comm, mem_pool_handle_t pool)
     {
         comm_printf(comm, "Number of chunks: %d\n", pool->chunks_num);
         comm_printf(comm, "Size of chunks: %d\n", pool->chunk_size);
+        comm_printf(comm, "Free chunks: %d (max used %d, failed allocations %u)\n", pool->chunks_free, pool->chunks_used_max, pool->alloc_failures);
         // size_t count = 0;
         // while(chunk)
         for(size_t i = 0; i < pool->chunks_num; i++)
@@ -556,4 +796,140 @@ void mem_pool_print_usage(comm_t* comm, mem_pool_handle_t pool)
 // Internal Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
+static void _push_free_chunk(mem_pool_handle_t pool, mem_pool_chunk_handle_t chunk)
+{
+    chunk->usage = MEM_POOL_FREE;
+    chunk->used_size = 0;
+    chunk->previous = NULL;
+    chunk->next = pool->free_list;
+    pool->free_list = chunk;
+    pool->chunks_free++;
+}
+
+static mem_pool_chunk_handle_t _take_chunks(mem_pool_handle_t pool, mem_pool_chunk_handle_t last_chunk, size_t num)
+{
+    mem_pool_chunk_handle_t first_chunk = NULL;
+
+    for(size_t i = 0; i < num; i++)
+    {
+        // Pop the head of the free list
+        mem_pool_chunk_handle_t c = pool->free_list;
+        pool->free_list = c->next;
+        pool->chunks_free--;
+
+        // Set chunk to used and clear the chunk from previous stuff
+        c->usage = MEM_POOL_USED;
+        c->next = NULL;
+        c->used_size = 0;
+        c->previous = last_chunk;
+        if(last_chunk)
+        {
+            last_chunk->next = c;
+        }
+        if(first_chunk == NULL)
+        {
+            first_chunk = c;
+        }
+        last_chunk = c;
+    }
+
+    size_t used = pool->chunks_num - pool->chunks_free;
+    if(used > pool->chunks_used_max)
+    {
+        pool->chunks_used_max = used;
+    }
+
+    return first_chunk;
+}
+
+static size_t _get_chunk_count(mem_pool_handle_t pool, size_t size)
+{
+    return (size + pool->chunk_size - 1) / pool->chunk_size;
+}
+
+#if MODULE_ENABLE_CRC
+static void _crc32_update_segment(void* ctx, const uint8_t* data, size_t len)
+{
+    crc32_update((crc32_t*)ctx, data, len);
+}
+#endif
+
+#if MEM_POOL_USE_CORE_CACHE
+
+static mem_pool_chunk_handle_t _core_cache_pop(mem_pool_handle_t pool)
+{
+    mem_pool_chunk_handle_t c = NULL;
+    // If the task is moved to the other core after reading the id, the other cache is used. This is still safe because of the lock.
+    mem_pool_core_cache_t* cache = &pool->core_cache[xPortGetCoreID()];
+
+    taskENTER_CRITICAL(&cache->lock);
+    if(cache->num > 0)
+    {
+        cache->num--;
+        c = cache->chunks[cache->num];
+        c->usage = MEM_POOL_USED;
+    }
+    taskEXIT_CRITICAL(&cache->lock);
+
+    return c;
+}
+
+static bool _core_cache_push(mem_pool_handle_t pool, mem_pool_chunk_handle_t chunk)
+{
+    bool cached = false;
+    mem_pool_core_cache_t* cache = &pool->core_cache[xPortGetCoreID()];
+
+    taskENTER_CRITICAL(&cache->lock);
+    if(cache->num < MEM_POOL_CORE_CACHE_SIZE)
+    {
+        cache->chunks[cache->num] = chunk;
+        cache->num++;
+        cached = true;
+    }
+    taskEXIT_CRITICAL(&cache->lock);
+
+    return cached;
+}
+
+static void _core_cache_refill(mem_pool_handle_t pool)
+{
+    mem_pool_core_cache_t* cache = &pool->core_cache[xPortGetCoreID()];
+
+    taskENTER_CRITICAL(&cache->lock);
+    while(cache->num < (MEM_POOL_CORE_CACHE_SIZE + 1) / 2 && pool->free_list)
+    {
+        mem_pool_chunk_handle_t c = pool->free_list;
+        pool->free_list = c->next;
+        pool->chunks_free--;
+        c->next = NULL;
+        cache->chunks[cache->num] = c;
+        cache->num++;
+    }
+    taskEXIT_CRITICAL(&cache->lock);
+
+    size_t used = pool->chunks_num - pool->chunks_free;
+    if(used > pool->chunks_used_max)
+    {
+        pool->chunks_used_max = used;
+    }
+}
+
+static void _core_cache_drain(mem_pool_handle_t pool)
+{
+    for(size_t i = 0; i < portNUM_PROCESSORS; i++)
+    {
+        mem_pool_core_cache_t* cache = &pool->core_cache[i];
+
+        taskENTER_CRITICAL(&cache->lock);
+        while(cache->num > 0)
+        {
+            cache->num--;
+            _push_free_chunk(pool, cache->chunks[cache->num]);
+        }
+        taskEXIT_CRITICAL(&cache->lock);
+    }
+}
+
+#endif // MEM_POOL_USE_CORE_CACHE
+
 #endif // MODULE_ENABLE_UTIL_MEM_POOL
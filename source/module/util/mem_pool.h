@@ -7,6 +7,12 @@
  *              The advantage using the memory pool is to reduce the fragmentation of the heap by directly allocating a bigger pool and then using these buffers without allocating/deallocating them all the time.
  *              The handling is a bit more complex, because when reading data from the chunks of the pool you have to consider that you may not have everything in a single buffer, but it can be splitted on multiple chunks.
  *			
+ *  @version	1.02 (18.10.2026)
+ *  	- Added views to access the data of a chunk chain as segments without copying it.
+ *  @version	1.01 (18.10.2026)
+ *  	- Free chunks are kept in an intrusive free list, so allocation no longer scans the whole pool.
+ *  	- Added optional per-core chunk caches (MEM_POOL_CORE_CACHE_SIZE).
+ *  	- Added mem_pool_get_stats with high-water mark and allocation failures.
  *  @version	1.00 (10.05.2022)
  *  	- Intial release
  *
@@ -20,6 +26,20 @@
 #include "module_public.h"
 #if MODULE_ENABLE_UTIL_MEM_POOL
 #include "module/enum/function_return.h"
+#if MODULE_ENABLE_CRC
+#include "module/crc/crc32.h"
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+// Configuration
+//-----------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef MEM_POOL_CORE_CACHE_SIZE
+/// Number of single chunks that each core can keep in a local cache. Only used on multi-core FreeRTOS targets.
+/// Allocations and frees of a single chunk are served from this cache without taking the pool semaphore.
+/// Set to 0 to disable the cache.
+#define MEM_POOL_CORE_CACHE_SIZE        0
+#endif
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // Enumeration
@@ -65,6 +85,48 @@ struct mem_pool_chunk_s
     mem_pool_chunk_handle_t previous;
 };
 
+/// Contiguous part of the data inside a chunk chain. Is returned by the view functions to access the data without copying it.
+typedef struct mem_pool_segment_s
+{
+    /// Pointer to the first byte of the segment inside the buffer of a chunk.
+    uint8_t* ptr;
+    /// Number of bytes in the segment.
+    size_t len;
+}mem_pool_segment_t;
+
+/// Iterator over a range of a chunk chain. Is initialized with mem_pool_view_init and yields segments with mem_pool_view_next.
+typedef struct mem_pool_view_s
+{
+    /// Chunk the next segment starts in. Is NULL when the end of the chain is reached.
+    mem_pool_chunk_handle_t chunk;
+    /// Offset inside the buffer of `chunk` where the next segment starts.
+    size_t offset;
+    /// Number of bytes left in the range.
+    size_t remaining;
+}mem_pool_view_t;
+
+/**
+ * @brief Callback that is called by mem_pool_view_foreach for each segment.
+ * 
+ * @param ctx           Context pointer that was passed to mem_pool_view_foreach.
+ * @param data          Pointer to the data of the segment.
+ * @param len           Number of bytes in the segment.
+ */
+typedef void (*mem_pool_segment_cb_t)(void* ctx, const uint8_t* data, size_t len);
+
+/// Statistics of a memory pool, see mem_pool_get_stats.
+typedef struct mem_pool_stats_s
+{
+    /// Number of chunks in the pool.
+    size_t chunks_num;
+    /// Number of chunks that are currently in the free list of the pool.
+    size_t chunks_free;
+    /// Highest number of chunks that were taken from the free list at the same time. Chunks held in a core cache count as taken.
+    size_t chunks_used_max;
+    /// Number of allocations or re-allocations that failed because there were not enough free chunks.
+    uint32_t alloc_failures;
+}mem_pool_stats_t;
+
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 // External Functions
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -177,6 +239,96 @@ size_t mem_pool_write_chunk(mem_pool_chunk_handle_t chunk, size_t chunk_offset,
  * @return size_t       Number of bytes that were read from the chunk.
  */
 size_t mem_pool_read_chunk(mem_pool_chunk_handle_t chunk, size_t chunk_offset, void* data, size_t size);
+/**
+ * @brief Initializes a view on a range of the data inside a chunk chain.
+ * The range is cut at the end of the last chunk, like in mem_pool_read_chunk.
+ * The view is only valid as long as the chunk is not re-allocated or freed.
+ * 
+ * @param view          Pointer to the view that is initialized.
+ * @param chunk         Handle for the chunk that was allocated by mem_pool_alloc_chunk.
+ * @param chunk_offset  Offset inside the chunk as to where the range starts.
+ * @param size          Number of bytes in the range.
+ * @retval FUNCTION_RETURN_OK           The view was initialized.
+ * @retval FUNCTION_RETURN_PARAM_ERROR  Invalid parameters
+ */
+FUNCTION_RETURN mem_pool_view_init(mem_pool_view_t* view, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size);
+/**
+ * @brief Returns the next contiguous segment of the view.
+ * 
+ * @param view          Pointer to the view initialized with mem_pool_view_init.
+ * @param segment       Pointer to the segment that is set to the next part of the data.
+ * @return              true if a segment was written, false if the end of the range is reached.
+ */
+bool mem_pool_view_next(mem_pool_view_t* view, mem_pool_segment_t* segment);
+/**
+ * @brief Fills an array with the segments of a range inside the chunk chain. Can be used like an iovec.
+ * 
+ * @param chunk         Handle for the chunk that was allocated by mem_pool_alloc_chunk.
+ * @param chunk_offset  Offset inside the chunk as to where the range starts.
+ * @param size          Number of bytes in the range.
+ * @param segments      Array that is filled with the segments.
+ * @param num           Number of elements in segments.
+ * @return size_t       Number of segments written into the array. If the range needs more segments than num, only the first num segments are written.
+ */
+size_t mem_pool_view_get_segments(mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size, mem_pool_segment_t* segments, size_t num);
+/**
+ * @brief Calls the callback for each segment of a range inside the chunk chain.
+ * 
+ * @param chunk         Handle for the chunk that was allocated by mem_pool_alloc_chunk.
+ * @param chunk_offset  Offset inside the chunk as to where the range starts.
+ * @param size          Number of bytes in the range.
+ * @param f             Callback that is called for each segment.
+ * @param ctx           Context pointer that is passed to the callback.
+ * @return size_t       Number of bytes that were passed to the callback.
+ */
+size_t mem_pool_view_foreach(mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size, mem_pool_segment_cb_t f, void* ctx);
+/**
+ * @brief Writes a range of the chunk chain on a comm interface without copying it into a contiguous buffer first.
+ * 
+ * @param comm          Pointer of the comm interface to write on.
+ * @param chunk         Handle for the chunk that was allocated by mem_pool_alloc_chunk.
+ * @param chunk_offset  Offset inside the chunk as to where the range starts.
+ * @param size          Number of bytes to write.
+ * @return size_t       Number of bytes that were written.
+ */
+size_t mem_pool_put_chunk(comm_t* comm, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size);
+#if MODULE_ENABLE_CRC
+/**
+ * @brief Updates a CRC32 calculation with a range of the chunk chain. crc32_start must be called before and crc32_finish afterwards.
+ * 
+ * @param crc           Pointer to the crc32_t structure that is updated.
+ * @param chunk         Handle for the chunk that was allocated by mem_pool_alloc_chunk.
+ * @param chunk_offset  Offset inside the chunk as to where the range starts.
+ * @param size          Number of bytes to process.
+ * @return size_t       Number of bytes that were processed.
+ */
+size_t mem_pool_crc32_update(crc32_t* crc, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size);
+#endif
+#if MCU_PERIPHERY_DEVICE_COUNT_SPI > 0
+/**
+ * @brief Adds one SPI write transaction per segment of a range inside the chunk chain. 
+ * Must be called between mcu_spi_transaction_start and mcu_spi_transaction_end.
+ * 
+ * @param h             SPI handler, that was created with mcu_spi_init.
+ * @param flags         Flags that are set for each transaction, for example to select the bus width.
+ * @param chunk         Handle for the chunk that was allocated by mem_pool_alloc_chunk.
+ * @param chunk_offset  Offset inside the chunk as to where the range starts.
+ * @param size          Number of bytes to send.
+ * @retval FUNCTION_RETURN_OK           All transactions were added.
+ * @retval FUNCTION_RETURN_PARAM_ERROR  Invalid parameters
+ * @return              Other values are returned from mcu_spi_transaction_add.
+ */
+FUNCTION_RETURN mem_pool_spi_transaction_add(mcu_spi_t h, MCU_SPI_TRANS_FLAGS_T flags, mem_pool_chunk_handle_t chunk, size_t chunk_offset, size_t size);
+#endif
+/**
+ * @brief Reads the statistics of the memory pool.
+ * 
+ * @param pool          Handle for the pool.
+ * @param stats         Pointer to the structure the statistics are written into.
+ * @retval FUNCTION_RETURN_OK           Statistics were written into stats.
+ * @retval FUNCTION_RETURN_PARAM_ERROR  Invalid parameters
+ */
+FUNCTION_RETURN mem_pool_get_stats(mem_pool_handle_t pool, mem_pool_stats_t* stats);
 /**
  * @brief Diagnostic function to print the usage of the memory pool on a comm interface.
  * 
@@ -55,6 +55,9 @@
 /// Enables the convert module. Is necessary for multiple other modules.
 #define MODULE_ENABLE_CONVERT_BCD                       CONFIG_MODULE_ENABLE_CONVERT_BCD
 
+/// Enables the convert module for float and double strings. Is necessary for %f, %F and %e in printf.
+#define MODULE_ENABLE_CONVERT_DTOA						CONFIG_MODULE_ENABLE_CONVERT_DTOA
+
 /// Enables the convert module. Is necessary for multiple other modules.
 #define MODULE_ENABLE_CONVERT_MATH						CONFIG_MODULE_ENABLE_CONVERT_MATH
 
@@ -85,9 +88,15 @@
 /// Enables the fifo module. This is also needed in mcu like uart or can.
 #define MODULE_ENABLE_FIFO								CONFIG_MODULE_ENABLE_FIFO
 
+/// Enables filter modules like moving averaging.
+#define MODULE_ENABLE_FILTER							CONFIG_MODULE_ENABLE_FILTER
+
 /// Enables the flash info module
 #define MODULE_ENABLE_FLASH_INFO						CONFIG_MODULE_ENABLE_FLASH_INFO
 
+/// Enables the flash integrity module
+#define MODULE_ENABLE_FLASH_INTEGRITY					CONFIG_MODULE_ENABLE_FLASH_INTEGRITY
+
 /// Enables gui module to enable the api for showing buttons, etc. on screens via EVE, FT810, etc.
 /// When enabled, you need to have a gui_config.h in your config directory. A template can be found in the template directory.
 #define MODULE_ENABLE_GUI								CONFIG_MODULE_ENABLE_GUI
@@ -183,6 +192,12 @@
 #define CONSOLE_MAX_ARGUMENTS						CONFIG_CONSOLE_MAX_ARGUMENTS
 /// Enables checking of crc for the console, the last 4 bytes are seen as a 4-character hex string containing the crc.
 #define CONSOLE_ENABLE_CRC							CONFIG_CONSOLE_ENABLE_CRC
+/// Maximum number of batch commands a host sends without waiting for their responses.
+#define CONSOLE_BATCH_WINDOW						CONFIG_CONSOLE_BATCH_WINDOW
+/// Maximum number of lines a console executes before it lets other tasks run.
+#define CONSOLE_MAX_LINES_PER_CALL				CONFIG_CONSOLE_MAX_LINES_PER_CALL
+/// Size of the arena in bytes that each console uses for dynamic responses.
+#define CONSOLE_RESPONSE_ARENA_SIZE				CONFIG_CONSOLE_RESPONSE_ARENA_SIZE
 #endif
 
 #if MODULE_ENABLE_DEBUG_CONSOLE
@@ -218,12 +233,22 @@
 #define DISPLAY_SLD_BOUNCE_BUFFER_PERCENTAGE            CONFIG_DISPLAY_SLD_BOUNCE_BUFFER_PERCENTAGE
 #endif
 
+#if MODULE_ENABLE_CONVERT_BASE64
+//------------------------------------
+// convert/base64
+//------------------------------------
+/// If true, the streaming encoder uses a 8 KiB table to encode 12 bit into two characters per lookup.
+/// If false, a 64 byte table is used with one lookup per character.
+#define BASE64_USE_LARGE_TABLE					    CONFIG_BASE64_USE_LARGE_TABLE
+#endif
 #if MODULE_ENABLE_CONVERT_MATH
 //------------------------------------
 // convert/math
 //------------------------------------
 /// Set to true if 64-Bit operations are needed, otherwise set to false to deactivate the functions.
 #define MATH_ENABLE_64BIT_OPERATIONS			    CONFIG_MATH_ENABLE_64BIT_OPERATIONS
+/// Set to true to use the esp-dsp component for the float dot product and scale, which uses the SIMD instructions of the ESP32-S3.
+#define MATH_USE_ESP_DSP							CONFIG_MATH_USE_ESP_DSP
 #endif
 #if MODULE_ENABLE_CONVERT_STRING
 //------------------------------------
@@ -237,6 +262,8 @@
 ///     true: string_printf function can be used.
 ///     false: string_printf function cannot be used.
 #define STRING_BUILD_PRINTF                         CONFIG_STRING_BUILD_PRINTF
+/// Set to true to use SSE2 or NEON for the hex conversion of arrays if the compiler supports it.
+#define STRING_USE_SIMD                             CONFIG_STRING_USE_SIMD
 #endif
 
 #if MODULE_ENABLE_CRC
@@ -249,6 +276,10 @@
 #define CRC_USE_TABLE_X16_X15_X2_1					CONFIG_CRC_USE_TABLE_X16_X15_X2_1
 /// If set, a constant lookup table will be used for 0x8408 when initialized with crc_init_handler_reversed.
 #define CRC_USE_TABLE_X16_X12_X5_1_REVERSED			CONFIG_CRC_USE_TABLE_X16_X12_X5_1_REVERSED
+/// If set, the default CRC32 polynom is calculated with 8 bytes per step using 7 KiB of additional constant tables.
+#define CRC32_USE_SLICING_BY_8						CONFIG_CRC32_USE_SLICING_BY_8
+/// If set, the default CRC32 polynom is calculated with CPU instructions where available.
+#define CRC32_USE_HARDWARE							CONFIG_CRC32_USE_HARDWARE
 #endif
 
 #if MODULE_ENABLE_FIFO
@@ -261,6 +292,14 @@
 #define FIFO_USE_AVERAGE				            CONFIG_FIFO_USE_AVERAGE
 #endif
 
+#if MODULE_ENABLE_FILTER
+//------------------------------------
+// filter
+//------------------------------------
+/// Set to true to use the esp-dsp component for float biquad filters, which uses the DSP instructions of the ESP32-S3.
+#define FILTER_USE_ESP_DSP							CONFIG_FILTER_USE_ESP_DSP
+#endif
+
 #if MODULE_ENABLE_FLASH_INFO
 //------------------------------------
 // flash_info
@@ -288,6 +327,16 @@
 #endif
 #endif
 
+#if MODULE_ENABLE_FLASH_INTEGRITY
+//------------------------------------
+// flash_integrity
+//------------------------------------
+/// Default size of the blocks that have their own CRC in bytes.
+#define FLASH_INTEGRITY_BLOCK_SIZE					CONFIG_FLASH_INTEGRITY_BLOCK_SIZE
+/// Interval in milliseconds in which the scrub task checks one block.
+#define FLASH_INTEGRITY_SCRUB_INTERVAL_MS			CONFIG_FLASH_INTEGRITY_SCRUB_INTERVAL_MS
+#endif
+
 #if MODULE_ENABLE_GUI
 //------------------------------------
 // gui
@@ -350,6 +399,18 @@
 //------------------------------------
 /// Synchronization interval in seconds for the rtc, before a synchronized clock is seen as relative.
 #define RTC_SYNCHRONIZE_DURATION    				CONFIG_RTC_SYNCHRONIZE_DURATION
+/// Number of years for which the daylight saving time transitions are cached.
+#define RTC_DST_CACHE_SIZE							CONFIG_RTC_DST_CACHE_SIZE
+/// Maximum time in milliseconds the alarm task waits before it compares the deadline with the rtc again.
+#define RTC_ALARM_MAX_SLEEP_MS						CONFIG_RTC_ALARM_MAX_SLEEP_MS
+#endif
+
+#if MODULE_ENABLE_UTIL_MEM_POOL
+//------------------------------------
+// util/mem_pool
+//------------------------------------
+/// Number of single chunks that each core can keep in a local cache. Set to 0 to disable the cache.
+#define MEM_POOL_CORE_CACHE_SIZE                    CONFIG_MEM_POOL_CORE_CACHE_SIZE
 #endif
 
 #endif // CONFIG_ESOPUBLIC_ENABLE
@@ -63,6 +63,10 @@
 
 /// Enable/disable freertos
 #define MCU_ENABLE_FREERTOS							true
+
+/// Redirects mcu_heap_calloc, mcu_heap_malloc and mcu_heap_free to the slab allocator in mcu_heap_slab.h.
+/// Small allocations are then served from size classes in an arena, bigger allocations still use the system heap.
+#define MCU_HEAP_USE_SLAB							false
 																		
 /***************************************************************************************************************************
  *  Part 2: MCU configuration
@@ -75,6 +75,12 @@
 #define CONSOLE_MAX_ARGUMENTS						40
 /// Enables checking of crc for the console, the last 4 bytes are seen as a 4-character hex string containing the crc.
 #define CONSOLE_ENABLE_CRC							true
+/// Maximum number of batch commands a host sends without waiting for their responses.
+#define CONSOLE_BATCH_WINDOW						8
+/// Maximum number of lines a console executes before it lets other tasks run.
+#define CONSOLE_MAX_LINES_PER_CALL				8
+/// Size of the arena in bytes that each console uses for dynamic responses.
+#define CONSOLE_RESPONSE_ARENA_SIZE				256
 #endif
 
 #if MODULE_ENABLE_DEBUG_CONSOLE
@@ -99,12 +105,22 @@
 #define DEBUG_CONSOLE_ENABLE_ESP					true
 #endif
 
+#if MODULE_ENABLE_CONVERT_BASE64
+//------------------------------------
+// convert/base64
+//------------------------------------
+/// If true, the streaming encoder uses a 8 KiB table to encode 12 bit into two characters per lookup.
+/// If false, a 64 byte table is used with one lookup per character.
+#define BASE64_USE_LARGE_TABLE					    false
+#endif
 #if MODULE_ENABLE_CONVERT_MATH
 //------------------------------------
 // convert/math
 //------------------------------------
 /// Set to true if 64-Bit operations are needed, otherwise set to false to deactivate the functions.
 #define MATH_ENABLE_64BIT_OPERATIONS			    true
+/// Set to true to use the esp-dsp component for the float dot product and scale, which uses the SIMD instructions of the ESP32-S3.
+#define MATH_USE_ESP_DSP							false
 #endif
 #if MODULE_ENABLE_CONVERT_STRING
 //------------------------------------
@@ -118,6 +134,8 @@
 ///     true: string_printf function can be used.
 ///     false: string_printf function cannot be used.
 #define STRING_BUILD_PRINTF                         true
+/// Set to true to use SSE2 or NEON for the hex conversion of arrays if the compiler supports it.
+#define STRING_USE_SIMD                             true
 #endif
 
 #if MODULE_ENABLE_CRC
@@ -130,6 +148,10 @@
 #define CRC_USE_TABLE_X16_X15_X2_1					true		
 /// If set, a constant lookup table will be used for 0x8408 when initialized with crc_init_handler_reversed.
 #define CRC_USE_TABLE_X16_X12_X5_1_REVERSED			false		
+/// If set, the default CRC32 polynom is calculated with 8 bytes per step using 7 KiB of additional constant tables.
+#define CRC32_USE_SLICING_BY_8						true
+/// If set, the default CRC32 polynom is calculated with CPU instructions where available.
+#define CRC32_USE_HARDWARE							true
 #endif
 
 #if MODULE_ENABLE_DISPLAY
@@ -153,6 +175,14 @@
 #define FIFO_USE_AVERAGE				            false
 #endif
 
+#if MODULE_ENABLE_FILTER
+//------------------------------------
+// filter
+//------------------------------------
+/// Set to true to use the esp-dsp component for float biquad filters, which uses the DSP instructions of the ESP32-S3.
+#define FILTER_USE_ESP_DSP							false
+#endif
+
 #if MODULE_ENABLE_FLASH_INFO
 //------------------------------------
 // flash_info
@@ -180,6 +210,16 @@
 #endif
 #endif
 
+#if MODULE_ENABLE_FLASH_INTEGRITY
+//------------------------------------
+// flash_integrity
+//------------------------------------
+/// Default size of the blocks that have their own CRC in bytes.
+#define FLASH_INTEGRITY_BLOCK_SIZE					4096
+/// Interval in milliseconds in which the scrub task checks one block.
+#define FLASH_INTEGRITY_SCRUB_INTERVAL_MS			10
+#endif
+
 #if MODULE_ENABLE_GUI
 //------------------------------------
 // gui
@@ -242,6 +282,10 @@
 //------------------------------------
 /// Synchronization interval in seconds for the rtc, before a synchronized clock is seen as relative.
 #define RTC_SYNCHRONIZE_DURATION    				(60 * 60)
+/// Number of years for which the daylight saving time transitions are cached.
+#define RTC_DST_CACHE_SIZE							4
+/// Maximum time in milliseconds the alarm task waits before it compares the deadline with the rtc again.
+#define RTC_ALARM_MAX_SLEEP_MS						1000
 #endif
 
 
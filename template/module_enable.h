@@ -43,6 +43,9 @@
 /// Enables the convert module. Is necessary for multiple other modules.
 #define MODULE_ENABLE_CONVERT_BCD                       1
 
+/// Enables the convert module for float and double strings. Is necessary for %f, %F and %e in printf.
+#define MODULE_ENABLE_CONVERT_DTOA						1
+
 /// Enables the convert module. Is necessary for multiple other modules.
 #define MODULE_ENABLE_CONVERT_MATH						1
 
@@ -70,9 +73,15 @@
 /// Enables the fifo module. This is also needed in mcu like uart or can.
 #define MODULE_ENABLE_FIFO								1
 
+/// Enables filter modules like moving averaging.
+#define MODULE_ENABLE_FILTER							0
+
 /// Enables the flash info module
 #define MODULE_ENABLE_FLASH_INFO						1
 
+/// Enables the flash integrity module
+#define MODULE_ENABLE_FLASH_INTEGRITY					0
+
 /// Enables gui module to enable the api for showing buttons, etc. on screens via EVE, FT810, etc.
 /// When enabled, you need to have a gui_config.h in your config directory. A template can be found in the template directory.
 #define MODULE_ENABLE_GUI								0
@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+    #include "module/console/console.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Comm interface that reads from a string and discards the output.
+struct bench_comm_s
+{
+    std::string rx;
+    size_t rx_pos = 0;
+};
+
+static void bench_putc(void* h, int c)
+{
+    (void)h;
+    (void)c;
+}
+
+static void bench_puts(void* h, uint8_t* buf, uint16_t len)
+{
+    (void)h;
+    (void)buf;
+    (void)len;
+}
+
+static int bench_getc(void* h)
+{
+    bench_comm_s* t = (bench_comm_s*)h;
+    return t->rx_pos < t->rx.size() ? (uint8_t)t->rx[t->rx_pos++] : -1;
+}
+
+static int bench_gets(void* h, uint8_t* buf, uint16_t len)
+{
+    int i = 0;
+    while(i < len && ((bench_comm_s*)h)->rx_pos < ((bench_comm_s*)h)->rx.size())
+        buf[i++] = (uint8_t)bench_getc(h);
+    return i;
+}
+
+static int bench_available(void* h)
+{
+    bench_comm_s* t = (bench_comm_s*)h;
+    return (int)(t->rx.size() - t->rx_pos);
+}
+
+static bool bench_transmit_ready(void* h)
+{
+    (void)h;
+    return true;
+}
+
+static void bench_flush(void* h)
+{
+    (void)h;
+}
+
+static const comm_interface_t bench_interface = {bench_putc, bench_getc, bench_puts, bench_gets, bench_available, bench_transmit_ready, bench_flush};
+
+static FUNCTION_RETURN cmd_bench(console_data_t* data, char* line)
+{
+    (void)line;
+    return console_set_response_static(data, FUNCTION_RETURN_OK, "a");
+}
+
+/// Executes 2000 lines on a console with 150 registered commands.
+static void benchmark_dispatch(void)
+{
+    const size_t count = 150;
+    const size_t lines_count = 2000;
+    std::vector<std::string> names(count);
+    std::vector<console_command_t> cmds(count);
+    bench_comm_s io;
+    comm_t comm = {};
+    console_data_t console = {};
+
+    comm.device_handler = &io;
+    comm.interface = &bench_interface;
+    console_init(&console, &comm);
+    console.suppress_invalid_command = true;
+
+    for(size_t i = 0; i < count; i++)
+    {
+        names[i] = "bench_command_" + std::to_string(i);
+        cmds[i] = {};
+        cmds[i].command = (char*)names[i].c_str();
+        cmds[i].fnc_exec = (void*)cmd_bench;
+        cmds[i].explanation = (char*)"";
+        console_add_command(&cmds[i]);
+    }
+    for(size_t i = 0; i < lines_count; i++)
+        io.rx += names[(i * 37) % count] + " arg\n";
+
+    auto t0 = std::chrono::steady_clock::now();
+    while(bench_available(&io) > 0)
+        console.task.f_handle(&console);
+    auto t1 = std::chrono::steady_clock::now();
+
+    printf("%.0f ns per command\n", std::chrono::duration<double, std::nano>(t1 - t0).count() / lines_count);
+
+    for(size_t i = 0; i < count; i++)
+        console_remove_command(&cmds[i]);
+    console_stop(&console);
+}
+
+int main(void)
+{
+    benchmark_dispatch();
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/base64.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns the throughput of bytes in the duration d in MB/s.
+static double mbps(std::chrono::steady_clock::duration d, size_t bytes)
+{
+    return (double)bytes / std::chrono::duration<double>(d).count() / 1e6;
+}
+
+/// Encodes and decodes with the buffer and the stream functions.
+static void benchmark_base64(void)
+{
+    // The buffer functions use 16-bit counters, so the encoded size has to stay below 64 KiB.
+    const size_t len = 30000;
+    const int rounds = 200;
+    std::vector<uint8_t> data(len);
+    std::vector<uint8_t> encoded(BASE64_ENCODE_STREAM_SIZE(len));
+    std::vector<uint8_t> decoded(len + 3);
+    base64_stream_t s;
+    uint32_t enc_len = 0, dec_len = 0;
+
+    for(size_t i = 0; i < len; i++)
+        data[i] = (uint8_t)(i * 131 + (i >> 7));
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(int i = 0; i < rounds; i++)
+        enc_len = base64_encodebuffer(data.data(), encoded.data(), len);
+    auto t1 = std::chrono::steady_clock::now();
+    for(int i = 0; i < rounds; i++)
+    {
+        base64_stream_init(&s);
+        enc_len = base64_encode_stream(&s, data.data(), len, encoded.data());
+        enc_len += base64_encode_stream_finish(&s, &encoded[enc_len]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for(int i = 0; i < rounds; i++)
+        dec_len = base64_decodebuffer(encoded.data(), decoded.data(), enc_len);
+    auto t3 = std::chrono::steady_clock::now();
+    for(int i = 0; i < rounds; i++)
+    {
+        base64_stream_init(&s);
+        dec_len = base64_decode_stream(&s, encoded.data(), enc_len, decoded.data());
+        dec_len += base64_decode_stream_finish(&s, &decoded[dec_len]);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    printf("BASE64_USE_LARGE_TABLE %u\n", (unsigned)BASE64_USE_LARGE_TABLE);
+    printf("encode: buffer %.0f MB/s, stream %.0f MB/s\n", mbps(t1 - t0, len * rounds), mbps(t2 - t1, len * rounds));
+    printf("decode: buffer %.0f MB/s, stream %.0f MB/s\n", mbps(t3 - t2, len * rounds), mbps(t4 - t3, len * rounds));
+}
+
+int main(void)
+{
+    benchmark_base64();
+    return 0;
+}
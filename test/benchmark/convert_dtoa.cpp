@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/dtoa.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+static uint64_t random_state = 88172645463325252ULL;
+
+static uint64_t random_u64(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+static double random_double(void)
+{
+    uint64_t bits;
+    double v;
+
+    do
+    {
+        bits = random_u64();
+        memcpy(&v, &bits, sizeof(v));
+    }while(!std::isfinite(v));
+
+    return v;
+}
+
+/// Returns the duration of d per element in nanoseconds.
+static double ns(std::chrono::steady_clock::duration d, size_t count)
+{
+    return std::chrono::duration<double, std::nano>(d).count() / count;
+}
+
+/// Creates the shortest strings of random doubles and parses them back, compared with snprintf and strtod.
+static void benchmark_shortest(void)
+{
+    const size_t count = 200000;
+    std::vector<double> values(count);
+    std::vector<std::string> strings(count);
+    char str[64];
+    double sum = 0;
+
+    for(size_t i = 0; i < count; i++)
+        values[i] = random_double();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        dtoa_create_double_string(str, values[i], -1, false);
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+    {
+        snprintf(str, sizeof(str), "%.17g", values[i]);
+        strings[i] = str;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        sum += dtoa_parse_double(strings[i].c_str(), NULL);
+    auto t3 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        sum -= strtod(strings[i].c_str(), NULL);
+    auto t4 = std::chrono::steady_clock::now();
+
+    printf("create: dtoa %.0f ns, snprintf %.0f ns\n", ns(t1 - t0, count), ns(t2 - t1, count));
+    printf("parse:  dtoa %.0f ns, strtod %.0f ns (%g)\n", ns(t3 - t2, count), ns(t4 - t3, count), sum);
+}
+
+/// Creates strings with 6 decimals of values around the decimal point, compared with snprintf.
+static void benchmark_precision(void)
+{
+    const size_t count = 200000;
+    std::vector<double> values(count);
+    char str[400];
+
+    for(size_t i = 0; i < count; i++)
+        values[i] = (double)(int64_t)random_u64() * 1e-15;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        dtoa_create_double_string(str, values[i], 6, false);
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        snprintf(str, sizeof(str), "%.6f", values[i]);
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("precision 6: dtoa %.0f ns, snprintf %.0f ns\n", ns(t1 - t0, count), ns(t2 - t1, count));
+}
+
+int main(void)
+{
+    benchmark_shortest();
+    benchmark_precision();
+    return 0;
+}
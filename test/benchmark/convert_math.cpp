@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/math.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Number of elements of each array.
+static const size_t count = 1u << 20;
+
+/// Prints the mean duration of 8 calls of fn.
+static void measure(const char* name, std::function<void()> fn)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for(int r = 0; r < 8; r++)
+        fn();
+    auto t1 = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / 8;
+    printf("%-26s %7.3f ms for %u elements\n", name, ms, (unsigned)count);
+}
+
+int main(void)
+{
+    std::vector<int16_t> i16(count);
+    volatile int64_t sink = 0;
+
+    srand(1234);
+    for(size_t i = 0; i < count; i++)
+        i16[i] = (int16_t)(rand() % 65536 - 32768);
+    std::vector<float> f(i16.begin(), i16.end());
+
+    measure("sum int16 (scalar)", [&]() { int64_t s = 0; for(size_t i = 0; i < count; i++) s += i16[i]; sink = s; });
+    measure("math_array_sum_int16", [&]() { sink = math_array_sum_int16(i16.data(), count); });
+    measure("math_array_max_int16", [&]() { size_t index; sink = math_array_max_int16(i16.data(), count, &index); });
+    measure("math_array_dot_int16", [&]() { sink = math_array_dot_int16(i16.data(), i16.data(), count); });
+    measure("math_array_sum_float", [&]() { sink = (int64_t)math_array_sum_float(f.data(), count); });
+    measure("math_array_dot_float", [&]() { sink = (int64_t)math_array_dot_float(f.data(), f.data(), count); });
+    measure("math_array_variance_float", [&]() { sink = (int64_t)math_array_variance_float(f.data(), count, NULL); });
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/sort.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+#include "module/convert/sort.hpp"
+
+static uint64_t random_state = 88172645463325252ULL;
+
+static uint64_t random_u64(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Returns the duration of d in milliseconds.
+static double ms(std::chrono::steady_clock::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+/// Sorts random numbers with the old exchange sort and each sort of the module.
+static void benchmark_uint32(void)
+{
+    const size_t count = 10000;
+    std::vector<uint32_t> v(count);
+    std::vector<uint32_t> a, tmp(count);
+
+    for(size_t i = 0; i < count; i++)
+        v[i] = (uint32_t)random_u64();
+
+    // Old exchange sort
+    a = v;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        for(size_t j = i; j < count; j++)
+            if(a[i] > a[j])
+                std::swap(a[i], a[j]);
+    auto t1 = std::chrono::steady_clock::now();
+    a = v;
+    sort_uint32(a.data(), count);
+    auto t2 = std::chrono::steady_clock::now();
+    a = v;
+    sort_radix_uint32(a.data(), tmp.data(), count);
+    auto t3 = std::chrono::steady_clock::now();
+    a = v;
+    sort_introsort(a.data(), count);
+    auto t4 = std::chrono::steady_clock::now();
+    a = v;
+    sort_select_uint32(a.data(), count, count / 2);
+    auto t5 = std::chrono::steady_clock::now();
+
+    printf("10k uint32: exchange sort %.2f ms, introsort %.2f ms, radix %.2f ms, C++ introsort %.2f ms, median %.2f ms\n",
+           ms(t1 - t0), ms(t2 - t1), ms(t3 - t2), ms(t4 - t3), ms(t5 - t4));
+}
+
+int main(void)
+{
+    benchmark_uint32();
+    return 0;
+}
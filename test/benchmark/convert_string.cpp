@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/string.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns the throughput of size bytes in the duration d in MB/s.
+static double mbps(std::chrono::steady_clock::duration d, size_t size)
+{
+    return size / std::chrono::duration<double>(d).count() / 1e6;
+}
+
+/// Searches with nested loops like the substring functions did before the Two-Way search.
+static const char* naive_find(const char* str, size_t str_len, const char* find, size_t find_len)
+{
+    for(size_t i = 0; i + find_len <= str_len; i++)
+    {
+        size_t j = 0;
+        while(j < find_len && str[i + j] == find[j])
+            j++;
+        if(j == find_len)
+            return str + i;
+    }
+    return NULL;
+}
+
+/// Searches a pattern in the worst case for nested loops with the Two-Way search and with nested loops.
+static void benchmark_find_substring(void)
+{
+    const size_t size = 1 << 18;
+    const int count = 8;
+    std::string str(size, 'a');
+    std::string find(100, 'a');
+    const char* volatile result;
+
+    // Each position matches 99 characters before it fails.
+    find[99] = 'b';
+    str[size - 1] = 'b';
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
+        result = string_strstr_end(&str[0], find.c_str());
+    auto t1 = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
+        result = string_strcasestr(&str[0], find.c_str());
+    auto t2 = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
+        result = naive_find(str.data(), size, find.data(), find.size());
+    auto t3 = std::chrono::steady_clock::now();
+    (void)result;
+
+    printf("strstr_end %.0f MB/s, strcasestr %.0f MB/s, nested loops %.0f MB/s\n",
+           mbps(t1 - t0, size * count), mbps(t2 - t1, size * count), mbps(t3 - t2, size * count));
+}
+
+/// Encodes and decodes 64 kB as hex string and decodes it nibble by nibble for comparison.
+static void benchmark_hex_array(void)
+{
+    const size_t size = 1 << 16;
+    const int count = 16;
+    std::vector<uint8_t> data(size);
+    std::vector<uint8_t> decoded(size);
+    std::vector<char> str(2 * size + 1);
+
+    for(size_t i = 0; i < size; i++)
+        data[i] = (uint8_t)(i * 31);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
+        string_create_hex_array_string(str.data(), data.data(), size, 0);
+    auto t1 = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
+        string_decode_hex_array(str.data(), 2 * size, decoded.data());
+    auto t2 = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
+    {
+        for(size_t j = 0; j < size; j++)
+            decoded[j] = (string_ascii_to_uint8(str[2 * j]) << 4) + string_ascii_to_uint8(str[2 * j + 1]);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    printf("hex encode %.0f MB/s, decode %.0f MB/s, nibble decode %.0f MB/s\n",
+           mbps(t1 - t0, size * count), mbps(t2 - t1, size * count), mbps(t3 - t2, size * count));
+}
+
+int main(void)
+{
+    benchmark_find_substring();
+    benchmark_hex_array();
+    return 0;
+}
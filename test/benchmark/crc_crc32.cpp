@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C"
+{
+    #include "module/crc/crc32.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns the throughput of size bytes in the duration d in GB/s.
+static double gbps(std::chrono::steady_clock::duration d, size_t size)
+{
+    return size / std::chrono::duration<double>(d).count() / 1e9;
+}
+
+/// Calculates the crc of 4 MB bytewise with a single table, with slicing by 8 and with the hardware if available.
+static void benchmark_crc32(void)
+{
+    const size_t size = 4 * 1024 * 1024;
+    std::vector<uint8_t> data(size);
+    volatile uint32_t sink;
+    uint32_t x = 0x12345678;
+    crc32_t crc;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        x = x * 1103515245 + 12345;
+        data[i] = x >> 24;
+    }
+
+    CRC32_INIT_DEFAULT(&crc);
+    bool has_hardware = crc.use_hardware;
+
+    // Bytewise with the single table, like before slicing by 8 was added.
+    auto t0 = std::chrono::steady_clock::now();
+    uint32_t c = 0xffffffff;
+    for(size_t i = 0; i < size; i++)
+        c = (c >> 8) ^ crc.table[(c & 0xff) ^ data[i]];
+    sink = c;
+    auto t1 = std::chrono::steady_clock::now();
+    crc.use_hardware = false;
+    crc32_start(&crc);
+    crc32_update(&crc, data.data(), size);
+    sink = crc32_finish(&crc);
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("crc32 bytewise %.2f GB/s, slicing by 8 %.2f GB/s", gbps(t1 - t0, size), gbps(t2 - t1, size));
+
+    if(has_hardware)
+    {
+        crc.use_hardware = true;
+        t0 = std::chrono::steady_clock::now();
+        crc32_start(&crc);
+        crc32_update(&crc, data.data(), size);
+        sink = crc32_finish(&crc);
+        t1 = std::chrono::steady_clock::now();
+        printf(", hardware %.2f GB/s", gbps(t1 - t0, size));
+    }
+    printf("\n");
+    (void)sink;
+}
+
+int main(void)
+{
+    benchmark_crc32();
+    return 0;
+}
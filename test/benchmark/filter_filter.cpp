@@ -0,0 +1,58 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+extern "C"
+{
+    #include "module/filter/filter.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns the duration of d per sample in nanoseconds.
+static double ns(std::chrono::steady_clock::duration d, size_t count)
+{
+    return std::chrono::duration<double, std::nano>(d).count() / count;
+}
+
+/// Filters random samples with a 32 tap q15 fir in blocks of 256 and one by one.
+static void benchmark_fir_q15(void)
+{
+    const size_t count = 1u << 18;
+    std::vector<q15_t> in(count), out(count);
+    q15_t coeffs[32], state_block[FILTER_FIR_STATE_SIZE(32, 256)], state_single[FILTER_FIR_STATE_SIZE(32, 1)];
+    filter_fir_q15_t fir_block, fir_single;
+
+    srand(42);
+    for(size_t i = 0; i < 32; i++)
+        coeffs[i] = FILTER_Q15(1.0 / 32);
+    for(size_t i = 0; i < count; i++)
+        in[i] = FILTER_Q15(0.9 * (2.0 * rand() / RAND_MAX - 1.0));
+
+    filter_fir_q15_init(&fir_block, coeffs, 32, state_block, 256, 1);
+    filter_fir_q15_init(&fir_single, coeffs, 32, state_single, 1, 1);
+
+    auto t0 = std::chrono::steady_clock::now();
+    filter_fir_q15_process(&fir_block, in.data(), out.data(), count);
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        filter_fir_q15_process(&fir_single, &in[i], &out[i], 1);
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("32 tap q15 fir: %.1f ns/sample in blocks of 256, %.1f ns/sample one by one\n", ns(t1 - t0, count), ns(t2 - t1, count));
+}
+
+int main(void)
+{
+    benchmark_fir_q15();
+    return 0;
+}
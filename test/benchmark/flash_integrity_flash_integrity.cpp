@@ -0,0 +1,70 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C"
+{
+    #include "module/flash_integrity/flash_integrity.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+#define REGION_BLOCKS   16
+
+/// Returns the duration of d in nanoseconds.
+static long long ns(std::chrono::steady_clock::duration d)
+{
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+static flash_integrity_handle_t create_region(void)
+{
+    flash_integrity_config_t config = {};
+
+    config.address = BLOCK(4);
+    config.size = REGION_BLOCKS * MCU_CONTROLLER_FLASH_BLOCK_SIZE;
+    config.index_address = BLOCK(2);
+
+    return flash_integrity_create(&config);
+}
+
+/// Loads a committed index like after a restart and compares it to verifying all blocks.
+static void benchmark_load(void)
+{
+    std::vector<uint8_t> data(REGION_BLOCKS * MCU_CONTROLLER_FLASH_BLOCK_SIZE);
+    flash_integrity_handle_t h, h2;
+
+    mcu_flash_init();
+    for(size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)(i * 7 + (i >> 8));
+
+    h = create_region();
+    flash_integrity_write(h, BLOCK(4), data.data(), data.size());
+    flash_integrity_commit(h);
+    h2 = create_region();
+
+    auto t0 = std::chrono::steady_clock::now();
+    flash_integrity_load(h2);
+    auto t1 = std::chrono::steady_clock::now();
+    flash_integrity_verify(h2);
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("load: %lld ns, full verify: %lld ns\n", ns(t1 - t0), ns(t2 - t1));
+
+    flash_integrity_free(h2);
+    flash_integrity_free(h);
+}
+
+int main(void)
+{
+    benchmark_load();
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdio>
+
+extern "C"
+{
+    #include "module/list/list.h"
+    #include "module/list/dlist.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+
+    typedef struct test_data_s test_data_t;
+    struct test_data_s
+    {
+        int integer;
+        test_data_t* next;
+    };
+
+    typedef struct test_ddata_s
+    {
+        int integer;
+        dlist_node_t node;
+    }test_ddata_t;
+
+    static int CompareInteger(const void* a, const void* b)
+    {
+        return ((const test_ddata_t*)a)->integer - ((const test_ddata_t*)b)->integer;
+    }
+}
+
+/// Returns the duration of d in microseconds.
+static double us(std::chrono::steady_clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+/// Adds all elements and removes them from the end, which is the worst case for list_t, then inserts sorted into a dlist_t.
+static void benchmark_add_remove(void)
+{
+    const int num = 1000;
+    test_data_t* s_elements = (test_data_t*)mcu_heap_calloc(num, sizeof(test_data_t));
+    test_ddata_t* d_elements = (test_ddata_t*)mcu_heap_calloc(num, sizeof(test_ddata_t));
+    list_t s_list;
+    dlist_t d_list;
+
+    list_init(&s_list, s_elements, &s_elements->next);
+    dlist_init(&d_list, d_elements, &d_elements->node);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(int i = 0; i < num; i++)
+        list_add_element(&s_list, &s_elements[i]);
+    for(int i = num - 1; i >= 0; i--)
+        list_remove_element(&s_list, &s_elements[i]);
+    auto t1 = std::chrono::steady_clock::now();
+    for(int i = 0; i < num; i++)
+        dlist_add_element(&d_list, &d_elements[i]);
+    for(int i = num - 1; i >= 0; i--)
+        dlist_remove_element(&d_list, &d_elements[i]);
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("%d add+remove: list %.1f us, dlist %.1f us\n", num, us(t1 - t0), us(t2 - t1));
+
+    // Sorted insert of deadlines that are mostly in order
+    for(int i = 0; i < num; i++)
+        d_elements[i].integer = i + ((i % 8) == 0 ? 16 : 0);
+    t0 = std::chrono::steady_clock::now();
+    for(int i = 0; i < num; i++)
+        dlist_insert_sorted(&d_list, &d_elements[i], CompareInteger);
+    t1 = std::chrono::steady_clock::now();
+
+    printf("%d sorted inserts: %.1f us\n", num, us(t1 - t0));
+
+    mcu_heap_free(s_elements);
+    mcu_heap_free(d_elements);
+}
+
+int main(void)
+{
+    benchmark_add_remove();
+    return 0;
+}
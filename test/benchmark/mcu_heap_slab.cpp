@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C"
+{
+    #include "module_public.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns the duration of d per alloc and free in nanoseconds.
+static double ns(std::chrono::steady_clock::duration d, size_t count)
+{
+    return std::chrono::duration<double, std::nano>(d).count() / count;
+}
+
+/// Allocates and frees blocks of each size class with the slab allocator and with malloc.
+static void benchmark_latency(void)
+{
+    const int rounds = 2000;
+    const int num = 64;
+    void* ptr[num];
+    const size_t sizes[] = {8, 24, 48, 100, 200};
+
+    for(size_t size : sizes)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++)
+        {
+            for(int i = 0; i < num; i++)
+                ptr[i] = mcu_heap_malloc(size);
+            for(int i = 0; i < num; i++)
+                mcu_heap_free(ptr[i]);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++)
+        {
+            for(int i = 0; i < num; i++)
+                ptr[i] = malloc(size);
+            for(int i = 0; i < num; i++)
+                free(ptr[i]);
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        printf("size %u: slab %.1f ns, malloc %.1f ns per alloc+free\n", (unsigned)size, ns(t1 - t0, rounds * num), ns(t2 - t1, rounds * num));
+    }
+}
+
+int main(void)
+{
+    benchmark_latency();
+    return 0;
+}
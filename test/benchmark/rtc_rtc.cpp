@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+extern "C"
+{
+    #include "module/rtc/rtc.h"
+    #include "module/rtc/rtc_alarm.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns the duration of d per element in nanoseconds.
+static double ns(std::chrono::steady_clock::duration d, size_t count)
+{
+    return std::chrono::duration<double, std::nano>(d).count() / count;
+}
+
+/// Returns the duration of d in microseconds.
+static double us(std::chrono::steady_clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+/// Converts sorted log timestamps one by one and with the array functions.
+static void benchmark_array(void)
+{
+    const size_t count = 200000;
+    std::vector<int64_t> t(count), t2(count);
+    std::vector<rtc_time_t> times(count);
+    int64_t start = rtc_civil_seconds_from_date(2030, 5, 1, 0, 0, 0) * 1000;
+
+    // Sorted log entries every 7.3 seconds
+    for(size_t i = 0; i < count; i++)
+        t[i] = start + i * 7300;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+        times[i] = rtc_time_ms(t[i]);
+    auto t1 = std::chrono::steady_clock::now();
+    rtc_time_array(t.data(), times.data(), count, true);
+    auto t2_ = std::chrono::steady_clock::now();
+    rtc_mktime_array(times.data(), t2.data(), count, true);
+    auto t3 = std::chrono::steady_clock::now();
+
+    printf("rtc_time_ms %.1f ns, rtc_time_array %.1f ns, rtc_mktime_array %.1f ns\n",
+           ns(t1 - t0, count), ns(t2_ - t1, count), ns(t3 - t2_, count));
+}
+
+/// Converts timestamps to the local time of Berlin one by one and with rtc_local_time_array.
+static void benchmark_local_time_array(void)
+{
+    const size_t count = 100000;
+    std::vector<int64_t> utc(count);
+    std::vector<rtc_time_t> times(count);
+    int64_t start = rtc_civil_seconds_from_date(2025, 2, 1, 0, 0, 0) * 1000;
+
+    for(size_t i = 0; i < count; i++)
+        utc[i] = start + (int64_t)i * 7300;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+    {
+        rtc_time_t t = rtc_time_ms(utc[i] + 3600000);
+        if(rtc_is_daylight_saving_time(&t))
+            t = rtc_time_ms(utc[i] + 7200000);
+        times[i] = t;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    rtc_local_time_array(utc.data(), times.data(), count, 1, true, true);
+    auto t2 = std::chrono::steady_clock::now();
+
+    printf("single conversion %.1f ns, rtc_local_time_array %.1f ns\n", ns(t1 - t0, count), ns(t2 - t1, count));
+}
+
+/// Number of alarms that were triggered by benchmark_alarm.
+static size_t alarm_count = 0;
+
+static void alarm_cb(const rtc_alarm_handle_t alarm, const rtc_alarm_config_t* config)
+{
+    (void)alarm;
+    (void)config;
+    alarm_count++;
+}
+
+/// Sets up random alarms within one day and processes them while the time jumps in steps of 10 minutes.
+static void benchmark_alarm(void)
+{
+    const size_t count = 5000;
+    std::vector<rtc_alarm_handle_t> alarms(count);
+    std::mt19937 rng(45);
+    int64_t start = rtc_civil_seconds_from_date(2026, 9, 18, 0, 0, 0) * 1000;
+    int64_t now = start;
+
+    for(size_t i = 0; i < count; i++)
+        alarms[i] = rtc_alarm_create();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < count; i++)
+    {
+        rtc_alarm_config_t c = {};
+        c.alarm_time = rtc_time_ms(start + 1 + (int64_t)(rng() % 86400000));
+        c.f = alarm_cb;
+        rtc_alarm_setup(alarms[i], &c);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    while(rtc_alarm_get_count() > 0)
+    {
+        now += 600000;
+        rtc_alarm_process(now);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < count; i++)
+        rtc_alarm_free(alarms[i]);
+
+    printf("setup %u alarms %.0f us, trigger %u alarms %.0f us\n", (unsigned)count, us(t1 - t0), (unsigned)alarm_count, us(t2 - t1));
+}
+
+int main(void)
+{
+    benchmark_array();
+    benchmark_local_time_array();
+    benchmark_alarm();
+    return 0;
+}
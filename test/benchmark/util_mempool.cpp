@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+extern "C"
+{
+    #include "module/util/mem_pool.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Allocates and frees single chunks while the upper part of the pool is allocated, so a linear scan would have to skip it.
+static void benchmark_alloc_free(void)
+{
+    const size_t num_chunks = 4096;
+    const size_t num_held = 1024;
+    const int rounds = 200;
+    mem_pool_handle_t pool;
+    mem_pool_chunk_handle_t filler;
+    std::vector<mem_pool_chunk_handle_t> held(num_held);
+
+    mem_pool_init(&pool, num_chunks, 64);
+    mem_pool_alloc_chunk(pool, &filler, 64 * (num_chunks - num_held));
+
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++)
+    {
+        for(size_t i = 0; i < num_held; i++)
+            mem_pool_alloc_chunk(pool, &held[i], 64);
+        for(size_t i = 0; i < num_held; i++)
+            mem_pool_free_chunk(held[i]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    printf("mem_pool alloc+free: %.1f Mops/s\n", (rounds * num_held) / seconds / 1e6);
+
+    mem_pool_free_chunk(filler);
+    mem_pool_free(pool, false);
+}
+
+int main(void)
+{
+    benchmark_alloc_free();
+    return 0;
+}
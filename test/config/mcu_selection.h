@@ -28,7 +28,7 @@
 /// Enable/disable functions to write into the code flash.
 #define MCU_PERIPHERY_ENABLE_CODE_FLASH				false
 /// Enable/disable functions to write into the data flash.
-#define MCU_PERIPHERY_ENABLE_DATA_FLASH				false
+#define MCU_PERIPHERY_ENABLE_DATA_FLASH				true
 /// Enable/disable Watchdog functions.
 #define MCU_PERIPHERY_ENABLE_WATCHDOG				true
 /// Enable/disable ethernet. If enable, lwip is needed in the project
@@ -63,6 +63,10 @@
 
 /// Enable/disable freertos
 #define MCU_ENABLE_FREERTOS							false
+
+/// Redirects mcu_heap_calloc, mcu_heap_malloc and mcu_heap_free to the slab allocator in mcu_heap_slab.h.
+/// Small allocations are then served from size classes in an arena, bigger allocations still use the system heap.
+#define MCU_HEAP_USE_SLAB							false
 																		
 /***************************************************************************************************************************
  *  Part 2: MCU configuration
@@ -26,6 +26,9 @@
 /// Enables the flash info module
 #define MODULE_ENABLE_FLASH_INFO						0
 
+/// Enables the flash integrity module
+#define MODULE_ENABLE_FLASH_INTEGRITY					1
+
 /// Enables the swupdate Module
 /// When enabled, the sw_update_routine can be automatically enabled during start-up. See defines in @see sw_update_mmc.h
 #define MODULE_ENABLE_SWUPDATE							0
@@ -94,7 +97,7 @@
 #define MODULE_ENABLE_COMM_SPI                          0
 
 /// Enables the virtual comm interface in the comm module.
-#define MODULE_ENABLE_COMM_VCOMM                        0
+#define MODULE_ENABLE_COMM_VCOMM                        1
 
 /// Enables the line_reader in the comm module.
 #define MODULE_ENABLE_COMM_LINE_READER                  0
@@ -108,6 +111,9 @@
 /// Enables the convert module. Is necessary for multiple other modules.
 #define MODULE_ENABLE_CONVERT_BASE64					1
 
+/// Enables the convert module for float and double strings. Is necessary for %f, %F and %e in printf.
+#define MODULE_ENABLE_CONVERT_DTOA						1
+
 /// Enables the convert module. Is necessary for multiple other modules.
 #define MODULE_ENABLE_CONVERT_MATH						1
 
@@ -154,7 +160,7 @@
 #define MODULE_ENABLE_FILE								0
 
 /// Enables filter modules like moving averaging.
-#define MODULE_ENABLE_FILTER							0
+#define MODULE_ENABLE_FILTER							1
 
 /// Enables the module to access an external flash via QSPI
 #define MODULE_ENABLE_FLASH_QSPI						0
@@ -291,7 +297,7 @@
 #define MODULE_ENABLE_RPC                               0
 
 /// Enables the rtc module for calculation function on time.
-#define MODULE_ENABLE_RTC								0
+#define MODULE_ENABLE_RTC								1
 
 /// Enables module for security
 #define MODULE_ENABLE_SECURITY                          0
@@ -0,0 +1,693 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+    #include "module/console/console.h"
+    #include "module/comm/virtual/vcomm.h"
+    #include "module/crc/crc.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Comm interface that reads from a string and writes into a string.
+struct test_comm_s
+{
+    std::string rx;
+    size_t rx_pos = 0;
+    std::string tx;
+};
+
+static void test_putc(void* h, int c)
+{
+    ((test_comm_s*)h)->tx.push_back((char)c);
+}
+
+static void test_puts(void* h, uint8_t* buf, uint16_t len)
+{
+    ((test_comm_s*)h)->tx.append((const char*)buf, len);
+}
+
+static int test_getc(void* h)
+{
+    test_comm_s* t = (test_comm_s*)h;
+    return t->rx_pos < t->rx.size() ? (uint8_t)t->rx[t->rx_pos++] : -1;
+}
+
+static int test_gets(void* h, uint8_t* buf, uint16_t len)
+{
+    int i = 0;
+    while(i < len && ((test_comm_s*)h)->rx_pos < ((test_comm_s*)h)->rx.size())
+        buf[i++] = (uint8_t)test_getc(h);
+    return i;
+}
+
+static int test_available(void* h)
+{
+    test_comm_s* t = (test_comm_s*)h;
+    return (int)(t->rx.size() - t->rx_pos);
+}
+
+static bool test_transmit_ready(void* h)
+{
+    (void)h;
+    return true;
+}
+
+static void test_flush(void* h)
+{
+    (void)h;
+}
+
+static const comm_interface_t test_interface = {test_putc, test_getc, test_puts, test_gets, test_available, test_transmit_ready, test_flush};
+
+/// Console on the test comm interface.
+class console_test : public ::testing::Test
+{
+protected:
+    test_comm_s io;
+    comm_t comm = {};
+    console_data_t console = {};
+
+    void SetUp() override
+    {
+        comm.device_handler = &io;
+        comm.interface = &test_interface;
+        console_init(&console, &comm);
+        console.suppress_invalid_command = true;
+    }
+
+    void TearDown() override
+    {
+        console_stop(&console);
+    }
+
+    /// Sends the lines to the console and returns what the console wrote.
+    std::string execute(const std::string& lines)
+    {
+        io.rx = lines;
+        io.rx_pos = 0;
+        io.tx.clear();
+        // Each call executes at most CONSOLE_MAX_LINES_PER_CALL lines.
+        while(test_available(&io) > 0)
+            console.task.f_handle(&console);
+        return io.tx;
+    }
+};
+
+static int calls_a = 0;
+static int calls_b = 0;
+
+static FUNCTION_RETURN cmd_a(console_data_t* data, char* line)
+{
+    (void)line;
+    calls_a++;
+    return console_set_response_static(data, FUNCTION_RETURN_OK, "a");
+}
+
+static FUNCTION_RETURN cmd_b(console_data_t* data, char* line)
+{
+    (void)line;
+    calls_b++;
+    return console_set_response_static(data, FUNCTION_RETURN_OK, "b");
+}
+
+static console_command_t make_command(const char* name, void* f)
+{
+    console_command_t c = {};
+    c.command = (char*)name;
+    c.fnc_exec = f;
+    c.explanation = (char*)"";
+    return c;
+}
+
+TEST_F(console_test, add_and_remove)
+{
+    const size_t count = 200;
+    std::vector<std::string> names(count);
+    std::vector<console_command_t> cmds(count);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        names[i] = "reg" + std::to_string(i);
+        cmds[i] = make_command(names[i].c_str(), (void*)cmd_a);
+        console_add_command(&cmds[i]);
+    }
+    // Adding twice does not change anything
+    console_add_command(&cmds[5]);
+
+    calls_a = 0;
+    EXPECT_EQ(execute("reg0\nreg199 x\nreg57\n"), "res 0 \"OK\" \"a\"\nres 0 \"OK\" \"a\"\nres 0 \"OK\" \"a\"\n");
+    EXPECT_EQ(calls_a, 3);
+
+    // Remove from the start, middle and end of the list
+    console_remove_command(&cmds[0]);
+    console_remove_command(&cmds[57]);
+    console_remove_command(&cmds[199]);
+    console_remove_command(&cmds[57]);
+    EXPECT_EQ(execute("reg0\nreg199\nreg57\n"), "");
+    EXPECT_EQ(execute("reg1\nreg198\n"), "res 0 \"OK\" \"a\"\nres 0 \"OK\" \"a\"\n");
+
+    // A command with the same name is hidden until the first one is removed.
+    console_command_t dup = make_command("reg1", (void*)cmd_b);
+    console_add_command(&dup);
+    calls_a = calls_b = 0;
+    execute("reg1\n");
+    EXPECT_EQ(calls_a, 1);
+    console_remove_command(&cmds[1]);
+    execute("reg1\n");
+    EXPECT_EQ(calls_b, 1);
+    console_remove_command(&dup);
+    EXPECT_EQ(execute("reg1\n"), "");
+
+    // Removed commands can be added again
+    console_add_command(&cmds[0]);
+    EXPECT_EQ(execute("reg0\n"), "res 0 \"OK\" \"a\"\n");
+
+    for(size_t i = 0; i < count; i++)
+        console_remove_command(&cmds[i]);
+    EXPECT_EQ(execute("reg0\nreg100\n"), "");
+}
+
+TEST_F(console_test, whitelist)
+{
+    console_command_t a = make_command("wl_a", (void*)cmd_a);
+    console_command_t b = make_command("wl_b", (void*)cmd_b);
+    const char* whitelist[] = {"help", "wl_a"};
+    const char* whitelist2[] = {"wl_b"};
+
+    console_add_command(&a);
+    console_add_command(&b);
+
+    console_set_whitelist(&console, whitelist, 2);
+    EXPECT_EQ(execute("wl_a\nwl_b\n"), "res 0 \"OK\" \"a\"\n");
+
+    // Setting the whitelist directly creates the set again.
+    console.command_whitelist = whitelist2;
+    console.num_whitelist = 1;
+    EXPECT_EQ(execute("wl_a\nwl_b\n"), "res 0 \"OK\" \"b\"\n");
+
+    console_set_whitelist(&console, NULL, 0);
+    EXPECT_EQ(execute("wl_a\nwl_b\n"), "res 0 \"OK\" \"a\"\nres 0 \"OK\" \"b\"\n");
+
+    console_remove_command(&a);
+    console_remove_command(&b);
+}
+
+TEST_F(console_test, complete)
+{
+    const char* names[] = {"comp_status", "comp_start", "comp_stop", "comp_reset"};
+    console_command_t cmds[4];
+    const console_command_t* matches[4];
+    size_t common = 0;
+
+    for(size_t i = 0; i < 4; i++)
+    {
+        cmds[i] = make_command(names[i], (void*)cmd_a);
+        console_add_command(&cmds[i]);
+    }
+
+    EXPECT_EQ(console_complete_command(NULL, "comp_", 5, matches, 4, &common), 4);
+    EXPECT_EQ(common, 5u);
+    EXPECT_EQ(matches[0], &cmds[0]);
+    EXPECT_EQ(matches[3], &cmds[3]);
+
+    // "comp_s" can be completed to "comp_st"
+    EXPECT_EQ(console_complete_command(NULL, "comp_s", 6, matches, 4, &common), 3);
+    EXPECT_EQ(common, 7u);
+
+    EXPECT_EQ(console_complete_command(NULL, "comp_r", 6, matches, 4, &common), 1);
+    EXPECT_EQ(common, strlen("comp_reset"));
+    EXPECT_EQ(console_complete_command(NULL, "comp_x", 6, matches, 4, &common), 0);
+    EXPECT_EQ(common, 0u);
+    EXPECT_EQ(console_complete_command(NULL, "he", 2, NULL, 0, &common), 1);
+    EXPECT_EQ(common, 4u);
+
+    // Only whitelisted commands are completed for a console.
+    const char* whitelist[] = {"comp_stop"};
+    console_set_whitelist(&console, whitelist, 1);
+    EXPECT_EQ(console_complete_command(&console, "comp_st", 7, matches, 4, &common), 1);
+    EXPECT_EQ(matches[0], &cmds[2]);
+    EXPECT_EQ(common, strlen("comp_stop"));
+    console_set_whitelist(&console, NULL, 0);
+
+    for(size_t i = 0; i < 4; i++)
+        console_remove_command(&cmds[i]);
+}
+
+static std::vector<std::string> array_args;
+
+static FUNCTION_RETURN cmd_array(console_data_t* data, char** args, uint8_t args_len)
+{
+    array_args.assign(args, args + args_len);
+    return console_set_response_dynamic(data, FUNCTION_RETURN_OK, 10, "%u", args_len);
+}
+
+TEST_F(console_test, tokenize)
+{
+    console_command_t c = make_command("tok", (void*)cmd_array);
+    c.use_array_param = true;
+    console_add_command(&c);
+
+    EXPECT_EQ(execute("tok\n"), "res 0 \"OK\" \"0\"\n");
+    EXPECT_TRUE(array_args.empty());
+
+    execute("tok a  bc   d\n");
+    EXPECT_EQ(array_args, std::vector<std::string>({"a", "bc", "d"}));
+
+    // Quotes can also be used for the first argument, an empty quote is an empty argument.
+    execute("tok \"a b\" c \"\" \"d  e\"\n");
+    EXPECT_EQ(array_args, std::vector<std::string>({"a b", "c", "", "d  e"}));
+
+    // A missing closing quote ends at the end of the line
+    execute("tok x \"y z\n");
+    EXPECT_EQ(array_args, std::vector<std::string>({"x", "y z"}));
+
+    // Arguments behind CONSOLE_MAX_ARGUMENTS are ignored.
+    std::string line = "tok";
+    for(int i = 0; i < CONSOLE_MAX_ARGUMENTS + 5; i++)
+        line += " " + std::to_string(i);
+    execute(line + "\n");
+    EXPECT_EQ(array_args.size(), (size_t)CONSOLE_MAX_ARGUMENTS);
+    EXPECT_EQ(array_args.back(), std::to_string(CONSOLE_MAX_ARGUMENTS - 1));
+
+    console_remove_command(&c);
+}
+
+static const char* const schema_modes[] = {"off", "on", "blink"};
+
+static const console_arg_schema_t schema_args[] = {
+    {"int", CONSOLE_ARG_INT, false, -100, 100, NULL, 0},
+    {"uint", CONSOLE_ARG_UINT, false, 0, 0, NULL, 0},
+    {"hex", CONSOLE_ARG_HEX, false, 0, 0, NULL, 0},
+    {"float", CONSOLE_ARG_FLOAT, false, 0, 0, NULL, 0},
+    {"mode", CONSOLE_ARG_ENUM, false, 0, 0, schema_modes, 3},
+    {"name", CONSOLE_ARG_STRING, false, 1, 8, NULL, 0},
+    {"data", CONSOLE_ARG_BYTES, true, 0, 4, NULL, 0},
+};
+
+static const console_arg_t* typed_args;
+static uint8_t typed_args_len;
+static std::vector<uint8_t> typed_bytes;
+
+static FUNCTION_RETURN cmd_typed(console_data_t* data, const console_arg_t* args, uint8_t args_len)
+{
+    (void)data;
+    typed_args = args;
+    typed_args_len = args_len;
+    typed_bytes.assign(args[6].bytes, args[6].bytes + args[6].len);
+    return FUNCTION_RETURN_OK;
+}
+
+TEST_F(console_test, args_schema)
+{
+    console_command_t c = make_command("typed", (void*)cmd_typed);
+    c.args_schema = schema_args;
+    c.num_args_schema = 7;
+    console_add_command(&c);
+
+    typed_args = NULL;
+    execute("typed -12 4000000000 0x1aF 1.5e-3 blink \"a b\" 00FF7e\n");
+    ASSERT_NE(typed_args, nullptr);
+    EXPECT_EQ(typed_args_len, 7);
+    EXPECT_EQ(typed_args[0].i, -12);
+    EXPECT_EQ(typed_args[1].u, 4000000000u);
+    EXPECT_EQ(typed_args[2].u, 0x1AFu);
+    EXPECT_FLOAT_EQ(typed_args[3].f, 1.5e-3f);
+    EXPECT_EQ(typed_args[4].u, 2u);
+    EXPECT_EQ(std::string(typed_args[5].str, typed_args[5].len), "a b");
+    EXPECT_TRUE(typed_args[6].present);
+    EXPECT_EQ(typed_bytes, std::vector<uint8_t>({0x00, 0xFF, 0x7E}));
+
+    // The optional argument can be omitted.
+    typed_args = NULL;
+    execute("typed 100 0 FFFFFFFF -1 off x\n");
+    ASSERT_NE(typed_args, nullptr);
+    EXPECT_EQ(typed_args[0].i, 100);
+    EXPECT_EQ(typed_args[2].u, 0xFFFFFFFFu);
+    EXPECT_FLOAT_EQ(typed_args[3].f, -1.0f);
+    EXPECT_EQ(typed_args[4].u, 0u);
+    EXPECT_FALSE(typed_args[6].present);
+    EXPECT_EQ(typed_args[6].len, 0);
+
+    // Invalid arguments are answered by the console, the command is not called.
+    typed_args = NULL;
+    EXPECT_EQ(execute("typed 101 0 0 0 on x\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument int\"\n");
+    EXPECT_EQ(execute("typed 1 -1 0 0 on x\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument uint\"\n");
+    EXPECT_EQ(execute("typed 1 4294967296 0 0 on x\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument uint\"\n");
+    EXPECT_EQ(execute("typed 1 1 0x 0 on x\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument hex\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1.5x on x\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument float\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 onn x\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument mode\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 on \"\"\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument name\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 on x 0G\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument data\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 on x 123\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument data\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 on x 0102030405\n"), "res 1 \"PARAM_ERROR\" \"Invalid argument data\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 on\n"), "res 1 \"PARAM_ERROR\" \"Missing argument name\"\n");
+    EXPECT_EQ(execute("typed 1 1 1 1 on x 00 extra\n"), "res 1 \"PARAM_ERROR\" \"Too many arguments\"\n");
+    EXPECT_EQ(typed_args, nullptr);
+
+    console_remove_command(&c);
+}
+
+TEST_F(console_test, args_schema_crc)
+{
+    console_command_t c = make_command("typed", (void*)cmd_typed);
+    crc_t crc;
+    char hex[8];
+    c.args_schema = schema_args;
+    c.num_args_schema = 7;
+    console_add_command(&c);
+    crc_init_handler(&crc, 0x1021, 0xFFFF, 0x0000);
+
+    // The crc at the end of a valid line is not parsed as an argument.
+    std::string body = "typed 5 6 7 8 on name 0102 ";
+    snprintf(hex, sizeof(hex), "%04X", crc_calc(&crc, (const uint8_t*)body.data(), (uint16_t)body.size()));
+    typed_args = NULL;
+    execute(body + hex + "\n");
+    ASSERT_NE(typed_args, nullptr);
+    EXPECT_EQ(typed_args[0].i, 5);
+    EXPECT_EQ(std::string(typed_args[5].str, typed_args[5].len), "name");
+    EXPECT_EQ(typed_bytes, std::vector<uint8_t>({0x01, 0x02}));
+
+    // Also without the optional argument, which leaves the crc directly behind the last argument.
+    body = "typed 5 6 7 8 on name ";
+    snprintf(hex, sizeof(hex), "%04X", crc_calc(&crc, (const uint8_t*)body.data(), (uint16_t)body.size()));
+    typed_args = NULL;
+    execute(body + hex + "\n");
+    ASSERT_NE(typed_args, nullptr);
+    EXPECT_FALSE(typed_args[6].present);
+
+    console_remove_command(&c);
+}
+
+static std::vector<bool> arena_used_on_entry;
+
+static FUNCTION_RETURN cmd_arena(console_data_t* data, char** args, uint8_t args_len)
+{
+    size_t len = args_len > 0 ? strtoul(args[0], NULL, 10) : 0;
+    arena_used_on_entry.push_back(data->arena_used != 0);
+
+    void* scratch = console_arena_alloc(data, 3);
+    EXPECT_NE(scratch, nullptr);
+    EXPECT_EQ((uintptr_t)scratch % 8, 0u);
+
+    std::string text(len, 'x');
+    FUNCTION_RETURN ret = console_set_response_dynamic(data, FUNCTION_RETURN_OK, len + 1, "%s", text.c_str());
+    // Short responses are created in the arena, long ones in heap.
+    EXPECT_EQ(data->message_heap, len + 1 + 8 > CONSOLE_RESPONSE_ARENA_SIZE);
+    return ret;
+}
+
+TEST_F(console_test, response_arena)
+{
+    console_command_t c = make_command("arena", (void*)cmd_arena);
+    c.use_array_param = true;
+    console_add_command(&c);
+
+    arena_used_on_entry.clear();
+    std::string big(CONSOLE_RESPONSE_ARENA_SIZE, 'x');
+    EXPECT_EQ(execute("arena 5\narena " + std::to_string(big.size()) + "\narena 0\n"),
+              "res 0 \"OK\" \"xxxxx\"\nres 0 \"OK\" \"" + big + "\"\nres 0 \"OK\" \"\"\n");
+    // The arena is empty when each command starts.
+    EXPECT_EQ(arena_used_on_entry, std::vector<bool>({false, false, false}));
+
+    // Allocations fail when the arena is full and the arena can be used completely.
+    EXPECT_EQ(console_arena_alloc(&console, CONSOLE_RESPONSE_ARENA_SIZE + 1), nullptr);
+    console.arena_used = 0;
+    EXPECT_NE(console_arena_alloc(&console, CONSOLE_RESPONSE_ARENA_SIZE - 8), nullptr);
+    EXPECT_NE(console_arena_alloc(&console, 8), nullptr);
+    EXPECT_EQ(console_arena_alloc(&console, 1), nullptr);
+    console.arena_used = 0;
+
+    console_remove_command(&c);
+}
+
+TEST_F(console_test, sessions)
+{
+    test_comm_s io2;
+    comm_t comm2 = {};
+    console_data_t console2 = {};
+    comm2.device_handler = &io2;
+    comm2.interface = &test_interface;
+    console_init(&console2, &comm2);
+
+    console_command_t c = make_command("tok", (void*)cmd_array);
+    c.use_array_param = true;
+    console_add_command(&c);
+
+    // A client sending many lines does not block the other session.
+    for(int i = 0; i < 100; i++)
+        io.rx += "tok a b\n";
+    io2.rx = "tok x\n";
+
+    int rounds = 0;
+    size_t lines_first = 0;
+    while(io2.tx.empty())
+    {
+        console.task.f_handle(&console);
+        console2.task.f_handle(&console2);
+        rounds++;
+    }
+    lines_first = std::count(io.tx.begin(), io.tx.end(), '\n');
+    EXPECT_EQ(rounds, 1);
+    EXPECT_EQ(lines_first, (size_t)CONSOLE_MAX_LINES_PER_CALL);
+    EXPECT_EQ(io2.tx, "res 0 \"OK\" \"1\"\n");
+
+    // The remaining lines stay in the receive buffer until the next call.
+    while(test_available(&io) > 0)
+        console.task.f_handle(&console);
+    EXPECT_EQ((size_t)std::count(io.tx.begin(), io.tx.end(), '\n'), 100u);
+
+    // A line that is received partially on one session is not affected by the other session.
+    io.rx = "tok 1 ";
+    io.rx_pos = 0;
+    io.tx.clear();
+    console.task.f_handle(&console);
+    io2.rx = "tok 2 3 4\n";
+    io2.rx_pos = 0;
+    io2.tx.clear();
+    console2.task.f_handle(&console2);
+    io.rx = "5\n";
+    io.rx_pos = 0;
+    console.task.f_handle(&console);
+    EXPECT_EQ(io.tx, "res 0 \"OK\" \"2\"\n");
+    EXPECT_EQ(io2.tx, "res 0 \"OK\" \"3\"\n");
+
+    console_remove_command(&c);
+    console_stop(&console2);
+}
+
+TEST_F(console_test, dispatch_many_commands)
+{
+    const size_t count = 150;
+    std::vector<std::string> names(count);
+    std::vector<console_command_t> cmds(count);
+    std::string lines;
+
+    for(size_t i = 0; i < count; i++)
+    {
+        names[i] = "bench_command_" + std::to_string(i);
+        cmds[i] = make_command(names[i].c_str(), (void*)cmd_a);
+        console_add_command(&cmds[i]);
+    }
+    for(size_t i = 0; i < 2000; i++)
+        lines += names[(i * 37) % count] + " arg\n";
+
+    calls_a = 0;
+    execute(lines);
+    EXPECT_EQ(calls_a, 2000);
+
+    for(size_t i = 0; i < count; i++)
+        console_remove_command(&cmds[i]);
+}
+
+/// Host side of the batch mode on a virtual comm loopback.
+class console_batch_test : public ::testing::Test
+{
+protected:
+    vcomm_init_t init = {};
+    vcomm_handle_t vcomm = NULL;
+    console_data_t console = {};
+    crc_t crc;
+    /// Data the console wrote that is not parsed yet.
+    std::string host_rx;
+
+    static void output(vcomm_handle_t v, uint8_t* buffer, size_t length)
+    {
+        ((console_batch_test*)vcomm_get_user(v))->host_rx.append((const char*)buffer, length);
+    }
+
+    void SetUp() override
+    {
+        init.user = this;
+        init.rx_buffer_size = 1024;
+        init.output_cb = output;
+        vcomm = vcomm_create(&init);
+        ASSERT_TRUE(vcomm != NULL);
+        console_init(&console, vcomm_get_comm(vcomm));
+        crc_init_handler(&crc, 0x1021, 0xFFFF, 0x0000);
+    }
+
+    void TearDown() override
+    {
+        console_stop(&console);
+        vcomm_free(vcomm);
+    }
+
+    /// Creates "#<seq> <cmd> <crc>\n".
+    std::string batch_line(uint16_t seq, const std::string& cmd)
+    {
+        char hex[8];
+        std::string body = "#" + std::to_string(seq) + " " + cmd + " ";
+        snprintf(hex, sizeof(hex), "%04X", crc_calc(&crc, (const uint8_t*)body.data(), (uint16_t)body.size()));
+        return body + hex + "\n";
+    }
+
+    void send(const std::string& s)
+    {
+        size_t len = s.size();
+        ASSERT_EQ(vcomm_input(vcomm, (uint8_t*)s.data(), &len), FUNCTION_RETURN_OK);
+        ASSERT_EQ(len, s.size()) << "receive buffer overflow";
+    }
+
+    /// Returns the next complete line the console wrote or an empty string.
+    std::string receive_line()
+    {
+        size_t pos = host_rx.find('\n');
+        if(pos == std::string::npos)
+            return "";
+        std::string line = host_rx.substr(0, pos);
+        host_rx.erase(0, pos + 1);
+        return line;
+    }
+};
+
+static std::vector<std::string> batch_executed;
+
+static FUNCTION_RETURN cmd_batch_echo(console_data_t* data, char* line)
+{
+    batch_executed.push_back(line);
+    return console_set_response_dynamic(data, FUNCTION_RETURN_OK, 32, "ok %s", line);
+}
+
+TEST_F(console_batch_test, pipelined)
+{
+    const size_t count = 1000;
+    const uint16_t corrupt = 37;
+    console_command_t echo = make_command("echo", (void*)cmd_batch_echo);
+    std::vector<std::string> results(count);
+    size_t base = 0, next = 0, outstanding = 0, rounds = 0, resent = 0;
+    bool corrupted = false;
+
+    console_add_command(&echo);
+    batch_executed.clear();
+
+    // The batch command resets the sequence and tells the window size.
+    send("batch\n");
+    console.task.f_handle(&console);
+    EXPECT_EQ(receive_line(), "res 0 \"OK\" \"" + std::to_string(CONSOLE_BATCH_WINDOW) + "\"");
+
+    while(base < count)
+    {
+        // Send until the window is full. Every line gets exactly one response.
+        while(next < count && outstanding < CONSOLE_BATCH_WINDOW)
+        {
+            std::string line = batch_line((uint16_t)next, "echo " + std::to_string(next));
+            if(next == corrupt && !corrupted)
+            {
+                corrupted = true;
+                line[line.size() - 7] ^= 1;
+            }
+            send(line);
+            next++;
+            outstanding++;
+        }
+
+        console.task.f_handle(&console);
+        rounds++;
+
+        for(std::string line = receive_line(); !line.empty(); line = receive_line())
+        {
+            unsigned seq = 0;
+            int ret = -1;
+            char msg[64] = {0};
+            ASSERT_EQ(sscanf(line.c_str(), "#%u res %d \"%*[^\"]\" \"%63[^\"]\"", &seq, &ret, msg), 3) << line;
+            outstanding--;
+
+            // Responses of lines that were sent after a failed line are ignored, they are sent again.
+            if(seq != (uint16_t)base)
+                continue;
+
+            if(ret != FUNCTION_RETURN_OK)
+            {
+                EXPECT_EQ(seq, corrupt);
+                EXPECT_STREQ(msg, "Invalid CRC");
+                resent += next - base;
+                next = base;
+                continue;
+            }
+            results[base++] = msg;
+        }
+    }
+    EXPECT_EQ(outstanding, 0u);
+
+    // Every command was executed once and in order.
+    ASSERT_EQ(batch_executed.size(), count);
+    for(size_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(batch_executed[i], std::to_string(i));
+        EXPECT_EQ(results[i], "ok " + std::to_string(i));
+    }
+    EXPECT_GT(resent, 0u);
+    EXPECT_LT(rounds, count / 4);
+
+    console_remove_command(&echo);
+}
+
+TEST_F(console_batch_test, errors)
+{
+    console_command_t echo = make_command("echo", (void*)cmd_batch_echo);
+    const char* whitelist[] = {"echo", "batch"};
+
+    console_add_command(&echo);
+    send("batch\n");
+    console.task.f_handle(&console);
+    receive_line();
+
+    // Unknown and not whitelisted commands are answered as well.
+    send(batch_line(0, "unknown_command"));
+    console.task.f_handle(&console);
+    EXPECT_EQ(receive_line(), "#0 res 4 \"NOT_FOUND\" \"Invalid Command\"");
+
+    console_set_whitelist(&console, whitelist, 2);
+    send(batch_line(1, "help"));
+    console.task.f_handle(&console);
+    EXPECT_EQ(receive_line(), "#1 res 6 \"UNAUTHORIZED\" \"Not whitelisted\"");
+    console_set_whitelist(&console, NULL, 0);
+
+    // A missing line is reported with the expected sequence number.
+    send(batch_line(3, "echo 3"));
+    console.task.f_handle(&console);
+    EXPECT_EQ(receive_line(), "#3 res 2 \"NOT_READY\" \"Expected #2\"");
+
+    // Lines without crc are not executed
+    send("#2 echo 2\n");
+    console.task.f_handle(&console);
+    EXPECT_EQ(receive_line(), "#2 res 1 \"PARAM_ERROR\" \"Invalid CRC\"");
+
+    send(batch_line(2, "echo    2"));
+    console.task.f_handle(&console);
+    EXPECT_EQ(receive_line(), "#2 res 0 \"OK\" \"ok 2\"");
+
+    console_remove_command(&echo);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/base64.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+static std::vector<uint8_t> make_data(size_t len)
+{
+    std::vector<uint8_t> data(len);
+
+    for(size_t i = 0; i < len; i++)
+        data[i] = (uint8_t)(i * 131 + (i >> 7));
+
+    return data;
+}
+
+static std::string encode_stream(const std::vector<uint8_t>& data, size_t chunk)
+{
+    std::vector<uint8_t> out(BASE64_ENCODE_STREAM_SIZE(data.size()) + 4);
+    base64_stream_t s;
+    uint32_t len = 0;
+
+    base64_stream_init(&s);
+    for(size_t i = 0; i < data.size(); i += chunk)
+        len += base64_encode_stream(&s, &data[i], std::min(chunk, data.size() - i), &out[len]);
+    len += base64_encode_stream_finish(&s, &out[len]);
+
+    return std::string(out.begin(), out.begin() + len);
+}
+
+static int32_t decode_stream(const std::string& str, size_t chunk, std::vector<uint8_t>& out)
+{
+    base64_stream_t s;
+    uint32_t len = 0;
+    int32_t ret;
+
+    out.resize(BASE64_DECODE_STREAM_SIZE(str.size()) + 3);
+    base64_stream_init(&s);
+    for(size_t i = 0; i < str.size(); i += chunk)
+        len += base64_decode_stream(&s, (const uint8_t*)&str[i], std::min(chunk, str.size() - i), &out[len]);
+
+    ret = base64_decode_stream_finish(&s, &out[len]);
+    if(ret < 0)
+        return ret;
+
+    out.resize(len + ret);
+    return out.size();
+}
+
+TEST(convert_base64, encode_stream)
+{
+    EXPECT_EQ(encode_stream({'f'}, 1), "Zg==");
+    EXPECT_EQ(encode_stream({'f', 'o'}, 1), "Zm8=");
+    EXPECT_EQ(encode_stream({'f', 'o', 'o', 'b', 'a', 'r'}, 4), "Zm9vYmFy");
+
+    for(size_t len : {1, 2, 3, 4, 5, 100, 1000})
+    {
+        std::vector<uint8_t> data = make_data(len);
+        std::vector<uint8_t> out(BASE64_ENCODE_STREAM_SIZE(len));
+        uint32_t ret = base64_encodebuffer(data.data(), out.data(), len);
+        std::string expected(out.begin(), out.begin() + ret);
+
+        for(size_t chunk : {1, 2, 3, 7, 64, 1000})
+            EXPECT_EQ(encode_stream(data, chunk), expected) << "len " << len << " chunk " << chunk;
+    }
+}
+
+TEST(convert_base64, decode_stream)
+{
+    std::vector<uint8_t> out;
+
+    for(size_t len : {1, 2, 3, 4, 5, 100, 1000})
+    {
+        std::vector<uint8_t> data = make_data(len);
+        std::string str = encode_stream(data, len);
+
+        for(size_t chunk : {1, 2, 3, 5, 64, 2000})
+        {
+            EXPECT_EQ(decode_stream(str, chunk, out), (int32_t)len) << "len " << len << " chunk " << chunk;
+            EXPECT_EQ(out, data);
+        }
+    }
+}
+
+TEST(convert_base64, decode_stream_format)
+{
+    std::vector<uint8_t> out;
+
+    // Line breaks and whitespace are skipped
+    ASSERT_EQ(decode_stream("Zm9v\r\nYmFy\n YQ==", 3, out), 7);
+    EXPECT_EQ(std::string(out.begin(), out.end()), "foobara");
+
+    // Without padding
+    ASSERT_EQ(decode_stream("Zm9vYmE", 16, out), 5);
+    EXPECT_EQ(std::string(out.begin(), out.end()), "fooba");
+
+    EXPECT_EQ(decode_stream("Zm9v*mFy", 16, out), -1);
+    EXPECT_EQ(decode_stream("Zm=v", 16, out), -1);
+    EXPECT_EQ(decode_stream("Zg==Zm9v", 16, out), -1);
+    EXPECT_EQ(decode_stream("Z", 16, out), -1);
+    EXPECT_EQ(decode_stream("=", 16, out), -1);
+}
+
+TEST(convert_base64, large_buffer)
+{
+    // The buffer functions use 16-bit counters, so the encoded size has to stay below 64 KiB.
+    const size_t len = 30000;
+    std::vector<uint8_t> data = make_data(len);
+    std::vector<uint8_t> encoded(BASE64_ENCODE_STREAM_SIZE(len)), encoded_stream(BASE64_ENCODE_STREAM_SIZE(len));
+    std::vector<uint8_t> decoded(len + 3);
+    base64_stream_t s;
+    uint32_t enc_len, stream_len, dec_len;
+
+    // Buffer and stream functions give the same result
+    enc_len = base64_encodebuffer(data.data(), encoded.data(), len);
+    base64_stream_init(&s);
+    stream_len = base64_encode_stream(&s, data.data(), len, encoded_stream.data());
+    stream_len += base64_encode_stream_finish(&s, &encoded_stream[stream_len]);
+    ASSERT_EQ(enc_len, stream_len);
+    EXPECT_EQ(memcmp(encoded.data(), encoded_stream.data(), enc_len), 0);
+
+    dec_len = base64_decodebuffer(encoded.data(), decoded.data(), enc_len);
+    ASSERT_EQ(dec_len, len);
+    EXPECT_EQ(std::vector<uint8_t>(decoded.begin(), decoded.begin() + len), data);
+
+    base64_stream_init(&s);
+    dec_len = base64_decode_stream(&s, encoded.data(), enc_len, decoded.data());
+    dec_len += base64_decode_stream_finish(&s, &decoded[dec_len]);
+    ASSERT_EQ(dec_len, len);
+    decoded.resize(len);
+    EXPECT_EQ(decoded, data);
+}
@@ -0,0 +1,2 @@
+// Runs the base64 tests again with BASE64_USE_LARGE_TABLE, which is enabled by the test config for this test.
+#include "convert_base64.cpp"
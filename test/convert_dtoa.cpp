@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+extern "C"
+{
+    #include "module/convert/dtoa.h"
+    #include "module/convert/string.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+static uint64_t random_state = 88172645463325252ULL;
+
+static uint64_t random_u64(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+static double random_double(void)
+{
+    uint64_t bits;
+    double v;
+
+    do
+    {
+        bits = random_u64();
+        memcpy(&v, &bits, sizeof(v));
+    }while(!std::isfinite(v));
+
+    return v;
+}
+
+static std::string double_string(double v, int8_t precision = -1, bool use_exponent = false)
+{
+    char str[DTOA_STRING_SIZE];
+    char* end = dtoa_create_double_string(str, v, precision, use_exponent);
+
+    EXPECT_LT(end - str, DTOA_STRING_SIZE);
+    EXPECT_EQ(strlen(str), (size_t)(end - str));
+    return str;
+}
+
+static std::string float_string(float v, int8_t precision = -1)
+{
+    char str[DTOA_STRING_SIZE];
+
+    dtoa_create_float_string(str, v, precision, false);
+    return str;
+}
+
+TEST(convert_dtoa, create_double_string)
+{
+    EXPECT_EQ(double_string(0.0), "0");
+    EXPECT_EQ(double_string(-0.0), "-0");
+    EXPECT_EQ(double_string(0.1), "0.1");
+    EXPECT_EQ(double_string(-1.5), "-1.5");
+    EXPECT_EQ(double_string(100), "100");
+    EXPECT_EQ(double_string(123456.789), "123456.789");
+    EXPECT_EQ(double_string(0.000001), "0.000001");
+    EXPECT_EQ(double_string(1.5e-7), "1.5e-7");
+    EXPECT_EQ(double_string(1e21), "1e21");
+    EXPECT_EQ(double_string(123e18), "123000000000000000000");
+    EXPECT_EQ(double_string(DBL_MAX), "1.7976931348623157e308");
+    EXPECT_EQ(double_string(DBL_MIN), "2.2250738585072014e-308");
+    EXPECT_EQ(double_string(5e-324), "5e-324");
+    EXPECT_EQ(double_string(INFINITY), "inf");
+    EXPECT_EQ(double_string(-INFINITY), "-inf");
+    EXPECT_EQ(double_string(NAN), "nan");
+}
+
+TEST(convert_dtoa, create_double_string_precision)
+{
+    EXPECT_EQ(double_string(3.14159, 2), "3.14");
+    EXPECT_EQ(double_string(2.675, 2), "2.67");	// 2.67499999999999982236431605997495353221893310546875
+    EXPECT_EQ(double_string(345.88499999999999, 2), "345.88");
+    EXPECT_EQ(double_string(0.125, 2), "0.12");	// Exact ties are rounded to the even digit
+    EXPECT_EQ(double_string(0.375, 2), "0.38");
+    EXPECT_EQ(double_string(0.5, 0), "0");
+    EXPECT_EQ(double_string(0.5000000000000001, 0), "1");
+    EXPECT_EQ(double_string(0.05, 0), "0");
+    EXPECT_EQ(double_string(9.999, 2), "10.00");
+    EXPECT_EQ(double_string(-0.4, 0), "-0");
+    EXPECT_EQ(double_string(0.6, 0), "1");
+    EXPECT_EQ(double_string(1e-10, 3), "0.000");
+    EXPECT_EQ(double_string(0, 3), "0.000");
+    EXPECT_EQ(double_string(12, 30), "12.00000000000000000");
+    EXPECT_EQ(double_string(1234.5, 3, true), "1.234e3");
+    EXPECT_EQ(double_string(9.9996e-5, 2, true), "1.00e-4");
+    EXPECT_EQ(double_string(-DBL_MAX, 17), "-1.79769313486231571e308");
+    EXPECT_EQ(double_string(5e-324, 17, true), "4.94065645841246544e-324");
+    EXPECT_EQ(double_string(1e21, 17), "1.00000000000000000e21");
+    EXPECT_EQ(double_string(0, -1, true), "0e0");
+}
+
+TEST(convert_dtoa, create_float_string)
+{
+    EXPECT_EQ(float_string(0.1f), "0.1");
+    EXPECT_EQ(float_string(16777216.0f), "16777216");
+    EXPECT_EQ(float_string(FLT_MAX), "3.4028235e38");
+    EXPECT_EQ(float_string(FLT_MIN), "1.1754944e-38");
+    EXPECT_EQ(float_string(1e-45f), "1e-45");
+    EXPECT_EQ(float_string(-21.53f, 1), "-21.5");
+}
+
+/// Formats v with snprintf and writes the exponent like dtoa without '+' and leading zeros.
+static std::string printf_string(double v, int precision, bool use_exponent)
+{
+    char ref[400];
+    char* e;
+
+    snprintf(ref, sizeof(ref), use_exponent ? "%.*e" : "%.*f", precision, v);
+    e = strchr(ref, 'e');
+    if(e)
+        sprintf(e + 1, "%ld", strtol(e + 1, NULL, 10));
+    return ref;
+}
+
+TEST(convert_dtoa, precision_compare_printf)
+{
+    for(int i = 0; i < 200000; i++)
+    {
+        // Values around the decimal point and values from the whole range
+        double v = (i & 1) ? random_double() : (double)(int64_t)random_u64() * pow(10, (int)(random_u64() % 60) - 45);
+        int precision = random_u64() % (DTOA_MAX_PRECISION + 1);
+
+        ASSERT_EQ(double_string(v, precision, true), printf_string(v, precision, true)) << precision;
+        if(fabs(v) < 1e21)
+            ASSERT_EQ(double_string(v, precision), printf_string(v, precision, false)) << precision;
+
+        float f = (float)v;
+        if(std::isfinite(f) && fabsf(f) < 1e21f)
+            ASSERT_EQ(float_string(f, precision), printf_string(f, precision, false)) << precision;
+    }
+
+    // Exact ties of small integers and halves
+    for(int i = 0; i < 2000; i++)
+    {
+        double v = i / 8.0;
+        for(int precision = 0; precision < 4; precision++)
+        {
+            ASSERT_EQ(double_string(v, precision), printf_string(v, precision, false));
+            ASSERT_EQ(double_string(v, precision, true), printf_string(v, precision, true));
+        }
+    }
+}
+
+TEST(convert_dtoa, round_trip)
+{
+    char str[DTOA_STRING_SIZE];
+    char* end;
+    int longer = 0;
+    const int count = 100000;
+
+    for(int i = 0; i < count; i++)
+    {
+        double v = random_double();
+        float f = (float)random_double();
+        int shortest;
+
+        char* str_end = dtoa_create_double_string(str, v, -1, false);
+        ASSERT_EQ(dtoa_parse_double(str, &end), v) << str;
+        ASSERT_EQ(end, str_end);
+        ASSERT_EQ(strtod(str, NULL), v) << str;
+
+        // Grisu2 is not always the shortest
+        for(shortest = 1; shortest < 17; shortest++)
+        {
+            char ref[40];
+            snprintf(ref, sizeof(ref), "%.*g", shortest, v);
+            if(strtod(ref, NULL) == v)
+                break;
+        }
+        // Significant digits without leading and trailing zeros
+        std::string digits;
+        for(char* p = str; *p && *p != 'e'; p++)
+        {
+            if(*p >= '0' && *p <= '9' && (*p != '0' || !digits.empty()))
+                digits += *p;
+        }
+        digits.erase(digits.find_last_not_of('0') + 1);
+        if((int)digits.size() > shortest)
+            longer++;
+
+        if(std::isfinite(f))
+        {
+            dtoa_create_float_string(str, f, -1, false);
+            ASSERT_EQ(dtoa_parse_float(str, NULL), f) << str;
+            ASSERT_EQ(strtof(str, NULL), f) << str;
+        }
+    }
+
+    EXPECT_LT(longer, count / 1000);
+}
+
+TEST(convert_dtoa, parse)
+{
+    char* end;
+    const char* str;
+
+    str = "  -12.5e3xyz";
+    EXPECT_EQ(dtoa_parse_double(str, &end), -12500.0);
+    EXPECT_EQ(end, str + 9);
+
+    str = "1e";
+    EXPECT_EQ(dtoa_parse_double(str, &end), 1.0);
+    EXPECT_EQ(end, str + 1);
+
+    str = "abc";
+    EXPECT_EQ(dtoa_parse_double(str, &end), 0.0);
+    EXPECT_EQ(end, str);
+
+    str = ".";
+    EXPECT_EQ(dtoa_parse_double(str, &end), 0.0);
+    EXPECT_EQ(end, str);
+
+    EXPECT_EQ(dtoa_parse_double(".5", NULL), 0.5);
+    EXPECT_EQ(dtoa_parse_double("+7.", NULL), 7.0);
+    EXPECT_EQ(dtoa_parse_double("0.000000000000000000000000000001", NULL), 1e-30);
+    EXPECT_EQ(dtoa_parse_double("1e400", NULL), INFINITY);
+    EXPECT_EQ(dtoa_parse_double("-1e-400", NULL), -0.0);
+    EXPECT_TRUE(std::signbit(dtoa_parse_double("-0", NULL)));
+    EXPECT_EQ(dtoa_parse_double("-Infinity", NULL), -INFINITY);
+    EXPECT_TRUE(std::isnan(dtoa_parse_double("NaN", NULL)));
+    EXPECT_EQ(dtoa_parse_double("4.9406564584124654e-324", NULL), 5e-324);
+    EXPECT_EQ(dtoa_parse_double("2.4703282292062328e-324", NULL), 5e-324);
+    EXPECT_EQ(dtoa_parse_double("2.4703282292062327e-324", NULL), 0.0);
+    EXPECT_EQ(dtoa_parse_double("1.7976931348623158e308", NULL), DBL_MAX);
+    EXPECT_EQ(dtoa_parse_double("9007199254740993", NULL), 9007199254740992.0);
+    EXPECT_EQ(dtoa_parse_double("123456789012345678901234567890", NULL), 123456789012345678901234567890.0);
+    EXPECT_EQ(dtoa_parse_float("3.4028235e38", NULL), FLT_MAX);
+    EXPECT_EQ(dtoa_parse_float("1e39", NULL), INFINITY);
+    EXPECT_EQ(dtoa_parse_float("1.00000005960464477539062500001", NULL), 1.00000012f);
+}
+
+TEST(convert_dtoa, parse_compare_strtod)
+{
+    char str[64];
+
+    for(int i = 0; i < 100000; i++)
+    {
+        uint64_t r = random_u64();
+        int digits = 1 + r % 25;
+        int exp = (int)((r >> 8) % 700) - 350;
+        char* p = str;
+
+        if(r & (1ULL << 40))
+            *p++ = '-';
+        for(int j = 0; j < digits; j++)
+        {
+            *p++ = '0' + (random_u64() % 10);
+            if(j == 0 && (r & (1ULL << 41)))
+                *p++ = '.';
+        }
+        sprintf(p, "e%d", exp);
+
+        double d = dtoa_parse_double(str, NULL);
+        double d_ref = strtod(str, NULL);
+        ASSERT_EQ(memcmp(&d, &d_ref, sizeof(d)), 0) << str;
+
+        sprintf(p, "e%d", exp % 50);
+        float f = dtoa_parse_float(str, NULL);
+        float f_ref = strtof(str, NULL);
+        ASSERT_EQ(memcmp(&f, &f_ref, sizeof(f)), 0) << str;
+    }
+}
+
+TEST(convert_dtoa, printf)
+{
+    char str[100];
+
+    string_printf(str, "%f %.2f|%8.3f|%08.2f|%F|%e", 0.1, 2.675, -3.14159, -3.14159, 0.1f, 1234.5);
+    EXPECT_STREQ(str, "0.1 2.67|  -3.142|-0003.14|0.1|1.2345e3");
+
+    string_printf(str, "%.3e %u %.0f", 0.00012345, 7, 2.5);
+    EXPECT_STREQ(str, "1.234e-4 7 2");
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/math.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+template<typename T> static std::vector<T> random_array(size_t count, int64_t min, int64_t max)
+{
+    std::vector<T> arr(count);
+
+    srand(1234);
+    for(size_t i = 0; i < count; i++)
+    {
+        arr[i] = (T)(min + (int64_t)(((uint64_t)rand() * RAND_MAX + rand()) % (uint64_t)(max - min + 1)));
+    }
+    return arr;
+}
+
+TEST(math, sum)
+{
+    std::vector<uint8_t> u8(100000, 255);
+    std::vector<int8_t> i8(100000, -128);
+    std::vector<int16_t> i16 = random_array<int16_t>(70000, INT16_MIN, INT16_MAX);
+    std::vector<uint32_t> u32(10, UINT32_MAX);
+    int64_t sum_i16 = 0;
+
+    for(int16_t v : i16)
+    {
+        sum_i16 += v;
+    }
+
+    EXPECT_EQ(math_array_sum_uint8(u8.data(), u8.size()), 25500000u);
+    EXPECT_EQ(math_array_sum_int8(i8.data(), i8.size()), -12800000);
+    EXPECT_EQ(math_array_sum_int16(i16.data(), i16.size()), sum_i16);
+    // No overflow in 64-bit
+    EXPECT_EQ(math_array_sum_uint32(u32.data(), u32.size()), 10ULL * UINT32_MAX);
+    // The old functions still wrap around
+    EXPECT_EQ(math_sum_u32(u32.data(), u32.size()), (uint32_t)(10ULL * UINT32_MAX));
+    EXPECT_EQ(math_array_sum_uint32(NULL, 10), 0u);
+
+    const float f[7] = {1.5f, 2.5f, -1.0f, 4.0f, 0.25f, 0.25f, 0.5f};
+    EXPECT_FLOAT_EQ(math_array_sum_float(f, 7), 8.0f);
+}
+
+TEST(math, min_max)
+{
+    const int16_t arr[8] = {5, -3, 7, 7, -3, 0, 1, 2};
+    const float f[5] = {1.0f, -2.0f, 3.5f, -2.0f, 3.5f};
+    size_t index;
+
+    EXPECT_EQ(math_array_min_int16(arr, 8, &index), -3);
+    EXPECT_EQ(index, 1u);
+    EXPECT_EQ(math_array_max_int16(arr, 8, &index), 7);
+    EXPECT_EQ(index, 2u);
+    EXPECT_EQ(math_array_max_int16(arr, 8, NULL), 7);
+    EXPECT_EQ(math_array_min_int16(arr, 0, &index), 0);
+    EXPECT_EQ(index, 0u);
+
+    EXPECT_FLOAT_EQ(math_array_min_float(f, 5, &index), -2.0f);
+    EXPECT_EQ(index, 1u);
+    EXPECT_FLOAT_EQ(math_array_max_float(f, 5, &index), 3.5f);
+    EXPECT_EQ(index, 2u);
+
+    std::vector<uint32_t> big = random_array<uint32_t>(1001, 0, UINT32_MAX);
+    big[777] = UINT32_MAX;
+    big[500] = 0;
+    EXPECT_EQ(math_array_max_uint32(big.data(), big.size(), &index), UINT32_MAX);
+    EXPECT_LE(index, 777u);
+    EXPECT_EQ(big[index], UINT32_MAX);
+    EXPECT_EQ(math_array_min_uint32(big.data(), big.size(), &index), 0u);
+    EXPECT_EQ(big[index], 0u);
+}
+
+TEST(math, mean_variance)
+{
+    const uint8_t arr[8] = {2, 4, 4, 4, 5, 5, 7, 9};
+    const int32_t large[4] = {1000000000, 1000000002, 1000000004, 1000000006};
+    float mean;
+
+    EXPECT_FLOAT_EQ(math_array_mean_uint8(arr, 8), 5.0f);
+    EXPECT_FLOAT_EQ(math_array_variance_uint8(arr, 8, &mean), 4.0f);
+    EXPECT_FLOAT_EQ(mean, 5.0f);
+
+    // Two passes keep the precision for large values with a small spread
+    EXPECT_FLOAT_EQ(math_array_variance_int32(large, 4, NULL), 5.0f);
+
+    const float f[8] = {2, 4, 4, 4, 5, 5, 7, 9};
+    EXPECT_FLOAT_EQ(math_array_variance_float(f, 8, &mean), 4.0f);
+    EXPECT_FLOAT_EQ(math_array_mean_float(f, 8), 5.0f);
+    EXPECT_FLOAT_EQ(math_array_variance_float(f, 0, &mean), 0.0f);
+}
+
+TEST(math, dot)
+{
+    std::vector<int16_t> a = random_array<int16_t>(1003, INT16_MIN, INT16_MAX);
+    std::vector<int16_t> b = random_array<int16_t>(1003, INT16_MIN, INT16_MAX);
+    std::vector<float> fa(a.begin(), a.end()), fb(b.begin(), b.end());
+    int64_t expected = 0;
+
+    for(size_t i = 0; i < a.size(); i++)
+    {
+        expected += (int64_t)a[i] * b[i];
+    }
+
+    EXPECT_EQ(math_array_dot_int16(a.data(), b.data(), a.size()), expected);
+    EXPECT_NEAR(math_array_dot_float(fa.data(), fb.data(), fa.size()), (double)expected, std::fabs((double)expected) * 1e-5 + 1e6);
+
+    const uint32_t u[2] = {UINT32_MAX, 2};
+    EXPECT_EQ(math_array_dot_uint32(u, u, 2), (uint64_t)UINT32_MAX * UINT32_MAX + 4);
+
+    // Exact at the documented limits, results outside of the return type wrap around
+    const int32_t i32_limit[4] = {-32768, 32768, -32768, 32768};
+    const int32_t i32_min[2] = {INT32_MIN, INT32_MIN};
+    const uint32_t u32_limit[2] = {65535, 65535};
+    const uint32_t u32_max[2] = {UINT32_MAX, UINT32_MAX};
+    EXPECT_EQ(math_array_dot_int32(i32_limit, i32_limit, 4), 4LL << 30);
+    EXPECT_EQ(math_array_dot_int32(i32_min, i32_min, 1), 1LL << 62);
+    EXPECT_EQ(math_array_dot_int32(i32_min, i32_min, 2), INT64_MIN);
+    EXPECT_EQ(math_array_dot_uint32(u32_limit, u32_limit, 2), 2ULL * 65535 * 65535);
+    EXPECT_EQ(math_array_dot_uint32(u32_max, u32_max, 2), (uint64_t)UINT32_MAX * UINT32_MAX * 2);
+}
+
+TEST(math, clamp_scale)
+{
+    int16_t arr[6] = {-500, -10, 0, 10, 500, 32767};
+    const int16_t clamped[6] = {-100, -10, 0, 10, 100, 100};
+    uint8_t u8[4] = {0, 100, 200, 255};
+    uint8_t u8_out[4];
+    float f[3] = {1.0f, -2.0f, 0.5f};
+
+    math_array_clamp_int16(arr, 6, -100, 100);
+    for(int i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(arr[i], clamped[i]) << i;
+    }
+
+    // * 1.5 + 10, saturated at 255
+    math_array_scale_uint8(u8, u8_out, 4, 3 * 65536 / 2, 10);
+    EXPECT_EQ(u8_out[0], 10);
+    EXPECT_EQ(u8_out[1], 160);
+    EXPECT_EQ(u8_out[2], 255);
+    EXPECT_EQ(u8_out[3], 255);
+
+    // * -0.5 rounded, saturated at 0
+    math_array_scale_uint8(u8, u8, 4, -32768, 100);
+    EXPECT_EQ(u8[0], 100);
+    EXPECT_EQ(u8[1], 50);
+    EXPECT_EQ(u8[2], 0);
+
+    math_array_scale_float(f, f, 3, 2.0f, 1.0f);
+    EXPECT_FLOAT_EQ(f[0], 3.0f);
+    EXPECT_FLOAT_EQ(f[1], -3.0f);
+    EXPECT_FLOAT_EQ(f[2], 2.0f);
+
+    math_array_clamp_float(f, 3, -1.0f, 2.5f);
+    EXPECT_FLOAT_EQ(f[0], 2.5f);
+    EXPECT_FLOAT_EQ(f[1], -1.0f);
+}
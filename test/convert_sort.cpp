@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+extern "C"
+{
+    #include "module/convert/sort.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+#include "module/convert/sort.hpp"
+
+static uint64_t random_state = 88172645463325252ULL;
+
+static uint64_t random_u64(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/// Creates arrays with patterns that are known to be bad for quicksort.
+template<typename T>
+static std::vector<T> create_array(size_t count, int pattern)
+{
+    std::vector<T> v(count);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        switch(pattern)
+        {
+        case 0: v[i] = (T)random_u64(); break;                          // Random
+        case 1: v[i] = (T)(random_u64() % 4); break;                    // Many duplicates
+        case 2: v[i] = (T)i; break;                                     // Sorted
+        case 3: v[i] = (T)(count - i); break;                           // Reversed
+        case 4: v[i] = (T)(i < count / 2 ? i : count - i); break;       // Organ pipe
+        default: v[i] = (T)7; break;                                    // All equal
+        }
+    }
+
+    // Median of three killer: The median is always the second smallest element.
+    if(pattern == 6)
+    {
+        for(size_t i = 0; i < count; i++)
+            v[i] = (T)i;
+        for(size_t i = count; i > 1; i--)
+            std::swap(v[i - 1], v[(i - 1) / 2]);
+    }
+
+    return v;
+}
+
+template<typename T>
+static void check_type(void (*f_sort)(T*, size_t), T (*f_select)(T*, size_t, size_t), void (*f_radix)(T*, T*, size_t))
+{
+    for(size_t count : {0, 1, 2, 3, 17, 100, 1000, 5000})
+    {
+        for(int pattern = 0; pattern < 7; pattern++)
+        {
+            std::vector<T> v = create_array<T>(count, pattern);
+            std::vector<T> expected = v;
+            std::sort(expected.begin(), expected.end());
+
+            std::vector<T> sorted = v;
+            f_sort(sorted.data(), count);
+            ASSERT_EQ(sorted, expected) << "count " << count << ", pattern " << pattern;
+
+            if(f_radix)
+            {
+                std::vector<T> tmp(count);
+                sorted = v;
+                f_radix(sorted.data(), tmp.data(), count);
+                ASSERT_EQ(sorted, expected) << "radix count " << count << ", pattern " << pattern;
+            }
+
+            if(count > 0)
+            {
+                for(size_t k : {(size_t)0, count / 2, count * 9 / 10, count - 1})
+                {
+                    std::vector<T> selected = v;
+                    ASSERT_EQ(f_select(selected.data(), count, k), expected[k]);
+                    ASSERT_EQ(selected[k], expected[k]);
+                    for(size_t i = 0; i < count; i++)
+                        ASSERT_TRUE(i < k ? !(selected[k] < selected[i]) : !(selected[i] < selected[k]));
+                }
+            }
+        }
+    }
+}
+
+TEST(convert_sort, typed)
+{
+    check_type<uint8_t>(sort_uint8, sort_select_uint8, sort_radix_uint8);
+    check_type<int8_t>(sort_int8, sort_select_int8, sort_radix_int8);
+    check_type<uint16_t>(sort_uint16, sort_select_uint16, sort_radix_uint16);
+    check_type<int16_t>(sort_int16, sort_select_int16, sort_radix_int16);
+    check_type<uint32_t>(sort_uint32, sort_select_uint32, sort_radix_uint32);
+    check_type<int32_t>(sort_int32, sort_select_int32, sort_radix_int32);
+    check_type<uint64_t>(sort_uint64, sort_select_uint64, sort_radix_uint64);
+    check_type<int64_t>(sort_int64, sort_select_int64, sort_radix_int64);
+    check_type<float>(sort_float, sort_select_float, NULL);
+    check_type<double>(sort_double, sort_select_double, NULL);
+
+    EXPECT_EQ(sort_select_uint32(NULL, 0, 0), 0u);
+}
+
+TEST(convert_sort, uint32_array)
+{
+    uint32_t arr[] = {5, 3, 0xFFFFFFFF, 0, 3, 1};
+    uint32_t expected[] = {0, 1, 3, 3, 5, 0xFFFFFFFF};
+
+    sort_uint32_array(arr, 6);
+    EXPECT_EQ(memcmp(arr, expected, sizeof(arr)), 0);
+}
+
+typedef struct
+{
+    uint16_t id;
+    int32_t value;
+    char name[37];
+}sort_test_entry_t;
+
+static int compare_entry(const void* a, const void* b, void* obj)
+{
+    const sort_test_entry_t* ea = (const sort_test_entry_t*)a;
+    const sort_test_entry_t* eb = (const sort_test_entry_t*)b;
+
+    (*(int*)obj)++;
+    return ea->value < eb->value ? -1 : ea->value > eb->value;
+}
+
+TEST(convert_sort, generic)
+{
+    for(int pattern = 0; pattern < 7; pattern++)
+    {
+        std::vector<int32_t> values = create_array<int32_t>(3000, pattern);
+        std::vector<sort_test_entry_t> entries(values.size());
+        int compare_count = 0;
+
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            entries[i].id = (uint16_t)i;
+            entries[i].value = values[i];
+            snprintf(entries[i].name, sizeof(entries[i].name), "%d", (int)values[i]);
+        }
+        std::sort(values.begin(), values.end());
+
+        std::vector<sort_test_entry_t> sorted = entries;
+        sort_generic(sorted.data(), sorted.size(), sizeof(sort_test_entry_t), compare_entry, &compare_count);
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_EQ(sorted[i].value, values[i]);
+            ASSERT_EQ(atoi(sorted[i].name), values[i]);
+            ASSERT_EQ(entries[sorted[i].id].value, values[i]);
+        }
+        // O(n log n) compares, also for the median of three killer
+        EXPECT_LT(compare_count, 3000 * 12 * 3);
+
+        sorted = entries;
+        sort_test_entry_t* e = (sort_test_entry_t*)sort_select_generic(sorted.data(), sorted.size(), sizeof(sort_test_entry_t), 1500, compare_entry, &compare_count);
+        ASSERT_EQ(e, &sorted[1500]);
+        EXPECT_EQ(e->value, values[1500]);
+    }
+}
+
+TEST(convert_sort, cpp)
+{
+    std::vector<sort_test_entry_t> entries(2000);
+    std::vector<double> values = create_array<double>(2000, 0);
+    std::vector<double> expected = values;
+
+    std::sort(expected.begin(), expected.end());
+    sort_introsort(values.data(), values.size());
+    EXPECT_EQ(values, expected);
+
+    for(size_t i = 0; i < entries.size(); i++)
+        entries[i].value = (int32_t)random_u64();
+
+    sort_introsort(entries.data(), entries.size(), [](const sort_test_entry_t& a, const sort_test_entry_t& b) { return a.value > b.value; });
+    for(size_t i = 1; i < entries.size(); i++)
+        ASSERT_GE(entries[i - 1].value, entries[i].value);
+
+    values = create_array<double>(2000, 6);
+    EXPECT_EQ(sort_nth_element(values.data(), values.size(), 1000), 1000.0);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "gmock/gmock.h"
+#include <string>
+#include <vector>
 
 extern "C"
 {
@@ -112,6 +114,8 @@ TEST(convert_string, index_of_substring)
     char find[] = "ABC";
     EXPECT_EQ(string_index_of_substring(test_string, find), 4);
     EXPECT_EQ(string_index_of_substring(find, test_string), -1);
+    EXPECT_EQ(string_index_of_substring("aaab", (char*)"aab"), 1);
+    EXPECT_EQ(string_index_of_substring(test_string, zero_length_string), -1);
 }
 
 TEST(convert_string, extract_between)
@@ -180,6 +184,105 @@ TEST(convert_string, parse_hex_array)
     test_string[1] = '0';
     EXPECT_TRUE(string_parse_hex_array(test_string, target_array, 5));
     EXPECT_EQ(memcmp(target_array, expected_result, sizeof(target_array)), 0);
+    test_string[4] = 'G';
+    EXPECT_FALSE(string_parse_hex_array(test_string, target_array, 5));
+}
+
+TEST(convert_string, hex_array)
+{
+    std::vector<uint8_t> data(1000);
+    std::vector<uint8_t> decoded(1000);
+    std::string str(3 * data.size() + 1, 0);
+    std::string expected;
+    char* end;
+
+    for(size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)(i * 73 + 11);
+
+    // All lengths around the 16 byte blocks of SSE2 and NEON.
+    for(size_t len : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 1000})
+    {
+        char tmp[4];
+        expected.clear();
+        for(size_t i = 0; i < len; i++)
+        {
+            snprintf(tmp, sizeof(tmp), "%02x", data[i]);
+            expected += tmp;
+        }
+
+        string_set_hex_letter_size(false);
+        end = string_create_hex_array_string(&str[0], data.data(), len, 0);
+        EXPECT_EQ(end - &str[0], (ptrdiff_t)(2 * len));
+        EXPECT_STREQ(str.c_str(), expected.c_str());
+
+        std::fill(decoded.begin(), decoded.end(), 0);
+        EXPECT_TRUE(string_decode_hex_array(str.c_str(), 2 * len, decoded.data()));
+        EXPECT_EQ(memcmp(decoded.data(), data.data(), len), 0);
+
+        string_set_hex_letter_size(true);
+        string_create_hex_array_string(&str[0], data.data(), len, 0);
+        for(char& c : expected)
+            c = toupper(c);
+        EXPECT_STREQ(str.c_str(), expected.c_str());
+        EXPECT_TRUE(string_decode_hex_array(str.c_str(), 2 * len, decoded.data()));
+        EXPECT_EQ(memcmp(decoded.data(), data.data(), len), 0);
+
+        // Each invalid character is detected, also inside the blocks.
+        for(size_t i = 0; i < 2 * len; i += 7)
+        {
+            for(char c : {'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '\xB0'})
+            {
+                char old = str[i];
+                str[i] = c;
+                EXPECT_FALSE(string_decode_hex_array(str.c_str(), 2 * len, decoded.data())) << len << " " << i << " " << (int)c;
+                str[i] = old;
+            }
+        }
+    }
+
+    EXPECT_FALSE(string_decode_hex_array("123", 3, decoded.data()));
+    EXPECT_FALSE(string_decode_hex_array(NULL, 2, decoded.data()));
+
+    string_set_hex_letter_size(true);
+    uint8_t three[3] = {0x01, 0xAB, 0xF0};
+    end = string_create_hex_array_string(&str[0], three, 3, ':');
+    EXPECT_STREQ(str.c_str(), "01:AB:F0");
+    EXPECT_EQ(*end, 0);
+    EXPECT_EQ(end - &str[0], 8);
+    string_create_hex_array_string(&str[0], three, 0, ':');
+    EXPECT_STREQ(str.c_str(), "");
+
+    // Arrays that are longer than a block are printed completely.
+    char printed[3 * 40 + 1];
+    EXPECT_EQ(string_printf(printed, "%#a", 40, data.data()), 3 * 40 - 1);
+    string_set_hex_letter_size(false);
+    string_create_hex_array_string(&str[0], data.data(), 40, ' ');
+    EXPECT_STREQ(printed, str.c_str());
+    EXPECT_EQ(string_printf(printed, "%#Q", 40, data.data()), 2 * 40);
+    string_set_hex_letter_size(true);
+    string_create_hex_array_string(&str[0], data.data(), 40, 0);
+    EXPECT_STREQ(printed, str.c_str());
+}
+
+TEST(convert_string, hex_array_large_buffer)
+{
+    const size_t size = 1 << 16;
+    std::vector<uint8_t> data(size);
+    std::vector<uint8_t> decoded(size);
+    std::vector<char> str(2 * size + 1);
+
+    for(size_t i = 0; i < size; i++)
+        data[i] = (uint8_t)(i * 31);
+
+    string_create_hex_array_string(str.data(), data.data(), size, 0);
+    EXPECT_EQ(strlen(str.data()), 2 * size);
+    ASSERT_TRUE(string_decode_hex_array(str.data(), 2 * size, decoded.data()));
+    EXPECT_EQ(decoded, data);
+
+    // Same result as decoding nibble by nibble
+    for(size_t j = 0; j < size; j++)
+        decoded[j] = (string_ascii_to_uint8(str[2 * j]) << 4) + string_ascii_to_uint8(str[2 * j + 1]);
+    EXPECT_EQ(decoded, data);
 }
 
 TEST(convert_string, case_conversions)
@@ -241,6 +344,60 @@ TEST(convert_string, num_strings)
     EXPECT_STREQ(result_string, "0111111111111111111111111111111111111111111111111111111111111111");
 }
 
+TEST(convert_string, num_strings_compare_printf)
+{
+    char result_string[70];
+    char expected[70];
+    uint64_t v = 1;
+
+    // Powers of 10 and 16 and their neighbours are the borders of the digit count.
+    for(int i = 0; i < 20; i++, v *= 10)
+    {
+        for(uint64_t x : {v - 1, v, v + 1, v * 16 / 10, (v << 4) - 1})
+        {
+            string_create_uint64_string(result_string, x, 10, 0, false);
+            snprintf(expected, sizeof(expected), "%llu", (unsigned long long)x);
+            EXPECT_STREQ(result_string, expected);
+
+            string_create_uint64_string(result_string, x, 16, 0, false);
+            snprintf(expected, sizeof(expected), "%llX", (unsigned long long)x);
+            EXPECT_STREQ(result_string, expected);
+
+            string_create_int64_string(result_string, -(int64_t)(x >> 1), 10, 22, true);
+            snprintf(expected, sizeof(expected), "%022lld", -(long long)(x >> 1));
+            EXPECT_STREQ(result_string, expected);
+
+            string_create_uint_string(result_string, (uint32_t)x, 10, 12, false);
+            snprintf(expected, sizeof(expected), "%12u", (uint32_t)x);
+            EXPECT_STREQ(result_string, expected);
+
+            string_create_int_string(result_string, (int32_t)x, 10, 0, false);
+            snprintf(expected, sizeof(expected), "%d", (int32_t)x);
+            EXPECT_STREQ(result_string, expected);
+
+            string_create_uint_string(result_string, (uint32_t)x, 16, 8, true);
+            snprintf(expected, sizeof(expected), "%08X", (uint32_t)x);
+            EXPECT_STREQ(result_string, expected);
+        }
+    }
+
+    string_create_uint64_string(result_string, UINT64_MAX, 10, 0, false);
+    EXPECT_STREQ(result_string, "18446744073709551615");
+    string_create_uint64_string(result_string, 0x100000000ULL, 16, 0, false);
+    EXPECT_STREQ(result_string, "100000000");
+    string_create_uint64_string(result_string, 0x1000000000ULL, 10, 0, false);
+    EXPECT_STREQ(result_string, "68719476736");
+    string_create_uint_string(result_string, 0, 16, 0, false);
+    EXPECT_STREQ(result_string, "0");
+    string_create_uint_string(result_string, 255, 8, 0, false);
+    EXPECT_STREQ(result_string, "377");
+
+    string_set_hex_letter_size(false);
+    string_create_uint64_string(result_string, 0xABCDEF0123456789ULL, 16, 0, false);
+    EXPECT_STREQ(result_string, "abcdef0123456789");
+    string_set_hex_letter_size(true);
+}
+
 TEST(convert_string, ends_with)
 {
     char str[] = "TeststringESoPe";
@@ -329,6 +486,86 @@ TEST(convert_string, strstr_end)
     EXPECT_EQ(string_strstr_end(test_string, find_invalid), nullptr);
 }
 
+static const char* naive_find(const char* str, size_t str_len, const char* find, size_t find_len, bool ignore_case)
+{
+    for(size_t i = 0; i + find_len <= str_len; i++)
+    {
+        size_t j = 0;
+        while(j < find_len && (ignore_case ? tolower(str[i + j]) == tolower(find[j]) : str[i + j] == find[j]))
+            j++;
+        if(j == find_len)
+            return str + i;
+    }
+    return NULL;
+}
+
+TEST(convert_string, find_substring)
+{
+    const char data[] = "abc\0AbCd\0x";
+    const char alphabet[] = "abAB.";
+    uint32_t seed = 1;
+    std::string str, find;
+
+    EXPECT_EQ(string_find_substring(data, sizeof(data) - 1, "bcd", 3, false), nullptr);
+    EXPECT_EQ(string_find_substring(data, sizeof(data) - 1, "bcd", 3, true), &data[5]);
+    EXPECT_EQ(string_find_substring(data, sizeof(data) - 1, "d\0x", 3, false), &data[7]);
+    EXPECT_EQ(string_find_substring(data, sizeof(data) - 1, "x", 0, false), nullptr);
+    EXPECT_EQ(string_find_substring(data, 3, "abc\0", 4, false), nullptr);
+
+    // Small alphabets create many periodic patterns and partial matches. Long patterns exceed the 255 limit of the
+    // shift table.
+    for(int i = 0; i < 20000; i++)
+    {
+        size_t str_len, find_len;
+
+        seed = seed * 1103515245 + 12345;
+        str_len = (seed >> 8) % (i < 19000 ? 64 : 1024);
+        seed = seed * 1103515245 + 12345;
+        find_len = 1 + (seed >> 8) % (i < 19000 ? 8 : 300);
+
+        str.resize(str_len);
+        find.resize(find_len);
+        for(size_t j = 0; j < str_len; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            str[j] = alphabet[(seed >> 16) % (i & 1 ? 2 : 5)];
+        }
+        seed = seed * 1103515245 + 12345;
+        if(str_len >= find_len && (seed & 0x10000))
+            find = str.substr((seed >> 17) % (str_len - find_len + 1), find_len);
+        else
+        {
+            for(size_t j = 0; j < find_len; j++)
+            {
+                seed = seed * 1103515245 + 12345;
+                find[j] = alphabet[(seed >> 16) % (i & 1 ? 2 : 5)];
+            }
+        }
+
+        for(bool ignore_case : {false, true})
+        {
+            ASSERT_EQ(string_find_substring(str.data(), str_len, find.data(), find_len, ignore_case),
+                      naive_find(str.data(), str_len, find.data(), find_len, ignore_case)) << str << " / " << find << " " << ignore_case;
+        }
+    }
+}
+
+TEST(convert_string, find_substring_worst_case)
+{
+    const size_t size = 1 << 16;
+    std::string str(size, 'a');
+    std::string find(100, 'a');
+
+    // Worst case for nested loops: Each position matches 99 characters before it fails.
+    find[99] = 'b';
+    str[size - 1] = 'b';
+
+    EXPECT_EQ(string_strstr_end(&str[0], find.c_str()), &str[size]);
+    EXPECT_EQ(string_strcasestr(&str[0], find.c_str()), &str[size - 100]);
+    EXPECT_EQ(string_find_substring(str.data(), size, find.data(), find.size(), true), &str[size - 100]);
+    EXPECT_EQ(string_find_substring(str.data(), size - 1, find.data(), find.size(), false), nullptr);
+}
+
 TEST(convert_string, num_array)
 {
     int32_t result_array[5] = { 0 };
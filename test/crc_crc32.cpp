@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C"
+{
+    #include "module/crc/crc32.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+static uint32_t ReferenceCrc32(const uint8_t* data, size_t length)
+{
+    uint32_t c = 0xffffffff;
+
+    while(length--)
+    {
+        c ^= *data++;
+        for(int i = 0; i < 8; i++)
+            c = (c & 1) ? (c >> 1) ^ 0xedb88320 : c >> 1;
+    }
+
+    return c ^ 0xffffffff;
+}
+
+static uint32_t Crc32(crc32_t* crc, const uint8_t* data, size_t length)
+{
+    crc32_start(crc);
+    crc32_update(crc, data, length);
+    return crc32_finish(crc);
+}
+
+static std::vector<uint8_t> RandomData(size_t length)
+{
+    std::vector<uint8_t> data(length);
+    uint32_t x = 0x12345678;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        x = x * 1103515245 + 12345;
+        data[i] = x >> 24;
+    }
+
+    return data;
+}
+
+TEST(crc_crc32, check_value)
+{
+    crc32_t crc;
+    CRC32_INIT_DEFAULT(&crc);
+
+    EXPECT_EQ(Crc32(&crc, (const uint8_t*)"123456789", 9), 0xCBF43926);
+    crc.use_hardware = false;
+    EXPECT_EQ(Crc32(&crc, (const uint8_t*)"123456789", 9), 0xCBF43926);
+}
+
+TEST(crc_crc32, lengths_and_alignments)
+{
+    std::vector<uint8_t> data = RandomData(1024 + 16);
+    crc32_t crc;
+    CRC32_INIT_DEFAULT(&crc);
+    bool has_hardware = crc.use_hardware;
+
+    for(int hw = 0; hw < 2; hw++)
+    {
+        crc.use_hardware = hw && has_hardware;
+        for(size_t offset = 0; offset < 8; offset++)
+        {
+            for(size_t length = 0; length <= 1024; length += (length < 160 ? 1 : 37))
+            {
+                ASSERT_EQ(Crc32(&crc, &data[offset], length), ReferenceCrc32(&data[offset], length)) << "offset " << offset << " length " << length << " hw " << hw;
+            }
+        }
+    }
+}
+
+TEST(crc_crc32, split_updates)
+{
+    std::vector<uint8_t> data = RandomData(4096);
+    uint32_t expected = ReferenceCrc32(data.data(), data.size());
+    crc32_t crc;
+    CRC32_INIT_DEFAULT(&crc);
+
+    for(size_t step = 1; step < 300; step += 7)
+    {
+        crc32_start(&crc);
+        for(size_t i = 0; i < data.size(); i += step)
+            crc32_update(&crc, &data[i], std::min(step, data.size() - i));
+        ASSERT_EQ(crc32_finish(&crc), expected) << "step " << step;
+    }
+}
+
+TEST(crc_crc32, other_polynom)
+{
+    std::vector<uint8_t> data = RandomData(100);
+    crc32_t crc;
+    // CRC-32C
+    crc32_init(&crc, 0x82F63B78, 0xffffffff, 0xffffffff);
+
+    EXPECT_FALSE(crc.use_hardware);
+    EXPECT_EQ(Crc32(&crc, (const uint8_t*)"123456789", 9), 0xE3069283);
+}
+
+TEST(crc_crc32, combine)
+{
+    std::vector<uint8_t> data = RandomData(5000);
+    uint32_t expected = ReferenceCrc32(data.data(), data.size());
+
+    for(size_t split : {0, 1, 7, 64, 1000, 4999, 5000})
+    {
+        uint32_t a = ReferenceCrc32(data.data(), split);
+        uint32_t b = ReferenceCrc32(data.data() + split, data.size() - split);
+        EXPECT_EQ(crc32_combine(a, b, data.size() - split), expected) << "split " << split;
+    }
+
+    // Checksum in four chunks and combine them, like it would be done in parallel.
+    const size_t chunk = data.size() / 4;
+    uint32_t result = ReferenceCrc32(data.data(), chunk);
+    for(size_t i = 1; i < 4; i++)
+    {
+        size_t len = (i == 3) ? data.size() - 3 * chunk : chunk;
+        result = crc32_combine(result, ReferenceCrc32(&data[i * chunk], len), len);
+    }
+    EXPECT_EQ(result, expected);
+}
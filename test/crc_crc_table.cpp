@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C"
+{
+    #include "module/crc/crc.h"
+    #include "module/crc/crc8.h"
+    #include "module/crc/crc32.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+#include "module/crc/crc_table.hpp"
+
+static const uint8_t check_data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+static constexpr crc_table_t<uint8_t> table_crc8 = crc_table_make<uint8_t, 0x07, false>();
+static constexpr crc_table_t<uint8_t> table_crc8_maxim = crc_table_make<uint8_t, 0x8C, true>();
+static constexpr crc_table_t<uint16_t> table_ccitt = crc_table_make<uint16_t, 0x1021, false>();
+static constexpr crc_table_t<uint16_t> table_kermit = crc_table_make<uint16_t, 0x8408, true>();
+static constexpr crc_table_t<uint16_t> table_modbus = crc_table_make<uint16_t, 0xA001, true>();
+static constexpr crc_table_t<uint32_t> table_crc32 = crc_table_make<uint32_t, 0xEDB88320, true>();
+static constexpr crc_table_t<uint32_t> table_crc32c = crc_table_make<uint32_t, 0x82F63B78, true>();
+
+// Tables are generated by the compiler
+static_assert(table_ccitt.data[1] == 0x1021 && table_ccitt.data[255] == 0x1EF0, "CCITT table");
+static_assert(table_kermit.data[1] == 0x1189 && table_kermit.data[0x80] == 0x8408, "Kermit table");
+static_assert(table_crc32.data[1] == 0x77073096 && table_crc32.data[255] == 0x2D02EF8D, "CRC32 table");
+
+TEST(crc_crc_table, crc8)
+{
+    crc8_t crc;
+
+    crc8_init_table(&crc, table_crc8.data, 0x00, 0x00, false);
+    EXPECT_EQ(crc.polynom, 0x07);
+    EXPECT_EQ(crc8_calc(&crc, check_data, sizeof(check_data)), 0xF4);
+
+    crc8_init_table(&crc, table_crc8_maxim.data, 0x00, 0x00, true);
+    EXPECT_EQ(crc.polynom, 0x8C);
+    EXPECT_EQ(crc8_calc(&crc, check_data, sizeof(check_data)), 0xA1);
+}
+
+TEST(crc_crc_table, crc16)
+{
+    crc_t crc;
+
+    // CRC-16/XMODEM
+    crc_init_table(&crc, table_ccitt.data, 0x0000, 0x0000, false);
+    EXPECT_EQ(crc.polynom, 0x1021);
+    EXPECT_EQ(crc_calc(&crc, check_data, sizeof(check_data)), 0x31C3);
+
+    // CRC-16/KERMIT
+    crc_init_table(&crc, table_kermit.data, 0x0000, 0x0000, true);
+    EXPECT_EQ(crc.polynom, 0x8408);
+    EXPECT_EQ(crc_calc(&crc, check_data, sizeof(check_data)), 0x2189);
+
+    // CRC-16/MODBUS
+    crc_init_table(&crc, table_modbus.data, 0xFFFF, 0x0000, true);
+    EXPECT_EQ(crc_calc(&crc, check_data, sizeof(check_data)), 0x4B37);
+}
+
+TEST(crc_crc_table, crc16_matches_bitwise)
+{
+    std::vector<uint8_t> data(300);
+    crc_t bitwise, table;
+
+    for(size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)(i * 37 + 11);
+
+    for(uint16_t polynom : {0x1021, 0x8005, 0x3D65})
+    {
+        crc_init_handler(&bitwise, polynom, 0xFFFF, 0x0000);
+        bitwise.table = NULL;
+        crc_init_handler(&table, polynom, 0xFFFF, 0x0000);
+        if(table.table == NULL)
+            continue;
+        EXPECT_EQ(crc_calc(&table, data.data(), data.size()), crc_calc(&bitwise, data.data(), data.size())) << "polynom " << polynom;
+    }
+
+    crc_init_handler(&bitwise, 0x1021, 0x1D0F, 0x0000);
+    bitwise.table = NULL;
+    crc_init_table(&table, table_ccitt.data, 0x1D0F, 0x0000, false);
+    EXPECT_EQ(crc_calc(&table, data.data(), data.size()), crc_calc(&bitwise, data.data(), data.size()));
+}
+
+TEST(crc_crc_table, crc32)
+{
+    crc32_t crc;
+
+    crc32_init_table(&crc, table_crc32c.data, 0xFFFFFFFF, 0xFFFFFFFF);
+    EXPECT_EQ(crc.polynom, 0x82F63B78u);
+    EXPECT_EQ(crc.table, table_crc32c.data);
+    EXPECT_FALSE(crc.use_hardware);
+    crc32_start(&crc);
+    crc32_update(&crc, check_data, sizeof(check_data));
+    EXPECT_EQ(crc32_finish(&crc), 0xE3069283u);
+
+    // The default polynom uses the internal table, so the faster paths are still used.
+    crc32_init_table(&crc, table_crc32.data, CRC32_INITIAL_DEFAULT, CRC32_FINAL_XOR_DEFAULT);
+    EXPECT_NE(crc.table, table_crc32.data);
+    EXPECT_EQ(memcmp(crc.table, table_crc32.data, sizeof(table_crc32.data)), 0);
+    crc32_start(&crc);
+    crc32_update(&crc, check_data, sizeof(check_data));
+    EXPECT_EQ(crc32_finish(&crc), 0xCBF43926u);
+}
@@ -0,0 +1,320 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+extern "C"
+{
+    #include "module/filter/filter.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+// Not symmetric, so the order of the coefficients is checked
+static const double fir_taps[9] = {0.03, -0.05, 0.1, 0.25, 0.4, 0.2, 0.1, -0.06, 0.01};
+
+static std::vector<double> fir_reference(const std::vector<double>& x, const double* b, size_t num_taps)
+{
+    std::vector<double> y(x.size(), 0.0);
+
+    for(size_t n = 0; n < x.size(); n++)
+    {
+        for(size_t k = 0; k < num_taps && k <= n; k++)
+        {
+            // The coefficients are stored in time reversed order
+            y[n] += b[num_taps - 1 - k] * x[n - k];
+        }
+    }
+    return y;
+}
+
+static std::vector<double> random_signal(size_t count, double amplitude)
+{
+    std::vector<double> x(count);
+
+    srand(42);
+    for(size_t i = 0; i < count; i++)
+    {
+        x[i] = amplitude * (2.0 * rand() / RAND_MAX - 1.0);
+    }
+    return x;
+}
+
+TEST(filter, fir_q15)
+{
+    std::vector<double> x = random_signal(1000, 0.9);
+    std::vector<double> y = fir_reference(x, fir_taps, 9);
+    q15_t coeffs[9], state[FILTER_FIR_STATE_SIZE(9, 32)];
+    std::vector<q15_t> in(x.size()), out(x.size());
+    filter_fir_q15_t fir;
+
+    for(size_t i = 0; i < 9; i++)
+    {
+        coeffs[i] = FILTER_Q15(fir_taps[i]);
+    }
+    for(size_t i = 0; i < x.size(); i++)
+    {
+        in[i] = FILTER_Q15(x[i]);
+    }
+
+    ASSERT_TRUE(filter_fir_q15_init(&fir, coeffs, 9, state, 32, 1));
+    // Blocks that are larger than block_size are split
+    ASSERT_EQ(filter_fir_q15_process(&fir, in.data(), out.data(), 100), 100u);
+    ASSERT_EQ(filter_fir_q15_process(&fir, &in[100], &out[100], x.size() - 100), x.size() - 100);
+
+    for(size_t i = 0; i < x.size(); i++)
+    {
+        ASSERT_NEAR(out[i] / 32768.0, y[i], 4.0 / 32768) << i;
+    }
+
+    EXPECT_FALSE(filter_fir_q15_init(&fir, coeffs, 0, state, 32, 1));
+    EXPECT_FALSE(filter_fir_q15_init(&fir, coeffs, 9, state, 32, 0));
+}
+
+TEST(filter, fir_q31)
+{
+    std::vector<double> x = random_signal(500, 0.9);
+    std::vector<double> y = fir_reference(x, fir_taps, 9);
+    q31_t coeffs[9], state[FILTER_FIR_STATE_SIZE(9, 16)];
+    std::vector<q31_t> data(x.size());
+    filter_fir_q31_t fir;
+
+    for(size_t i = 0; i < 9; i++)
+    {
+        coeffs[i] = FILTER_Q31(fir_taps[i]);
+    }
+    for(size_t i = 0; i < x.size(); i++)
+    {
+        data[i] = FILTER_Q31(x[i]);
+    }
+
+    // In place
+    ASSERT_TRUE(filter_fir_q31_init(&fir, coeffs, 9, state, 16, 1));
+    ASSERT_EQ(filter_fir_q31_process(&fir, data.data(), data.data(), data.size()), data.size());
+
+    for(size_t i = 0; i < x.size(); i++)
+    {
+        ASSERT_NEAR(data[i] / 2147483648.0, y[i], 1e-8) << i;
+    }
+}
+
+TEST(filter, fir_decimation)
+{
+    std::vector<double> x = random_signal(999, 1.0);
+    std::vector<float> in(x.begin(), x.end()), full(x.size()), dec(x.size());
+    float coeffs[9], state_full[FILTER_FIR_STATE_SIZE(9, 64)], state_dec[FILTER_FIR_STATE_SIZE(9, 64)];
+    filter_fir_float_t fir_full, fir_dec;
+    size_t n = 0;
+
+    for(size_t i = 0; i < 9; i++)
+    {
+        coeffs[i] = (float)fir_taps[i];
+    }
+
+    ASSERT_TRUE(filter_fir_float_init(&fir_full, coeffs, 9, state_full, 64, 1));
+    ASSERT_TRUE(filter_fir_float_init(&fir_dec, coeffs, 9, state_dec, 64, 3));
+    ASSERT_EQ(filter_fir_float_process(&fir_full, in.data(), full.data(), in.size()), in.size());
+
+    // Odd block sizes, so the phase is carried over between the calls
+    for(size_t pos = 0, len = 1; pos < in.size(); pos += len, len = len % 7 + 1)
+    {
+        if(len > in.size() - pos)
+        {
+            len = in.size() - pos;
+        }
+        n += filter_fir_float_process(&fir_dec, &in[pos], &dec[n], len);
+    }
+
+    // Every third output of the full filter, starting with the third
+    ASSERT_EQ(n, in.size() / 3);
+    for(size_t i = 0; i < n; i++)
+    {
+        ASSERT_FLOAT_EQ(dec[i], full[i * 3 + 2]) << i;
+    }
+}
+
+static std::vector<double> biquad_reference(const std::vector<double>& x, const double* c, size_t stages)
+{
+    std::vector<double> y = x;
+
+    for(size_t s = 0; s < stages; s++)
+    {
+        const double* k = &c[s * 5];
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        for(size_t n = 0; n < y.size(); n++)
+        {
+            double x0 = y[n];
+            double y0 = k[0] * x0 + k[1] * x1 + k[2] * x2 - k[3] * y1 - k[4] * y2;
+
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            y[n] = y0;
+        }
+    }
+    return y;
+}
+
+// 4th order butterworth lowpass at 0.1 * fs as 2 stages. The gain is moved between the stages, so b1 of the second
+// stage is not 2.0, which does not fit into the fixed-point coefficients.
+static const double biquad_coeffs[10] =
+{
+    0.019297373430864912, 0.038594746861729824, 0.019297373430864912, -1.0485995763626117, 0.2961403575616696,
+    0.25, 0.5, 0.25, -1.3209134308194261, 0.6327387928852763
+};
+
+TEST(filter, biquad)
+{
+    std::vector<double> x = random_signal(2000, 0.5);
+    std::vector<double> y = biquad_reference(x, biquad_coeffs, 2);
+    float coeffs_float[10], state_float[4];
+    int32_t coeffs_q31[10];
+    int16_t coeffs_q15[10];
+    q31_t state_q31[8];
+    q15_t state_q15[8];
+    std::vector<float> data_float(x.begin(), x.end());
+    std::vector<q31_t> data_q31(x.size());
+    std::vector<q15_t> data_q15(x.size());
+    filter_biquad_float_t f_float;
+    filter_biquad_q31_t f_q31;
+    filter_biquad_q15_t f_q15;
+
+    for(size_t i = 0; i < 10; i++)
+    {
+        coeffs_float[i] = (float)biquad_coeffs[i];
+        coeffs_q31[i] = FILTER_BIQUAD_Q30(biquad_coeffs[i]);
+        coeffs_q15[i] = FILTER_BIQUAD_Q14(biquad_coeffs[i]);
+    }
+    for(size_t i = 0; i < x.size(); i++)
+    {
+        data_q31[i] = FILTER_Q31(x[i]);
+        data_q15[i] = FILTER_Q15(x[i]);
+    }
+
+    ASSERT_TRUE(filter_biquad_float_init(&f_float, coeffs_float, state_float, 2));
+    ASSERT_TRUE(filter_biquad_q31_init(&f_q31, coeffs_q31, state_q31, 2));
+    ASSERT_TRUE(filter_biquad_q15_init(&f_q15, coeffs_q15, state_q15, 2));
+
+    // Two calls, so the state is carried over
+    for(size_t pos = 0; pos < x.size(); pos += x.size() / 2)
+    {
+        filter_biquad_float_process(&f_float, &data_float[pos], &data_float[pos], x.size() / 2);
+        filter_biquad_q31_process(&f_q31, &data_q31[pos], &data_q31[pos], x.size() / 2);
+        filter_biquad_q15_process(&f_q15, &data_q15[pos], &data_q15[pos], x.size() / 2);
+    }
+
+    for(size_t i = 0; i < x.size(); i++)
+    {
+        ASSERT_NEAR(data_float[i], y[i], 1e-4) << i;
+        ASSERT_NEAR(data_q31[i] / 2147483648.0, y[i], 1e-6) << i;
+        // The Q14 coefficients of the first stage are rounded a lot, so only the rough shape is checked
+        ASSERT_NEAR(data_q15[i] / 32768.0, y[i], 0.02) << i;
+    }
+}
+
+TEST(filter, moving_average)
+{
+    int32_t buffer[4], out[32];
+    const int32_t in[10] = {4, 8, 12, 16, 20, -20, -40, 0, 1, 2};
+    const int32_t expected[10] = {4, 6, 8, 10, 14, 7, -6, -10, -15, -9};
+    filter_average_t avg;
+
+    ASSERT_TRUE(filter_average_init(&avg, buffer, 4, 1));
+    for(size_t i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(filter_average_add(&avg, in[i]), expected[i]) << i;
+    }
+
+    // Block processing wraps around the ring buffer
+    filter_average_reset(&avg);
+    ASSERT_EQ(filter_average_process(&avg, in, out, 3), 3u);
+    ASSERT_EQ(filter_average_process(&avg, &in[3], &out[3], 7), 7u);
+    for(size_t i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(out[i], expected[i]) << i;
+    }
+
+    // Boxcar decimator
+    int32_t samples[32];
+    for(size_t i = 0; i < 32; i++)
+    {
+        samples[i] = (int32_t)i;
+    }
+    ASSERT_TRUE(filter_average_init(&avg, buffer, 4, 4));
+    ASSERT_EQ(filter_average_process(&avg, samples, out, 30), 7u);
+    ASSERT_EQ(filter_average_process(&avg, &samples[30], &out[7], 2), 1u);
+    for(size_t i = 0; i < 8; i++)
+    {
+        // Average of 4i, 4i + 1, 4i + 2 and 4i + 3 rounded up
+        EXPECT_EQ(out[i], (int32_t)(4 * i + 2)) << i;
+    }
+}
+
+TEST(filter, ema)
+{
+    filter_ema_t ema;
+    filter_ema_float_t ema_float;
+    int32_t value = 0;
+    float value_float = 0;
+
+    filter_ema_init(&ema, FILTER_Q15(0.01));
+    filter_ema_float_init(&ema_float, 0.01f);
+
+    EXPECT_EQ(filter_ema_add(&ema, 100), 100);
+
+    // A step is reached without getting stuck below the target
+    for(int i = 0; i < 3000; i++)
+    {
+        float one = 1000.0f;
+
+        value = filter_ema_add(&ema, 1000);
+        value_float = filter_ema_float_process(&ema_float, &one, NULL, 1);
+    }
+    EXPECT_EQ(value, 1000);
+    EXPECT_NEAR(value_float, 1000.0f, 0.01f);
+
+    // After 69 samples with alpha 0.01 about half of the step is done
+    std::vector<int32_t> in(69, 0), out(69);
+    EXPECT_EQ(filter_ema_process(&ema, in.data(), out.data(), in.size()), out.back());
+    EXPECT_NEAR(out.back(), 500, 3);
+}
+
+TEST(filter, block_and_single)
+{
+    const size_t count = 4096;
+    std::vector<double> x = random_signal(count, 0.9);
+    std::vector<q15_t> in(count), out_block(count), out_single(count);
+    q15_t coeffs[32], state_block[FILTER_FIR_STATE_SIZE(32, 256)], state_single[FILTER_FIR_STATE_SIZE(32, 1)];
+    filter_fir_q15_t fir_block, fir_single;
+
+    for(size_t i = 0; i < 32; i++)
+    {
+        coeffs[i] = FILTER_Q15(1.0 / 32);
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+        in[i] = FILTER_Q15(x[i]);
+    }
+
+    ASSERT_TRUE(filter_fir_q15_init(&fir_block, coeffs, 32, state_block, 256, 1));
+    ASSERT_TRUE(filter_fir_q15_init(&fir_single, coeffs, 32, state_single, 1, 1));
+
+    // Processing in blocks gives the same output as processing each sample alone
+    filter_fir_q15_process(&fir_block, in.data(), out_block.data(), count);
+    for(size_t i = 0; i < count; i++)
+    {
+        filter_fir_q15_process(&fir_single, &in[i], &out_single[i], 1);
+    }
+
+    ASSERT_EQ(out_block, out_single);
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C"
+{
+    #include "module/flash_integrity/flash_integrity.h"
+    #include "module/crc/crc32.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+#define REGION_BLOCKS   16
+
+static std::vector<uint32_t> error_addresses;
+
+static void on_error(flash_integrity_handle_t h, uint32_t address, uint32_t size, void* obj)
+{
+    (void)h;
+    (void)obj;
+    EXPECT_EQ(size, (uint32_t)MCU_CONTROLLER_FLASH_BLOCK_SIZE);
+    error_addresses.push_back(address);
+}
+
+static flash_integrity_handle_t create_region(void)
+{
+    flash_integrity_config_t config = {};
+
+    config.address = BLOCK(4);
+    config.size = REGION_BLOCKS * MCU_CONTROLLER_FLASH_BLOCK_SIZE;
+    config.index_address = BLOCK(2);
+    config.f_error = on_error;
+
+    return flash_integrity_create(&config);
+}
+
+class flash_integrity_test : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> data;
+    flash_integrity_handle_t h;
+
+    void SetUp() override
+    {
+        mcu_flash_init();
+        error_addresses.clear();
+
+        data.resize(REGION_BLOCKS * MCU_CONTROLLER_FLASH_BLOCK_SIZE);
+        for(size_t i = 0; i < data.size(); i++)
+            data[i] = (uint8_t)(i * 7 + (i >> 8));
+
+        h = create_region();
+        ASSERT_NE(h, nullptr);
+        ASSERT_TRUE(flash_integrity_write(h, BLOCK(4), data.data(), data.size()));
+    }
+
+    void TearDown() override
+    {
+        flash_integrity_free(h);
+    }
+};
+
+TEST_F(flash_integrity_test, create)
+{
+    flash_integrity_config_t config = {};
+    flash_integrity_handle_t h2;
+
+    EXPECT_EQ(flash_integrity_get_block_count(h), (size_t)REGION_BLOCKS);
+    EXPECT_EQ(flash_integrity_get_dirty_count(h), (size_t)REGION_BLOCKS);
+
+    config.address = BLOCK(4);
+    config.size = 4 * MCU_CONTROLLER_FLASH_BLOCK_SIZE;
+    config.index_address = BLOCK(5);
+    EXPECT_EQ(flash_integrity_create(&config), nullptr);
+
+    // 1024 blocks need an index of 2 erasable blocks, so it overlaps the region when it starts in the block before
+    config.size = 16 * MCU_CONTROLLER_FLASH_BLOCK_SIZE;
+    config.block_size = 64;
+    config.index_address = BLOCK(3);
+    EXPECT_EQ(flash_integrity_create(&config), nullptr);
+    config.index_address = BLOCK(2);
+    h2 = flash_integrity_create(&config);
+    EXPECT_NE(h2, nullptr);
+    flash_integrity_free(h2);
+}
+
+TEST_F(flash_integrity_test, index_spans_erase_blocks)
+{
+    flash_integrity_config_t config = {};
+    flash_integrity_handle_t small, h2;
+
+    // Index of 20 + 4 * 4096 bytes is spread over 5 erasable blocks
+    config.address = BLOCK(4);
+    config.size = REGION_BLOCKS * MCU_CONTROLLER_FLASH_BLOCK_SIZE;
+    config.index_address = BLOCK(24);
+    config.block_size = 16;
+
+    small = flash_integrity_create(&config);
+    ASSERT_NE(small, nullptr);
+    EXPECT_EQ(flash_integrity_get_block_count(small), 4096u);
+    ASSERT_EQ(flash_integrity_commit(small), FUNCTION_RETURN_OK);
+
+    // Commit again after a write, so the whole index has to be erased before it is written again
+    ASSERT_TRUE(flash_integrity_write(small, BLOCK(19) + 5, &data[BLOCK(15) + 5], 40));
+    EXPECT_EQ(flash_integrity_get_dirty_count(small), 3u);
+    ASSERT_EQ(flash_integrity_commit(small), FUNCTION_RETURN_OK);
+
+    h2 = flash_integrity_create(&config);
+    ASSERT_NE(h2, nullptr);
+    EXPECT_EQ(flash_integrity_load(h2), FUNCTION_RETURN_OK);
+    EXPECT_EQ(flash_integrity_verify(h2), 0u);
+
+    flash_integrity_free(h2);
+    flash_integrity_free(small);
+}
+
+TEST_F(flash_integrity_test, erase_range)
+{
+    uint8_t buffer[16];
+
+    ASSERT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+
+    // The range is extended to whole erasable blocks
+    ASSERT_TRUE(flash_integrity_erase(h, BLOCK(6) + 100, MCU_CONTROLLER_FLASH_BLOCK_SIZE + 10));
+    EXPECT_EQ(flash_integrity_get_dirty_count(h), 2u);
+    for(uint32_t address : {(uint32_t)BLOCK(6), (uint32_t)BLOCK(7) + MCU_CONTROLLER_FLASH_BLOCK_SIZE - 16})
+    {
+        ASSERT_TRUE(mcu_flash_read(address, buffer, sizeof(buffer)));
+        for(size_t i = 0; i < sizeof(buffer); i++)
+            EXPECT_EQ(buffer[i], 0xFF);
+    }
+    ASSERT_TRUE(mcu_flash_read(BLOCK(8), buffer, sizeof(buffer)));
+    EXPECT_EQ(buffer[0], data[BLOCK(4)]);
+
+    EXPECT_FALSE(flash_integrity_erase(h, BLOCK(3) + 10, 10));
+    EXPECT_FALSE(flash_integrity_erase(h, BLOCK(4 + REGION_BLOCKS) - 10, 20));
+
+    ASSERT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+    EXPECT_EQ(flash_integrity_verify(h), 0u);
+}
+
+TEST_F(flash_integrity_test, load_after_commit)
+{
+    flash_integrity_handle_t h2;
+
+    EXPECT_EQ(flash_integrity_load(h), FUNCTION_RETURN_NOT_FOUND);
+    EXPECT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+    EXPECT_EQ(flash_integrity_get_dirty_count(h), 0u);
+
+    // Simulates a restart
+    h2 = create_region();
+    EXPECT_EQ(flash_integrity_load(h2), FUNCTION_RETURN_OK);
+    EXPECT_EQ(flash_integrity_get_dirty_count(h2), 0u);
+    EXPECT_EQ(flash_integrity_verify(h2), 0u);
+    flash_integrity_free(h2);
+}
+
+TEST_F(flash_integrity_test, detect_bit_error)
+{
+    uint8_t zero = 0x00;
+
+    ASSERT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+
+    // Bit error that is not written through the module
+    ASSERT_TRUE(mcu_flash_write(BLOCK(9) + 100, &zero, 1));
+
+    EXPECT_EQ(flash_integrity_verify(h), 1u);
+    ASSERT_EQ(error_addresses.size(), 1u);
+    EXPECT_EQ(error_addresses[0], (uint32_t)BLOCK(9));
+    EXPECT_FALSE(flash_integrity_verify_block(h, 5));
+    EXPECT_TRUE(flash_integrity_verify_block(h, 4));
+
+    error_addresses.clear();
+    for(size_t i = 0; i < REGION_BLOCKS; i++)
+        flash_integrity_scrub_step(h);
+    ASSERT_EQ(error_addresses.size(), 1u);
+    EXPECT_EQ(error_addresses[0], (uint32_t)BLOCK(9));
+}
+
+TEST_F(flash_integrity_test, interrupted_update)
+{
+    flash_integrity_handle_t h2;
+    uint8_t zero = 0x00;
+
+    ASSERT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+
+    // Reset after the write, before the commit
+    ASSERT_TRUE(flash_integrity_write(h, BLOCK(6) + 10, &zero, 1));
+    EXPECT_EQ(flash_integrity_get_dirty_count(h), 1u);
+
+    h2 = create_region();
+    EXPECT_EQ(flash_integrity_load(h2), FUNCTION_RETURN_NOT_FOUND);
+    flash_integrity_free(h2);
+
+    // Only the dirty block is calculated again
+    EXPECT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+    h2 = create_region();
+    EXPECT_EQ(flash_integrity_load(h2), FUNCTION_RETURN_OK);
+    EXPECT_EQ(flash_integrity_verify(h2), 0u);
+    flash_integrity_free(h2);
+}
+
+TEST_F(flash_integrity_test, region_crc)
+{
+    std::vector<uint8_t> flash(data.size());
+    uint32_t crc = 0;
+    crc32_t c;
+
+    EXPECT_EQ(flash_integrity_get_crc(h, &crc), FUNCTION_RETURN_NOT_READY);
+    ASSERT_EQ(flash_integrity_commit(h), FUNCTION_RETURN_OK);
+    ASSERT_EQ(flash_integrity_get_crc(h, &crc), FUNCTION_RETURN_OK);
+
+    ASSERT_TRUE(mcu_flash_read(BLOCK(4), flash.data(), flash.size()));
+    CRC32_INIT_DEFAULT(&c);
+    crc32_start(&c);
+    crc32_update(&c, flash.data(), flash.size());
+    EXPECT_EQ(crc, crc32_finish(&c));
+}
@@ -3,6 +3,7 @@
 extern "C"
 {
     #include "module/list/list.h"
+    #include "module/list/dlist.h"
 
     void app_main_init(void)
     {
@@ -21,6 +22,17 @@ extern "C"
         test_data_t* next;
     };
 
+    typedef struct test_ddata_s
+    {
+        int integer;
+        dlist_node_t node;
+    }test_ddata_t;
+
+    static int CompareInteger(const void* a, const void* b)
+    {
+        return ((const test_ddata_t*)a)->integer - ((const test_ddata_t*)b)->integer;
+    }
+
     static int GetListSize(list_t* list)
     {
         int cnt = 0;
@@ -106,3 +118,125 @@ TEST(list_list, all_test)
 
     mcu_heap_free(elements);
 }
+
+TEST(list_list, dlist_test)
+{
+    dlist_t list;
+    test_ddata_t* test = NULL;
+    test_ddata_t* elements = (test_ddata_t*)mcu_heap_calloc(5, sizeof(test_ddata_t));
+    ASSERT_NE(elements, nullptr);
+
+    EXPECT_EQ(dlist_init(NULL, test, &test->node), FUNCTION_RETURN_PARAM_ERROR);
+    EXPECT_EQ(dlist_init(&list, test, &test->node), FUNCTION_RETURN_OK);
+    EXPECT_EQ(list.offset_node, offsetof(test_ddata_t, node));
+    EXPECT_EQ(dlist_first_element(&list), nullptr);
+    EXPECT_EQ(dlist_pop_first(&list), nullptr);
+
+    for(int i = 0; i < 5; i++)
+    {
+        elements[i].integer = i;
+        EXPECT_EQ(dlist_add_element(&list, &elements[i]), FUNCTION_RETURN_OK);
+        EXPECT_EQ(dlist_add_element(&list, &elements[i]), FUNCTION_RETURN_NOT_READY);
+    }
+    EXPECT_EQ(dlist_count(&list), 5);
+    EXPECT_EQ(dlist_first_element(&list), &elements[0]);
+    EXPECT_EQ(dlist_last_element(&list), &elements[4]);
+    EXPECT_EQ(dlist_prev_element(&list, &elements[3]), &elements[2]);
+
+    // Remove middle, first and last
+    EXPECT_EQ(dlist_remove_element(&list, &elements[2]), FUNCTION_RETURN_OK);
+    EXPECT_EQ(dlist_remove_element(&list, &elements[2]), FUNCTION_RETURN_NOT_FOUND);
+    EXPECT_EQ(dlist_remove_element(&list, &elements[0]), FUNCTION_RETURN_OK);
+    EXPECT_EQ(dlist_remove_element(&list, &elements[4]), FUNCTION_RETURN_OK);
+    EXPECT_EQ(dlist_count(&list), 2);
+    EXPECT_EQ(dlist_first_element(&list), &elements[1]);
+    EXPECT_EQ(dlist_next_element(&list, &elements[1]), &elements[3]);
+    EXPECT_EQ(dlist_last_element(&list), &elements[3]);
+
+    // Removing all elements while iterating
+    for(int i = 0; i < 5; i++)
+    {
+        dlist_add_element(&list, &elements[i]);
+    }
+    int cnt = 0;
+    void* it = dlist_first_element(&list);
+    while(it)
+    {
+        void* next = dlist_next_element(&list, it);
+        if(((test_ddata_t*)it)->integer % 2 == 0)
+        {
+            EXPECT_EQ(dlist_remove_element(&list, it), FUNCTION_RETURN_OK);
+        }
+        it = next;
+        cnt++;
+    }
+    EXPECT_EQ(cnt, 5);
+    EXPECT_EQ(dlist_count(&list), 2);
+    while(dlist_pop_first(&list));
+    EXPECT_EQ(dlist_count(&list), 0);
+    EXPECT_EQ(dlist_last_element(&list), nullptr);
+
+    // Sorted insert, equal elements keep their order
+    const int order[] = {3, 1, 4, 1, 0};
+    for(int i = 0; i < 5; i++)
+    {
+        elements[i].integer = order[i];
+        EXPECT_EQ(dlist_insert_sorted(&list, &elements[i], CompareInteger), FUNCTION_RETURN_OK);
+    }
+    EXPECT_EQ(dlist_insert_sorted(&list, &elements[0], CompareInteger), FUNCTION_RETURN_NOT_READY);
+    const test_ddata_t* expected[] = {&elements[4], &elements[1], &elements[3], &elements[0], &elements[2]};
+    test = (test_ddata_t*)dlist_first_element(&list);
+    for(int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(test, expected[i]);
+        test = (test_ddata_t*)dlist_next_element(&list, test);
+    }
+    EXPECT_EQ(test, nullptr);
+
+    mcu_heap_free(elements);
+}
+
+TEST(list_list, add_remove_sorted)
+{
+    const int num = 1000;
+    test_data_t* s_elements = (test_data_t*)mcu_heap_calloc(num, sizeof(test_data_t));
+    test_ddata_t* d_elements = (test_ddata_t*)mcu_heap_calloc(num, sizeof(test_ddata_t));
+    list_t s_list;
+    dlist_t d_list;
+    ASSERT_NE(s_elements, nullptr);
+    ASSERT_NE(d_elements, nullptr);
+
+    list_init(&s_list, s_elements, &s_elements->next);
+    dlist_init(&d_list, d_elements, &d_elements->node);
+
+    // Add all, then remove from the end, which is the worst case for list_t
+    for(int i = 0; i < num; i++)
+        list_add_element(&s_list, &s_elements[i]);
+    for(int i = num - 1; i >= 0; i--)
+        list_remove_element(&s_list, &s_elements[i]);
+
+    for(int i = 0; i < num; i++)
+        dlist_add_element(&d_list, &d_elements[i]);
+    for(int i = num - 1; i >= 0; i--)
+        dlist_remove_element(&d_list, &d_elements[i]);
+
+    EXPECT_EQ(list_first_element(&s_list), nullptr);
+    EXPECT_EQ(dlist_count(&d_list), 0);
+
+    // Sorted insert of deadlines that are mostly in order
+    for(int i = 0; i < num; i++)
+        d_elements[i].integer = i + ((i % 8) == 0 ? 16 : 0);
+    for(int i = 0; i < num; i++)
+        dlist_insert_sorted(&d_list, &d_elements[i], CompareInteger);
+    EXPECT_EQ(dlist_count(&d_list), num);
+
+    int last = -1;
+    for(test_ddata_t* it = (test_ddata_t*)dlist_first_element(&d_list); it; it = (test_ddata_t*)dlist_next_element(&d_list, it))
+    {
+        EXPECT_LE(last, it->integer);
+        last = it->integer;
+    }
+
+    mcu_heap_free(s_elements);
+    mcu_heap_free(d_elements);
+}
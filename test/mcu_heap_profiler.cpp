@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <iostream>
+
+extern "C"
+{
+    #include "module_public.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/**
+ * @brief Copies the call site of this file with the given line into site and returns false if it was not found.
+ */
+static bool find_site(const char* line, mcu_heap_profiler_site_t* site)
+{
+    static mcu_heap_profiler_site_t sites[MCU_HEAP_PROFILER_SITES];
+    size_t cnt = mcu_heap_profiler_get_sites(sites, MCU_HEAP_PROFILER_SITES);
+
+    for(size_t i = 0; i < cnt; i++)
+    {
+        if(sites[i].filename && strstr(sites[i].filename, "mcu_heap_profiler.cpp") && strcmp(sites[i].line, line) == 0)
+        {
+            *site = sites[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char* line_a;
+static const char* line_b;
+
+// The line is stored in the same line as the allocation, so it matches the call site.
+static void* alloc_a(size_t size)
+{
+    line_a = LINE2STRING(__LINE__); return mcu_heap_malloc(size);
+}
+
+static void* alloc_b(size_t num, size_t size)
+{
+    line_b = LINE2STRING(__LINE__); return mcu_heap_calloc(num, size);
+}
+
+TEST(mcu_heap_profiler, accounting)
+{
+    mcu_heap_profiler_site_t a, b;
+    uint8_t* p[4];
+
+    // The unittest activates MCU_HEAP_DEBUG, so mcu_heap redirects to the profiler
+    p[0] = (uint8_t*)alloc_a(100);
+    p[1] = (uint8_t*)alloc_a(28);
+    p[2] = (uint8_t*)alloc_b(4, 16);
+    p[3] = (uint8_t*)alloc_b(1, 0);
+    for(int i = 0; i < 4; i++)
+    {
+        ASSERT_NE(p[i], nullptr);
+        EXPECT_EQ((uintptr_t)p[i] % alignof(max_align_t), 0u);
+    }
+    for(int i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(p[2][i], 0);
+    }
+    memset(p[0], 0xAA, 100);
+
+    ASSERT_TRUE(find_site(line_a, &a));
+    ASSERT_TRUE(find_site(line_b, &b));
+    EXPECT_EQ(a.live_bytes, 128u);
+    EXPECT_EQ(a.peak_bytes, 128u);
+    EXPECT_EQ(a.alloc_count, 2u);
+    EXPECT_EQ(a.free_count, 0u);
+    EXPECT_EQ(b.live_bytes, 64u);
+    EXPECT_EQ(b.alloc_count, 2u);
+
+    // The frees are accounted to the call site that allocated the memory
+    mcu_heap_free(p[0]);
+    mcu_heap_free(p[2]);
+    ASSERT_TRUE(find_site(line_a, &a));
+    ASSERT_TRUE(find_site(line_b, &b));
+    EXPECT_EQ(a.live_bytes, 28u);
+    EXPECT_EQ(a.peak_bytes, 128u);
+    EXPECT_EQ(a.free_count, 1u);
+    EXPECT_EQ(b.live_bytes, 0u);
+    EXPECT_EQ(b.peak_bytes, 64u);
+    EXPECT_EQ(b.free_count, 1u);
+
+    mcu_heap_profiler_reset_peaks();
+    ASSERT_TRUE(find_site(line_a, &a));
+    EXPECT_EQ(a.peak_bytes, 28u);
+
+    mcu_heap_free(p[1]);
+    mcu_heap_free(p[3]);
+    mcu_heap_free(NULL);
+    ASSERT_TRUE(find_site(line_a, &a));
+    ASSERT_TRUE(find_site(line_b, &b));
+    EXPECT_EQ(a.live_bytes, 0u);
+    EXPECT_EQ(a.free_count, 2u);
+    EXPECT_EQ(b.free_count, 2u);
+
+    // Overflowing calloc is rejected without accounting
+    EXPECT_EQ(alloc_b(SIZE_MAX / 2, 4), nullptr);
+    ASSERT_TRUE(find_site(line_b, &b));
+    EXPECT_EQ(b.alloc_count, 2u);
+}
+
+TEST(mcu_heap_profiler, sorted_sites)
+{
+    mcu_heap_profiler_site_t sites[2];
+    void* small = alloc_a(10);
+    void* big = alloc_b(1, 5000);
+
+    // Only the biggest sites are copied, starting with the biggest
+    ASSERT_EQ(mcu_heap_profiler_get_sites(sites, 2), 2u);
+    EXPECT_GE(sites[0].live_bytes, sites[1].live_bytes);
+    EXPECT_STREQ(sites[0].line, line_b);
+    EXPECT_EQ(sites[0].live_bytes, 5000u);
+    EXPECT_EQ(mcu_heap_profiler_get_sites(NULL, 2), 0u);
+    EXPECT_EQ(mcu_heap_profiler_get_sites(sites, 0), 0u);
+
+    mcu_heap_free(small);
+    mcu_heap_free(big);
+}
+
+TEST(mcu_heap_profiler, system_memory)
+{
+    mcu_heap_profiler_site_t a_before, a;
+    void* tracked = alloc_a(48);
+    ASSERT_TRUE(find_site(line_a, &a_before));
+
+    // Memory of the system heap has no header and is freed with its own function without touching the call sites
+    for(int i = 0; i < 16; i++)
+    {
+        void* system = mcu_heap_system_calloc(1, 16 + i * 8);
+        ASSERT_NE(system, nullptr);
+        mcu_heap_system_free(system);
+    }
+
+    ASSERT_TRUE(find_site(line_a, &a));
+    EXPECT_EQ(a.live_bytes, a_before.live_bytes);
+    EXPECT_EQ(a.alloc_count, a_before.alloc_count);
+    EXPECT_EQ(a.free_count, a_before.free_count);
+
+    mcu_heap_free(tracked);
+    ASSERT_TRUE(find_site(line_a, &a));
+    EXPECT_EQ(a.live_bytes, a_before.live_bytes - 48);
+    EXPECT_EQ(a.free_count, a_before.free_count + 1);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+extern "C"
+{
+    #include "module_public.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+TEST(mcu_heap_slab, alloc_free)
+{
+    mcu_heap_slab_stats_t before, stats;
+    mcu_heap_slab_get_stats(&before);
+
+    // The unittest redirects mcu_heap to the slab allocator
+    uint8_t* a = (uint8_t*)mcu_heap_calloc(1, 24);
+    uint8_t* b = (uint8_t*)mcu_heap_calloc(3, 8);
+    uint32_t* c = (uint32_t*)mcu_heap_malloc(5);
+    uint8_t* big = (uint8_t*)mcu_heap_calloc(1, MCU_HEAP_SLAB_MAX_SIZE + 1);
+
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    ASSERT_NE(big, nullptr);
+    EXPECT_NE(a, b);
+
+    for(int i = 0; i < 24; i++)
+    {
+        EXPECT_EQ(a[i], 0);
+        EXPECT_EQ(b[i], 0);
+    }
+    memset(a, 0xAA, 24);
+    memset(b, 0x55, 24);
+    *c = 0x12345678;
+    EXPECT_EQ(a[23], 0xAA);
+    EXPECT_EQ(b[0], 0x55);
+    EXPECT_EQ(*c, 0x12345678);
+
+    mcu_heap_slab_get_stats(&stats);
+    EXPECT_EQ(stats.classes[0].object_size, 8);
+    EXPECT_EQ(stats.classes[0].in_use - before.classes[0].in_use, 1);
+    EXPECT_EQ(stats.classes[2].object_size, 32);
+    EXPECT_EQ(stats.classes[2].in_use - before.classes[2].in_use, 2);
+    EXPECT_EQ(stats.fallback_allocations, before.fallback_allocations);
+    EXPECT_EQ(stats.bytes_requested - before.bytes_requested, 24 + 24 + 5);
+    EXPECT_EQ(stats.bytes_served - before.bytes_served, 32 + 32 + 8);
+
+    mcu_heap_free(a);
+    mcu_heap_free(b);
+    mcu_heap_free(c);
+    mcu_heap_free(big);
+    mcu_heap_free(NULL);
+
+    mcu_heap_slab_get_stats(&stats);
+    EXPECT_EQ(stats.classes[0].in_use, before.classes[0].in_use);
+    EXPECT_EQ(stats.classes[2].in_use, before.classes[2].in_use);
+
+    // Freed objects are reused
+    uint8_t* d = (uint8_t*)mcu_heap_calloc(1, 32);
+    EXPECT_TRUE(d == a || d == b);
+    mcu_heap_free(d);
+}
+
+// Runs last, because pages stay assigned to their size class once they are used.
+TEST(mcu_heap_slab, arena_exhausted)
+{
+    const size_t num = MCU_HEAP_SLAB_ARENA_SIZE / MCU_HEAP_SLAB_MAX_SIZE + 10;
+    void** ptr = new void*[num];
+    mcu_heap_slab_stats_t before, stats;
+
+    mcu_heap_slab_get_stats(&before);
+
+    for(size_t i = 0; i < num; i++)
+    {
+        ptr[i] = mcu_heap_malloc(MCU_HEAP_SLAB_MAX_SIZE);
+        ASSERT_NE(ptr[i], nullptr);
+    }
+
+    mcu_heap_slab_get_stats(&stats);
+    EXPECT_EQ(stats.pages_used, stats.pages_total);
+    EXPECT_GE(stats.fallback_allocations - before.fallback_allocations, 10);
+
+    for(size_t i = 0; i < num; i++)
+    {
+        mcu_heap_free(ptr[i]);
+    }
+    delete[] ptr;
+}
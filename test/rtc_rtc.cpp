@@ -0,0 +1,373 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+
+extern "C"
+{
+    #include "module/rtc/rtc.h"
+    #include "module/rtc/rtc_alarm.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+// Date calculations can be used as constants
+static_assert(rtc_civil_days_from_date(1900, 0, 1) == 0, "1.1.1900");
+static_assert(rtc_civil_seconds_from_date(2000, 0, 1, 0, 0, 0) == 3155673600LL, "1.1.2000");
+static_assert(rtc_civil_seconds_from_date(1970, 0, 1, 0, 0, 0) == 2208988800LL, "Unix epoch");
+static_assert(rtc_civil_year_from_days(rtc_civil_days_from_date(2024, 1, 29)) == 2024, "Year");
+static_assert(rtc_civil_mon_from_days(rtc_civil_days_from_date(2024, 1, 29)) == 1, "Month");
+static_assert(rtc_civil_mday_from_days(rtc_civil_days_from_date(2024, 1, 29)) == 29, "Day");
+
+static rtc_time_t make_time(int year, int mon, int mday, int hour, int min, int sec, int msec)
+{
+    rtc_time_t t = {};
+
+    t.tm_year = year - RTC_EPOCH_YR;
+    t.tm_mon = mon - 1;
+    t.tm_mday = mday;
+    t.tm_hour = hour;
+    t.tm_min = min;
+    t.tm_sec = sec;
+    t.tm_msec = msec;
+    return t;
+}
+
+TEST(rtc_rtc, civil_all_days)
+{
+    // Counts the dates up day by day and compares them with the calculated date.
+    uint8_t wday = 1;   // 1.1.1900 was a monday
+    uint16_t yday = 0;
+    int32_t days = 0;
+
+    for(uint32_t year = 1900; year < 2500; year++)
+    {
+        for(uint8_t mon = 0; mon < 12; mon++)
+        {
+            for(uint8_t mday = 1; mday <= rtc_get_days(mon, year); mday++)
+            {
+                ASSERT_EQ(rtc_civil_days_from_date(year, mon, mday), days);
+                ASSERT_EQ(rtc_civil_year_from_days(days), (int32_t)year);
+                ASSERT_EQ(rtc_civil_mon_from_days(days), mon);
+                ASSERT_EQ(rtc_civil_mday_from_days(days), mday);
+                ASSERT_EQ(rtc_civil_wday_from_days(days), wday);
+                ASSERT_EQ(rtc_civil_yday_from_days(days), yday);
+
+                rtc_time_t t = rtc_time((int64_t)days * SECONDS_IN_DAY + 45296);
+                ASSERT_EQ(t.tm_year, year - RTC_EPOCH_YR);
+                ASSERT_EQ(t.tm_mon, mon);
+                ASSERT_EQ(t.tm_mday, mday);
+                ASSERT_EQ(t.tm_wday, wday);
+                ASSERT_EQ(t.tm_yday, yday);
+                ASSERT_EQ(t.tm_hour, 12);
+                ASSERT_EQ(t.tm_min, 34);
+                ASSERT_EQ(t.tm_sec, 56);
+
+                days++;
+                wday = (wday + 1) % 7;
+                yday++;
+            }
+        }
+        yday = 0;
+    }
+}
+
+TEST(rtc_rtc, mktime_and_time)
+{
+    rtc_time_t t = make_time(2024, 2, 29, 23, 59, 58, 123);
+    rtc_time_t t2;
+    rtc_time_t t_null = {};
+
+    EXPECT_EQ(rtc_mktime(&t), 3918239998LL);
+    EXPECT_EQ(rtc_mktime_ms(&t), 3918239998123LL);
+    EXPECT_EQ(rtc_mktime(&t_null), 0);
+
+    t2 = rtc_time_ms(rtc_mktime_ms(&t));
+    EXPECT_EQ(rtc_compare(&t, &t2), 0);
+    EXPECT_EQ(t2.tm_msec, 123);
+    EXPECT_EQ(t2.tm_wday, 4);
+    EXPECT_EQ(t2.tm_yday, 59);
+
+    // Timestamps after 7.2.2036 do not fit into 32-bit
+    t = make_time(2100, 12, 31, 1, 2, 3, 0);
+    t2 = rtc_time(rtc_mktime(&t));
+    EXPECT_EQ(rtc_compare(&t, &t2), 0);
+
+    t2 = rtc_time(-1);
+    EXPECT_EQ(t2.tm_year, 0);
+    EXPECT_EQ(t2.tm_mday, 1);
+}
+
+TEST(rtc_rtc, array)
+{
+    const size_t count = 200000;
+    std::vector<int64_t> t(count), t2(count);
+    std::vector<rtc_time_t> times(count);
+    int64_t start = rtc_civil_seconds_from_date(2030, 5, 1, 0, 0, 0) * 1000;
+
+    // Sorted log entries every 7.3 seconds
+    for(size_t i = 0; i < count; i++)
+        t[i] = start + i * 7300;
+
+    rtc_time_array(t.data(), times.data(), count, true);
+    rtc_mktime_array(times.data(), t2.data(), count, true);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        rtc_time_t single = rtc_time_ms(t[i]);
+        ASSERT_EQ(memcmp(&single, &times[i], sizeof(single)), 0) << i;
+        ASSERT_EQ(t2[i], t[i]) << i;
+    }
+
+    // Unsorted timestamps in seconds
+    for(size_t i = 0; i < 1000; i++)
+        t[i] = (int64_t)(i * 2654435761ULL % 8000000000ULL);
+    rtc_time_array(t.data(), times.data(), 1000, false);
+    rtc_mktime_array(times.data(), t2.data(), 1000, false);
+    for(size_t i = 0; i < 1000; i++)
+        ASSERT_EQ(t2[i], t[i]) << i;
+}
+
+// Straightforward check of the european rule: From the last sunday of march to the last sunday of october at 01:00 UTC.
+static bool dst_reference(int64_t utc)
+{
+    rtc_time_t t = rtc_time(utc);
+    int last_sunday;
+
+    if(t.tm_mon < 2 || t.tm_mon > 9)
+        return false;
+    if(t.tm_mon > 2 && t.tm_mon < 9)
+        return true;
+
+    last_sunday = 31 - rtc_get_day_of_week(t.tm_year + RTC_EPOCH_YR, t.tm_mon, 31);
+    if(t.tm_mday != last_sunday)
+        return (t.tm_mon == 2) == (t.tm_mday > last_sunday);
+
+    return (t.tm_mon == 2) == (t.tm_hour >= 1);
+}
+
+TEST(rtc_rtc, daylight_saving_time)
+{
+    // 2024: 31.03. 01:00 UTC to 27.10. 01:00 UTC
+    int64_t start = rtc_civil_seconds_from_date(2024, 2, 31, 1, 0, 0);
+    int64_t end = rtc_civil_seconds_from_date(2024, 9, 27, 1, 0, 0);
+
+    EXPECT_FALSE(rtc_is_daylight_saving_time_utc(start - 1));
+    EXPECT_TRUE(rtc_is_daylight_saving_time_utc(start));
+    EXPECT_TRUE(rtc_is_daylight_saving_time_utc(end - 1));
+    EXPECT_FALSE(rtc_is_daylight_saving_time_utc(end));
+
+    // CET standard time like before: 02:00 CET is the start of the daylight saving time
+    rtc_time_t t = make_time(2024, 3, 31, 1, 59, 59, 0);
+    EXPECT_FALSE(rtc_is_daylight_saving_time(&t));
+    t.tm_hour = 2;
+    t.tm_min = 0;
+    t.tm_sec = 0;
+    EXPECT_TRUE(rtc_is_daylight_saving_time(&t));
+
+    // Every 30 minutes around the transitions of many years, jumping between years to use the cache
+    for(int year = 1970; year < 2150; year++)
+    {
+        for(int y : {year, 2300 - year})
+        {
+            for(int mon : {2, 9})
+            {
+                int64_t base = rtc_civil_seconds_from_date(y, mon, 24, 0, 0, 0);
+                for(int64_t s = 0; s < 8 * SECONDS_IN_DAY; s += 1800)
+                {
+                    ASSERT_EQ(rtc_is_daylight_saving_time_utc(base + s), dst_reference(base + s)) << y << " " << mon << " " << s;
+                }
+            }
+        }
+    }
+}
+
+TEST(rtc_rtc, local_time_array)
+{
+    const size_t count = 100000;
+    std::vector<int64_t> utc(count), local(count);
+    std::vector<rtc_time_t> times(count);
+    // Every 5 minutes over the start of the daylight saving time 2025 (30.03. 01:00 UTC)
+    int64_t start = rtc_civil_seconds_from_date(2025, 2, 1, 0, 0, 0) * 1000;
+
+    for(size_t i = 0; i < count; i++)
+        utc[i] = start + (int64_t)i * 300000;
+
+    rtc_utc_to_local_array(utc.data(), local.data(), count, 1, true, true);
+    rtc_local_time_array(utc.data(), times.data(), count, 1, true, true);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        bool dst = dst_reference(utc[i] / 1000);
+        rtc_time_t expected = rtc_time_ms(utc[i] + (dst ? 7200000 : 3600000));
+
+        ASSERT_EQ(local[i], utc[i] + (dst ? 7200000 : 3600000)) << i;
+        ASSERT_EQ(times[i].tm_isdst, dst) << i;
+        ASSERT_EQ(times[i].tm_timezone, 1) << i;
+        ASSERT_EQ(rtc_mktime_ms(&times[i]), local[i]) << i;
+        ASSERT_EQ(times[i].tm_mday, expected.tm_mday) << i;
+        ASSERT_EQ(times[i].tm_wday, expected.tm_wday) << i;
+    }
+
+    // 30.03.2025 00:59 UTC is 01:59 CET, one minute later it is 03:00 CEST
+    int64_t before = rtc_civil_seconds_from_date(2025, 2, 30, 0, 59, 0);
+    int64_t after = before + 60;
+    rtc_local_time_array(&before, &times[0], 1, 1, true, false);
+    rtc_local_time_array(&after, &times[1], 1, 1, true, false);
+    EXPECT_EQ(times[0].tm_hour, 1);
+    EXPECT_EQ(times[1].tm_hour, 3);
+
+    // Without daylight saving time and in place
+    rtc_utc_to_local_array(utc.data(), utc.data(), count, -5, false, true);
+    EXPECT_EQ(utc[0], start - 5 * 3600000LL);
+}
+
+TEST(rtc_rtc, alarm_selfcheck)
+{
+    EXPECT_EQ(rtc_alarm_selfcheck(), FUNCTION_RETURN_OK);
+}
+
+/// Index and deadline of the triggered alarms in the order they were triggered.
+static std::vector<std::pair<size_t, int64_t>> alarm_triggered;
+/// Number of times the repeating alarm is setup again.
+static int alarm_repeat = 0;
+
+static void alarm_cb(const rtc_alarm_handle_t alarm, const rtc_alarm_config_t* config)
+{
+    alarm_triggered.push_back(std::make_pair((size_t)config->user, rtc_mktime_ms(&config->alarm_time)));
+
+    // Alarms can be setup again inside the callback.
+    if((size_t)config->user == 0 && alarm_repeat > 0)
+    {
+        rtc_alarm_config_t c = *config;
+        alarm_repeat--;
+        c.alarm_time = rtc_time_ms(rtc_mktime_ms(&config->alarm_time) + 60000);
+        EXPECT_EQ(rtc_alarm_setup(alarm, &c), FUNCTION_RETURN_OK);
+    }
+}
+
+TEST(rtc_rtc, alarm_accelerated_time)
+{
+    const size_t count = 5000;
+    std::vector<rtc_alarm_handle_t> alarms(count);
+    std::vector<int64_t> deadlines(count);
+    std::mt19937 rng(45);
+    rtc_time_t t = make_time(2026, 10, 18, 0, 0, 0, 0);
+    int64_t start = rtc_mktime_ms(&t);
+    size_t expected = 0;
+
+    alarm_triggered.clear();
+    alarm_repeat = 3;
+
+    // Random alarms within one day. Every 10th has the same deadline as the one before.
+    for(size_t i = 0; i < count; i++)
+    {
+        rtc_alarm_config_t c = {};
+        deadlines[i] = (i % 10 == 9) ? deadlines[i - 1] : start + 1 + (int64_t)(rng() % 86400000);
+        c.alarm_time = rtc_time_ms(deadlines[i]);
+        c.user = (void*)i;
+        c.f = alarm_cb;
+        alarms[i] = rtc_alarm_create();
+        ASSERT_TRUE(alarms[i] != NULL);
+        ASSERT_EQ(rtc_alarm_setup(alarms[i], &c), FUNCTION_RETURN_OK);
+    }
+
+    // Cancel every 7th alarm
+    for(size_t i = 3; i < count; i += 7)
+        ASSERT_EQ(rtc_alarm_stop(alarms[i]), FUNCTION_RETURN_OK);
+    expected = rtc_alarm_get_count();
+    EXPECT_EQ(expected, count - (count - 3 + 6) / 7);
+
+    // Nothing is due at the start, afterwards the clock jumps in steps of 10 minutes.
+    rtc_set_simulation_time(&t);
+    EXPECT_GT(rtc_alarm_process(rtc_get_current_time_ms()), 0);
+    EXPECT_TRUE(alarm_triggered.empty());
+
+    int64_t now = start;
+    size_t checked = 0;
+    while(rtc_alarm_get_count() > 0)
+    {
+        now += 600000;
+        rtc_time_t tnow = rtc_time_ms(now);
+        rtc_set_simulation_time(&tnow);
+        // An alarm that is set-up again in its callback is triggered by the next call, which is signalled by 0.
+        int64_t next;
+        do
+        {
+            next = rtc_alarm_process(rtc_get_current_time_ms());
+        }
+        while(next == 0);
+        for(; checked < alarm_triggered.size(); checked++)
+            ASSERT_LE(alarm_triggered[checked].second, now);
+    }
+    rtc_stop_simulation();
+
+    // All alarms except the stopped were triggered in the order of their deadline, same deadlines in setup order.
+    ASSERT_EQ(alarm_triggered.size(), expected + 3);
+    for(size_t i = 1; i < alarm_triggered.size(); i++)
+    {
+        ASSERT_LE(alarm_triggered[i - 1].second, alarm_triggered[i].second);
+        if(alarm_triggered[i - 1].second == alarm_triggered[i].second && alarm_triggered[i - 1].first != 0 && alarm_triggered[i].first != 0)
+        {
+            ASSERT_LT(alarm_triggered[i - 1].first, alarm_triggered[i].first);
+        }
+    }
+    for(size_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(rtc_alarm_is_triggered(alarms[i]), (i % 7) != 3) << i;
+        rtc_alarm_free(alarms[i]);
+    }
+
+    // The repeating alarm was triggered at its deadline and 3 times one minute later.
+    int repeats = 0;
+    for(size_t i = 0; i < alarm_triggered.size(); i++)
+    {
+        if(alarm_triggered[i].first == 0)
+        {
+            EXPECT_EQ(alarm_triggered[i].second, deadlines[0] + repeats * 60000);
+            repeats++;
+        }
+    }
+    EXPECT_EQ(repeats, 4);
+    EXPECT_EQ(rtc_alarm_process(start), -1);
+}
+
+/// Number of times the alarm of rearm_cb was triggered.
+static int rearm_count = 0;
+
+static void rearm_cb(const rtc_alarm_handle_t alarm, const rtc_alarm_config_t* config)
+{
+    // Sets up the alarm again with a time that is already reached.
+    rearm_count++;
+    EXPECT_EQ(rtc_alarm_setup(alarm, config), FUNCTION_RETURN_OK);
+}
+
+TEST(rtc_rtc, alarm_rearm_in_callback)
+{
+    rtc_alarm_config_t c = {};
+    int64_t now = rtc_get_current_time_ms();
+    rtc_alarm_handle_t alarm = rtc_alarm_create();
+
+    ASSERT_TRUE(alarm != NULL);
+    c.alarm_time = rtc_time_ms(now + 1000);
+    c.f = rearm_cb;
+    rearm_count = 0;
+    ASSERT_EQ(rtc_alarm_setup(alarm, &c), FUNCTION_RETURN_OK);
+
+    // Each call triggers the alarm only once and reports that it is due again.
+    EXPECT_EQ(rtc_alarm_process(now + 2000), 0);
+    EXPECT_EQ(rearm_count, 1);
+    EXPECT_EQ(rtc_alarm_process(now + 2000), 0);
+    EXPECT_EQ(rearm_count, 2);
+    EXPECT_EQ(rtc_alarm_get_count(), 1u);
+
+    rtc_alarm_free(alarm);
+    EXPECT_EQ(rtc_alarm_get_count(), 0u);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+
+extern "C"
+{
+    #include "module/util/bit_array.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Sizes in bytes: Smaller than a word, exactly one and two words and with a partial last word.
+static const size_t test_sizes[] = {1, 3, 8, 16, 13, 21};
+
+/// Reference model of a bit array.
+typedef std::vector<bool> model_t;
+
+static model_t random_model(size_t bits, std::mt19937& rng, unsigned percent)
+{
+    model_t m(bits);
+    for(size_t i = 0; i < bits; i++)
+        m[i] = (rng() % 100) < percent;
+    return m;
+}
+
+static bit_array_handle_t from_model(const model_t& m)
+{
+    bit_array_handle_t ba = bit_array_create(m.size());
+    for(size_t i = 0; i < m.size(); i++)
+        bit_array_set_value(ba, i, m[i]);
+    return ba;
+}
+
+static void expect_equal(bit_array_handle_t ba, const model_t& m)
+{
+    ASSERT_EQ(ba->size * 8, m.size());
+    for(size_t i = 0; i < m.size(); i++)
+        ASSERT_EQ(bit_array_is_set(ba, i), m[i]) << "bit " << i;
+}
+
+TEST(util_bit_array, count_and_find)
+{
+    std::mt19937 rng(42);
+
+    for(size_t bytes : test_sizes)
+    {
+        size_t bits = bytes * 8;
+        for(unsigned percent : {0u, 3u, 50u, 97u, 100u})
+        {
+            model_t m = random_model(bits, rng, percent);
+            bit_array_handle_t ba = from_model(m);
+            size_t count = 0;
+
+            for(bool b : m)
+                count += b;
+            EXPECT_EQ(bit_array_count(ba), count) << bytes << " " << percent;
+            EXPECT_EQ(bit_array_has_any_set(ba), count > 0);
+
+            // Search from every position, including the last bit of a partial word.
+            for(size_t start = 0; start <= bits; start++)
+            {
+                size_t next_set = BIT_ARRAY_NOT_FOUND, next_clear = BIT_ARRAY_NOT_FOUND;
+                for(size_t i = start; i < bits; i++)
+                {
+                    if(m[i] && next_set == BIT_ARRAY_NOT_FOUND)
+                        next_set = i;
+                    if(!m[i] && next_clear == BIT_ARRAY_NOT_FOUND)
+                        next_clear = i;
+                }
+                ASSERT_EQ(bit_array_find_next_set(ba, start), next_set) << bytes << " " << percent << " " << start;
+                ASSERT_EQ(bit_array_find_next_clear(ba, start), next_clear) << bytes << " " << percent << " " << start;
+            }
+            EXPECT_EQ(bit_array_find_next_set(ba, bits + 100), BIT_ARRAY_NOT_FOUND);
+
+            bit_array_free(ba);
+        }
+    }
+}
+
+TEST(util_bit_array, iterate_set_bits)
+{
+    bit_array_handle_t ba = bit_array_create(13 * 8);
+    std::vector<size_t> expected = {0, 7, 8, 31, 32, 63, 64, 65, 100, 103};
+    std::vector<size_t> found;
+
+    for(size_t i : expected)
+        bit_array_set(ba, i);
+
+    for(size_t i = bit_array_find_next_set(ba, 0); i != BIT_ARRAY_NOT_FOUND; i = bit_array_find_next_set(ba, i + 1))
+        found.push_back(i);
+
+    EXPECT_EQ(found, expected);
+    bit_array_free(ba);
+}
+
+TEST(util_bit_array, set_and_clear_range)
+{
+    std::mt19937 rng(7);
+
+    for(size_t bytes : test_sizes)
+    {
+        size_t bits = bytes * 8;
+        model_t m = random_model(bits, rng, 50);
+        bit_array_handle_t ba = from_model(m);
+
+        // Every range, so ranges inside a byte, across words and up to the end of the last partial word are covered.
+        for(size_t index = 0; index < bits; index += (bits > 64 ? 3 : 1))
+        {
+            for(size_t num = 0; index + num <= bits; num++)
+            {
+                bool value = (index + num) & 1;
+                if(value)
+                    ASSERT_EQ(bit_array_set_range(ba, index, num), FUNCTION_RETURN_OK);
+                else
+                    ASSERT_EQ(bit_array_clear_range(ba, index, num), FUNCTION_RETURN_OK);
+                for(size_t i = index; i < index + num; i++)
+                    m[i] = value;
+                expect_equal(ba, m);
+            }
+        }
+
+        // Ranges outside of the array are rejected without modifying it.
+        EXPECT_EQ(bit_array_set_range(ba, bits - 1, 2), FUNCTION_RETURN_PARAM_ERROR);
+        EXPECT_EQ(bit_array_clear_range(ba, bits, 1), FUNCTION_RETURN_PARAM_ERROR);
+        EXPECT_EQ(bit_array_set_range(ba, 1, SIZE_MAX), FUNCTION_RETURN_PARAM_ERROR);
+        expect_equal(ba, m);
+
+        bit_array_free(ba);
+    }
+}
+
+TEST(util_bit_array, combine)
+{
+    std::mt19937 rng(99);
+
+    for(size_t bytes : test_sizes)
+    {
+        size_t bits = bytes * 8;
+        model_t a = random_model(bits, rng, 50);
+        model_t b = random_model(bits, rng, 50);
+        model_t r(bits);
+        bit_array_handle_t src = from_model(b);
+        bit_array_handle_t dst;
+
+        dst = from_model(a);
+        ASSERT_EQ(bit_array_and(dst, src), FUNCTION_RETURN_OK);
+        for(size_t i = 0; i < bits; i++)
+            r[i] = a[i] && b[i];
+        expect_equal(dst, r);
+        bit_array_free(dst);
+
+        dst = from_model(a);
+        ASSERT_EQ(bit_array_or(dst, src), FUNCTION_RETURN_OK);
+        for(size_t i = 0; i < bits; i++)
+            r[i] = a[i] || b[i];
+        expect_equal(dst, r);
+        bit_array_free(dst);
+
+        dst = from_model(a);
+        ASSERT_EQ(bit_array_xor(dst, src), FUNCTION_RETURN_OK);
+        for(size_t i = 0; i < bits; i++)
+            r[i] = a[i] != b[i];
+        expect_equal(dst, r);
+        bit_array_free(dst);
+
+        dst = from_model(a);
+        ASSERT_EQ(bit_array_andnot(dst, src), FUNCTION_RETURN_OK);
+        for(size_t i = 0; i < bits; i++)
+            r[i] = a[i] && !b[i];
+        expect_equal(dst, r);
+
+        // The source is not modified.
+        expect_equal(src, b);
+
+        bit_array_free(dst);
+        bit_array_free(src);
+    }
+
+    // Different sizes cannot be combined.
+    bit_array_handle_t a = bit_array_create(64);
+    bit_array_handle_t b = bit_array_create(72);
+    EXPECT_EQ(bit_array_or(a, b), FUNCTION_RETURN_PARAM_ERROR);
+    EXPECT_EQ(bit_array_and(a, NULL), FUNCTION_RETURN_PARAM_ERROR);
+    bit_array_free(a);
+    bit_array_free(b);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+extern "C"
+{
+    #include "module/util/hash_map.h"
+
+    void app_main_init(void)
+    {
+
+    }
+
+    void board_init(void)
+    {
+
+    }
+}
+
+/// Returns count different keys whose hash has the same home entry in a map with the given capacity.
+static std::vector<std::string> colliding_keys(size_t count, size_t capacity)
+{
+    std::vector<std::string> keys;
+    uint32_t home = hash_map_hash_str("k0", 2) & (capacity - 1);
+
+    for(size_t i = 0; keys.size() < count; i++)
+    {
+        std::string k = "k" + std::to_string(i);
+        if((hash_map_hash_str(k.data(), k.size()) & (capacity - 1)) == home)
+            keys.push_back(k);
+    }
+    return keys;
+}
+
+TEST(util_hash_map, static_init)
+{
+    hash_map_t map;
+    hash_map_entry_t entries[HASH_MAP_CAPACITY(3)];
+    int a, b, c, d;
+
+    EXPECT_EQ(HASH_MAP_CAPACITY(3), 8u);
+    EXPECT_EQ(HASH_MAP_CAPACITY(4), 8u);
+    EXPECT_EQ(HASH_MAP_CAPACITY(5), 16u);
+    EXPECT_EQ(hash_map_init(&map, HASH_MAP_KEY_STRING, entries, 6), FUNCTION_RETURN_PARAM_ERROR);
+    EXPECT_EQ(hash_map_init(&map, HASH_MAP_KEY_STRING, NULL, 8), FUNCTION_RETURN_PARAM_ERROR);
+
+    // Memory is not cleared by the caller, hash_map_init clears it.
+    memset(entries, 0xA5, sizeof(entries));
+    ASSERT_EQ(hash_map_init(&map, HASH_MAP_KEY_STRING, entries, 8), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_count(&map), 0u);
+    EXPECT_EQ(hash_map_get_str(&map, "a"), nullptr);
+
+    EXPECT_EQ(hash_map_put_str(&map, "a", &a), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_put_str(&map, "b", &b), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_put_str(&map, "c", &c), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_get_str(&map, "b"), &b);
+
+    // Replacing a value does not add a key.
+    EXPECT_EQ(hash_map_put_str(&map, "b", &d), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_get_str(&map, "b"), &d);
+    EXPECT_EQ(hash_map_count(&map), 3u);
+
+    // A fixed map keeps one entry empty and does not grow.
+    for(const char* key : {"d", "e", "f", "g"})
+        EXPECT_EQ(hash_map_put_str(&map, key, &a), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_count(&map), 7u);
+    EXPECT_EQ(hash_map_put_str(&map, "h", &a), FUNCTION_RETURN_INSUFFICIENT_MEMORY);
+    EXPECT_EQ(hash_map_get_str(&map, "h"), nullptr);
+    EXPECT_EQ(map.capacity, 8u);
+
+    // Wrong key type
+    EXPECT_EQ(hash_map_put_int(&map, 1, &a), FUNCTION_RETURN_PARAM_ERROR);
+    EXPECT_EQ(hash_map_get_int(&map, 1), nullptr);
+
+    hash_map_clear(&map);
+    EXPECT_EQ(hash_map_count(&map), 0u);
+    EXPECT_EQ(hash_map_get_str(&map, "a"), nullptr);
+
+    // Does nothing for a fixed map
+    hash_map_free(&map);
+    EXPECT_EQ(map.entries, entries);
+}
+
+TEST(util_hash_map, remove_backshift)
+{
+    hash_map_t map;
+    hash_map_entry_t entries[16];
+    std::vector<std::string> keys = colliding_keys(5, 16);
+    int values[5];
+
+    ASSERT_EQ(hash_map_init(&map, HASH_MAP_KEY_STRING, entries, 16), FUNCTION_RETURN_OK);
+    for(size_t i = 0; i < keys.size(); i++)
+        ASSERT_EQ(hash_map_put_str(&map, keys[i].c_str(), &values[i]), FUNCTION_RETURN_OK);
+
+    // All keys are in one probe sequence. Removing one in the middle moves the following ones back.
+    EXPECT_EQ(hash_map_remove_str(&map, keys[1].c_str()), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_remove_str(&map, keys[1].c_str()), FUNCTION_RETURN_NOT_FOUND);
+    EXPECT_EQ(hash_map_get_str(&map, keys[1].c_str()), nullptr);
+    for(size_t i : {0, 2, 3, 4})
+        EXPECT_EQ(hash_map_get_str(&map, keys[i].c_str()), &values[i]) << i;
+
+    // No deleted markers are left, so the probe sequence is as long as the number of keys.
+    size_t used = 0;
+    size_t home = hash_map_hash_str(keys[0].data(), keys[0].size()) & 15;
+    while(entries[(home + used) & 15].hash != 0)
+        used++;
+    EXPECT_EQ(used, 4u);
+
+    EXPECT_EQ(hash_map_remove_str(&map, keys[0].c_str()), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_remove_str(&map, keys[4].c_str()), FUNCTION_RETURN_OK);
+    EXPECT_EQ(hash_map_get_str(&map, keys[2].c_str()), &values[2]);
+    EXPECT_EQ(hash_map_get_str(&map, keys[3].c_str()), &values[3]);
+    EXPECT_EQ(hash_map_count(&map), 2u);
+}
+
+TEST(util_hash_map, remove_random)
+{
+    hash_map_t map;
+    hash_map_entry_t entries[64];
+    std::vector<uintptr_t> keys;
+    std::mt19937 rng(1234);
+    int value;
+
+    // A nearly full map has long clusters that wrap around the end of the array.
+    ASSERT_EQ(hash_map_init(&map, HASH_MAP_KEY_INT, entries, 64), FUNCTION_RETURN_OK);
+    for(size_t round = 0; round < 50; round++)
+    {
+        while(keys.size() < 63)
+        {
+            uintptr_t k = rng();
+            if(hash_map_get_int(&map, k) != nullptr)
+                continue;
+            ASSERT_EQ(hash_map_put_int(&map, k, (void*)(k | 1)), FUNCTION_RETURN_OK);
+            keys.push_back(k);
+        }
+        EXPECT_EQ(hash_map_put_int(&map, 1, &value), FUNCTION_RETURN_INSUFFICIENT_MEMORY);
+
+        std::shuffle(keys.begin(), keys.end(), rng);
+        for(size_t i = 0; i < 40; i++)
+        {
+            ASSERT_EQ(hash_map_remove_int(&map, keys.back()), FUNCTION_RETURN_OK);
+            EXPECT_EQ(hash_map_get_int(&map, keys.back()), nullptr);
+            keys.pop_back();
+        }
+        ASSERT_EQ(hash_map_count(&map), keys.size());
+        for(uintptr_t k : keys)
+            ASSERT_EQ(hash_map_get_int(&map, k), (void*)(k | 1));
+    }
+}
+
+TEST(util_hash_map, dynamic_growth)
+{
+    hash_map_t map;
+    std::vector<std::string> keys;
+
+    ASSERT_EQ(hash_map_init_dynamic(&map, HASH_MAP_KEY_STRING, 5), FUNCTION_RETURN_OK);
+    EXPECT_EQ(map.capacity, 8u);
+
+    for(size_t i = 0; i < 1000; i++)
+        keys.push_back("key" + std::to_string(i));
+
+    // The map grows when the next key would fill more than 75%.
+    for(size_t i = 0; i < 6; i++)
+        ASSERT_EQ(hash_map_put_str(&map, keys[i].c_str(), (void*)&keys[i]), FUNCTION_RETURN_OK);
+    EXPECT_EQ(map.capacity, 8u);
+    ASSERT_EQ(hash_map_put_str(&map, keys[6].c_str(), (void*)&keys[6]), FUNCTION_RETURN_OK);
+    EXPECT_EQ(map.capacity, 16u);
+
+    for(size_t i = 7; i < keys.size(); i++)
+    {
+        ASSERT_EQ(hash_map_put_str(&map, keys[i].c_str(), (void*)&keys[i]), FUNCTION_RETURN_OK);
+        EXPECT_LE(hash_map_count(&map) * 4, map.capacity * 3);
+    }
+    EXPECT_EQ(map.capacity, 2048u);
+    EXPECT_EQ(hash_map_count(&map), keys.size());
+
+    // All keys were moved by the resizes.
+    for(size_t i = 0; i < keys.size(); i++)
+        ASSERT_EQ(hash_map_get_str(&map, keys[i].c_str()), (void*)&keys[i]) << i;
+
+    hash_map_free(&map);
+    EXPECT_EQ(map.entries, nullptr);
+    EXPECT_EQ(hash_map_count(&map), 0u);
+    EXPECT_EQ(hash_map_get_str(&map, keys[0].c_str()), nullptr);
+    EXPECT_EQ(hash_map_put_str(&map, keys[0].c_str(), NULL), FUNCTION_RETURN_NOT_READY);
+}
+
+TEST(util_hash_map, get_strn)
+{
+    hash_map_t map;
+    hash_map_entry_t entries[16];
+    const char* line = "led ledx 1";
+    int led, ledx;
+
+    ASSERT_EQ(hash_map_init(&map, HASH_MAP_KEY_STRING, entries, 16), FUNCTION_RETURN_OK);
+    ASSERT_EQ(hash_map_put_str(&map, "led", &led), FUNCTION_RETURN_OK);
+    ASSERT_EQ(hash_map_put_str(&map, "ledx", &ledx), FUNCTION_RETURN_OK);
+
+    // Words inside a line are found without copying them, prefixes and longer words do not match.
+    EXPECT_EQ(hash_map_get_strn(&map, line, 3), &led);
+    EXPECT_EQ(hash_map_get_strn(&map, line + 4, 4), &ledx);
+    EXPECT_EQ(hash_map_get_strn(&map, line + 4, 3), &led);
+    EXPECT_EQ(hash_map_get_strn(&map, line, 2), nullptr);
+    EXPECT_EQ(hash_map_get_strn(&map, line, 5), nullptr);
+    EXPECT_EQ(hash_map_get_strn(&map, line, 0), nullptr);
+    EXPECT_EQ(hash_map_get_strn(&map, NULL, 3), nullptr);
+
+    EXPECT_EQ(hash_map_get_strn_hashed(&map, line + 4, 4, hash_map_hash_str(line + 4, 4)), &ledx);
+    EXPECT_EQ(hash_map_hash_str("", 0), hash_map_hash_str("", 0));
+    EXPECT_NE(hash_map_hash_str("", 0), 0u);
+}
@@ -3,6 +3,7 @@
 extern "C"
 {
     #include "module/util/mem_pool.h"
+    #include "module/crc/crc32.h"
 
     void app_main_init(void)
     {
@@ -160,4 +161,133 @@ TEST_F(UtilMempoolTest, AllocWriteRead)
 
 	ret = mem_pool_free_chunk(chunk);
 	ASSERT_EQ(ret, FUNCTION_RETURN_OK);
-}
\ No newline at end of file
+}
+
+TEST_F(UtilMempoolTest, Stats)
+{
+    mem_pool_chunk_handle_t chunk, chunk2;
+    mem_pool_stats_t stats;
+
+    ASSERT_EQ(ret, FUNCTION_RETURN_OK) << "Pool init failed\n";
+
+    ASSERT_EQ(mem_pool_get_stats(pool, &stats), FUNCTION_RETURN_OK);
+    EXPECT_EQ(stats.chunks_num, 12);
+    EXPECT_EQ(stats.chunks_free, 12);
+    EXPECT_EQ(stats.chunks_used_max, 0);
+    EXPECT_EQ(stats.alloc_failures, 0);
+
+    ASSERT_EQ(mem_pool_alloc_chunk(pool, &chunk, 512 * 8), FUNCTION_RETURN_OK);
+    EXPECT_EQ(mem_pool_alloc_chunk(pool, &chunk2, 512 * 5), FUNCTION_RETURN_INSUFFICIENT_MEMORY);
+    EXPECT_EQ(chunk2, nullptr);
+    EXPECT_EQ(mem_pool_realloc_chunk(chunk, 512 * 13), FUNCTION_RETURN_INSUFFICIENT_MEMORY);
+    EXPECT_EQ(mem_pool_get_chunk_total_size(chunk), 512 * 8);
+
+    ASSERT_EQ(mem_pool_realloc_chunk(chunk, 512 * 10), FUNCTION_RETURN_OK);
+    ASSERT_EQ(mem_pool_realloc_chunk(chunk, 1), FUNCTION_RETURN_OK);
+    EXPECT_EQ(mem_pool_get_chunk_total_size(chunk), 512);
+
+    ASSERT_EQ(mem_pool_get_stats(pool, &stats), FUNCTION_RETURN_OK);
+    EXPECT_EQ(stats.chunks_free, 11);
+    EXPECT_EQ(stats.chunks_used_max, 10);
+    EXPECT_EQ(stats.alloc_failures, 2);
+
+    // All other chunks are free again, so the full remainder can be allocated.
+    ASSERT_EQ(mem_pool_alloc_chunk(pool, &chunk2, 512 * 11), FUNCTION_RETURN_OK);
+    EXPECT_EQ(mem_pool_get_chunk_total_size(chunk2), 512 * 11);
+
+    ASSERT_EQ(mem_pool_free_chunk(chunk2), FUNCTION_RETURN_OK);
+    ASSERT_EQ(mem_pool_free_chunk(chunk), FUNCTION_RETURN_OK);
+
+    ASSERT_EQ(mem_pool_get_stats(pool, &stats), FUNCTION_RETURN_OK);
+    EXPECT_EQ(stats.chunks_free, 12);
+    EXPECT_EQ(stats.chunks_used_max, 12);
+}
+
+TEST_F(UtilMempoolTest, View)
+{
+    mem_pool_chunk_handle_t chunk;
+    mem_pool_segment_t segments[8];
+    uint8_t data[2000];
+    size_t count;
+
+    ASSERT_EQ(ret, FUNCTION_RETURN_OK) << "Pool init failed\n";
+
+    for(size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 7);
+    }
+
+    ASSERT_EQ(mem_pool_alloc_chunk(pool, &chunk, sizeof(data)), FUNCTION_RETURN_OK);
+    ASSERT_EQ(mem_pool_append_chunk(chunk, data, sizeof(data), false), sizeof(data));
+
+    // Range spanning three chunks
+    count = mem_pool_view_get_segments(chunk, 500, 600, segments, 8);
+    ASSERT_EQ(count, 3);
+    EXPECT_EQ(segments[0].len, 12);
+    EXPECT_EQ(segments[1].len, 512);
+    EXPECT_EQ(segments[2].len, 76);
+    EXPECT_EQ(memcmp(segments[0].ptr, &data[500], 12), 0);
+    EXPECT_EQ(memcmp(segments[1].ptr, &data[512], 512), 0);
+    EXPECT_EQ(memcmp(segments[2].ptr, &data[1024], 76), 0);
+
+    // Range is cut at the end of the chain
+    count = mem_pool_view_get_segments(chunk, 1500, 1000, segments, 8);
+    ASSERT_EQ(count, 2);
+    EXPECT_EQ(segments[0].len, 36);
+    EXPECT_EQ(segments[1].len, 512);
+
+    // Array is too small
+    EXPECT_EQ(mem_pool_view_get_segments(chunk, 0, 2000, segments, 2), 2);
+
+    // Offset behind the chain
+    EXPECT_EQ(mem_pool_view_get_segments(chunk, 2048, 10, segments, 8), 0);
+
+    // CRC over the segments must match the CRC over the contiguous data
+    crc32_t crc;
+    CRC32_INIT_DEFAULT(&crc);
+    crc32_start(&crc);
+    crc32_update(&crc, &data[3], 1990);
+    uint32_t expected = crc32_finish(&crc);
+    crc32_start(&crc);
+    EXPECT_EQ(mem_pool_crc32_update(&crc, chunk, 3, 1990), 1990);
+    EXPECT_EQ(crc32_finish(&crc), expected);
+
+    ASSERT_EQ(mem_pool_free_chunk(chunk), FUNCTION_RETURN_OK);
+}
+
+TEST(util_mempool, alloc_free_rounds)
+{
+    const size_t num_chunks = 4096;
+    const size_t num_held = 1024;
+    const int rounds = 4;
+    mem_pool_handle_t pool;
+    mem_pool_chunk_handle_t* held = new mem_pool_chunk_handle_t[num_held];
+
+    ASSERT_EQ(mem_pool_init(&pool, num_chunks, 64), FUNCTION_RETURN_OK);
+
+    // Keep the upper part of the pool allocated, so the free chunks are only found through the free list.
+    mem_pool_chunk_handle_t filler;
+    ASSERT_EQ(mem_pool_alloc_chunk(pool, &filler, 64 * (num_chunks - num_held)), FUNCTION_RETURN_OK);
+
+    for(int r = 0; r < rounds; r++)
+    {
+        for(size_t i = 0; i < num_held; i++)
+        {
+            ASSERT_EQ(mem_pool_alloc_chunk(pool, &held[i], 64), FUNCTION_RETURN_OK);
+        }
+        for(size_t i = 0; i < num_held; i++)
+        {
+            ASSERT_EQ(mem_pool_free_chunk(held[i]), FUNCTION_RETURN_OK);
+        }
+    }
+
+    mem_pool_stats_t stats;
+    ASSERT_EQ(mem_pool_get_stats(pool, &stats), FUNCTION_RETURN_OK);
+    EXPECT_EQ(stats.chunks_free, num_held);
+    EXPECT_EQ(stats.chunks_used_max, num_chunks);
+    EXPECT_EQ(stats.alloc_failures, 0);
+
+    ASSERT_EQ(mem_pool_free_chunk(filler), FUNCTION_RETURN_OK);
+    ASSERT_EQ(mem_pool_free(pool, false), FUNCTION_RETURN_OK);
+    delete[] held;
+}